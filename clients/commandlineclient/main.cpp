@@ -16,6 +16,7 @@ struct Options {
 void printUsage() {
     std::cout << "Usage:\n"
               << "  commandlineclient list-cues [--host HOST] [--port PORT]\n"
+              << "  commandlineclient load-cues [projectId] [--host HOST] [--port PORT]\n"
               << "  commandlineclient play-cue <cueId> [--host HOST] [--port PORT]\n"
               << "  commandlineclient help\n";
 }
@@ -69,6 +70,26 @@ int listCues(const Options& opts) {
     return 1;
 }
 
+int loadCues(const Options& opts, const std::string& projectId) {
+    auto cli = makeClient(opts);
+
+    nlohmann::json payload = nlohmann::json::object();
+    if (!projectId.empty()) {
+        payload["projectId"] = projectId;
+    }
+    if (auto res = cli.Post("/renderer/loadCues", "application/json", payload.dump())) {
+        if (res->status == 200) {
+            auto body = nlohmann::json::parse(res->body);
+            std::cout << "Sent " << body.value("cues", 0) << " cues and " << body.value("scenes", 0)
+                      << " scenes to the renderers\n";
+            return 0;
+        }
+        std::cerr << "loadCues responded " << res->status << ", response: " << res->body << "\n";
+    }
+
+    return 1;
+}
+
 int playCue(const Options& opts, const std::string& cueId) {
     auto cli = makeClient(opts);
 
@@ -104,6 +125,10 @@ int main(int argc, char* argv[]) {
         return listCues(opts);
     }
 
+    if (command == "load-cues") {
+        return loadCues(opts, argc >= 3 && argv[2] != nullptr ? argv[2] : "");
+    }
+
     if (command == "play-cue") {
         if (argc < 3 || argv[2] == nullptr) {
             std::cerr << "play-cue requires <cueId>\n";
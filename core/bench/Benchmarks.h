@@ -0,0 +1,9 @@
+#pragma once
+
+#include <projection/bench/BenchHarness.h>
+
+namespace projection::core::bench {
+
+void runLineFramerBenchmarks(projection::bench::BenchRunner& runner);
+
+}  // namespace projection::core::bench
@@ -0,0 +1,74 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#include "projection/core/LineFramer.h"
+
+namespace projection::core::bench {
+
+using projection::bench::doNotOptimize;
+
+namespace {
+constexpr double kMega = 1e-6;
+constexpr size_t kReadSize = 64 * 1024;
+
+// The readers' previous approach: append each read to a std::string, search it from the
+// start for '\n' and erase the consumed prefix per line.
+size_t legacyFrame(const std::string& stream, size_t readSize) {
+  std::string buffer;
+  size_t total = 0;
+  for (size_t offset = 0; offset < stream.size(); offset += readSize) {
+    buffer.append(stream, offset, std::min(readSize, stream.size() - offset));
+    size_t newline = 0;
+    while ((newline = buffer.find('\n')) != std::string::npos) {
+      const std::string line = buffer.substr(0, newline);
+      buffer.erase(0, newline + 1);
+      total += line.size();
+    }
+  }
+  return total;
+}
+
+size_t framerFrame(const std::string& stream, size_t readSize) {
+  LineFramer framer(LineFramer::kDefaultMaxLineBytes, readSize);
+  size_t total = 0;
+  std::string_view line;
+  for (size_t offset = 0; offset < stream.size(); offset += readSize) {
+    framer.append(stream.data() + offset, std::min(readSize, stream.size() - offset));
+    while (framer.nextLine(line)) {
+      total += line.size();
+    }
+  }
+  return total;
+}
+
+void runStream(projection::bench::BenchRunner& runner, const std::string& name, const std::string& stream) {
+  const double bytes = static_cast<double>(stream.size());
+  runner.run(
+      "framing/" + name + "/legacy", [&] { doNotOptimize(legacyFrame(stream, kReadSize)); }, bytes, kMega,
+      "MB/s");
+  runner.run(
+      "framing/" + name + "/LineFramer", [&] { doNotOptimize(framerFrame(stream, kReadSize)); }, bytes, kMega,
+      "MB/s");
+}
+}  // namespace
+
+void runLineFramerBenchmarks(projection::bench::BenchRunner& runner) {
+  // One 10 MB message (e.g. a large scene definition) arriving in 64 KB reads.
+  std::string large(10 * 1024 * 1024, 'x');
+  large.push_back('\n');
+  runStream(runner, "10MB-message", large);
+
+  // 100k acks/status lines of ~80 bytes, several per read.
+  const std::string small = R"({"type":"ack","commandId":"cmd-000000","status":"ok","timestamp":1234567890})";
+  std::string flood;
+  for (int i = 0; i < 100000; ++i) {
+    flood += small;
+    flood.push_back('\n');
+  }
+  runStream(runner, "small-flood", flood);
+}
+
+}  // namespace projection::core::bench
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace projection::bench {
+
+// Minimal micro-benchmark harness shared by the *_benchmarks executables. Each case runs
+// its body repeatedly for at least minSeconds after one warm-up call and reports time per
+// iteration plus throughput in the case's own unit (e.g. MP/s, MB/s, msg/s).
+
+struct BenchOptions {
+  double minSeconds{0.5};
+  // Only cases whose name contains this substring run.
+  std::string filter{};
+};
+
+struct BenchResult {
+  std::string name;
+  size_t iterations{0};
+  double secondsPerIteration{0.0};
+  // itemsPerIteration / secondsPerIteration scaled by the case's unitScale.
+  double throughput{0.0};
+  std::string unit;
+};
+
+// Accepts --min-time <seconds> and --filter <substring>.
+inline BenchOptions parseBenchArgs(int argc, char* argv[]) {
+  BenchOptions options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg(argv[i]);
+    if (arg == "--min-time" && i + 1 < argc) {
+      options.minSeconds = std::atof(argv[++i]);
+    } else if (arg == "--filter" && i + 1 < argc) {
+      options.filter = argv[++i];
+    }
+  }
+  return options;
+}
+
+// Keeps the compiler from discarding a computed value.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T* sink;
+  sink = &value;
+#endif
+}
+
+class BenchRunner {
+ public:
+  explicit BenchRunner(BenchOptions options) : options_(std::move(options)) {
+    std::printf("%-48s %12s %14s %16s\n", "benchmark", "iterations", "time/iter", "throughput");
+  }
+
+  // itemsPerIteration * unitScale / secondsPerIteration is reported in `unit`;
+  // e.g. pixels with unitScale 1e-6 and unit "MP/s".
+  template <typename Fn>
+  void run(const std::string& name, Fn&& body, double itemsPerIteration, double unitScale, const std::string& unit) {
+    if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos) {
+      return;
+    }
+    using Clock = std::chrono::steady_clock;
+    body();
+
+    size_t iterations = 0;
+    const auto start = Clock::now();
+    double elapsed = 0.0;
+    do {
+      body();
+      ++iterations;
+      elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < options_.minSeconds);
+
+    BenchResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.secondsPerIteration = elapsed / static_cast<double>(iterations);
+    result.throughput = itemsPerIteration * unitScale / result.secondsPerIteration;
+    result.unit = unit;
+    print(result);
+    results_.push_back(std::move(result));
+  }
+
+  const std::vector<BenchResult>& results() const { return results_; }
+
+ private:
+  static void print(const BenchResult& result) {
+    const double micros = result.secondsPerIteration * 1e6;
+    std::printf("%-48s %12zu %11.2f us %11.2f %s\n", result.name.c_str(), result.iterations, micros,
+                result.throughput, result.unit.c_str());
+  }
+
+  BenchOptions options_;
+  std::vector<BenchResult> results_{};
+};
+
+}  // namespace projection::bench
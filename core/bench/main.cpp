@@ -0,0 +1,7 @@
+#include "Benchmarks.h"
+
+int main(int argc, char* argv[]) {
+  projection::bench::BenchRunner runner(projection::bench::parseBenchArgs(argc, argv));
+  projection::core::bench::runLineFramerBenchmarks(runner);
+  return 0;
+}
@@ -27,6 +27,11 @@ class Cue {
   const std::map<SurfaceId, float>& getSurfaceBrightnesses() const { return surfaceBrightnesses_; }
   std::map<SurfaceId, float>& getSurfaceBrightnesses() { return surfaceBrightnesses_; }
 
+  bool operator==(const Cue& other) const {
+    return id_ == other.id_ && name_ == other.name_ && sceneId_ == other.sceneId_ &&
+           surfaceOpacities_ == other.surfaceOpacities_ && surfaceBrightnesses_ == other.surfaceBrightnesses_;
+  }
+
  private:
   CueId id_{};
   std::string name_{};
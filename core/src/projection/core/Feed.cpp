@@ -1,6 +1,7 @@
 #include "projection/core/Feed.h"
 
 #include <nlohmann/json.hpp>
+#include <cstdio>
 #include <utility>
 #include <stdexcept>
 
@@ -25,9 +26,174 @@ VideoFileConfig parseVideoFileConfig(const Feed& feed) {
   return VideoFileConfig{json["filePath"].get<std::string>()};
 }
 
+namespace {
+constexpr int kMaxGeneratedSize = 8192;
+
+struct GeneratorName {
+  GeneratorKind kind;
+  const char* name;
+};
+
+constexpr GeneratorName kGeneratorNames[] = {
+    {GeneratorKind::ColorField, "colorField"},       {GeneratorKind::Gradient, "gradient"},
+    {GeneratorKind::Noise, "noise"},                 {GeneratorKind::TestPattern, "testPattern"},
+    {GeneratorKind::ScrollingText, "scrollingText"},
+};
+
+int hexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+GeneratorColor parseColor(const std::string& text) {
+  if ((text.size() != 7 && text.size() != 9) || text[0] != '#') {
+    throw std::runtime_error("Invalid Generated feed config: color '" + text + "' must be #rrggbb or #rrggbbaa");
+  }
+  uint8_t channels[4] = {0, 0, 0, 255};
+  for (size_t i = 1, c = 0; i < text.size(); i += 2, ++c) {
+    const int high = hexDigit(text[i]);
+    const int low = hexDigit(text[i + 1]);
+    if (high < 0 || low < 0) {
+      throw std::runtime_error("Invalid Generated feed config: color '" + text + "' is not hexadecimal");
+    }
+    channels[c] = static_cast<uint8_t>(high * 16 + low);
+  }
+  return GeneratorColor{channels[0], channels[1], channels[2], channels[3]};
+}
+
+std::string formatColor(const GeneratorColor& color) {
+  char buffer[10];
+  if (color.a == 255) {
+    std::snprintf(buffer, sizeof(buffer), "#%02x%02x%02x", color.r, color.g, color.b);
+  } else {
+    std::snprintf(buffer, sizeof(buffer), "#%02x%02x%02x%02x", color.r, color.g, color.b, color.a);
+  }
+  return buffer;
+}
+
+int parseSize(const nlohmann::json& json, const char* key, int fallback) {
+  if (!json.contains(key)) {
+    return fallback;
+  }
+  if (!json[key].is_number_integer()) {
+    throw std::runtime_error(std::string("Invalid Generated feed config: ") + key + " must be an integer");
+  }
+  const auto value = json[key].get<int64_t>();
+  if (value < 1 || value > kMaxGeneratedSize) {
+    throw std::runtime_error(std::string("Invalid Generated feed config: ") + key + " must be in 1..8192");
+  }
+  return static_cast<int>(value);
+}
+
+float parseNumber(const nlohmann::json& json, const char* key, float fallback) {
+  if (!json.contains(key)) {
+    return fallback;
+  }
+  if (!json[key].is_number()) {
+    throw std::runtime_error(std::string("Invalid Generated feed config: ") + key + " must be a number");
+  }
+  return json[key].get<float>();
+}
+}  // namespace
+
+std::string toString(GeneratorKind kind) {
+  for (const auto& entry : kGeneratorNames) {
+    if (entry.kind == kind) {
+      return entry.name;
+    }
+  }
+  return "Unknown";
+}
+
+bool fromString(const std::string& value, GeneratorKind& outKind) {
+  for (const auto& entry : kGeneratorNames) {
+    if (value == entry.name) {
+      outKind = entry.kind;
+      return true;
+    }
+  }
+  return false;
+}
+
 Feed makeVideoFileFeed(const FeedId& id, const std::string& name, const std::string& filePath) {
   nlohmann::json config{{"filePath", filePath}};
   return Feed(id, name, FeedType::VideoFile, config.dump());
 }
 
+GeneratedFeedConfig parseGeneratedFeedConfig(const Feed& feed) {
+  if (feed.getType() != FeedType::Generated) {
+    throw std::runtime_error("parseGeneratedFeedConfig requires a Generated feed");
+  }
+
+  auto json = nlohmann::json::parse(feed.getConfigJson());
+  if (!json.is_object() || !json.contains("generator") || !json["generator"].is_string()) {
+    throw std::runtime_error("Invalid Generated feed config: missing generator");
+  }
+
+  GeneratedFeedConfig config;
+  const auto generator = json["generator"].get<std::string>();
+  if (!fromString(generator, config.generator)) {
+    throw std::runtime_error("Invalid Generated feed config: unknown generator '" + generator + "'");
+  }
+  config.width = parseSize(json, "width", config.width);
+  config.height = parseSize(json, "height", config.height);
+
+  if (json.contains("colors")) {
+    if (!json["colors"].is_array()) {
+      throw std::runtime_error("Invalid Generated feed config: colors must be an array");
+    }
+    for (const auto& color : json["colors"]) {
+      if (!color.is_string()) {
+        throw std::runtime_error("Invalid Generated feed config: colors must be strings");
+      }
+      config.colors.push_back(parseColor(color.get<std::string>()));
+    }
+  }
+
+  config.angleDegrees = parseNumber(json, "angle", config.angleDegrees);
+  config.speed = parseNumber(json, "speed", config.speed);
+  config.scale = parseNumber(json, "scale", config.scale);
+  if (config.scale < 0.0f) {
+    throw std::runtime_error("Invalid Generated feed config: scale must not be negative");
+  }
+  if (json.contains("seed")) {
+    if (!json["seed"].is_number_unsigned()) {
+      throw std::runtime_error("Invalid Generated feed config: seed must be a non-negative integer");
+    }
+    config.seed = json["seed"].get<uint32_t>();
+  }
+  if (json.contains("text")) {
+    if (!json["text"].is_string()) {
+      throw std::runtime_error("Invalid Generated feed config: text must be a string");
+    }
+    config.text = json["text"].get<std::string>();
+  }
+  return config;
+}
+
+Feed makeGeneratedFeed(const FeedId& id, const std::string& name, const GeneratedFeedConfig& config) {
+  nlohmann::json colors = nlohmann::json::array();
+  for (const auto& color : config.colors) {
+    colors.push_back(formatColor(color));
+  }
+  nlohmann::json json{{"generator", toString(config.generator)},
+                      {"width", config.width},
+                      {"height", config.height},
+                      {"colors", colors},
+                      {"angle", config.angleDegrees},
+                      {"speed", config.speed},
+                      {"scale", config.scale},
+                      {"seed", config.seed},
+                      {"text", config.text}};
+  return Feed(id, name, FeedType::Generated, json.dump());
+}
+
 }  // namespace projection::core
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "projection/core/Enums.h"
 #include "projection/core/Ids.h"
@@ -11,6 +13,51 @@ struct VideoFileConfig {
   std::string filePath;
 };
 
+// Built-in procedural sources for FeedType::Generated.
+enum class GeneratorKind { ColorField, Gradient, Noise, TestPattern, ScrollingText };
+
+std::string toString(GeneratorKind kind);
+// Parse a GeneratorKind from its config name ("colorField", "gradient", ...). Returns true on success.
+bool fromString(const std::string& value, GeneratorKind& outKind);
+
+struct GeneratorColor {
+  uint8_t r{0};
+  uint8_t g{0};
+  uint8_t b{0};
+  uint8_t a{255};
+
+  bool operator==(const GeneratorColor& other) const {
+    return r == other.r && g == other.g && b == other.b && a == other.a;
+  }
+};
+
+// Config of a Generated feed. Colors are written as "#rrggbb" or "#rrggbbaa" and mean:
+//   colorField     colors cross-faded in turn, `speed` colors per second (one color is static)
+//   gradient       evenly spaced stops along `angleDegrees`, scrolled `speed` lengths per second
+//   noise          low and high end of smooth value noise with `scale` pixel cells, drifting
+//                  `speed` pixels per second
+//   testPattern    ignored (color bars, grey ramp and alignment grid; never animates)
+//   scrollingText  text and background colors; glyph pixels are `scale` output pixels and the
+//                  text scrolls left `speed` pixels per second
+// A scale of 0 picks the generator's default.
+struct GeneratedFeedConfig {
+  GeneratorKind generator{GeneratorKind::ColorField};
+  int width{1920};
+  int height{1080};
+  std::vector<GeneratorColor> colors{};
+  float angleDegrees{0.0f};
+  float speed{0.0f};
+  float scale{0.0f};
+  uint32_t seed{1};
+  std::string text{};
+
+  bool operator==(const GeneratedFeedConfig& other) const {
+    return generator == other.generator && width == other.width && height == other.height &&
+           colors == other.colors && angleDegrees == other.angleDegrees && speed == other.speed &&
+           scale == other.scale && seed == other.seed && text == other.text;
+  }
+};
+
 class Feed {
  public:
   Feed() = default;
@@ -42,4 +89,9 @@ class Feed {
 VideoFileConfig parseVideoFileConfig(const Feed& feed);
 Feed makeVideoFileFeed(const FeedId& id, const std::string& name, const std::string& filePath);
 
+// Throws std::runtime_error for non-Generated feeds, unknown generators, frame sizes outside
+// 1..8192, malformed colors or a negative scale.
+GeneratedFeedConfig parseGeneratedFeedConfig(const Feed& feed);
+Feed makeGeneratedFeed(const FeedId& id, const std::string& name, const GeneratedFeedConfig& config);
+
 }  // namespace projection::core
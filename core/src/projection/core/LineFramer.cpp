@@ -0,0 +1,83 @@
+#include "projection/core/LineFramer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace projection::core {
+
+LineFramer::LineFramer(size_t maxLineBytes, size_t readSize)
+    : maxLineBytes_(std::max<size_t>(1, maxLineBytes)), readSize_(std::max<size_t>(1, readSize)) {}
+
+char* LineFramer::prepare() {
+  if (begin_ == end_) {
+    begin_ = scan_ = end_ = 0;
+  }
+  if (capacity_ - end_ >= readSize_) {
+    return data_.get() + end_;
+  }
+
+  const size_t pending = end_ - begin_;
+  if (capacity_ != 0 && pending <= capacity_ / 2 && capacity_ - pending >= readSize_) {
+    std::memmove(data_.get(), data_.get() + begin_, pending);
+  } else {
+    const size_t grown = std::max(capacity_ * 2, std::max(pending + readSize_, readSize_ * 2));
+    std::unique_ptr<char[]> data(new char[grown]);
+    if (pending != 0) {
+      std::memcpy(data.get(), data_.get() + begin_, pending);
+    }
+    data_ = std::move(data);
+    capacity_ = grown;
+  }
+  copiedBytes_ += pending;
+  scan_ -= begin_;
+  end_ = pending;
+  begin_ = 0;
+  return data_.get() + end_;
+}
+
+void LineFramer::commit(size_t bytes) {
+  if (bytes > capacity_ - end_) {
+    throw std::runtime_error("LineFramer::commit past the prepared space");
+  }
+  end_ += bytes;
+}
+
+void LineFramer::append(const char* data, size_t size) {
+  while (size != 0) {
+    char* target = prepare();
+    const size_t count = std::min(size, writableBytes());
+    std::memcpy(target, data, count);
+    commit(count);
+    data += count;
+    size -= count;
+  }
+}
+
+bool LineFramer::nextLine(std::string_view& line) {
+  const char* base = data_.get();
+  // memchr is vectorized by the C library, so the scan runs at memory bandwidth.
+  const void* found = scan_ < end_ ? std::memchr(base + scan_, '\n', end_ - scan_) : nullptr;
+  if (found == nullptr) {
+    scan_ = end_;
+    if (end_ - begin_ > maxLineBytes_) {
+      throw std::runtime_error("Control message exceeds " + std::to_string(maxLineBytes_) + " bytes");
+    }
+    return false;
+  }
+
+  const size_t newline = static_cast<size_t>(static_cast<const char*>(found) - base);
+  size_t lineEnd = newline;
+  if (lineEnd > begin_ && base[lineEnd - 1] == '\r') {
+    --lineEnd;
+  }
+  if (lineEnd - begin_ > maxLineBytes_) {
+    throw std::runtime_error("Control message exceeds " + std::to_string(maxLineBytes_) + " bytes");
+  }
+  line = std::string_view(base + begin_, lineEnd - begin_);
+  begin_ = scan_ = newline + 1;
+  return true;
+}
+
+}  // namespace projection::core
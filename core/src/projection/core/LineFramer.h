@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace projection::core {
+
+// Receive buffer for the newline-delimited control protocol. Socket reads land directly in
+// the buffer (prepare/commit), the newline scan resumes where the previous one stopped, and
+// complete lines come back as views into the buffer, so a message is neither copied nor
+// rescanned while its bytes arrive. Consumed bytes are reclaimed by moving the unfinished
+// tail to the front only when it is at most half the buffer; otherwise the buffer doubles.
+// Both keep the copying linear in the bytes received.
+//
+// One instance per connection reader; not thread-safe.
+class LineFramer {
+ public:
+  static constexpr size_t kDefaultMaxLineBytes = 64 * 1024 * 1024;
+  static constexpr size_t kDefaultReadSize = 64 * 1024;
+
+  explicit LineFramer(size_t maxLineBytes = kDefaultMaxLineBytes, size_t readSize = kDefaultReadSize);
+
+  // Writable space of at least readSize() bytes for the next read. Invalidates line views.
+  // Call it before writableBytes() (not in the same argument list: the order is unspecified).
+  char* prepare();
+  size_t writableBytes() const { return capacity_ - end_; }
+  // Marks `bytes` written at prepare() as received.
+  void commit(size_t bytes);
+  // prepare() + copy + commit(), for data that is already in memory.
+  void append(const char* data, size_t size);
+
+  // Next complete line without its '\n' (or "\r\n"). The view stays valid until the next
+  // prepare() or append(). Returns false when no complete line is buffered. Throws
+  // std::runtime_error once an unterminated line exceeds maxLineBytes(); the stream cannot
+  // be resynchronized after that, so the caller should drop the connection.
+  bool nextLine(std::string_view& line);
+
+  size_t bufferedBytes() const { return end_ - begin_; }
+  size_t capacity() const { return capacity_; }
+  size_t maxLineBytes() const { return maxLineBytes_; }
+  size_t readSize() const { return readSize_; }
+  // Total bytes moved by compaction and growth since construction.
+  size_t copiedBytes() const { return copiedBytes_; }
+
+ private:
+  std::unique_ptr<char[]> data_{};
+  size_t capacity_{0};
+  // Unconsumed bytes are [begin_, end_); bytes in [begin_, scan_) hold no newline.
+  size_t begin_{0};
+  size_t scan_{0};
+  size_t end_{0};
+  size_t maxLineBytes_;
+  size_t readSize_;
+  size_t copiedBytes_{0};
+};
+
+}  // namespace projection::core
@@ -12,6 +12,10 @@ struct ProjectSettings {
   std::map<std::string, std::string> controllers{};
   std::vector<int> midiChannels{};
   std::map<std::string, std::string> globalConfig{};
+
+  bool operator==(const ProjectSettings& other) const {
+    return controllers == other.controllers && midiChannels == other.midiChannels && globalConfig == other.globalConfig;
+  }
 };
 
 class Project {
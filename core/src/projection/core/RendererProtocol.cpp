@@ -1,5 +1,6 @@
 #include "projection/core/RendererProtocol.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -17,7 +18,10 @@ const std::unordered_map<RendererMessageType, std::string> kRendererMessageTypeT
                                                                                        {RendererMessageType::LoadScene, "loadScene"},
                                                                                        {RendererMessageType::LoadSceneDefinition, "loadSceneDefinition"},
                                                                                        {RendererMessageType::SetFeedForSurface, "setFeedForSurface"},
-                                                                                       {RendererMessageType::PlayCue, "playCue"}};
+                                                                                       {RendererMessageType::PlayCue, "playCue"},
+                                                                                       {RendererMessageType::TimeSync, "timeSync"},
+                                                                                       {RendererMessageType::UpdateSurfaceParams, "updateSurfaceParams"},
+                                                                                       {RendererMessageType::LoadCueTable, "loadCueTable"}};
 
 std::string toString(RendererMessageType type) { return kRendererMessageTypeToString.at(type); }
 
@@ -45,8 +49,84 @@ std::string requireString(const json& j, const std::string& key) {
   return field.get<std::string>();
 }
 
+int64_t requireInt64(const json& j, const std::string& key) {
+  const auto& field = requireField(j, key);
+  if (!field.is_number_integer()) {
+    throw std::runtime_error("Field '" + key + "' must be an integer");
+  }
+  return field.get<int64_t>();
+}
+
+float requireFloat(const json& j, const std::string& key) {
+  const auto& field = requireField(j, key);
+  if (!field.is_number()) {
+    throw std::runtime_error("Field '" + key + "' must be a number");
+  }
+  return field.get<float>();
+}
+
 }  // namespace
 
+void mergeSurfaceParams(UpdateSurfaceParamsMessage& earlier, const UpdateSurfaceParamsMessage& later) {
+  for (const auto& update : later.updates) {
+    auto it = std::find_if(earlier.updates.begin(), earlier.updates.end(),
+                           [&](const SurfaceParams& existing) { return existing.surfaceId == update.surfaceId; });
+    if (it == earlier.updates.end()) {
+      earlier.updates.push_back(update);
+      continue;
+    }
+    if (update.opacity) {
+      it->opacity = update.opacity;
+    }
+    if (update.brightness) {
+      it->brightness = update.brightness;
+    }
+    if (update.blendMode) {
+      it->blendMode = update.blendMode;
+    }
+    if (update.zOrder) {
+      it->zOrder = update.zOrder;
+    }
+    if (update.vertices) {
+      it->vertices = update.vertices;
+    }
+    if (update.feedId) {
+      it->feedId = update.feedId;
+    }
+  }
+}
+
+bool applySurfaceParams(Scene& scene, const SurfaceParams& params, std::string& error) {
+  Surface* surface = scene.findSurface(params.surfaceId);
+  if (surface == nullptr) {
+    error = "Surface not found: " + params.surfaceId.value;
+    return false;
+  }
+  if (params.vertices && params.vertices->size() < 3) {
+    error = "Surface " + params.surfaceId.value + " needs at least 3 vertices";
+    return false;
+  }
+  if (params.opacity) {
+    surface->setOpacity(*params.opacity);
+  }
+  if (params.brightness) {
+    surface->setBrightness(*params.brightness);
+  }
+  if (params.blendMode) {
+    surface->setBlendMode(*params.blendMode);
+  }
+  if (params.zOrder) {
+    surface->setZOrder(*params.zOrder);
+  }
+  if (params.vertices) {
+    surface->setVertices(*params.vertices);
+  }
+  if (params.feedId) {
+    surface->setFeedId(*params.feedId);
+  }
+  return true;
+}
+
 void to_json(json& j, const RendererMessageType& type) { j = toString(type); }
 
 void from_json(const json& j, RendererMessageType& type) {
@@ -58,6 +138,12 @@ void from_json(const json& j, RendererMessageType& type) {
 
 void to_json(json& j, const HelloMessage& message) {
   j = json{{"version", message.version}, {"role", message.role}, {"name", message.name}};
+  if (!message.group.empty()) {
+    j["group"] = message.group;
+  }
+  if (!message.tags.empty()) {
+    j["tags"] = message.tags;
+  }
 }
 
 void from_json(const json& j, HelloMessage& message) {
@@ -67,6 +153,20 @@ void from_json(const json& j, HelloMessage& message) {
   message.version = requireString(j, "version");
   message.role = requireString(j, "role");
   message.name = requireString(j, "name");
+  message.group = j.contains("group") ? requireString(j, "group") : std::string();
+  message.tags.clear();
+  if (j.contains("tags")) {
+    const auto& tagsJson = j.at("tags");
+    if (!tagsJson.is_array()) {
+      throw std::runtime_error("Field 'tags' must be an array");
+    }
+    for (const auto& tag : tagsJson) {
+      if (!tag.is_string()) {
+        throw std::runtime_error("Field 'tags' must contain strings");
+      }
+      message.tags.push_back(tag.get<std::string>());
+    }
+  }
 }
 
 void to_json(json& j, const AckMessage& message) { j = json{{"commandId", message.commandId}}; }
@@ -147,8 +247,128 @@ void from_json(const json& j, PlayCueMessage& message) {
   message.cueId = CueId(requireString(j, "cueId"));
 }
 
+void to_json(json& j, const TimeSyncMessage& message) {
+  j = json{{"clientSend", message.clientSendMicros},
+           {"serverReceive", message.serverReceiveMicros},
+           {"serverSend", message.serverSendMicros}};
+}
+
+void from_json(const json& j, TimeSyncMessage& message) {
+  if (!j.is_object()) {
+    throw std::runtime_error("TimeSync payload must be an object");
+  }
+  message.clientSendMicros = requireInt64(j, "clientSend");
+  message.serverReceiveMicros = requireInt64(j, "serverReceive");
+  message.serverSendMicros = requireInt64(j, "serverSend");
+}
+
+void to_json(json& j, const SurfaceParams& params) {
+  j = json{{"surfaceId", params.surfaceId.value}};
+  if (params.opacity) {
+    j["opacity"] = *params.opacity;
+  }
+  if (params.brightness) {
+    j["brightness"] = *params.brightness;
+  }
+  if (params.blendMode) {
+    j["blendMode"] = *params.blendMode;
+  }
+  if (params.zOrder) {
+    j["zOrder"] = *params.zOrder;
+  }
+  if (params.vertices) {
+    j["vertices"] = *params.vertices;
+  }
+  if (params.feedId) {
+    j["feedId"] = params.feedId->value;
+  }
+}
+
+void from_json(const json& j, SurfaceParams& params) {
+  if (!j.is_object()) {
+    throw std::runtime_error("Surface update must be an object");
+  }
+  params = SurfaceParams();
+  params.surfaceId = SurfaceId(requireString(j, "surfaceId"));
+  if (j.contains("opacity")) {
+    params.opacity = requireFloat(j, "opacity");
+  }
+  if (j.contains("brightness")) {
+    params.brightness = requireFloat(j, "brightness");
+  }
+  if (j.contains("blendMode")) {
+    params.blendMode = j.at("blendMode").get<BlendMode>();
+  }
+  if (j.contains("zOrder")) {
+    params.zOrder = static_cast<int>(requireInt64(j, "zOrder"));
+  }
+  if (j.contains("vertices")) {
+    const auto& verticesJson = j.at("vertices");
+    if (!verticesJson.is_array()) {
+      throw std::runtime_error("Field 'vertices' must be an array");
+    }
+    params.vertices = verticesJson.get<std::vector<Vec2>>();
+  }
+  if (j.contains("feedId")) {
+    params.feedId = FeedId(requireString(j, "feedId"));
+  }
+  if (!params.opacity && !params.brightness && !params.blendMode && !params.zOrder && !params.vertices &&
+      !params.feedId) {
+    throw std::runtime_error("Surface update for " + params.surfaceId.value + " changes no field");
+  }
+}
+
+void to_json(json& j, const UpdateSurfaceParamsMessage& message) { j = json{{"updates", message.updates}}; }
+
+void from_json(const json& j, UpdateSurfaceParamsMessage& message) {
+  if (!j.is_object()) {
+    throw std::runtime_error("UpdateSurfaceParams payload must be an object");
+  }
+  const auto& updatesJson = requireField(j, "updates");
+  if (!updatesJson.is_array() || updatesJson.empty()) {
+    throw std::runtime_error("Field 'updates' must be a non-empty array");
+  }
+  message.updates = updatesJson.get<std::vector<SurfaceParams>>();
+}
+
+void to_json(json& j, const CueTableMessage& message) {
+  j = json{{"cues", message.cues}, {"scenes", message.scenes}};
+  if (message.settings) {
+    j["settings"] = *message.settings;
+  }
+}
+
+void from_json(const json& j, CueTableMessage& message) {
+  if (!j.is_object()) {
+    throw std::runtime_error("LoadCueTable payload must be an object");
+  }
+  const auto& cuesJson = requireField(j, "cues");
+  if (!cuesJson.is_array()) {
+    throw std::runtime_error("Field 'cues' must be an array");
+  }
+  const auto& scenesJson = requireField(j, "scenes");
+  if (!scenesJson.is_array()) {
+    throw std::runtime_error("Field 'scenes' must be an array");
+  }
+  message.cues = cuesJson.get<std::vector<Cue>>();
+  message.scenes.clear();
+  message.scenes.reserve(scenesJson.size());
+  for (const auto& sceneJson : scenesJson) {
+    LoadSceneDefinitionMessage definition;
+    from_json(sceneJson, definition);
+    message.scenes.push_back(std::move(definition));
+  }
+  message.settings.reset();
+  if (j.contains("settings")) {
+    message.settings = j.at("settings").get<ProjectSettings>();
+  }
+}
+
 void to_json(json& j, const RendererMessage& message) {
   j = json{{"type", message.type}, {"commandId", message.commandId}};
+  if (message.executeAt) {
+    j["executeAt"] = *message.executeAt;
+  }
 
   json payload;
   switch (message.type) {
@@ -194,6 +414,24 @@ void to_json(json& j, const RendererMessage& message) {
       }
       payload = *message.playCue;
       break;
+    case RendererMessageType::TimeSync:
+      if (!message.timeSync) {
+        throw std::runtime_error("TimeSync message missing payload");
+      }
+      payload = *message.timeSync;
+      break;
+    case RendererMessageType::UpdateSurfaceParams:
+      if (!message.updateSurfaceParams) {
+        throw std::runtime_error("UpdateSurfaceParams message missing payload");
+      }
+      payload = *message.updateSurfaceParams;
+      break;
+    case RendererMessageType::LoadCueTable:
+      if (!message.cueTable) {
+        throw std::runtime_error("LoadCueTable message missing payload");
+      }
+      payload = *message.cueTable;
+      break;
   }
 
   if (!payload.is_null()) {
@@ -208,6 +446,10 @@ void from_json(const json& j, RendererMessage& message) {
 
   message.type = parseRendererMessageType(requireString(j, "type"));
   message.commandId = requireString(j, "commandId");
+  message.executeAt.reset();
+  if (j.contains("executeAt")) {
+    message.executeAt = requireInt64(j, "executeAt");
+  }
 
   const auto payloadIt = j.find("payload");
   if (payloadIt == j.end()) {
@@ -261,6 +503,24 @@ void from_json(const json& j, RendererMessage& message) {
       message.playCue = playCueMessage;
       break;
     }
+    case RendererMessageType::TimeSync: {
+      TimeSyncMessage timeSyncMessage;
+      from_json(payload, timeSyncMessage);
+      message.timeSync = timeSyncMessage;
+      break;
+    }
+    case RendererMessageType::UpdateSurfaceParams: {
+      UpdateSurfaceParamsMessage updateMessage;
+      from_json(payload, updateMessage);
+      message.updateSurfaceParams = std::move(updateMessage);
+      break;
+    }
+    case RendererMessageType::LoadCueTable: {
+      CueTableMessage cueTableMessage;
+      from_json(payload, cueTableMessage);
+      message.cueTable = std::move(cueTableMessage);
+      break;
+    }
   }
 }
 
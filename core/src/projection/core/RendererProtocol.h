@@ -1,12 +1,16 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
 
 #include <nlohmann/json.hpp>
 
+#include "projection/core/Cue.h"
+#include "projection/core/Enums.h"
 #include "projection/core/Ids.h"
+#include "projection/core/Project.h"
 #include "projection/core/Scene.h"
 #include "projection/core/Feed.h"
 
@@ -24,7 +28,10 @@ enum class RendererMessageType {
   LoadScene,
   LoadSceneDefinition,
   SetFeedForSurface,
-  PlayCue
+  PlayCue,
+  TimeSync,
+  UpdateSurfaceParams,
+  LoadCueTable
 };
 
 struct RendererMessageBase {
@@ -40,9 +47,14 @@ struct HelloMessage {
   std::string version;
   std::string role;
   std::string name;
+  // Addressing labels: the server can send to every renderer of a group or with a tag (e.g. a
+  // venue zone and the projector's position). Optional; omitted from the JSON when empty.
+  std::string group{};
+  std::vector<std::string> tags{};
 
   bool operator==(const HelloMessage& other) const {
-    return version == other.version && role == other.role && name == other.name;
+    return version == other.version && role == other.role && name == other.name && group == other.group &&
+           tags == other.tags;
   }
 };
 
@@ -85,15 +97,82 @@ struct SetFeedForSurfaceMessage {
   }
 };
 
+// Partial update of one surface: only the fields that are present change.
+struct SurfaceParams {
+  SurfaceId surfaceId;
+  std::optional<float> opacity;
+  std::optional<float> brightness;
+  std::optional<BlendMode> blendMode;
+  std::optional<int> zOrder;
+  std::optional<std::vector<Vec2>> vertices;
+  std::optional<FeedId> feedId;
+
+  // True when the update can change draw order or batching (anything but opacity/brightness).
+  bool changesLayout() const { return blendMode || zOrder || vertices || feedId; }
+
+  bool operator==(const SurfaceParams& other) const {
+    return surfaceId == other.surfaceId && opacity == other.opacity && brightness == other.brightness &&
+           blendMode == other.blendMode && zOrder == other.zOrder && vertices == other.vertices &&
+           feedId == other.feedId;
+  }
+};
+
+// Live changes to surfaces of the renderer's current scene, applied in place without
+// reloading any feed. Carries at most one entry per surface once built with
+// mergeSurfaceParams.
+struct UpdateSurfaceParamsMessage {
+  std::vector<SurfaceParams> updates;
+
+  bool operator==(const UpdateSurfaceParamsMessage& other) const { return updates == other.updates; }
+};
+
+// Folds `later` into `earlier` (later fields win) so applying the result equals applying
+// both messages in order.
+void mergeSurfaceParams(UpdateSurfaceParamsMessage& earlier, const UpdateSurfaceParamsMessage& later);
+
+// Applies params to the matching surface of scene. Returns false and leaves the scene
+// unchanged when the surface does not exist or the new vertices are not a polygon.
+bool applySurfaceParams(Scene& scene, const SurfaceParams& params, std::string& error);
+
 struct PlayCueMessage {
   CueId cueId;
 
   bool operator==(const PlayCueMessage& other) const { return cueId == other.cueId; }
 };
 
+// Cues a renderer caches ahead of time so PlayCue carries only the cue id: the cues plus
+// the definition (scene and feeds) of every scene they target. Replaces any earlier table.
+struct CueTableMessage {
+  std::vector<Cue> cues;
+  std::vector<LoadSceneDefinitionMessage> scenes;
+  // Settings of the project the cues belong to (MIDI channels and controller mappings);
+  // absent when the table is not for a single project.
+  std::optional<ProjectSettings> settings;
+
+  bool operator==(const CueTableMessage& other) const {
+    return cues == other.cues && scenes == other.scenes && settings == other.settings;
+  }
+};
+
+// Clock-offset probe. The renderer sends clientSendMicros on its own clock; the server echoes
+// it with its receive and send times (server clock, see TimeSync.h).
+struct TimeSyncMessage {
+  int64_t clientSendMicros{0};
+  int64_t serverReceiveMicros{0};
+  int64_t serverSendMicros{0};
+
+  bool operator==(const TimeSyncMessage& other) const {
+    return clientSendMicros == other.clientSendMicros && serverReceiveMicros == other.serverReceiveMicros &&
+           serverSendMicros == other.serverSendMicros;
+  }
+};
+
 struct RendererMessage {
   RendererMessageType type;
   std::string commandId;
+  // Server-clock time (monotonicMicros on the server) at which renderers should apply the
+  // command; absent means as soon as it arrives.
+  std::optional<int64_t> executeAt;
   std::optional<HelloMessage> hello;
   std::optional<AckMessage> ack;
   std::optional<ErrorMessage> error;
@@ -101,12 +180,17 @@ struct RendererMessage {
   std::optional<LoadSceneDefinitionMessage> loadSceneDefinition;
   std::optional<SetFeedForSurfaceMessage> setFeedForSurface;
   std::optional<PlayCueMessage> playCue;
+  std::optional<TimeSyncMessage> timeSync;
+  std::optional<UpdateSurfaceParamsMessage> updateSurfaceParams;
+  std::optional<CueTableMessage> cueTable;
 
   bool operator==(const RendererMessage& other) const {
-    return type == other.type && commandId == other.commandId && hello == other.hello &&
-           ack == other.ack && error == other.error && loadScene == other.loadScene &&
+    return type == other.type && commandId == other.commandId && executeAt == other.executeAt &&
+           hello == other.hello && ack == other.ack && error == other.error && loadScene == other.loadScene &&
            loadSceneDefinition == other.loadSceneDefinition &&
-           setFeedForSurface == other.setFeedForSurface && playCue == other.playCue;
+           setFeedForSurface == other.setFeedForSurface && playCue == other.playCue &&
+           timeSync == other.timeSync && updateSurfaceParams == other.updateSurfaceParams &&
+           cueTable == other.cueTable;
   }
 };
 
@@ -135,6 +219,18 @@ void from_json(const nlohmann::json& j, SetFeedForSurfaceMessage& message);
 void to_json(nlohmann::json& j, const PlayCueMessage& message);
 void from_json(const nlohmann::json& j, PlayCueMessage& message);
 
+void to_json(nlohmann::json& j, const TimeSyncMessage& message);
+void from_json(const nlohmann::json& j, TimeSyncMessage& message);
+
+void to_json(nlohmann::json& j, const SurfaceParams& params);
+void from_json(const nlohmann::json& j, SurfaceParams& params);
+
+void to_json(nlohmann::json& j, const UpdateSurfaceParamsMessage& message);
+void from_json(const nlohmann::json& j, UpdateSurfaceParamsMessage& message);
+
+void to_json(nlohmann::json& j, const CueTableMessage& message);
+void from_json(const nlohmann::json& j, CueTableMessage& message);
+
 void to_json(nlohmann::json& j, const RendererMessage& message);
 void from_json(const nlohmann::json& j, RendererMessage& message);
 
@@ -0,0 +1,47 @@
+#include "projection/core/TimeSync.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace projection::core {
+
+int64_t monotonicMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+ClockSample computeClockSample(int64_t t0, int64_t t1, int64_t t2, int64_t t3) {
+  ClockSample sample;
+  sample.offsetMicros = ((t1 - t0) + (t2 - t3)) / 2;
+  sample.roundTripMicros = std::max<int64_t>(0, (t3 - t0) - (t2 - t1));
+  return sample;
+}
+
+ClockOffsetEstimator::ClockOffsetEstimator(size_t window) {
+  if (window == 0) {
+    throw std::runtime_error("ClockOffsetEstimator window must be positive");
+  }
+  window_.resize(window);
+}
+
+void ClockOffsetEstimator::addSample(const ClockSample& sample) {
+  window_[next_] = sample;
+  next_ = (next_ + 1) % window_.size();
+  count_ = std::min(count_ + 1, window_.size());
+
+  best_ = window_[0];
+  for (size_t i = 1; i < count_; ++i) {
+    if (window_[i].roundTripMicros < best_.roundTripMicros) {
+      best_ = window_[i];
+    }
+  }
+}
+
+void ClockOffsetEstimator::reset() {
+  next_ = 0;
+  count_ = 0;
+  best_ = ClockSample{};
+}
+
+}  // namespace projection::core
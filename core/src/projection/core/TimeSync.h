@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace projection::core {
+
+// Clock used for protocol timestamps (RendererMessage::executeAt, TimeSync): monotonic
+// microseconds. Each process has its own epoch; renderers estimate the server's offset.
+int64_t monotonicMicros();
+
+// One NTP-style exchange. t0: client send, t1: server receive, t2: server send, t3: client
+// receive. offset is server clock minus client clock; roundTrip excludes server processing.
+struct ClockSample {
+  int64_t offsetMicros{0};
+  int64_t roundTripMicros{0};
+};
+
+ClockSample computeClockSample(int64_t t0, int64_t t1, int64_t t2, int64_t t3);
+
+// NTP-style clock filter: keeps the most recent samples and trusts the offset of the one with
+// the shortest round trip, since queuing delay is what makes the on-wire estimate asymmetric.
+// Not thread-safe.
+class ClockOffsetEstimator {
+ public:
+  explicit ClockOffsetEstimator(size_t window = 8);
+
+  void addSample(const ClockSample& sample);
+  void reset();
+
+  bool synchronized() const { return count_ > 0; }
+  size_t sampleCount() const { return count_; }
+  // Offset and round trip of the best sample in the window (0 before the first sample).
+  int64_t offsetMicros() const { return best_.offsetMicros; }
+  int64_t roundTripMicros() const { return best_.roundTripMicros; }
+
+  int64_t toLocal(int64_t serverMicros) const { return serverMicros - best_.offsetMicros; }
+  int64_t toServer(int64_t localMicros) const { return localMicros + best_.offsetMicros; }
+
+ private:
+  std::vector<ClockSample> window_;
+  size_t next_{0};
+  size_t count_{0};
+  ClockSample best_{};
+};
+
+}  // namespace projection::core
@@ -6,8 +6,13 @@
 using projection::core::Feed;
 using projection::core::FeedId;
 using projection::core::FeedType;
+using projection::core::GeneratedFeedConfig;
+using projection::core::GeneratorColor;
+using projection::core::GeneratorKind;
 using projection::core::VideoFileConfig;
+using projection::core::makeGeneratedFeed;
 using projection::core::makeVideoFileFeed;
+using projection::core::parseGeneratedFeedConfig;
 using projection::core::parseVideoFileConfig;
 
 TEST_CASE("makeVideoFileFeed round-trips file path", "[core][feed][config]") {
@@ -41,3 +46,64 @@ TEST_CASE("parseVideoFileConfig validates config JSON", "[core][feed][config][er
     }
     REQUIRE(threw);
 }
+
+TEST_CASE("makeGeneratedFeed round-trips generator config", "[core][feed][config]") {
+    GeneratedFeedConfig config;
+    config.generator = GeneratorKind::ScrollingText;
+    config.width = 1280;
+    config.height = 720;
+    config.colors = {GeneratorColor{255, 200, 0, 255}, GeneratorColor{0, 0, 0, 128}};
+    config.angleDegrees = 45.0f;
+    config.speed = 120.0f;
+    config.scale = 8.0f;
+    config.seed = 7;
+    config.text = "DOORS OPEN";
+
+    Feed feed = makeGeneratedFeed(FeedId{"13"}, "Ticker", config);
+    REQUIRE(feed.getType() == FeedType::Generated);
+    REQUIRE(parseGeneratedFeedConfig(feed) == config);
+}
+
+TEST_CASE("parseGeneratedFeedConfig applies defaults and parses colors", "[core][feed][config]") {
+    Feed feed(FeedId{"14"}, "Bars", FeedType::Generated,
+              "{\"generator\":\"gradient\",\"colors\":[\"#FF0080\",\"#00ff0040\"]}");
+    GeneratedFeedConfig config = parseGeneratedFeedConfig(feed);
+    REQUIRE(config.generator == GeneratorKind::Gradient);
+    REQUIRE(config.width == 1920);
+    REQUIRE(config.height == 1080);
+    REQUIRE(config.colors.size() == 2);
+    REQUIRE((config.colors[0] == GeneratorColor{255, 0, 128, 255}));
+    REQUIRE((config.colors[1] == GeneratorColor{0, 255, 0, 64}));
+    REQUIRE(config.speed == 0.0f);
+}
+
+TEST_CASE("parseGeneratedFeedConfig rejects invalid configs", "[core][feed][config][error]") {
+    const char* invalid[] = {
+        "{}",
+        "{\"generator\":\"plasma\"}",
+        "{\"generator\":\"noise\",\"width\":0}",
+        "{\"generator\":\"noise\",\"height\":9000}",
+        "{\"generator\":\"colorField\",\"colors\":[\"red\"]}",
+        "{\"generator\":\"colorField\",\"colors\":[\"#12345g\"]}",
+        "{\"generator\":\"noise\",\"scale\":-1}",
+    };
+    for (const char* json : invalid) {
+        Feed feed(FeedId{"15"}, "Generated", FeedType::Generated, json);
+        bool threw = false;
+        try {
+            parseGeneratedFeedConfig(feed);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        REQUIRE(threw);
+    }
+
+    Feed video = makeVideoFileFeed(FeedId{"16"}, "Video", "/videos/demo.mp4");
+    bool threw = false;
+    try {
+        parseGeneratedFeedConfig(video);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "projection/core/LineFramer.h"
+
+using namespace projection::core;
+
+namespace {
+std::vector<std::string> drain(LineFramer& framer) {
+  std::vector<std::string> lines;
+  std::string_view line;
+  while (framer.nextLine(line)) {
+    lines.emplace_back(line);
+  }
+  return lines;
+}
+}  // namespace
+
+TEST_CASE("LineFramer splits lines across arbitrary read boundaries", "[LineFramer]") {
+  const std::string stream = "{\"a\":1}\n\n{\"b\":2}\r\nlast";
+  // Feed one byte at a time through prepare/commit like a socket read would.
+  LineFramer framer(1024, 4);
+  std::vector<std::string> lines;
+  for (char c : stream) {
+    char* target = framer.prepare();
+    REQUIRE(framer.writableBytes() >= 4);
+    *target = c;
+    framer.commit(1);
+    for (auto& line : drain(framer)) {
+      lines.push_back(std::move(line));
+    }
+  }
+  REQUIRE((lines == std::vector<std::string>{"{\"a\":1}", "", "{\"b\":2}"}));
+  REQUIRE(framer.bufferedBytes() == 4);
+
+  framer.append("\n", 1);
+  REQUIRE((drain(framer) == std::vector<std::string>{"last"}));
+  REQUIRE(framer.bufferedBytes() == 0);
+}
+
+TEST_CASE("LineFramer returns views into its buffer without copying", "[LineFramer]") {
+  LineFramer framer(1024, 64);
+  char* target = framer.prepare();
+  std::memcpy(target, "one\ntwo\n", 8);
+  framer.commit(8);
+
+  std::string_view first;
+  std::string_view second;
+  REQUIRE(framer.nextLine(first));
+  REQUIRE(framer.nextLine(second));
+  REQUIRE(first.data() == target);
+  REQUIRE(second.data() == target + 4);
+  REQUIRE(second == "two");
+}
+
+TEST_CASE("LineFramer copies a large message a bounded number of times", "[LineFramer]") {
+  // 4 MB message arriving in 1 KB reads: growth copies stay linear in the message size.
+  const size_t messageBytes = 4 * 1024 * 1024;
+  std::string message(messageBytes, 'x');
+  message.push_back('\n');
+  LineFramer framer(8 * 1024 * 1024, 1024);
+  std::string_view line;
+  for (size_t offset = 0; offset < message.size(); offset += 1024) {
+    framer.append(message.data() + offset, std::min<size_t>(1024, message.size() - offset));
+    if (offset + 1024 < message.size()) {
+      REQUIRE(!framer.nextLine(line));
+    }
+  }
+  REQUIRE(framer.nextLine(line));
+  REQUIRE(line.size() == messageBytes);
+  REQUIRE(framer.copiedBytes() <= 2 * messageBytes);
+}
+
+TEST_CASE("LineFramer rejects lines longer than the maximum", "[LineFramer]") {
+  LineFramer framer(16, 8);
+  const std::string ok(16, 'a');
+  framer.append(ok.data(), ok.size());
+  framer.append("\n", 1);
+  std::string_view line;
+  REQUIRE(framer.nextLine(line));
+
+  const std::string tooLong(17, 'b');
+  framer.append(tooLong.data(), tooLong.size());
+  bool threw = false;
+  try {
+    framer.nextLine(line);
+  } catch (const std::runtime_error& ex) {
+    threw = true;
+    REQUIRE(std::string(ex.what()) == "Control message exceeds 16 bytes");
+  }
+  REQUIRE(threw);
+}
@@ -16,6 +16,22 @@ TEST_CASE("RendererProtocol round trip Hello", "[RendererProtocol]") {
   auto parsed = j.get<RendererMessage>();
 
   REQUIRE(parsed == message);
+  REQUIRE(!j["payload"].contains("group"));
+
+  message.hello->group = "zone-a";
+  message.hello->tags = {"left", "upper"};
+  j = message;
+  REQUIRE(j["payload"]["tags"].size() == 2);
+  REQUIRE(j.get<RendererMessage>() == message);
+
+  j["payload"]["tags"] = "left";
+  bool threw = false;
+  try {
+    (void)j.get<RendererMessage>();
+  } catch (const std::exception&) {
+    threw = true;
+  }
+  REQUIRE(threw);
 }
 
 TEST_CASE("RendererProtocol round trip Ack and Error", "[RendererProtocol]") {
@@ -105,3 +121,138 @@ TEST_CASE("RendererProtocol requires commandId", "[RendererProtocol]") {
   }
   REQUIRE(threw);
 }
+
+TEST_CASE("RendererProtocol round trip TimeSync and executeAt", "[RendererProtocol]") {
+  RendererMessage timeSyncMessage{};
+  timeSyncMessage.type = RendererMessageType::TimeSync;
+  timeSyncMessage.commandId = "sync-1";
+  timeSyncMessage.timeSync = TimeSyncMessage{1000, 5000000000LL, 5000000042LL};
+
+  json timeSyncJson = timeSyncMessage;
+  REQUIRE(timeSyncJson["payload"]["serverReceive"] == 5000000000LL);
+  REQUIRE(!timeSyncJson.contains("executeAt"));
+  REQUIRE(timeSyncJson.get<RendererMessage>() == timeSyncMessage);
+
+  RendererMessage scheduled{};
+  scheduled.type = RendererMessageType::PlayCue;
+  scheduled.commandId = "cmd-cue";
+  scheduled.executeAt = 123456789012LL;
+  scheduled.playCue = PlayCueMessage{CueId{"cue-1"}};
+
+  json scheduledJson = scheduled;
+  REQUIRE(scheduledJson["executeAt"] == 123456789012LL);
+  auto parsed = scheduledJson.get<RendererMessage>();
+  REQUIRE(parsed == scheduled);
+  REQUIRE(parsed.executeAt.has_value());
+
+  scheduledJson["executeAt"] = "soon";
+  bool threw = false;
+  try {
+    scheduledJson.get<RendererMessage>();
+  } catch (const std::runtime_error& ex) {
+    threw = true;
+    REQUIRE(std::string(ex.what()) == "Field 'executeAt' must be an integer");
+  }
+  REQUIRE(threw);
+}
+
+TEST_CASE("RendererProtocol round trip UpdateSurfaceParams with partial fields", "[RendererProtocol]") {
+  SurfaceParams opacityOnly;
+  opacityOnly.surfaceId = SurfaceId{"surface-1"};
+  opacityOnly.opacity = 0.25f;
+  SurfaceParams geometry;
+  geometry.surfaceId = SurfaceId{"surface-2"};
+  geometry.blendMode = BlendMode::Additive;
+  geometry.zOrder = -3;
+  geometry.vertices = std::vector<Vec2>{{0.0f, 0.0f}, {1.0f, 0.0f}, {0.5f, 1.0f}};
+  geometry.feedId = FeedId{"feed-2"};
+
+  RendererMessage message{};
+  message.type = RendererMessageType::UpdateSurfaceParams;
+  message.commandId = "cmd-params";
+  message.updateSurfaceParams = UpdateSurfaceParamsMessage{{opacityOnly, geometry}};
+
+  json j = message;
+  REQUIRE(j["type"] == "updateSurfaceParams");
+  // Absent fields are not sent.
+  REQUIRE(j["payload"]["updates"][0].size() == 2);
+  REQUIRE(j.get<RendererMessage>() == message);
+  REQUIRE(!opacityOnly.changesLayout());
+  REQUIRE(geometry.changesLayout());
+
+  json empty = json::parse(R"({"type":"updateSurfaceParams","commandId":"c","payload":{"updates":[{"surfaceId":"s"}]}})");
+  bool threw = false;
+  try {
+    (void)empty.get<RendererMessage>();
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  REQUIRE(threw);
+}
+
+TEST_CASE("RendererProtocol merges and applies surface params", "[RendererProtocol]") {
+  SurfaceParams first;
+  first.surfaceId = SurfaceId{"a"};
+  first.opacity = 0.1f;
+  first.zOrder = 4;
+  SurfaceParams later;
+  later.surfaceId = SurfaceId{"a"};
+  later.opacity = 0.7f;
+  SurfaceParams other;
+  other.surfaceId = SurfaceId{"b"};
+  other.brightness = 0.5f;
+
+  UpdateSurfaceParamsMessage merged{{first}};
+  mergeSurfaceParams(merged, UpdateSurfaceParamsMessage{{later, other}});
+  REQUIRE(merged.updates.size() == 2);
+  REQUIRE(*merged.updates[0].opacity == 0.7f);
+  REQUIRE(*merged.updates[0].zOrder == 4);
+  REQUIRE(*merged.updates[1].brightness == 0.5f);
+
+  std::vector<Vec2> tri{{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}};
+  Scene scene(SceneId{"scene"}, "Scene", "", {Surface(SurfaceId{"a"}, "A", tri, FeedId{"f"})});
+  std::string error;
+  REQUIRE(applySurfaceParams(scene, merged.updates[0], error));
+  REQUIRE(scene.getSurfaces()[0].getOpacity() == 0.7f);
+  REQUIRE(scene.getSurfaces()[0].getZOrder() == 4);
+
+  REQUIRE(!applySurfaceParams(scene, merged.updates[1], error));
+  REQUIRE(error == "Surface not found: b");
+
+  SurfaceParams degenerate;
+  degenerate.surfaceId = SurfaceId{"a"};
+  degenerate.opacity = 0.0f;
+  degenerate.vertices = std::vector<Vec2>{{0.0f, 0.0f}};
+  REQUIRE(!applySurfaceParams(scene, degenerate, error));
+  REQUIRE(scene.getSurfaces()[0].getOpacity() == 0.7f);
+}
+
+TEST_CASE("RendererProtocol round trip LoadCueTable", "[RendererProtocol]") {
+  std::vector<Vec2> tri{{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}};
+  Scene scene(SceneId{"scene-2"}, "Second", "", {Surface(SurfaceId{"s"}, "S", tri, FeedId{"feed-1"})});
+  Feed feed(FeedId{"feed-1"}, "Clip", FeedType::VideoFile, R"({"filePath":"clip.mp4"})");
+  Cue cue(CueId{"cue-1"}, "Dim", SceneId{"scene-2"});
+  cue.getSurfaceOpacities()[SurfaceId{"s"}] = 0.3f;
+  cue.getSurfaceBrightnesses()[SurfaceId{"s"}] = 0.6f;
+
+  RendererMessage message{};
+  message.type = RendererMessageType::LoadCueTable;
+  message.commandId = "cmd-cues";
+  message.cueTable = CueTableMessage{};
+  message.cueTable->cues = {cue};
+  message.cueTable->scenes = {LoadSceneDefinitionMessage{scene, {feed}}};
+
+  json j = message;
+  REQUIRE(j["type"] == "loadCueTable");
+  REQUIRE(!j["payload"].contains("settings"));
+  REQUIRE(j.get<RendererMessage>() == message);
+
+  // A project's table carries its MIDI settings.
+  ProjectSettings settings;
+  settings.midiChannels = {2, 10};
+  settings.controllers["cc7"] = "brightness";
+  message.cueTable->settings = settings;
+  j = message;
+  REQUIRE(j["payload"]["settings"]["midiChannels"].size() == 2);
+  REQUIRE(j.get<RendererMessage>() == message);
+}
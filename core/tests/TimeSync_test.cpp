@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+#include "projection/core/TimeSync.h"
+
+using namespace projection::core;
+
+TEST_CASE("computeClockSample recovers offset for symmetric paths", "[TimeSync]") {
+  // Server clock is 5 s ahead; 2 ms each way and 100 us of server processing.
+  const int64_t offset = 5000000;
+  const int64_t t0 = 1000;
+  const int64_t t1 = t0 + 2000 + offset;
+  const int64_t t2 = t1 + 100;
+  const int64_t t3 = t2 - offset + 2000;
+
+  const auto sample = computeClockSample(t0, t1, t2, t3);
+  REQUIRE(sample.offsetMicros == offset);
+  REQUIRE(sample.roundTripMicros == 4000);
+}
+
+TEST_CASE("ClockOffsetEstimator trusts the shortest round trip in its window", "[TimeSync]") {
+  ClockOffsetEstimator estimator(4);
+  REQUIRE(!estimator.synchronized());
+  REQUIRE(estimator.toLocal(42) == 42);
+
+  // Queuing delay on one leg skews the offset by half the extra delay; the clean sample wins.
+  const int64_t offset = -250000;
+  auto exchange = [&](int64_t t0, int64_t upMicros, int64_t downMicros) {
+    const int64_t t1 = t0 + upMicros + offset;
+    const int64_t t2 = t1 + 50;
+    const int64_t t3 = t2 - offset + downMicros;
+    estimator.addSample(computeClockSample(t0, t1, t2, t3));
+  };
+  exchange(0, 9000, 1000);
+  REQUIRE(estimator.offsetMicros() == offset + 4000);
+  exchange(100000, 1000, 1000);
+  exchange(200000, 1000, 15000);
+  REQUIRE(estimator.synchronized());
+  REQUIRE(estimator.sampleCount() == 3);
+  REQUIRE(estimator.offsetMicros() == offset);
+  REQUIRE(estimator.roundTripMicros() == 2000);
+  REQUIRE(estimator.toLocal(estimator.toServer(777)) == 777);
+
+  // Once the clean sample ages out of the window the best remaining one is used.
+  exchange(300000, 3000, 3000);
+  exchange(400000, 5000, 3000);
+  exchange(500000, 4000, 4000);
+  REQUIRE(estimator.sampleCount() == 4);
+  REQUIRE(estimator.roundTripMicros() == 6000);
+  REQUIRE(estimator.offsetMicros() == offset);
+
+  estimator.reset();
+  REQUIRE(!estimator.synchronized());
+  REQUIRE(estimator.offsetMicros() == 0);
+}
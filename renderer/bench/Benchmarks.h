@@ -0,0 +1,11 @@
+#pragma once
+
+#include <projection/bench/BenchHarness.h>
+
+namespace projection::renderer::bench {
+
+void runCompositorBenchmarks(projection::bench::BenchRunner& runner);
+void runEdgeBlendBenchmarks(projection::bench::BenchRunner& runner);
+void runGeneratorBenchmarks(projection::bench::BenchRunner& runner);
+
+}  // namespace projection::renderer::bench
@@ -0,0 +1,123 @@
+#include "Benchmarks.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <projection/core/Enums.h>
+
+#include "compositor/BlendKernels.h"
+#include "compositor/RgbaImage.h"
+#include "compositor/SoftwareCompositor.h"
+#include "util/WorkerPool.h"
+
+namespace projection::renderer::bench {
+
+using projection::bench::doNotOptimize;
+using projection::core::BlendMode;
+using projection::core::Vec2;
+
+namespace {
+constexpr double kMega = 1e-6;
+
+struct Resolution {
+  const char* name;
+  int width;
+  int height;
+};
+
+RgbaImage makeTexture(int width, int height) {
+  RgbaImage texture(width, height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      uint8_t* px = texture.pixel(x, y);
+      px[0] = static_cast<uint8_t>(x * 7);
+      px[1] = static_cast<uint8_t>(y * 5);
+      px[2] = static_cast<uint8_t>((x ^ y) * 3);
+      px[3] = static_cast<uint8_t>(128 + (x & 127));
+    }
+  }
+  return texture;
+}
+
+// `count` full-frame quads, slightly inset from each other, cycling through blend modes.
+std::vector<CompositorLayer> makeLayers(const RgbaImage& texture, int width, int height, int count) {
+  std::vector<CompositorLayer> layers;
+  const BlendMode modes[3] = {BlendMode::Normal, BlendMode::Additive, BlendMode::Multiply};
+  for (int i = 0; i < count; ++i) {
+    const float inset = static_cast<float>(i) * 4.0f;
+    const float w = static_cast<float>(width);
+    const float h = static_cast<float>(height);
+    CompositorLayer layer;
+    layer.positions = {Vec2{inset, inset}, Vec2{w - inset, inset}, Vec2{w - inset, h - inset}, Vec2{inset, h - inset}};
+    layer.texCoords = {Vec2{0, 0}, Vec2{1, 0}, Vec2{1, 1}, Vec2{0, 1}};
+    layer.texture = texture.view();
+    layer.alpha = 0.8f;
+    layer.brightness = 0.9f;
+    layer.blendMode = modes[i % 3];
+    layer.zOrder = i;
+    layers.push_back(layer);
+  }
+  return layers;
+}
+}  // namespace
+
+void runCompositorBenchmarks(projection::bench::BenchRunner& runner) {
+  // Blend kernels alone: one long span, as the rasterizer feeds them.
+  constexpr size_t kSpanPixels = 1 << 20;
+  std::vector<uint8_t> source(kSpanPixels * 4);
+  std::vector<uint8_t> destination(kSpanPixels * 4);
+  for (size_t i = 0; i < source.size(); ++i) {
+    source[i] = static_cast<uint8_t>(i * 31);
+    destination[i] = static_cast<uint8_t>(i * 17);
+  }
+  const struct {
+    const char* name;
+    BlendMode mode;
+  } modes[] = {{"normal", BlendMode::Normal}, {"additive", BlendMode::Additive}, {"multiply", BlendMode::Multiply}};
+  for (const auto& mode : modes) {
+    for (bool simd : {true, false}) {
+      const std::string name = std::string("blendSpan/") + mode.name + "/" + (simd ? blendSimdBackend() : "scalar");
+      runner.run(
+          name,
+          [&]() {
+            blendSpan(mode.mode, destination.data(), source.data(), kSpanPixels, 230, 200, simd);
+            doNotOptimize(destination[0]);
+          },
+          static_cast<double>(kSpanPixels), kMega, "MP/s");
+    }
+  }
+
+  // Whole-scene compositing: 4 overlapping textured quads, reported as layer pixels per second.
+  const RgbaImage texture = makeTexture(256, 256);
+  const Resolution resolutions[] = {{"360p", 640, 360}, {"1080p", 1920, 1080}, {"4k", 3840, 2160}};
+  constexpr int kLayers = 4;
+  WorkerPool pool;
+  for (const auto& resolution : resolutions) {
+    const auto layers = makeLayers(texture, resolution.width, resolution.height, kLayers);
+    RgbaImage target(resolution.width, resolution.height);
+    const double layerPixels = static_cast<double>(resolution.width) * resolution.height * kLayers;
+
+    struct Variant {
+      const char* name;
+      WorkerPool* pool;
+      bool simd;
+    };
+    const std::string threaded = "threads" + std::to_string(pool.threadCount());
+    const Variant variants[] = {{"scalar", nullptr, false}, {"simd", nullptr, true}, {threaded.c_str(), &pool, true}};
+    for (const auto& variant : variants) {
+      CompositorOptions options;
+      options.useSimd = variant.simd;
+      SoftwareCompositor compositor(variant.pool, options);
+      runner.run(
+          std::string("composite/") + resolution.name + "/" + std::to_string(kLayers) + "layers/" + variant.name,
+          [&]() {
+            compositor.composite(layers, target);
+            doNotOptimize(target.pixels()[0]);
+          },
+          layerPixels, kMega, "MP/s");
+    }
+  }
+}
+
+}  // namespace projection::renderer::bench
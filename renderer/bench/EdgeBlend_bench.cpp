@@ -0,0 +1,65 @@
+#include "Benchmarks.h"
+
+#include <string>
+
+#include "compositor/EdgeBlend.h"
+#include "compositor/RgbaImage.h"
+
+namespace projection::renderer::bench {
+
+using projection::bench::doNotOptimize;
+
+namespace {
+constexpr double kMega = 1e-6;
+constexpr int kWidth = 3840;
+constexpr int kHeight = 2160;
+
+// A middle projector of a three-wide wall: blended left and right, black level compensated.
+EdgeBlendSettings makeSettings() {
+  EdgeBlendSettings settings;
+  settings.left = EdgeBlendEdge{512, 2.2f, 2.0f};
+  settings.right = EdgeBlendEdge{512, 2.2f, 2.0f};
+  settings.top = EdgeBlendEdge{64, 2.2f, 2.0f};
+  settings.blackLevel = 0.02f;
+  return settings;
+}
+}  // namespace
+
+void runEdgeBlendBenchmarks(projection::bench::BenchRunner& runner) {
+  const double pixels = static_cast<double>(kWidth) * kHeight;
+  const EdgeBlendSettings first = makeSettings();
+  EdgeBlendSettings second = first;
+  second.left.gamma = 2.4f;
+
+  for (bool simd : {true, false}) {
+    const std::string backend = simd ? edgeBlendSimdBackend() : "scalar";
+    // Alternating between two settings forces a full regeneration every iteration.
+    EdgeBlendMask mask;
+    bool flip = false;
+    runner.run(
+        "edgeBlend/regenerate/4k/" + backend,
+        [&]() {
+          flip = !flip;
+          mask.configure(kWidth, kHeight, flip ? first : second, simd);
+          doNotOptimize(mask.gain()[0]);
+        },
+        pixels, kMega, "MP/s");
+
+    // Unchanged settings hit the cache.
+    runner.run(
+        "edgeBlend/configure-cached/4k/" + backend,
+        [&]() { doNotOptimize(mask.configure(kWidth, kHeight, mask.settings(), simd)); }, 1.0, kMega, "M/s");
+
+    RgbaImage frame(kWidth, kHeight);
+    frame.fill(200, 150, 100, 255);
+    runner.run(
+        "edgeBlend/apply/4k/" + backend,
+        [&]() {
+          mask.apply(frame.mutableView(), simd);
+          doNotOptimize(frame.pixels()[0]);
+        },
+        pixels, kMega, "MP/s");
+  }
+}
+
+}  // namespace projection::renderer::bench
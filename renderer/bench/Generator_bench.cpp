@@ -0,0 +1,99 @@
+#include "Benchmarks.h"
+
+#include <memory>
+#include <string>
+
+#include <projection/core/Feed.h>
+
+#include "compositor/BlendKernels.h"
+#include "compositor/RgbaImage.h"
+#include "generators/Generators.h"
+#include "util/WorkerPool.h"
+
+namespace projection::renderer::bench {
+
+using projection::bench::doNotOptimize;
+using projection::core::GeneratedFeedConfig;
+using projection::core::GeneratorColor;
+using projection::core::GeneratorKind;
+
+namespace {
+constexpr double kMega = 1e-6;
+constexpr size_t kRowsPerChunk = 32;
+
+GeneratedFeedConfig makeConfig(GeneratorKind kind) {
+  GeneratedFeedConfig config;
+  config.generator = kind;
+  config.width = 1920;
+  config.height = 1080;
+  config.speed = 1.0f;
+  switch (kind) {
+    case GeneratorKind::ColorField:
+      config.colors = {GeneratorColor{255, 0, 0, 255}, GeneratorColor{0, 0, 255, 255}};
+      break;
+    case GeneratorKind::Gradient:
+      // Diagonal is the general (table lookup per pixel) path.
+      config.colors = {GeneratorColor{255, 0, 128, 255}, GeneratorColor{0, 200, 255, 255},
+                       GeneratorColor{255, 255, 0, 255}};
+      config.angleDegrees = 30.0f;
+      break;
+    case GeneratorKind::Noise:
+      config.scale = 48.0f;
+      config.speed = 120.0f;
+      config.angleDegrees = 45.0f;
+      break;
+    case GeneratorKind::TestPattern:
+      break;
+    case GeneratorKind::ScrollingText:
+      config.text = "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789";
+      config.scale = 12.0f;
+      config.speed = 240.0f;
+      break;
+  }
+  return config;
+}
+}  // namespace
+
+void runGeneratorBenchmarks(projection::bench::BenchRunner& runner) {
+  // One full 1080p frame per iteration, rendered unconditionally (the content-change skip in
+  // GeneratedVideoSource would otherwise hide the cost of static generators).
+  const GeneratorKind kinds[] = {GeneratorKind::ColorField, GeneratorKind::Gradient, GeneratorKind::Noise,
+                                 GeneratorKind::TestPattern, GeneratorKind::ScrollingText};
+  WorkerPool pool;
+  const std::string threaded = "threads" + std::to_string(pool.threadCount());
+  for (const auto kind : kinds) {
+    const auto config = makeConfig(kind);
+    auto generator = makeGenerator(config);
+    RgbaImage image(config.width, config.height);
+    const MutableImageView frame = image.mutableView();
+    const double pixels = static_cast<double>(config.width) * config.height;
+
+    struct Variant {
+      std::string name;
+      WorkerPool* pool;
+      bool simd;
+    };
+    const Variant variants[] = {{"scalar", nullptr, false}, {blendSimdBackend(), nullptr, true}, {threaded, &pool, true}};
+    for (const auto& variant : variants) {
+      double seconds = 0.0;
+      runner.run(
+          "generate/" + projection::core::toString(kind) + "/1080p/" + variant.name,
+          [&]() {
+            seconds += 1.0 / 60.0;
+            generator->prepare(seconds);
+            auto renderBand = [&](size_t begin, size_t end) {
+              generator->renderRows(frame, static_cast<int>(begin), static_cast<int>(end), variant.simd);
+            };
+            if (variant.pool != nullptr) {
+              variant.pool->parallelFor(static_cast<size_t>(frame.height), renderBand, kRowsPerChunk);
+            } else {
+              renderBand(0, static_cast<size_t>(frame.height));
+            }
+            doNotOptimize(frame.data[0]);
+          },
+          pixels, kMega, "MP/s");
+    }
+  }
+}
+
+}  // namespace projection::renderer::bench
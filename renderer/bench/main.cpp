@@ -0,0 +1,11 @@
+#include "Benchmarks.h"
+
+#include <cstdio>
+
+int main(int argc, char* argv[]) {
+  projection::bench::BenchRunner runner(projection::bench::parseBenchArgs(argc, argv));
+  projection::renderer::bench::runCompositorBenchmarks(runner);
+  projection::renderer::bench::runEdgeBlendBenchmarks(runner);
+  projection::renderer::bench::runGeneratorBenchmarks(runner);
+  return 0;
+}
@@ -0,0 +1,126 @@
+#include "DrawListCompiler.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace projection::renderer {
+
+using projection::core::Scene;
+using projection::core::Surface;
+
+namespace {
+struct Bounds {
+  float minX{std::numeric_limits<float>::max()};
+  float minY{std::numeric_limits<float>::max()};
+  float maxX{std::numeric_limits<float>::lowest()};
+  float maxY{std::numeric_limits<float>::lowest()};
+};
+
+Bounds boundsOf(const Surface& surface) {
+  Bounds b;
+  for (const auto& v : surface.getVertices()) {
+    b.minX = std::min(b.minX, v.x);
+    b.minY = std::min(b.minY, v.y);
+    b.maxX = std::max(b.maxX, v.x);
+    b.maxY = std::max(b.maxY, v.y);
+  }
+  return b;
+}
+
+// Shared edges do not count: pixel-centre coverage never assigns an edge pixel to both.
+bool overlaps(const Bounds& a, const Bounds& b) {
+  return a.minX < b.maxX && b.minX < a.maxX && a.minY < b.maxY && b.minY < a.maxY;
+}
+
+bool sameBatchKey(const Surface& a, const Surface& b) {
+  return a.getBlendMode() == b.getBlendMode() && a.getFeedId() == b.getFeedId();
+}
+}  // namespace
+
+std::vector<size_t> compileDrawOrder(const Scene& scene) {
+  const auto& surfaces = scene.getSurfaces();
+  std::vector<size_t> byZ(surfaces.size());
+  for (size_t i = 0; i < byZ.size(); ++i) {
+    byZ[i] = i;
+  }
+  std::stable_sort(byZ.begin(), byZ.end(),
+                   [&](size_t a, size_t b) { return surfaces[a].getZOrder() < surfaces[b].getZOrder(); });
+
+  std::vector<size_t> order;
+  order.reserve(surfaces.size());
+  std::vector<Bounds> bounds;
+  std::vector<size_t> blockers;
+  std::vector<bool> emitted;
+
+  for (size_t groupBegin = 0; groupBegin < byZ.size();) {
+    size_t groupEnd = groupBegin + 1;
+    while (groupEnd < byZ.size() && surfaces[byZ[groupEnd]].getZOrder() == surfaces[byZ[groupBegin]].getZOrder()) {
+      ++groupEnd;
+    }
+    const size_t count = groupEnd - groupBegin;
+
+    // blockers[i]: earlier surfaces in this zOrder group that overlap i and are not emitted yet.
+    bounds.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      bounds[i] = boundsOf(surfaces[byZ[groupBegin + i]]);
+    }
+    blockers.assign(count, 0);
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t j = 0; j < i; ++j) {
+        if (overlaps(bounds[i], bounds[j])) {
+          ++blockers[i];
+        }
+      }
+    }
+    emitted.assign(count, false);
+
+    for (size_t step = 0; step < count; ++step) {
+      // The earliest unemitted surface is always ready; prefer a ready one that extends the
+      // current batch.
+      size_t pick = count;
+      size_t firstReady = count;
+      for (size_t i = 0; i < count; ++i) {
+        if (emitted[i] || blockers[i] != 0) {
+          continue;
+        }
+        if (firstReady == count) {
+          firstReady = i;
+        }
+        if (!order.empty() && sameBatchKey(surfaces[order.back()], surfaces[byZ[groupBegin + i]])) {
+          pick = i;
+          break;
+        }
+      }
+      if (pick == count) {
+        pick = firstReady;
+      }
+
+      emitted[pick] = true;
+      order.push_back(byZ[groupBegin + pick]);
+      for (size_t i = pick + 1; i < count; ++i) {
+        if (!emitted[i] && overlaps(bounds[i], bounds[pick])) {
+          --blockers[i];
+        }
+      }
+    }
+    groupBegin = groupEnd;
+  }
+  return order;
+}
+
+void buildDrawBatches(DrawList& list) {
+  list.batches.clear();
+  for (size_t i = 0; i < list.surfaces.size(); ++i) {
+    const auto& surface = list.surfaces[i];
+    if (!list.batches.empty()) {
+      auto& last = list.batches.back();
+      if (last.feedId == surface.feedId && last.blendMode == surface.blendMode) {
+        ++last.surfaceCount;
+        continue;
+      }
+    }
+    list.batches.push_back(DrawBatch{surface.feedId, surface.blendMode, i, 1});
+  }
+}
+
+}  // namespace projection::renderer
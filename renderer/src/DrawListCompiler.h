@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <projection/core/Enums.h>
+#include <projection/core/Scene.h>
+#include <projection/core/Surface.h>
+
+namespace projection::renderer {
+
+// One surface ready for the graphics backend. Positions are in output pixels, texture
+// coordinates are normalized to the feed frame (0..1), color is grey level plus alpha.
+struct SurfaceDraw {
+  std::string surfaceId;
+  std::string feedId;
+  std::vector<projection::core::Vec2> positions;
+  std::vector<projection::core::Vec2> texCoords;
+  float brightness{1.0f};
+  float alpha{1.0f};
+  projection::core::BlendMode blendMode{projection::core::BlendMode::Normal};
+  int zOrder{0};
+};
+
+// Run of consecutive surfaces in a DrawList that share feed and blend mode, so the backend
+// can draw them as one mesh with a single texture bind and blend state.
+struct DrawBatch {
+  std::string feedId;
+  projection::core::BlendMode blendMode{projection::core::BlendMode::Normal};
+  size_t firstSurface{0};
+  size_t surfaceCount{0};
+};
+
+struct DrawList {
+  std::vector<SurfaceDraw> surfaces;  // in draw order
+  std::vector<DrawBatch> batches;
+  // Drawable surfaces left out because they lie entirely outside the output.
+  size_t culledSurfaces{0};
+};
+
+// Draw order for a scene (indices into scene.getSurfaces()). Surfaces are sorted by ascending
+// zOrder. Within one zOrder, a surface is pulled forward next to earlier surfaces with the
+// same blend mode and feed, but never past a surface whose bounds it overlaps, so the
+// composited result matches a plain stable sort by zOrder. Compute it once per scene change.
+std::vector<size_t> compileDrawOrder(const projection::core::Scene& scene);
+
+// Rebuilds list.batches by merging consecutive surfaces with the same feed and blend mode.
+void buildDrawBatches(DrawList& list);
+
+}  // namespace projection::renderer
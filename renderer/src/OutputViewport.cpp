@@ -0,0 +1,119 @@
+#include "OutputViewport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+namespace projection::renderer {
+
+using projection::core::Vec2;
+
+namespace {
+constexpr float kPi = 3.14159265358979f;
+}  // namespace
+
+ViewportTransform::ViewportTransform(const OutputViewport& viewport) : rect_(viewport.sceneRect) {
+  const float radians = viewport.rotationDegrees * kPi / 180.0f;
+  cos_ = std::cos(radians);
+  sin_ = std::sin(radians);
+  // A quarter-turned output shows the scene rectangle along its other axis.
+  const bool sideways = std::fabs(sin_) > std::fabs(cos_);
+  const auto width = static_cast<float>(viewport.width);
+  const auto height = static_cast<float>(viewport.height);
+  const float contentW = sideways ? height : width;
+  const float contentH = sideways ? width : height;
+  scaleX_ = contentW / (rect_.right - rect_.left);
+  scaleY_ = contentH / (rect_.bottom - rect_.top);
+  halfContentW_ = contentW * 0.5f;
+  halfContentH_ = contentH * 0.5f;
+  centerX_ = width * 0.5f;
+  centerY_ = height * 0.5f;
+
+  const Vec2 corners[] = {toScene(Vec2{0.0f, 0.0f}), toScene(Vec2{width, 0.0f}), toScene(Vec2{width, height}),
+                          toScene(Vec2{0.0f, height})};
+  visible_ = SceneRect{corners[0].x, corners[0].y, corners[0].x, corners[0].y};
+  for (const auto& corner : corners) {
+    visible_.left = std::min(visible_.left, corner.x);
+    visible_.top = std::min(visible_.top, corner.y);
+    visible_.right = std::max(visible_.right, corner.x);
+    visible_.bottom = std::max(visible_.bottom, corner.y);
+  }
+}
+
+Vec2 ViewportTransform::toScene(Vec2 pixel) const {
+  const float dx = pixel.x - centerX_;
+  const float dy = pixel.y - centerY_;
+  const float cx = dx * cos_ + dy * sin_;
+  const float cy = -dx * sin_ + dy * cos_;
+  return Vec2{(cx + halfContentW_) / scaleX_ + rect_.left, (cy + halfContentH_) / scaleY_ + rect_.top};
+}
+
+OutputViewport fullSceneViewport(float width, float height) {
+  OutputViewport viewport;
+  viewport.name = "main";
+  viewport.width = static_cast<int>(width);
+  viewport.height = static_cast<int>(height);
+  return viewport;
+}
+
+std::vector<OutputViewport> partitionSceneHorizontally(size_t count, int width, int height, float overlap) {
+  std::vector<OutputViewport> outputs;
+  if (count == 0) {
+    return outputs;
+  }
+  const float span = (2.0f + static_cast<float>(count - 1) * overlap) / static_cast<float>(count);
+  for (size_t i = 0; i < count; ++i) {
+    OutputViewport viewport;
+    viewport.name = "output-" + std::to_string(i + 1);
+    viewport.sceneRect.left = -1.0f + static_cast<float>(i) * (span - overlap);
+    viewport.sceneRect.right = i + 1 == count ? 1.0f : viewport.sceneRect.left + span;
+    viewport.width = width;
+    viewport.height = height;
+    viewport.x = static_cast<int>(i) * width;
+    const auto overlapPixels = static_cast<int>(std::lround(overlap / span * static_cast<float>(width)));
+    if (i > 0) {
+      viewport.blend.left.width = overlapPixels;
+    }
+    if (i + 1 < count) {
+      viewport.blend.right.width = overlapPixels;
+    }
+    outputs.push_back(std::move(viewport));
+  }
+  return outputs;
+}
+
+bool parseOutputViewport(const std::string& spec, OutputViewport& viewport, std::string& error) {
+  OutputViewport parsed;
+  int consumed = 0;
+  const int fields = std::sscanf(spec.c_str(), "%dx%d+%d+%d:%f,%f,%f,%f%n", &parsed.width, &parsed.height,
+                                 &parsed.x, &parsed.y, &parsed.sceneRect.left, &parsed.sceneRect.top,
+                                 &parsed.sceneRect.right, &parsed.sceneRect.bottom, &consumed);
+  if (fields != 8) {
+    error = "Output must look like WxH+X+Y:left,top,right,bottom[:rotation]: " + spec;
+    return false;
+  }
+  const std::string rest = spec.substr(static_cast<size_t>(consumed));
+  if (!rest.empty()) {
+    int rotationConsumed = 0;
+    if (std::sscanf(rest.c_str(), ":%f%n", &parsed.rotationDegrees, &rotationConsumed) != 1 ||
+        static_cast<size_t>(rotationConsumed) != rest.size()) {
+      error = "Invalid output rotation: " + spec;
+      return false;
+    }
+  }
+  if (parsed.width <= 0 || parsed.height <= 0) {
+    error = "Output size must be positive: " + spec;
+    return false;
+  }
+  if (!(parsed.sceneRect.right > parsed.sceneRect.left) || !(parsed.sceneRect.bottom > parsed.sceneRect.top)) {
+    error = "Output scene rectangle must have positive width and height: " + spec;
+    return false;
+  }
+  parsed.name = viewport.name;
+  viewport = parsed;
+  return true;
+}
+
+}  // namespace projection::renderer
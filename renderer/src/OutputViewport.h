@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <projection/core/Surface.h>
+
+#include "compositor/EdgeBlend.h"
+
+namespace projection::renderer {
+
+// Axis-aligned rectangle in normalized scene coordinates (-1..1 on both axes, y down: -1 is
+// the top edge, as in the single-output mapping).
+struct SceneRect {
+  float left{-1.0f};
+  float top{-1.0f};
+  float right{1.0f};
+  float bottom{1.0f};
+
+  bool intersects(const SceneRect& other) const {
+    return left < other.right && other.left < right && top < other.bottom && other.top < bottom;
+  }
+};
+
+// One physical output of a renderer: the part of the scene it shows, its pixel size, where it
+// sits in the (spanning) window, and how the picture is rotated on it.
+struct OutputViewport {
+  std::string name;
+  SceneRect sceneRect{};
+  int width{1920};
+  int height{1080};
+  // Top-left corner of the output inside the window the windowed renderer draws into.
+  int x{0};
+  int y{0};
+  // Clockwise rotation of the picture on the output in degrees, e.g. 90 for a projector
+  // mounted on its side. Near 90/270 the scene rectangle's width runs along the output's
+  // height.
+  float rotationDegrees{0.0f};
+  // Edge-blend mask applied to the finished output (widths in this output's pixels).
+  EdgeBlendSettings blend{};
+};
+
+// Maps scene coordinates to one output's pixels: sceneRect is stretched over the output
+// (over its rotated extent when turned), then rotated about the output centre.
+class ViewportTransform {
+ public:
+  explicit ViewportTransform(const OutputViewport& viewport);
+
+  projection::core::Vec2 toPixels(projection::core::Vec2 scene) const {
+    const float cx = (scene.x - rect_.left) * scaleX_ - halfContentW_;
+    const float cy = (scene.y - rect_.top) * scaleY_ - halfContentH_;
+    return projection::core::Vec2{centerX_ + cx * cos_ - cy * sin_, centerY_ + cx * sin_ + cy * cos_};
+  }
+  projection::core::Vec2 toScene(projection::core::Vec2 pixel) const;
+
+  // Scene-space bounds of everything that can land on the output; a surface whose bounds
+  // miss it is culled.
+  const SceneRect& visibleSceneBounds() const { return visible_; }
+
+ private:
+  SceneRect rect_;
+  float scaleX_;
+  float scaleY_;
+  float halfContentW_;
+  float halfContentH_;
+  float centerX_;
+  float centerY_;
+  float cos_;
+  float sin_;
+  SceneRect visible_{};
+};
+
+// The whole scene on one unrotated output of the given size (the single-window mapping).
+OutputViewport fullSceneViewport(float width, float height);
+
+// Splits the scene into `count` side-by-side outputs of width x height pixels, placed left to
+// right in the window. Neighbours share `overlap` scene units, so each output shows
+// (2 + (count - 1) * overlap) / count scene units horizontally; the shared strip becomes the
+// blend width of the facing edges.
+std::vector<OutputViewport> partitionSceneHorizontally(size_t count, int width, int height, float overlap = 0.0f);
+
+// Parses "WxH+X+Y:left,top,right,bottom[:rotation]" (e.g. "1920x1080+1920+0:0,-1,1,1:90").
+// Returns false with a message for malformed specs, empty sizes or empty scene rectangles.
+bool parseOutputViewport(const std::string& spec, OutputViewport& viewport, std::string& error);
+
+}  // namespace projection::renderer
@@ -2,10 +2,19 @@
 
 #include <projection/core/Feed.h>
 
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "generators/GeneratedVideoSource.h"
+#include "video/StubVideoSource.h"
+
 using projection::core::Feed;
 using projection::core::FeedType;
+using projection::core::GeneratedFeedConfig;
 using projection::core::Scene;
 using projection::core::VideoFileConfig;
+using projection::core::parseGeneratedFeedConfig;
 using projection::core::parseVideoFileConfig;
 
 namespace projection::renderer {
@@ -23,13 +32,46 @@ std::unordered_map<std::string, std::string> mapVideoFeedFilePaths(const Scene&
   return mapping;
 }
 
+RenderState::RenderState() : RenderState(makeStubVideoSourceFactory()) {}
+
+RenderState::RenderState(VideoSourceFactory videoSourceFactory)
+    : videoResidency_(std::move(videoSourceFactory)) {}
+
 void RenderState::loadSceneDefinition(const Scene& scene, const std::vector<Feed>& feeds) {
+  // Every config is parsed before anything is replaced, so a bad one leaves the scene playing.
+  auto mapping = mapVideoFeedFilePaths(scene, feeds);
+  std::unordered_map<std::string, GeneratedFeedConfig> generatedConfigs;
+  for (const auto& feed : feeds) {
+    if (feed.getType() == FeedType::Generated) {
+      generatedConfigs.insert_or_assign(feed.getId().value, parseGeneratedFeedConfig(feed));
+    }
+  }
+
   currentScene_ = scene;
   currentFeeds_ = feeds;
+  for (auto& entry : videoFeeds_) {
+    if (!entry.second.filePath.empty()) {
+      videoResidency_.release(entry.second.filePath, std::move(entry.second.source));
+    }
+  }
   videoFeeds_.clear();
+  ++sceneGeneration_;
+  ++layoutGeneration_;
 
-  auto mapping = mapVideoFeedFilePaths(scene, feeds);
   for (const auto& feed : feeds) {
+    if (feed.getType() == FeedType::Generated) {
+      const GeneratedFeedConfig& config = generatedConfigs.at(feed.getId().value);
+      if (!generatorPool_) {
+        generatorPool_ = std::make_unique<WorkerPool>();
+      }
+      VideoFeedResource resource{feed.getId(),
+                                 std::make_unique<GeneratedVideoSource>(config, generatorPool_.get(), &framePool_),
+                                 std::string{}, masterClock_.seconds()};
+      resource.source->load(std::string{});
+      resource.source->play();
+      videoFeeds_.emplace(feed.getId().value, std::move(resource));
+      continue;
+    }
     if (feed.getType() != FeedType::VideoFile) {
       continue;
     }
@@ -38,21 +80,112 @@ void RenderState::loadSceneDefinition(const Scene& scene, const std::vector<Feed
       continue;
     }
 
-    VideoFeedResource resource{feed.getId(), {}};
-    const bool loaded = resource.player.load(it->second);
-    if (loaded) {
-      resource.player.setLoopState(OF_LOOP_NORMAL);
-      resource.player.play();
+    VideoFeedResource resource{feed.getId(), videoResidency_.acquire(it->second), it->second,
+                               masterClock_.seconds()};
+    videoFeeds_.emplace(feed.getId().value, std::move(resource));
+  }
+}
+
+void RenderState::applySurfaceParams(const projection::core::UpdateSurfaceParamsMessage& message) {
+  std::string errors;
+  bool layoutChanged = false;
+  for (const auto& params : message.updates) {
+    std::string error;
+    // Only feeds sent with the scene definition have players; switching to any other feed
+    // needs a scene reload.
+    const bool feedLoaded =
+        !params.feedId || params.feedId->value.empty() ||
+        std::any_of(currentFeeds_.begin(), currentFeeds_.end(),
+                    [&](const Feed& feed) { return feed.getId() == *params.feedId; });
+    if (!feedLoaded) {
+      error = "Feed not loaded: " + params.feedId->value;
+    } else if (projection::core::applySurfaceParams(currentScene_, params, error)) {
+      layoutChanged = layoutChanged || params.changesLayout();
+      continue;
+    }
+    errors += errors.empty() ? error : "; " + error;
+  }
+  if (layoutChanged) {
+    ++layoutGeneration_;
+  }
+  if (!errors.empty()) {
+    throw std::runtime_error(errors);
+  }
+}
+
+void RenderState::loadCueTable(const projection::core::CueTableMessage& table) {
+  cues_.clear();
+  cueScenes_.clear();
+  for (const auto& cue : table.cues) {
+    cues_.insert_or_assign(cue.getId().value, cue);
+  }
+  for (const auto& definition : table.scenes) {
+    cueScenes_.insert_or_assign(definition.scene.getId().value, definition);
+  }
+
+  std::vector<std::string> predicted;
+  for (const auto& cue : table.cues) {
+    auto sceneIt = cueScenes_.find(cue.getSceneId().value);
+    if (sceneIt == cueScenes_.end()) {
+      continue;
+    }
+    for (const auto& feed : sceneIt->second.feeds) {
+      if (feed.getType() != FeedType::VideoFile) {
+        continue;
+      }
+      try {
+        predicted.push_back(parseVideoFileConfig(feed).filePath);
+      } catch (const std::exception&) {
+        // Reported when the scene is actually loaded.
+      }
+    }
+  }
+  videoResidency_.prewarm(predicted);
+}
+
+bool RenderState::playCue(const projection::core::CueId& cueId) {
+  auto cueIt = cues_.find(cueId.value);
+  if (cueIt == cues_.end()) {
+    throw std::runtime_error("Cue not cached: " + cueId.value);
+  }
+  const auto& cue = cueIt->second;
+
+  bool switched = false;
+  if (cue.getSceneId() != currentScene_.getId()) {
+    auto sceneIt = cueScenes_.find(cue.getSceneId().value);
+    if (sceneIt == cueScenes_.end()) {
+      throw std::runtime_error("Scene " + cue.getSceneId().value + " for cue " + cueId.value + " not cached");
     }
-    resource.filePath = it->second;
+    loadSceneDefinition(sceneIt->second.scene, sceneIt->second.feeds);
+    switched = true;
+  }
 
-    videoFeeds_.emplace(feed.getId().value, std::move(resource));
+  projection::core::UpdateSurfaceParamsMessage overrides;
+  for (const auto& [surfaceId, opacity] : cue.getSurfaceOpacities()) {
+    projection::core::SurfaceParams params;
+    params.surfaceId = surfaceId;
+    params.opacity = opacity;
+    overrides.updates.push_back(std::move(params));
+  }
+  projection::core::UpdateSurfaceParamsMessage brightnesses;
+  for (const auto& [surfaceId, brightness] : cue.getSurfaceBrightnesses()) {
+    projection::core::SurfaceParams params;
+    params.surfaceId = surfaceId;
+    params.brightness = brightness;
+    brightnesses.updates.push_back(std::move(params));
   }
+  projection::core::mergeSurfaceParams(overrides, brightnesses);
+  applySurfaceParams(overrides);
+  return switched;
 }
 
-void RenderState::updateVideoPlayers() {
+void RenderState::updateVideoPlayers(double deltaSeconds) {
+  masterClock_.advance(deltaSeconds);
   for (auto& entry : videoFeeds_) {
-    entry.second.player.update();
+    auto& resource = entry.second;
+    resource.source->update(deltaSeconds);
+    driftCorrector_.correct(*resource.source, masterClock_.seconds(), resource.startSeconds, deltaSeconds,
+                            resource.drift);
   }
 }
 
@@ -1,19 +1,31 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
-#include <ofMain.h>
-
 #include <projection/core/Feed.h>
+#include <projection/core/RendererProtocol.h>
 #include <projection/core/Scene.h>
 
+#include "util/FramePool.h"
+#include "util/WorkerPool.h"
+#include "video/PlaybackClock.h"
+#include "video/VideoResidency.h"
+#include "video/VideoSource.h"
+
 namespace projection::renderer {
 
+// A playing feed: a decoded video file or a Generated feed (empty filePath).
 struct VideoFeedResource {
   projection::core::FeedId id;
-  ofVideoPlayer player;
+  std::unique_ptr<VideoSource> source;
   std::string filePath;
+  // Master clock time at which the feed was at position 0.
+  double startSeconds{0.0};
+  FeedDriftMetrics drift{};
 };
 
 // Extracts the configured file paths for video feeds.
@@ -22,20 +34,67 @@ std::unordered_map<std::string, std::string> mapVideoFeedFilePaths(
 
 class RenderState {
  public:
-  RenderState() = default;
+  // Without a factory, video feeds are backed by StubVideoSource (no decoding).
+  RenderState();
+  explicit RenderState(VideoSourceFactory videoSourceFactory);
 
+  // Takes a source per VideoFile feed from the video residency (reusing a warm player for
+  // the same file, otherwise opening one through the factory) and creates a
+  // GeneratedVideoSource per Generated feed. The previous scene's players stay warm.
+  // Throws std::runtime_error for invalid feed configs, before anything is replaced.
   void loadSceneDefinition(const projection::core::Scene& scene,
                            const std::vector<projection::core::Feed>& feeds);
-  void updateVideoPlayers();
+  // Applies live surface changes to the current scene in place; no feed is reloaded. Every
+  // valid update is applied, then std::runtime_error lists the ones that were rejected
+  // (unknown surface, degenerate vertices, or a feed this scene did not load).
+  void applySurfaceParams(const projection::core::UpdateSurfaceParamsMessage& message);
+  // Replaces the cached cue table. Cues are played from it without any scene or cue data
+  // on the wire. The video files of the cued scenes are prewarmed, in cue order, as far as
+  // the video budget allows.
+  void loadCueTable(const projection::core::CueTableMessage& table);
+  // Applies a cached cue's opacity and brightness overrides to the current scene, first
+  // switching to the cue's scene (from the cached definitions) when another one is loaded.
+  // Returns true when the scene was switched. Throws std::runtime_error for cues or scenes
+  // that are not cached and for overrides naming unknown surfaces.
+  bool playCue(const projection::core::CueId& cueId);
+  size_t cachedCueCount() const { return cues_.size(); }
+  // Advances the master clock, updates every video source and corrects its drift against
+  // the clock.
+  void updateVideoPlayers(double deltaSeconds);
+
+  const MasterClock& masterClock() const { return masterClock_; }
+  const DriftCorrectionOptions& driftCorrection() const { return driftCorrector_.options(); }
+  void setDriftCorrection(const DriftCorrectionOptions& options) { driftCorrector_.setOptions(options); }
 
   const projection::core::Scene& currentScene() const { return currentScene_; }
   const std::vector<projection::core::Feed>& currentFeeds() const { return currentFeeds_; }
   const std::unordered_map<std::string, VideoFeedResource>& videoFeeds() const { return videoFeeds_; }
+  // Open video players: the current scene's plus warm ones for previous and predicted scenes.
+  const VideoResidency& videoResidency() const { return videoResidency_; }
+  void setVideoBudget(size_t budgetBytes) { videoResidency_.setBudget(budgetBytes); }
+  // Recycles CPU frame buffers for every feed that produces frames on the CPU.
+  FramePool& framePool() { return framePool_; }
+  const FramePool& framePool() const { return framePool_; }
+  // Bumped on scene loads only; surface parameter changes bump layoutGeneration() instead.
+  uint64_t sceneGeneration() const { return sceneGeneration_; }
+  // Bumped on scene loads and on surface changes that can affect draw order or batching.
+  uint64_t layoutGeneration() const { return layoutGeneration_; }
 
  private:
+  VideoResidency videoResidency_;
   projection::core::Scene currentScene_{};
   std::vector<projection::core::Feed> currentFeeds_{};
+  // Both are declared before videoFeeds_ so they outlive the sources that point at them. The
+  // worker pool is shared by all generated feeds and created with the first one.
+  FramePool framePool_{};
+  std::unique_ptr<WorkerPool> generatorPool_{};
   std::unordered_map<std::string, VideoFeedResource> videoFeeds_{};
+  uint64_t sceneGeneration_{0};
+  uint64_t layoutGeneration_{0};
+  std::unordered_map<std::string, projection::core::Cue> cues_{};
+  std::unordered_map<std::string, projection::core::LoadSceneDefinitionMessage> cueScenes_{};
+  MasterClock masterClock_{};
+  DriftCorrector driftCorrector_{};
 };
 
 }  // namespace projection::renderer
@@ -0,0 +1,603 @@
+#include "RendererRuntime.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <projection/core/TimeSync.h>
+
+#include "util/InteractionUtils.h"
+
+namespace projection::renderer {
+
+using projection::core::RendererMessage;
+using projection::core::RendererMessageType;
+using projection::core::Vec2;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Surface a message updates in place, or nullptr when it is not a per-surface update.
+const std::string* surfaceUpdateTarget(const RendererMessage& message) {
+  if (message.type == RendererMessageType::SetFeedForSurface && message.setFeedForSurface) {
+    return &message.setFeedForSurface->surfaceId.value;
+  }
+  return nullptr;
+}
+
+// Messages that change which scene or cues later surface updates apply to; updates on either
+// side of one must not be merged across it.
+bool separatesSurfaceUpdates(const RendererMessage& message) {
+  return message.type == RendererMessageType::PlayCue || message.type == RendererMessageType::LoadScene ||
+         message.type == RendererMessageType::LoadCueTable;
+}
+}  // namespace
+
+RendererRuntime::RendererRuntime(VideoSourceFactory videoSourceFactory, bool verbose)
+    : verbose_(verbose), renderState_(std::move(videoSourceFactory)) {}
+
+void RendererRuntime::handle(const RendererMessage& message) { handle(RendererMessage(message)); }
+
+void RendererRuntime::handle(RendererMessage&& message) {
+  auto owned = std::make_unique<RendererMessage>(std::move(message));
+  if (!messageQueue_.tryPush(std::move(owned))) {
+    // Reported back to the server as an Error reply by RendererClient.
+    throw std::runtime_error("Renderer message queue full");
+  }
+}
+
+void RendererRuntime::update(double deltaSeconds) { update(deltaSeconds, projection::core::monotonicMicros()); }
+
+void RendererRuntime::update(double deltaSeconds, int64_t frameTimeMicros) {
+  const auto start = Clock::now();
+  std::unique_ptr<RendererMessage> message;
+  while (messageQueue_.tryPop(message)) {
+    if (message->executeAt && *message->executeAt > frameTimeMicros) {
+      const int64_t executeAt = *message->executeAt;
+      scheduled_.push_back(ScheduledMessage{executeAt, scheduledSequence_++, std::move(message)});
+      std::push_heap(scheduled_.begin(), scheduled_.end(), scheduledAfter);
+      continue;
+    }
+    batch_.push_back(std::move(message));
+  }
+  while (!scheduled_.empty() && scheduled_.front().executeAt <= frameTimeMicros) {
+    std::pop_heap(scheduled_.begin(), scheduled_.end(), scheduledAfter);
+    ScheduledMessage due = std::move(scheduled_.back());
+    scheduled_.pop_back();
+    batch_.push_back(std::move(due.message));
+    lastScheduleLatenessMs_ = static_cast<double>(frameTimeMicros - due.executeAt) / 1000.0;
+    lastScheduledFrameMicros_ = frameTimeMicros;
+  }
+  coalesceBatch();
+  for (size_t i = 0; i < batch_.size(); ++i) {
+    if (batch_[i]) {
+      processMessage(*batch_[i]);
+      ++coalescing_.applied;
+      recordOutcome(i, batch_[i]->commandId);
+    }
+  }
+  batch_.clear();
+  if (!outcomes_.empty()) {
+    std::lock_guard<std::mutex> lock(outcomeSinkMutex_);
+    if (outcomeSink_) {
+      outcomeSink_(outcomes_);
+    }
+    outcomes_.clear();
+  }
+  if (snapshotWriter_) {
+    submitSceneSnapshot(frameTimeMicros, false);
+  }
+  drainMidi(frameTimeMicros);
+  const auto messagesDone = Clock::now();
+
+  renderState_.updateVideoPlayers(deltaSeconds);
+  const auto videoDone = Clock::now();
+
+  const int audioInterval = std::max(1, quality_.level().audioAnalysisInterval);
+  if (frameCount_ % static_cast<uint64_t>(audioInterval) == 0) {
+    updateAudio();
+  }
+  const auto audioDone = Clock::now();
+
+  elapsedSeconds_ += deltaSeconds;
+  ++frameCount_;
+  lastTimings_.messagesMs = elapsedMs(start, messagesDone);
+  lastTimings_.videoMs = elapsedMs(messagesDone, videoDone);
+  lastTimings_.audioMs = elapsedMs(videoDone, audioDone);
+}
+
+bool RendererRuntime::recordFrameTime(double frameMs) {
+  if (!quality_.addFrame(frameMs)) {
+    return false;
+  }
+  const auto& change = quality_.lastChange();
+  const auto& levels = quality_.levels();
+  std::cerr << "[renderer] quality " << levels[change.fromLevel].name << " -> " << levels[change.toLevel].name
+            << " at frame " << change.frame << " (p" << quality_.options().percentile << " " << change.percentileMs
+            << " ms, budget " << quality_.budgetMs() << " ms)" << std::endl;
+  return true;
+}
+
+bool RendererRuntime::setCommandOutcomeSink(CommandOutcomeSink sink) {
+  std::lock_guard<std::mutex> lock(outcomeSinkMutex_);
+  outcomeSink_ = std::move(sink);
+  return true;
+}
+
+void RendererRuntime::recordOutcome(size_t index, const std::string& commandId) {
+  std::string error;
+  {
+    std::lock_guard<std::mutex> lock(statusMutex_);
+    error = status_.lastError;
+  }
+  outcomes_.push_back(CommandOutcome{commandId, error});
+  for (const auto& [foldedIndex, foldedId] : foldedCommands_) {
+    if (foldedIndex == index) {
+      outcomes_.push_back(CommandOutcome{foldedId, error});
+    }
+  }
+}
+
+void RendererRuntime::coalesceBatch() {
+  foldedCommands_.clear();
+  coalescing_.received += batch_.size();
+  coalescing_.largestBatch = std::max(coalescing_.largestBatch, batch_.size());
+  if (batch_.size() < 2) {
+    return;
+  }
+
+  // A full scene load replaces the scene, its feeds and every surface, so anything that only
+  // changes scene state before the last one would be torn down again in the same frame.
+  size_t lastLoad = batch_.size();
+  for (size_t i = batch_.size(); i-- > 0;) {
+    if (batch_[i]->type == RendererMessageType::LoadSceneDefinition) {
+      lastLoad = i;
+      break;
+    }
+  }
+  if (lastLoad != batch_.size()) {
+    for (size_t i = 0; i < lastLoad; ++i) {
+      const auto type = batch_[i]->type;
+      if (type == RendererMessageType::LoadSceneDefinition || type == RendererMessageType::LoadScene ||
+          type == RendererMessageType::PlayCue) {
+        outcomes_.push_back(CommandOutcome{batch_[i]->commandId, {}});
+        batch_[i].reset();
+        ++coalescing_.sceneLoadsSuperseded;
+      } else if (type == RendererMessageType::UpdateSurfaceParams || surfaceUpdateTarget(*batch_[i]) != nullptr) {
+        outcomes_.push_back(CommandOutcome{batch_[i]->commandId, {}});
+        batch_[i].reset();
+        ++coalescing_.surfaceUpdatesMerged;
+      }
+    }
+  }
+
+  // Newest update per surface wins; walk backwards so the survivor keeps its position.
+  mergedSurfaces_.clear();
+  const size_t firstLive = lastLoad == batch_.size() ? 0 : lastLoad + 1;
+  for (size_t i = batch_.size(); i-- > firstLive;) {
+    if (separatesSurfaceUpdates(*batch_[i])) {
+      mergedSurfaces_.clear();
+      continue;
+    }
+    const std::string* surfaceId = surfaceUpdateTarget(*batch_[i]);
+    if (surfaceId == nullptr) {
+      continue;
+    }
+    const bool seen = std::any_of(mergedSurfaces_.begin(), mergedSurfaces_.end(),
+                                  [&](const std::string* other) { return *other == *surfaceId; });
+    if (seen) {
+      outcomes_.push_back(CommandOutcome{batch_[i]->commandId, {}});
+      batch_[i].reset();
+      ++coalescing_.surfaceUpdatesMerged;
+    } else {
+      mergedSurfaces_.push_back(surfaceId);
+    }
+  }
+
+  // Each run of surface parameter batches folds into its last one, which then carries every
+  // change of the run. A cue or scene switch ends the run: its overrides must land in between.
+  size_t pendingParams = batch_.size();
+  for (size_t i = firstLive; i < batch_.size(); ++i) {
+    if (batch_[i] && separatesSurfaceUpdates(*batch_[i])) {
+      pendingParams = batch_.size();
+      continue;
+    }
+    if (!batch_[i] || batch_[i]->type != RendererMessageType::UpdateSurfaceParams ||
+        !batch_[i]->updateSurfaceParams) {
+      continue;
+    }
+    if (pendingParams != batch_.size()) {
+      auto& merged = *batch_[pendingParams];
+      projection::core::mergeSurfaceParams(*merged.updateSurfaceParams, *batch_[i]->updateSurfaceParams);
+      for (auto& folded : foldedCommands_) {
+        if (folded.first == pendingParams) {
+          folded.first = i;
+        }
+      }
+      foldedCommands_.emplace_back(i, std::move(merged.commandId));
+      merged.commandId = batch_[i]->commandId;
+      batch_[i] = std::move(batch_[pendingParams]);
+      ++coalescing_.surfaceUpdatesMerged;
+    }
+    pendingParams = i;
+  }
+}
+
+bool RendererRuntime::restoreSceneSnapshot(const std::string& path, std::string& error) {
+  SceneSnapshot snapshot;
+  if (!readSceneSnapshotFile(path, snapshot, error)) {
+    return false;
+  }
+  if (snapshot.empty()) {
+    error = "'" + path + "' holds no scene";
+    return false;
+  }
+  // The scene goes first: it is the part that can be rejected, and loading it changes nothing
+  // when it is. The cue table is only taken once the scene is in.
+  if (snapshot.scene) {
+    try {
+      renderState_.loadSceneDefinition(snapshot.scene->scene, snapshot.scene->feeds);
+    } catch (const std::exception& ex) {
+      error = "'" + path + "': " + ex.what();
+      return false;
+    }
+    reconcileScene_ = true;
+  }
+  if (snapshot.cueTable) {
+    renderState_.loadCueTable(*snapshot.cueTable);
+    if (snapshot.cueTable->settings) {
+      std::vector<std::string> warnings;
+      setMidiMap(compileMidiMap(*snapshot.cueTable->settings, warnings));
+    }
+    cueTable_ = snapshot.cueTable;
+    reconcileCueTable_ = true;
+  }
+  // Nothing changed since the file was written.
+  snapshotSceneGeneration_ = renderState_.sceneGeneration();
+  snapshotDirty_ = false;
+  restoredFromSnapshot_ = true;
+  std::lock_guard<std::mutex> lock(statusMutex_);
+  status_.sceneId = renderState_.currentScene().getId().value;
+  status_.lastCommand = "Restored snapshot " + path;
+  return true;
+}
+
+void RendererRuntime::enableSceneSnapshots(const std::string& path, double minIntervalSeconds) {
+  snapshotWriter_ = std::make_unique<SceneSnapshotWriter>(path);
+  snapshotIntervalMicros_ = static_cast<int64_t>(std::max(0.0, minIntervalSeconds) * 1e6);
+  snapshotSceneGeneration_ = renderState_.sceneGeneration();
+}
+
+void RendererRuntime::flushSceneSnapshots() {
+  if (!snapshotWriter_) {
+    return;
+  }
+  submitSceneSnapshot(projection::core::monotonicMicros(), true);
+  snapshotWriter_->flush();
+}
+
+void RendererRuntime::submitSceneSnapshot(int64_t frameTimeMicros, bool force) {
+  if (renderState_.sceneGeneration() != snapshotSceneGeneration_) {
+    snapshotSceneGeneration_ = renderState_.sceneGeneration();
+    snapshotDirty_ = true;
+  }
+  // Live surface changes can arrive every frame; the interval bounds the copies they cost.
+  if (!snapshotDirty_ ||
+      (!force && lastSnapshotMicros_ && frameTimeMicros - *lastSnapshotMicros_ < snapshotIntervalMicros_)) {
+    return;
+  }
+  SceneSnapshot snapshot;
+  if (!renderState_.currentScene().getId().value.empty()) {
+    snapshot.scene = projection::core::LoadSceneDefinitionMessage{renderState_.currentScene(),
+                                                                  renderState_.currentFeeds()};
+  }
+  snapshot.cueTable = cueTable_;
+  snapshotWriter_->submit(std::move(snapshot));
+  snapshotDirty_ = false;
+  lastSnapshotMicros_ = frameTimeMicros;
+}
+
+bool RendererRuntime::writeMidi(MidiEvent event) {
+  if (event.timestampMicros == 0) {
+    event.timestampMicros = projection::core::monotonicMicros();
+  }
+  return midiQueue_.tryPush(std::move(event));
+}
+
+void RendererRuntime::setMidiParameter(MidiParameter parameter, float value) {
+  if (parameter != MidiParameter::None) {
+    midiParameters_[static_cast<size_t>(parameter)] = std::clamp(value, 0.0f, 1.0f);
+  }
+}
+
+void RendererRuntime::drainMidi(int64_t frameTimeMicros) {
+  // At most one ring's worth per frame, so a flooding controller costs a bounded, small amount
+  // of work per frame instead of stretching it; anything newer waits for the next frame.
+  MidiEvent event;
+  size_t drained = 0;
+  double frameMaxLatencyMs = 0.0;
+  while (drained < kMidiQueueCapacity && midiQueue_.tryPop(event)) {
+    ++drained;
+    const double latencyMs = static_cast<double>(std::max<int64_t>(0, frameTimeMicros - event.timestampMicros)) / 1000.0;
+    frameMaxLatencyMs = std::max(frameMaxLatencyMs, latencyMs);
+    midiStats_.totalLatencyMs += latencyMs;
+    if (!midiMap_.listensTo(event.channel())) {
+      ++midiStats_.filtered;
+      continue;
+    }
+    float value = 0.0f;
+    const MidiParameter parameter = midiMap_.lookup(event, value);
+    if (parameter == MidiParameter::None) {
+      ++midiStats_.unmapped;
+      continue;
+    }
+    midiParameters_[static_cast<size_t>(parameter)] = value;
+    ++midiStats_.applied;
+  }
+  midiStats_.received += drained;
+  midiStats_.dropped = midiQueue_.rejectedCount();
+  midiStats_.lastFrameEvents = drained;
+  midiStats_.lastFrameMaxLatencyMs = frameMaxLatencyMs;
+  midiStats_.maxLatencyMs = std::max(midiStats_.maxLatencyMs, frameMaxLatencyMs);
+}
+
+void RendererRuntime::updateAudio() {
+  if (!audioAnalyzer_.running()) {
+    audioAnalyzer_.pump();
+  }
+  // One attempt, constant time: while the analyzer is mid-publish the previous snapshot stays.
+  AudioFeatures features;
+  if (!audioAnalyzer_.tryRead(features) || features.blocks == 0) {
+    return;
+  }
+  audioFeatures_ = features;
+  audioScale_ = mapEnergyToScale(features.smoothedEnergy);
+}
+
+const DrawList& RendererRuntime::prepareFrame(float outputWidth, float outputHeight) {
+  const auto start = Clock::now();
+  prepareSurfaces();
+  buildDrawList(ViewportTransform(fullSceneViewport(outputWidth, outputHeight)), drawList_);
+  lastTimings_.prepareMs = elapsedMs(start, Clock::now());
+  return drawList_;
+}
+
+const std::vector<DrawList>& RendererRuntime::prepareOutputs(const std::vector<OutputViewport>& outputs) {
+  const auto start = Clock::now();
+  prepareSurfaces();
+  outputDrawLists_.resize(outputs.size());
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    buildDrawList(ViewportTransform(outputs[i]), outputDrawLists_[i]);
+  }
+  lastTimings_.prepareMs = elapsedMs(start, Clock::now());
+  return outputDrawLists_;
+}
+
+void RendererRuntime::prepareSurfaces() {
+  const auto& scene = renderState_.currentScene();
+  if (drawOrderGeneration_ != renderState_.layoutGeneration()) {
+    drawOrder_ = compileDrawOrder(scene);
+    drawOrderGeneration_ = renderState_.layoutGeneration();
+  }
+  const auto& surfaces = scene.getSurfaces();
+  const auto& videoFeeds = renderState_.videoFeeds();
+
+  // Feed lookups and bounds are shared by every output; the audio scale applies around the
+  // scene origin (the centre of the single-output mapping), at the MIDI-controlled depth.
+  surfaceScale_ = 1.0f + (audioScale_ - 1.0f) * midiParameter(MidiParameter::AudioDepth);
+  preparedSurfaces_.clear();
+  for (size_t surfaceIndex : drawOrder_) {
+    const auto& surface = surfaces[surfaceIndex];
+    auto feedIt = videoFeeds.find(surface.getFeedId().value);
+    if (feedIt == videoFeeds.end()) {
+      continue;
+    }
+    const auto& source = *feedIt->second.source;
+    if (!source.isLoaded() || source.width() <= 0.0f || source.height() <= 0.0f) {
+      continue;
+    }
+
+    const auto& vertices = surface.getVertices();
+    if (vertices.size() < 3) {
+      continue;
+    }
+    SceneRect bounds{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                     std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    for (const auto& v : vertices) {
+      bounds.left = std::min(bounds.left, v.x * surfaceScale_);
+      bounds.top = std::min(bounds.top, v.y * surfaceScale_);
+      bounds.right = std::max(bounds.right, v.x * surfaceScale_);
+      bounds.bottom = std::max(bounds.bottom, v.y * surfaceScale_);
+    }
+    if (bounds.right <= bounds.left || bounds.bottom <= bounds.top) {
+      continue;
+    }
+    preparedSurfaces_.push_back(PreparedSurface{surfaceIndex, bounds});
+  }
+}
+
+void RendererRuntime::buildDrawList(const ViewportTransform& transform, DrawList& list) {
+  const auto& surfaces = renderState_.currentScene().getSurfaces();
+  const float brightnessModulation = midiBrightness();
+  const SceneRect& visible = transform.visibleSceneBounds();
+  auto& draws = list.surfaces;
+
+  // Entries are reused frame to frame so steady-state preparation does not reallocate.
+  size_t drawCount = 0;
+  list.culledSurfaces = 0;
+  for (const auto& prepared : preparedSurfaces_) {
+    if (!prepared.bounds.intersects(visible)) {
+      ++list.culledSurfaces;
+      continue;
+    }
+    const auto& surface = surfaces[prepared.surfaceIndex];
+    if (drawCount == draws.size()) {
+      draws.emplace_back();
+    }
+    SurfaceDraw& draw = draws[drawCount];
+    draw.positions.clear();
+    draw.texCoords.clear();
+
+    // The feed frame is stretched over the surface's scene-space bounding box, so a surface
+    // split across outputs continues seamlessly and turns with a rotated output.
+    const SceneRect& bounds = prepared.bounds;
+    const float invW = 1.0f / (bounds.right - bounds.left);
+    const float invH = 1.0f / (bounds.bottom - bounds.top);
+    for (const auto& v : surface.getVertices()) {
+      const Vec2 scaled{v.x * surfaceScale_, v.y * surfaceScale_};
+      draw.positions.push_back(transform.toPixels(scaled));
+      draw.texCoords.push_back(Vec2{std::clamp((scaled.x - bounds.left) * invW, 0.0f, 1.0f),
+                                    std::clamp((scaled.y - bounds.top) * invH, 0.0f, 1.0f)});
+    }
+
+    draw.surfaceId = surface.getId().value;
+    draw.feedId = surface.getFeedId().value;
+    draw.alpha = std::clamp(surface.getOpacity() * brightnessModulation, 0.0f, 1.0f);
+    draw.brightness = std::clamp(surface.getBrightness(), 0.0f, 1.0f);
+    draw.blendMode = surface.getBlendMode();
+    draw.zOrder = surface.getZOrder();
+    ++drawCount;
+  }
+  draws.resize(drawCount);
+  buildDrawBatches(list);
+}
+
+void RendererRuntime::writeAudio(const float* interleaved, size_t frames, size_t channels) {
+  audioRing_.writeInterleaved(interleaved, frames, channels);
+}
+
+void RendererRuntime::setLastError(const std::string& error) {
+  std::lock_guard<std::mutex> lock(statusMutex_);
+  status_.lastError = error;
+}
+
+RendererStatus RendererRuntime::status() const {
+  std::lock_guard<std::mutex> lock(statusMutex_);
+  return status_;
+}
+
+void RendererRuntime::processMessage(const RendererMessage& message) {
+  {
+    std::lock_guard<std::mutex> lock(statusMutex_);
+    status_.lastError.clear();
+  }
+
+  switch (message.type) {
+    case RendererMessageType::Hello: {
+      std::lock_guard<std::mutex> lock(statusMutex_);
+      status_.role = message.hello->role;
+      status_.version = message.hello->version;
+      status_.lastCommand = "Hello (#" + message.commandId + ")";
+      break;
+    }
+    case RendererMessageType::LoadScene: {
+      std::lock_guard<std::mutex> lock(statusMutex_);
+      status_.sceneId = message.loadScene->sceneId.value;
+      status_.lastCommand = "LoadScene (#" + message.commandId + ")";
+      break;
+    }
+    case RendererMessageType::LoadSceneDefinition: {
+      const auto& definition = *message.loadSceneDefinition;
+      if (verbose_) {
+        std::cerr << "[renderer] LoadSceneDefinition with scene " << definition.scene.getId().value
+                  << " feeds=" << definition.feeds.size() << std::endl;
+      }
+      if (std::exchange(reconcileScene_, false) && definition.scene == renderState_.currentScene() &&
+          definition.feeds == renderState_.currentFeeds()) {
+        // The server confirms the restored scene; it is already playing.
+        std::lock_guard<std::mutex> lock(statusMutex_);
+        status_.lastCommand = "LoadSceneDefinition (#" + message.commandId + ") matches snapshot";
+        break;
+      }
+      try {
+        renderState_.loadSceneDefinition(definition.scene, definition.feeds);
+      } catch (const std::exception& ex) {
+        setLastError(std::string("LoadSceneDefinition failed: ") + ex.what());
+        break;
+      }
+      std::lock_guard<std::mutex> lock(statusMutex_);
+      status_.sceneId = definition.scene.getId().value;
+      status_.lastCommand = "LoadSceneDefinition (#" + message.commandId + ")";
+      break;
+    }
+    case RendererMessageType::SetFeedForSurface: {
+      std::lock_guard<std::mutex> lock(statusMutex_);
+      status_.lastCommand = "SetFeedForSurface (#" + message.commandId + ") -> surface " +
+                            message.setFeedForSurface->surfaceId.value + " feed " +
+                            message.setFeedForSurface->feedId.value;
+      break;
+    }
+    case RendererMessageType::UpdateSurfaceParams: {
+      const auto& updates = message.updateSurfaceParams->updates;
+      // Surface edits keep the scene generation, and a failed batch may have applied some.
+      snapshotDirty_ = true;
+      try {
+        renderState_.applySurfaceParams(*message.updateSurfaceParams);
+      } catch (const std::exception& ex) {
+        setLastError(std::string("UpdateSurfaceParams failed: ") + ex.what());
+        break;
+      }
+      std::lock_guard<std::mutex> lock(statusMutex_);
+      status_.lastCommand = "UpdateSurfaceParams (#" + message.commandId + ") -> " + std::to_string(updates.size()) +
+                            (updates.size() == 1 ? " surface" : " surfaces");
+      break;
+    }
+    case RendererMessageType::PlayCue: {
+      const auto& cueId = message.playCue->cueId;
+      const uint64_t generation = renderState_.sceneGeneration();
+      std::string error;
+      try {
+        renderState_.playCue(cueId);
+      } catch (const std::exception& ex) {
+        error = std::string("PlayCue failed: ") + ex.what();
+      }
+      // A cue on the current scene only applies overrides, and a failed one may have applied some.
+      snapshotDirty_ = true;
+      std::lock_guard<std::mutex> lock(statusMutex_);
+      // Overrides can fail after the cue already switched scenes.
+      if (renderState_.sceneGeneration() != generation) {
+        status_.sceneId = renderState_.currentScene().getId().value;
+      }
+      status_.lastError = error;
+      status_.lastCommand = "PlayCue (#" + message.commandId + ") -> cue " + cueId.value;
+      break;
+    }
+    case RendererMessageType::LoadCueTable: {
+      if (std::exchange(reconcileCueTable_, false) && cueTable_ && *cueTable_ == *message.cueTable) {
+        std::lock_guard<std::mutex> lock(statusMutex_);
+        status_.lastCommand = "LoadCueTable (#" + message.commandId + ") matches snapshot";
+        break;
+      }
+      renderState_.loadCueTable(*message.cueTable);
+      cueTable_ = std::make_shared<const projection::core::CueTableMessage>(*message.cueTable);
+      snapshotDirty_ = true;
+      if (message.cueTable->settings) {
+        std::vector<std::string> warnings;
+        setMidiMap(compileMidiMap(*message.cueTable->settings, warnings));
+        for (const auto& warning : warnings) {
+          std::cerr << "[renderer] " << warning << std::endl;
+        }
+      }
+      std::lock_guard<std::mutex> lock(statusMutex_);
+      status_.lastCommand = "LoadCueTable (#" + message.commandId + ") -> " +
+                            std::to_string(message.cueTable->cues.size()) + " cues";
+      break;
+    }
+    case RendererMessageType::Ack:
+    case RendererMessageType::Error:
+    case RendererMessageType::TimeSync:
+      // Renderer should not receive these in normal operation (RendererClient consumes
+      // TimeSync replies itself), ignore.
+      break;
+  }
+}
+
+}  // namespace projection::renderer
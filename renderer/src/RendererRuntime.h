@@ -0,0 +1,278 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <projection/core/RendererProtocol.h>
+#include <projection/core/Surface.h>
+
+#include "DrawListCompiler.h"
+#include "OutputViewport.h"
+#include "RenderState.h"
+#include "SceneSnapshot.h"
+#include "audio/AudioAnalyzer.h"
+#include "audio/SampleRingBuffer.h"
+#include "midi/MidiMap.h"
+#include "net/RendererServer.h"
+#include "util/QualityGovernor.h"
+#include "util/SpscQueue.h"
+#include "video/VideoSource.h"
+
+namespace projection::renderer {
+
+// Snapshot of the human-readable status shown in the renderer overlay.
+struct RendererStatus {
+  std::string lastCommand;
+  std::string lastError;
+  std::string sceneId;
+  std::string role;
+  std::string version;
+};
+
+// Wall-clock duration of each per-frame stage, in milliseconds.
+struct FrameStageTimings {
+  double messagesMs{0.0};
+  double videoMs{0.0};
+  double audioMs{0.0};
+  double prepareMs{0.0};
+};
+
+// Per-frame command coalescing (render thread). The network layer acks every command on
+// receipt; coalescing only decides which of the messages due in one frame reach RenderState.
+struct CoalescingStats {
+  uint64_t received{0};
+  uint64_t applied{0};
+  // Scene loads and cues dropped because a later LoadSceneDefinition was due in the same
+  // frame.
+  uint64_t sceneLoadsSuperseded{0};
+  // Per-surface updates dropped because a later scene load or a later update to the same
+  // surface was due in the same frame.
+  uint64_t surfaceUpdatesMerged{0};
+  size_t largestBatch{0};
+
+  uint64_t coalesced() const { return sceneLoadsSuperseded + surfaceUpdatesMerged; }
+};
+
+// MIDI events drained by update() and their latency from receipt on the MIDI thread
+// (MidiEvent::timestampMicros) to the frame that drained them.
+struct MidiStats {
+  uint64_t received{0};
+  uint64_t applied{0};
+  // On channels the project does not listen to.
+  uint64_t filtered{0};
+  // Other messages, or CCs and notes not mapped to a parameter.
+  uint64_t unmapped{0};
+  // Rejected by the full ring on the MIDI thread.
+  uint64_t dropped{0};
+  size_t lastFrameEvents{0};
+  double lastFrameMaxLatencyMs{0.0};
+  double maxLatencyMs{0.0};
+  double totalLatencyMs{0.0};
+
+  double meanLatencyMs() const { return received > 0 ? totalLatencyMs / static_cast<double>(received) : 0.0; }
+};
+
+// Everything the renderer does per frame that does not need a GPU: draining commands from the
+// network thread, applying them to RenderState, advancing video sources, audio modulation and
+// building the surface geometry. ofApp and the headless runner are thin shells around it.
+class RendererRuntime : public RendererCommandHandler {
+ public:
+  explicit RendererRuntime(VideoSourceFactory videoSourceFactory, bool verbose = false);
+
+  // Called from the RendererClient thread; queues the message for the next update().
+  void handle(const projection::core::RendererMessage& message) override;
+  void handle(projection::core::RendererMessage&& message) override;
+  // Once per frame, update() passes `sink` the outcome of every command it finished: applied,
+  // rejected with the error it set as lastError, or coalesced away (which counts as applied;
+  // an update merged into another shares its outcome). Called on the render thread.
+  bool setCommandOutcomeSink(CommandOutcomeSink sink) override;
+
+  // Render thread: applies queued messages and advances video/audio state by deltaSeconds.
+  // Messages with an executeAt (local monotonic microseconds, see RendererClient) later than
+  // the frame time wait in a time-ordered queue and are applied on the first frame at or
+  // after it; ties keep arrival order. All messages due in one frame are coalesced first:
+  // only the last LoadSceneDefinition is applied (earlier scene loads, cues and per-surface
+  // updates are superseded by it); after it SetFeedForSurface keeps only the newest per
+  // surface and UpdateSurfaceParams batches merge into one.
+  void update(double deltaSeconds);
+  void update(double deltaSeconds, int64_t frameTimeMicros);
+
+  // Render thread: rebuilds the draw list for an output of the given pixel size, in the
+  // scene's compiled draw order (recompiled only when the scene changes) and batched.
+  const DrawList& prepareFrame(float outputWidth, float outputHeight);
+  // Render thread: one draw list per output, in that output's pixels. Each list holds only
+  // the surfaces whose bounds reach the output's viewport; the others are counted in
+  // culledSurfaces and cost no vertex work. Draw order and feed lookups are shared.
+  const std::vector<DrawList>& prepareOutputs(const std::vector<OutputViewport>& outputs);
+
+  // Audio thread: lock- and allocation-free.
+  void writeAudio(const float* interleaved, size_t frames, size_t channels);
+  // Moves audio analysis onto its own thread. Until it is started (and after it is stopped)
+  // update() analyses the waiting samples inline; either way it then only reads the newest
+  // AudioFeatures snapshot. Options may only change while the thread is stopped.
+  void startAudioAnalysis() { audioAnalyzer_.start(); }
+  void stopAudioAnalysis() { audioAnalyzer_.stop(); }
+  void setAudioAnalysis(const AudioAnalyzerOptions& options) { audioAnalyzer_.setOptions(options); }
+  const AudioAnalyzer& audioAnalyzer() const { return audioAnalyzer_; }
+  // MIDI thread: lock- and allocation-free. Stamps the event with core::monotonicMicros()
+  // when timestampMicros is 0. Returns false (counted in MidiStats::dropped) when the ring
+  // is full.
+  bool writeMidi(MidiEvent event);
+  // Render thread. update() drains the ring once per frame, filters by the map's channels
+  // and applies each mapped event; a parameter takes the last value it received in the
+  // frame. LoadCueTable messages carrying project settings replace the map.
+  void setMidiMap(const MidiMap& map) { midiMap_ = map; }
+  const MidiMap& midiMap() const { return midiMap_; }
+  float midiParameter(MidiParameter parameter) const { return midiParameters_[static_cast<size_t>(parameter)]; }
+  void setMidiParameter(MidiParameter parameter, float value);
+  float midiBrightness() const { return midiParameter(MidiParameter::Brightness); }
+  void setMidiBrightness(float brightness) { setMidiParameter(MidiParameter::Brightness, brightness); }
+  const MidiStats& midiStats() const { return midiStats_; }
+
+  // Render thread, before the first update(): applies a snapshot written by an earlier run
+  // (scene, then cue table) so playback starts without waiting for the server. Until the
+  // server's own state arrives, a LoadSceneDefinition or LoadCueTable identical to the
+  // restored one is acknowledged without reloading anything. False with a message when the
+  // file is missing or unusable; the runtime is then left as it was.
+  bool restoreSceneSnapshot(const std::string& path, std::string& error);
+  bool restoredFromSnapshot() const { return restoredFromSnapshot_; }
+  // Render thread: after the scene, its surfaces or the cue table change, update() hands a
+  // copy to a SceneSnapshotWriter writing `path`, at most once per minIntervalSeconds. All
+  // encoding and disk I/O happen on the writer's thread.
+  void enableSceneSnapshots(const std::string& path, double minIntervalSeconds = 0.5);
+  // Submits any change still waiting for the interval and waits until it is on disk.
+  void flushSceneSnapshots();
+  const SceneSnapshotWriter* sceneSnapshotWriter() const { return snapshotWriter_.get(); }
+
+  // Render thread (or before the first update()).
+  void setDriftCorrection(const DriftCorrectionOptions& options) { renderState_.setDriftCorrection(options); }
+  void setVideoBudget(size_t budgetBytes) { renderState_.setVideoBudget(budgetBytes); }
+  void setQualityGovernor(const QualityGovernorOptions& options) { quality_.setOptions(options); }
+
+  // Render thread, once per frame: the frame's work time (from update() to the end of
+  // drawing, excluding any wait for vsync). Steps the quality level and logs each change;
+  // returns true when it changed. update() analyses audio at the level's rate.
+  bool recordFrameTime(double frameMs);
+  const QualityGovernor& qualityGovernor() const { return quality_; }
+  const QualityLevel& qualityLevel() const { return quality_.level(); }
+
+  void setLastError(const std::string& error);
+  RendererStatus status() const;
+
+  float audioScale() const { return audioScale_; }
+  // Snapshot update() last picked up.
+  const AudioFeatures& audioFeatures() const { return audioFeatures_; }
+  double elapsedSeconds() const { return elapsedSeconds_; }
+  uint64_t frameCount() const { return frameCount_; }
+  const FrameStageTimings& lastTimings() const { return lastTimings_; }
+  size_t scheduledCount() const { return scheduled_.size(); }
+  // Frame time minus executeAt for the most recently applied scheduled message.
+  double lastScheduleLatenessMs() const { return lastScheduleLatenessMs_; }
+  int64_t lastScheduledFrameMicros() const { return lastScheduledFrameMicros_; }
+  const CoalescingStats& coalescingStats() const { return coalescing_; }
+
+  const RenderState& renderState() const { return renderState_; }
+  // Thread-safe; CPU-side consumers (previews, downscales) take their buffers from here too.
+  FramePool& framePool() { return renderState_.framePool(); }
+  const SpscQueue<std::unique_ptr<projection::core::RendererMessage>>& messageQueue() const {
+    return messageQueue_;
+  }
+
+ private:
+  struct ScheduledMessage {
+    int64_t executeAt;
+    uint64_t sequence;
+    std::unique_ptr<projection::core::RendererMessage> message;
+  };
+  // Min-heap order on (executeAt, sequence).
+  static bool scheduledAfter(const ScheduledMessage& a, const ScheduledMessage& b) {
+    return a.executeAt != b.executeAt ? a.executeAt > b.executeAt : a.sequence > b.sequence;
+  }
+
+  void coalesceBatch();
+  void processMessage(const projection::core::RendererMessage& message);
+  // Records the outcome of the batch entry at `index` and of the updates merged into it.
+  void recordOutcome(size_t index, const std::string& commandId);
+  void drainMidi(int64_t frameTimeMicros);
+  void submitSceneSnapshot(int64_t frameTimeMicros, bool force);
+  void updateAudio();
+  void prepareSurfaces();
+  void buildDrawList(const ViewportTransform& transform, DrawList& list);
+
+  bool verbose_{false};
+  RenderState renderState_;
+
+  // Filled by the RendererClient thread, drained by update() on the render thread.
+  static constexpr size_t kMessageQueueCapacity = 256;
+  SpscQueue<std::unique_ptr<projection::core::RendererMessage>> messageQueue_{kMessageQueueCapacity};
+  std::vector<ScheduledMessage> scheduled_{};
+  uint64_t scheduledSequence_{0};
+  double lastScheduleLatenessMs_{0.0};
+  int64_t lastScheduledFrameMicros_{0};
+  // Messages due this frame, in apply order; reused so steady state does not allocate.
+  std::vector<std::unique_ptr<projection::core::RendererMessage>> batch_{};
+  std::vector<const std::string*> mergedSurfaces_{};
+  // Command ids folded into the surface update now at the batch index.
+  std::vector<std::pair<size_t, std::string>> foldedCommands_{};
+  std::vector<CommandOutcome> outcomes_{};
+  std::mutex outcomeSinkMutex_{};
+  CommandOutcomeSink outcomeSink_{};
+  CoalescingStats coalescing_{};
+  QualityGovernor quality_{};
+
+  mutable std::mutex statusMutex_{};
+  RendererStatus status_{};
+
+  // Filled by the MIDI thread, drained by update(). 1024 events is about a second of a
+  // controller sending at 1 kHz.
+  static constexpr size_t kMidiQueueCapacity = 1024;
+  SpscQueue<MidiEvent> midiQueue_{kMidiQueueCapacity};
+  MidiMap midiMap_{};
+  std::array<float, kMidiParameterCount> midiParameters_{1.0f, 1.0f};
+  MidiStats midiStats_{};
+
+  // Last cue table applied, shared with the snapshots written from it.
+  std::shared_ptr<const projection::core::CueTableMessage> cueTable_{};
+  std::unique_ptr<SceneSnapshotWriter> snapshotWriter_{};
+  int64_t snapshotIntervalMicros_{0};
+  std::optional<int64_t> lastSnapshotMicros_{};
+  uint64_t snapshotSceneGeneration_{0};
+  bool snapshotDirty_{false};
+  bool restoredFromSnapshot_{false};
+  // Restored state not yet confirmed by the server.
+  bool reconcileScene_{false};
+  bool reconcileCueTable_{false};
+
+  // Written by the audio thread, consumed block by block by audioAnalyzer_ (declared after
+  // the ring so its thread stops first).
+  static constexpr size_t kAudioRingCapacity = 8192;
+  SampleRingBuffer audioRing_{kAudioRingCapacity};
+  AudioAnalyzer audioAnalyzer_{audioRing_};
+  AudioFeatures audioFeatures_{};
+  float audioScale_{1.0f};
+
+  double elapsedSeconds_{0.0};
+  uint64_t frameCount_{0};
+  FrameStageTimings lastTimings_{};
+  uint64_t drawOrderGeneration_{0};
+  std::vector<size_t> drawOrder_{};
+  DrawList drawList_{};
+  // Drawable surfaces of this frame in draw order, with their (audio-scaled) scene bounds.
+  struct PreparedSurface {
+    size_t surfaceIndex;
+    SceneRect bounds;
+  };
+  std::vector<PreparedSurface> preparedSurfaces_{};
+  // audioScale_ at the MIDI-controlled audio depth, fixed for the frame by prepareSurfaces().
+  float surfaceScale_{1.0f};
+  std::vector<DrawList> outputDrawLists_{};
+};
+
+}  // namespace projection::renderer
@@ -0,0 +1,242 @@
+#include "SceneSnapshot.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+namespace projection::renderer {
+
+namespace {
+constexpr char kMagic[8] = {'L', 'U', 'M', 'I', 'S', 'N', 'A', 'P'};
+constexpr size_t kHeaderSize = 32;
+
+uint64_t fnv1a(const uint8_t* data, size_t size) {
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+void putLittleEndian(uint8_t* out, uint64_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+uint64_t getLittleEndian(const uint8_t* in, size_t bytes) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    value |= static_cast<uint64_t>(in[i]) << (8 * i);
+  }
+  return value;
+}
+
+std::string errnoMessage(const std::string& what, const std::string& path) {
+  return what + " '" + path + "': " + std::strerror(errno);
+}
+
+// Directory entry of `path`, so the rename itself is durable.
+void syncParentDirectory(const std::string& path) {
+  const auto slash = path.find_last_of('/');
+  const std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+  const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if (fd >= 0) {
+    ::fsync(fd);
+    ::close(fd);
+  }
+}
+}  // namespace
+
+std::vector<uint8_t> encodeSceneSnapshot(const SceneSnapshot& snapshot) {
+  nlohmann::json j = nlohmann::json::object();
+  if (snapshot.scene) {
+    j["scene"] = *snapshot.scene;
+  }
+  if (snapshot.cueTable) {
+    j["cueTable"] = *snapshot.cueTable;
+  }
+  const std::vector<uint8_t> payload = nlohmann::json::to_msgpack(j);
+
+  std::vector<uint8_t> bytes(kHeaderSize + payload.size());
+  std::memcpy(bytes.data(), kMagic, sizeof(kMagic));
+  putLittleEndian(bytes.data() + 8, kSceneSnapshotVersion, 4);
+  putLittleEndian(bytes.data() + 12, 0, 4);
+  putLittleEndian(bytes.data() + 16, payload.size(), 8);
+  putLittleEndian(bytes.data() + 24, fnv1a(payload.data(), payload.size()), 8);
+  std::memcpy(bytes.data() + kHeaderSize, payload.data(), payload.size());
+  return bytes;
+}
+
+bool decodeSceneSnapshot(const uint8_t* data, size_t size, SceneSnapshot& snapshot, std::string& error) {
+  if (size < kHeaderSize || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+    error = "not a scene snapshot";
+    return false;
+  }
+  const auto version = static_cast<uint32_t>(getLittleEndian(data + 8, 4));
+  if (version != kSceneSnapshotVersion) {
+    error = "unsupported scene snapshot version " + std::to_string(version);
+    return false;
+  }
+  const uint64_t payloadSize = getLittleEndian(data + 16, 8);
+  if (payloadSize != size - kHeaderSize) {
+    error = "scene snapshot is truncated";
+    return false;
+  }
+  const uint8_t* payload = data + kHeaderSize;
+  if (fnv1a(payload, payloadSize) != getLittleEndian(data + 24, 8)) {
+    error = "scene snapshot checksum mismatch";
+    return false;
+  }
+  try {
+    const auto j = nlohmann::json::from_msgpack(payload, payload + payloadSize);
+    SceneSnapshot decoded;
+    if (j.contains("scene")) {
+      decoded.scene = j.at("scene").get<projection::core::LoadSceneDefinitionMessage>();
+    }
+    if (j.contains("cueTable")) {
+      auto cueTable = j.at("cueTable").get<projection::core::CueTableMessage>();
+      decoded.cueTable = std::make_shared<const projection::core::CueTableMessage>(std::move(cueTable));
+    }
+    snapshot = std::move(decoded);
+  } catch (const std::exception& ex) {
+    error = std::string("invalid scene snapshot payload: ") + ex.what();
+    return false;
+  }
+  return true;
+}
+
+bool writeFileAtomically(const std::string& path, const std::vector<uint8_t>& bytes, std::string& error) {
+  const std::string temporary = path + ".tmp";
+  const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    error = errnoMessage("cannot create", temporary);
+    return false;
+  }
+  size_t written = 0;
+  while (written < bytes.size()) {
+    const ssize_t result = ::write(fd, bytes.data() + written, bytes.size() - written);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      error = errnoMessage("cannot write", temporary);
+      ::close(fd);
+      ::unlink(temporary.c_str());
+      return false;
+    }
+    written += static_cast<size_t>(result);
+  }
+  if (::fsync(fd) != 0) {
+    error = errnoMessage("cannot sync", temporary);
+    ::close(fd);
+    ::unlink(temporary.c_str());
+    return false;
+  }
+  ::close(fd);
+  if (::rename(temporary.c_str(), path.c_str()) != 0) {
+    error = errnoMessage("cannot replace", path);
+    ::unlink(temporary.c_str());
+    return false;
+  }
+  syncParentDirectory(path);
+  return true;
+}
+
+bool readSceneSnapshotFile(const std::string& path, SceneSnapshot& snapshot, std::string& error) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    error = "cannot open '" + path + "'";
+    return false;
+  }
+  const std::vector<uint8_t> bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  if (!decodeSceneSnapshot(bytes.data(), bytes.size(), snapshot, error)) {
+    error = "'" + path + "': " + error;
+    return false;
+  }
+  return true;
+}
+
+SceneSnapshotWriter::SceneSnapshotWriter(std::string path) : path_(std::move(path)) {
+  thread_ = std::thread([this]() { run(); });
+}
+
+SceneSnapshotWriter::~SceneSnapshotWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+}
+
+void SceneSnapshotWriter::submit(SceneSnapshot snapshot) {
+  auto next = std::make_unique<SceneSnapshot>(std::move(snapshot));
+  std::unique_ptr<SceneSnapshot> replaced;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.submitted;
+    if (pending_) {
+      ++stats_.superseded;
+    }
+    // The replaced snapshot is freed outside the lock (and the writer never waits on it).
+    replaced = std::exchange(pending_, std::move(next));
+  }
+  wake_.notify_one();
+}
+
+void SceneSnapshotWriter::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this]() { return !pending_ && !writing_; });
+}
+
+SceneSnapshotWriterStats SceneSnapshotWriter::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void SceneSnapshotWriter::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [this]() { return pending_ || stopping_; });
+    if (!pending_) {
+      return;
+    }
+    std::unique_ptr<SceneSnapshot> snapshot = std::move(pending_);
+    writing_ = true;
+    lock.unlock();
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto bytes = encodeSceneSnapshot(*snapshot);
+    std::string error;
+    const bool ok = writeFileAtomically(path_, bytes, error);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    snapshot.reset();
+
+    lock.lock();
+    writing_ = false;
+    if (ok) {
+      ++stats_.written;
+      stats_.lastBytes = bytes.size();
+      stats_.lastWriteMs = ms;
+    } else {
+      ++stats_.failed;
+      stats_.lastError = error;
+    }
+    if (!pending_) {
+      idle_.notify_all();
+    }
+  }
+}
+
+}  // namespace projection::renderer
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <projection/core/RendererProtocol.h>
+
+namespace projection::renderer {
+
+// What a renderer needs to come back up showing what it showed before a restart: the last
+// applied scene with its feeds, and the cached cue table (with its project settings). The
+// cue table only changes when a new one arrives, so snapshots share it instead of copying.
+struct SceneSnapshot {
+  std::optional<projection::core::LoadSceneDefinitionMessage> scene;
+  std::shared_ptr<const projection::core::CueTableMessage> cueTable;
+
+  bool empty() const { return !scene && !cueTable; }
+};
+
+// On-disk layout: a 32-byte header (magic "LUMISNAP", format version, payload size and an
+// FNV-1a checksum of the payload, little-endian) followed by the snapshot as MessagePack.
+// MessagePack keeps the protocol's JSON shape, so the format follows the message structs
+// without a second schema, at a fraction of the size and parse time of text JSON.
+constexpr uint32_t kSceneSnapshotVersion = 1;
+
+std::vector<uint8_t> encodeSceneSnapshot(const SceneSnapshot& snapshot);
+// False with a message for a wrong magic, unknown version, truncated payload, checksum
+// mismatch or an undecodable payload; `snapshot` is only assigned on success.
+bool decodeSceneSnapshot(const uint8_t* data, size_t size, SceneSnapshot& snapshot, std::string& error);
+
+// Writes `bytes` to path + ".tmp", flushes it to disk and renames it over `path`, so a crash
+// or power cut leaves either the previous file or the new one, never a torn mix.
+bool writeFileAtomically(const std::string& path, const std::vector<uint8_t>& bytes, std::string& error);
+bool readSceneSnapshotFile(const std::string& path, SceneSnapshot& snapshot, std::string& error);
+
+struct SceneSnapshotWriterStats {
+  uint64_t submitted{0};
+  uint64_t written{0};
+  // Submissions replaced by a newer one before the writer got to them.
+  uint64_t superseded{0};
+  uint64_t failed{0};
+  size_t lastBytes{0};
+  double lastWriteMs{0.0};
+  std::string lastError{};
+};
+
+// Persists snapshots on its own thread. submit() only moves the snapshot into a single
+// pending slot (a newer submission replaces an unwritten one), so the render thread never
+// encodes or touches the disk. The destructor writes whatever is still pending.
+class SceneSnapshotWriter {
+ public:
+  explicit SceneSnapshotWriter(std::string path);
+  ~SceneSnapshotWriter();
+
+  SceneSnapshotWriter(const SceneSnapshotWriter&) = delete;
+  SceneSnapshotWriter& operator=(const SceneSnapshotWriter&) = delete;
+
+  const std::string& path() const { return path_; }
+  void submit(SceneSnapshot snapshot);
+  // Blocks until every submitted snapshot has been written (or has failed).
+  void flush();
+  SceneSnapshotWriterStats stats() const;
+
+ private:
+  void run();
+
+  std::string path_;
+  mutable std::mutex mutex_{};
+  std::condition_variable wake_{};
+  std::condition_variable idle_{};
+  std::unique_ptr<SceneSnapshot> pending_{};
+  bool writing_{false};
+  bool stopping_{false};
+  SceneSnapshotWriterStats stats_{};
+  std::thread thread_{};
+};
+
+}  // namespace projection::renderer
@@ -0,0 +1,160 @@
+#include "audio/AudioAnalyzer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace projection::renderer {
+
+namespace {
+constexpr double kTwoPi = 6.283185307179586;
+// Crossover frequencies between the bands, in Hz.
+constexpr double kCrossovers[AudioFeatures::kBands - 1] = {200.0, 1000.0, 4000.0};
+
+// Per-step coefficient of a one-pole filter / exponential average with the given time constant.
+float timeConstantCoefficient(double stepSeconds, double timeConstantSeconds) {
+  if (timeConstantSeconds <= 0.0) {
+    return 1.0f;
+  }
+  return static_cast<float>(1.0 - std::exp(-stepSeconds / timeConstantSeconds));
+}
+}  // namespace
+
+AudioAnalyzer::AudioAnalyzer(SampleRingBuffer& ring, AudioAnalyzerOptions options) : ring_(ring) {
+  setOptions(options);
+}
+
+AudioAnalyzer::~AudioAnalyzer() { stop(); }
+
+void AudioAnalyzer::setOptions(const AudioAnalyzerOptions& options) {
+  options_ = options;
+  options_.sampleRate = options_.sampleRate > 0.0 ? options_.sampleRate : 44100.0;
+  options_.blockSize = std::max<size_t>(1, options_.blockSize);
+  reset();
+}
+
+void AudioAnalyzer::reset() {
+  block_.assign(options_.blockSize, 0.0f);
+  blockFill_ = 0;
+  for (size_t i = 0; i < crossoverCoefficients_.size(); ++i) {
+    const double cutoff = std::min(kCrossovers[i], options_.sampleRate * 0.45);
+    crossoverCoefficients_[i] = static_cast<float>(1.0 - std::exp(-kTwoPi * cutoff / options_.sampleRate));
+  }
+  lowpass_.fill(0.0f);
+  const double blockSeconds = static_cast<double>(options_.blockSize) / options_.sampleRate;
+  smoothingCoefficient_ = timeConstantCoefficient(blockSeconds, options_.smoothingSeconds);
+  averageCoefficient_ = timeConstantCoefficient(blockSeconds, options_.onsetAverageSeconds);
+  holdBlocks_ = static_cast<uint64_t>(std::ceil(options_.onsetHoldSeconds / blockSeconds));
+  averageEnergy_.fill(0.0f);
+  lastOnsetBlock_.fill(0);
+  armed_.fill(true);
+  current_ = AudioFeatures{};
+  published_.store(current_);
+}
+
+void AudioAnalyzer::start() {
+  if (running()) {
+    return;
+  }
+  stopRequested_ = false;
+  thread_ = std::thread([this]() { run(); });
+}
+
+void AudioAnalyzer::stop() {
+  if (!running()) {
+    return;
+  }
+  stopRequested_ = true;
+  thread_.join();
+}
+
+void AudioAnalyzer::run() {
+  // The audio callback must not block, so it cannot wake this thread; poll at half a block.
+  const auto idle = std::chrono::microseconds(
+      static_cast<int64_t>(static_cast<double>(options_.blockSize) / options_.sampleRate * 0.5e6));
+  while (!stopRequested_.load(std::memory_order_relaxed)) {
+    if (pump() == 0) {
+      std::this_thread::sleep_for(idle);
+    }
+  }
+}
+
+size_t AudioAnalyzer::pump() {
+  size_t analysed = 0;
+  while (true) {
+    blockFill_ += ring_.read(block_.data() + blockFill_, block_.size() - blockFill_);
+    if (blockFill_ < block_.size()) {
+      return analysed;
+    }
+    analyzeBlock(block_.data(), block_.size());
+    blockFill_ = 0;
+    ++analysed;
+  }
+}
+
+void AudioAnalyzer::analyzeBlock(const float* samples, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  // One-pole low-passes at each crossover; band i is the difference of neighbouring
+  // low-passes, so the bands sum back to the input exactly.
+  std::array<float, AudioFeatures::kBands> bandSum{};
+  float energySum = 0.0f;
+  float peak = 0.0f;
+  for (size_t n = 0; n < count; ++n) {
+    const float x = samples[n];
+    energySum += x * x;
+    peak = std::max(peak, std::fabs(x));
+    float lower = 0.0f;
+    for (size_t i = 0; i < lowpass_.size(); ++i) {
+      lowpass_[i] += crossoverCoefficients_[i] * (x - lowpass_[i]);
+      const float band = lowpass_[i] - lower;
+      bandSum[i] += band * band;
+      lower = lowpass_[i];
+    }
+    const float top = x - lower;
+    bandSum[AudioFeatures::kBands - 1] += top * top;
+  }
+
+  const float invCount = 1.0f / static_cast<float>(count);
+  ++current_.blocks;
+  current_.samples += count;
+  current_.energy = energySum * invCount;
+  current_.peak = peak;
+  current_.smoothedEnergy += smoothingCoefficient_ * (current_.energy - current_.smoothedEnergy);
+  for (size_t i = 0; i < AudioFeatures::kBands; ++i) {
+    current_.bandEnergy[i] = bandSum[i] * invCount;
+  }
+
+  // Index 0 is the whole signal, 1.. the bands. Detection is edge-triggered: after an onset
+  // the index re-arms only once its energy has fallen back under the threshold, so a sustained
+  // level never fires again while the running average catches up with it.
+  const auto detect = [&](size_t index, float energy) {
+    const bool above = energy > options_.onsetFloor && energy > averageEnergy_[index] * options_.onsetRatio;
+    const bool held = lastOnsetBlock_[index] != 0 && current_.blocks - lastOnsetBlock_[index] < holdBlocks_;
+    const bool onset = above && armed_[index] && !held;
+    averageEnergy_[index] += averageCoefficient_ * (energy - averageEnergy_[index]);
+    if (onset) {
+      lastOnsetBlock_[index] = current_.blocks;
+      armed_[index] = false;
+    } else if (!above) {
+      armed_[index] = true;
+    }
+    return onset;
+  };
+  current_.onset = detect(0, current_.energy);
+  if (current_.onset) {
+    ++current_.onsetCount;
+  }
+  current_.bandOnsets = 0;
+  for (size_t i = 0; i < AudioFeatures::kBands; ++i) {
+    if (detect(i + 1, current_.bandEnergy[i])) {
+      current_.bandOnsets |= 1u << i;
+      ++current_.bandOnsetCounts[i];
+    }
+  }
+
+  published_.store(current_);
+}
+
+}  // namespace projection::renderer
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "audio/SampleRingBuffer.h"
+#include "util/Seqlock.h"
+
+namespace projection::renderer {
+
+// Compact per-block audio features, published as one snapshot.
+struct AudioFeatures {
+  // Crossover bands: < 200 Hz, 200 Hz - 1 kHz, 1 - 4 kHz, > 4 kHz.
+  static constexpr size_t kBands = 4;
+
+  // Blocks analysed so far; 0 until the first block arrives.
+  uint64_t blocks{0};
+  uint64_t samples{0};
+  // Mean square and peak of the last block, and the mean square smoothed over time.
+  float energy{0.0f};
+  float smoothedEnergy{0.0f};
+  float peak{0.0f};
+  std::array<float, kBands> bandEnergy{};
+  // Onsets (energy jumping well above its recent average) in the last block: `onset` for the
+  // whole signal, bit i of `bandOnsets` for band i. The counters only grow, so a reader that
+  // samples less often than blocks arrive detects onsets by comparing them.
+  bool onset{false};
+  uint32_t bandOnsets{0};
+  uint64_t onsetCount{0};
+  std::array<uint32_t, kBands> bandOnsetCounts{};
+};
+
+struct AudioAnalyzerOptions {
+  double sampleRate{44100.0};
+  // Samples per analysis block (about 5.8 ms at 44.1 kHz).
+  size_t blockSize{256};
+  // Time constant of smoothedEnergy.
+  double smoothingSeconds{0.15};
+  // An onset is a block whose energy rises above onsetRatio times the band's running average
+  // (time constant onsetAverageSeconds) and onsetFloor, at most once per onsetHoldSeconds and
+  // only after the energy has dropped below that threshold again since the previous onset.
+  double onsetAverageSeconds{0.5};
+  float onsetRatio{2.0f};
+  float onsetFloor{1e-4f};
+  double onsetHoldSeconds{0.1};
+};
+
+// Turns the mono samples in a SampleRingBuffer into AudioFeatures, block by block, and
+// publishes each result through a seqlock. Runs on its own thread (start/stop) so analysis
+// never lands in the frame budget; without the thread, pump() does the same work inline.
+// Readers on any thread get the newest snapshot in constant time without locks.
+class AudioAnalyzer {
+ public:
+  explicit AudioAnalyzer(SampleRingBuffer& ring, AudioAnalyzerOptions options = {});
+  ~AudioAnalyzer();
+
+  AudioAnalyzer(const AudioAnalyzer&) = delete;
+  AudioAnalyzer& operator=(const AudioAnalyzer&) = delete;
+
+  // Only while the thread is stopped; resets the analysis state.
+  void setOptions(const AudioAnalyzerOptions& options);
+  const AudioAnalyzerOptions& options() const { return options_; }
+
+  void start();
+  void stop();
+  bool running() const { return thread_.joinable(); }
+
+  // Analyses every complete block waiting in the ring (the thread's loop body); returns the
+  // number of blocks. Call directly only while the thread is stopped.
+  size_t pump();
+  // Analyses one block of mono samples and publishes the result. Same threading rule as pump().
+  void analyzeBlock(const float* samples, size_t count);
+
+  // Any thread: copies the newest snapshot into `out`; false while a publish is in progress.
+  bool tryRead(AudioFeatures& out) const { return published_.tryLoad(out); }
+  AudioFeatures read() const { return published_.load(); }
+
+ private:
+  void run();
+  void reset();
+
+  SampleRingBuffer& ring_;
+  AudioAnalyzerOptions options_;
+  std::thread thread_{};
+  std::atomic<bool> stopRequested_{false};
+
+  // Analysis state; owned by whichever thread is analysing.
+  std::vector<float> block_{};
+  size_t blockFill_{0};
+  std::array<float, AudioFeatures::kBands - 1> crossoverCoefficients_{};
+  std::array<float, AudioFeatures::kBands - 1> lowpass_{};
+  float smoothingCoefficient_{0.0f};
+  float averageCoefficient_{0.0f};
+  // Running averages for onset detection: the whole signal, then each band.
+  std::array<float, AudioFeatures::kBands + 1> averageEnergy_{};
+  std::array<uint64_t, AudioFeatures::kBands + 1> lastOnsetBlock_{};
+  std::array<bool, AudioFeatures::kBands + 1> armed_{};
+  uint64_t holdBlocks_{0};
+  AudioFeatures current_{};
+
+  Seqlock<AudioFeatures> published_{};
+};
+
+}  // namespace projection::renderer
@@ -0,0 +1,116 @@
+#include "audio/SampleRingBuffer.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace projection::renderer {
+namespace {
+size_t roundUpToPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+}  // namespace
+
+SampleRingBuffer::SampleRingBuffer(size_t capacity)
+    : capacity_(roundUpToPowerOfTwo(std::max<size_t>(capacity, 2))),
+      mask_(capacity_ - 1),
+      samples_(std::make_unique<std::atomic<float>[]>(capacity_)) {
+  for (size_t i = 0; i < capacity_; ++i) {
+    samples_[i].store(0.0f, std::memory_order_relaxed);
+  }
+}
+
+void SampleRingBuffer::writeInterleaved(const float* samples, size_t frames, size_t channels) {
+  if (channels <= 1) {
+    write(samples, frames);
+    return;
+  }
+
+  const float scale = 1.0f / static_cast<float>(channels);
+  uint64_t index = writeIndex_.load(std::memory_order_relaxed);
+  reserveIndex_.store(index + frames, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t frame = 0; frame < frames; ++frame) {
+    const float* first = samples + frame * channels;
+    float sum = 0.0f;
+    for (size_t channel = 0; channel < channels; ++channel) {
+      sum += first[channel];
+    }
+    samples_[index & mask_].store(sum * scale, std::memory_order_relaxed);
+    ++index;
+  }
+  writeIndex_.store(index, std::memory_order_release);
+}
+
+void SampleRingBuffer::write(const float* mono, size_t count) {
+  uint64_t index = writeIndex_.load(std::memory_order_relaxed);
+  reserveIndex_.store(index + count, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < count; ++i) {
+    samples_[index & mask_].store(mono[i], std::memory_order_relaxed);
+    ++index;
+  }
+  writeIndex_.store(index, std::memory_order_release);
+}
+
+size_t SampleRingBuffer::readLatest(float* out, size_t count) const {
+  const uint64_t end = writeIndex_.load(std::memory_order_acquire);
+  const uint64_t available = std::min<uint64_t>(end, capacity_);
+  const size_t wanted = static_cast<size_t>(std::min<uint64_t>(count, available));
+  const uint64_t start = end - wanted;
+  copyOut(start, wanted, out);
+
+  // Drop samples the writer lapped while we were copying; keep the result contiguous.
+  const uint64_t valid = firstValidIndex(start);
+  if (valid <= start) {
+    return wanted;
+  }
+  const size_t skipped = static_cast<size_t>(std::min<uint64_t>(valid - start, wanted));
+  std::copy(out + skipped, out + wanted, out);
+  return wanted - skipped;
+}
+
+size_t SampleRingBuffer::read(float* out, size_t maxCount) {
+  const uint64_t end = writeIndex_.load(std::memory_order_acquire);
+  if (end - readIndex_ > capacity_) {
+    const uint64_t lost = end - capacity_ - readIndex_;
+    overrunSamples_.fetch_add(lost, std::memory_order_relaxed);
+    readIndex_ = end - capacity_;
+  }
+
+  size_t count = static_cast<size_t>(std::min<uint64_t>(maxCount, end - readIndex_));
+  copyOut(readIndex_, count, out);
+
+  const uint64_t valid = firstValidIndex(readIndex_);
+  if (valid > readIndex_) {
+    const size_t skipped = static_cast<size_t>(std::min<uint64_t>(valid - readIndex_, count));
+    overrunSamples_.fetch_add(skipped, std::memory_order_relaxed);
+    std::copy(out + skipped, out + count, out);
+    count -= skipped;
+    readIndex_ += skipped;
+  }
+  readIndex_ += count;
+  return count;
+}
+
+uint64_t SampleRingBuffer::firstValidIndex(uint64_t start) const {
+  // Any slot below reserved - capacity may have been reused by a batch that started while
+  // we were copying; everything after that is intact.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint64_t reserved = reserveIndex_.load(std::memory_order_relaxed);
+  if (reserved <= capacity_) {
+    return start;
+  }
+  return std::max(start, reserved - capacity_);
+}
+
+void SampleRingBuffer::copyOut(uint64_t start, size_t count, float* out) const {
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = samples_[(start + i) & mask_].load(std::memory_order_relaxed);
+  }
+}
+
+}  // namespace projection::renderer
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace projection::renderer {
+
+// Preallocated lock-free ring of mono audio samples.
+//
+// A single writer (the audio callback) appends samples and never allocates, locks or
+// waits; when the ring is full the oldest samples are overwritten. Readers either peek at
+// the most recent window (readLatest) or consume samples in order through a single reader
+// cursor (read). Capacity is rounded up to the next power of two.
+class SampleRingBuffer {
+ public:
+  explicit SampleRingBuffer(size_t capacity);
+
+  SampleRingBuffer(const SampleRingBuffer&) = delete;
+  SampleRingBuffer& operator=(const SampleRingBuffer&) = delete;
+
+  // Writer side: averages the channels of each interleaved frame down to one sample.
+  void writeInterleaved(const float* samples, size_t frames, size_t channels);
+  void write(const float* mono, size_t count);
+
+  // Copies the newest `count` samples (oldest first) into out. Returns the number copied,
+  // which is smaller than count while the ring has not yet seen that many samples.
+  size_t readLatest(float* out, size_t count) const;
+
+  // Single consumer: copies up to maxCount samples that this cursor has not seen yet.
+  // Samples overwritten before they could be read are skipped and counted as overruns.
+  size_t read(float* out, size_t maxCount);
+
+  size_t capacity() const { return capacity_; }
+  uint64_t totalWritten() const { return writeIndex_.load(std::memory_order_acquire); }
+  uint64_t overrunSamples() const { return overrunSamples_.load(std::memory_order_relaxed); }
+
+ private:
+  // First index at or after start whose slot the writer cannot have overwritten yet.
+  uint64_t firstValidIndex(uint64_t start) const;
+  void copyOut(uint64_t start, size_t count, float* out) const;
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<std::atomic<float>[]> samples_;
+  // The writer announces the end of the batch it is about to store (reserveIndex_) before
+  // touching any slot, and publishes it via writeIndex_ once the batch is complete.
+  std::atomic<uint64_t> reserveIndex_{0};
+  std::atomic<uint64_t> writeIndex_{0};
+  uint64_t readIndex_{0};
+  std::atomic<uint64_t> overrunSamples_{0};
+};
+
+}  // namespace projection::renderer
@@ -0,0 +1,179 @@
+#include "compositor/BlendKernels.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PROJECTION_BLEND_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PROJECTION_BLEND_NEON 1
+#endif
+
+namespace projection::renderer {
+
+using projection::core::BlendMode;
+
+namespace {
+// Exact round(x / 255) for x in [0, 255 * 255].
+inline uint32_t div255(uint32_t x) {
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+inline uint8_t saturate(uint32_t x) { return static_cast<uint8_t>(std::min<uint32_t>(x, 255)); }
+
+void blendScalar(BlendMode mode, uint8_t* dst, const uint8_t* src, size_t count, uint8_t brightness, uint8_t alpha) {
+  for (size_t i = 0; i < count; ++i, dst += 4, src += 4) {
+    const uint32_t sa = div255(src[3] * uint32_t{alpha});
+    const uint32_t inv = 255 - sa;
+    uint32_t s[4] = {div255(src[0] * uint32_t{brightness}), div255(src[1] * uint32_t{brightness}),
+                     div255(src[2] * uint32_t{brightness}), sa};
+    // Color channels are weighted by source alpha; the alpha channel by one.
+    const uint32_t weight[4] = {sa, sa, sa, 255};
+    for (int c = 0; c < 4; ++c) {
+      const uint32_t d = dst[c];
+      switch (mode) {
+        case BlendMode::Normal:
+          dst[c] = static_cast<uint8_t>(div255(s[c] * weight[c] + d * inv));
+          break;
+        case BlendMode::Additive:
+          dst[c] = saturate(d + div255(s[c] * weight[c]));
+          break;
+        case BlendMode::Multiply:
+          dst[c] = saturate(div255(s[c] * d) + div255(d * inv));
+          break;
+      }
+    }
+  }
+}
+
+#if defined(PROJECTION_BLEND_SSE2)
+// Eight 16-bit lanes hold two RGBA pixels.
+inline __m128i div255x8(__m128i x) {
+  x = _mm_add_epi16(x, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+inline __m128i broadcastAlpha(__m128i px) {
+  return _mm_shufflehi_epi16(_mm_shufflelo_epi16(px, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+inline __m128i blendPair(BlendMode mode, __m128i s, __m128i d, __m128i modulation, __m128i alphaLanes) {
+  const __m128i v255 = _mm_set1_epi16(255);
+  s = div255x8(_mm_mullo_epi16(s, modulation));
+  const __m128i sa = broadcastAlpha(s);
+  const __m128i inv = _mm_sub_epi16(v255, sa);
+  const __m128i weight = _mm_or_si128(_mm_andnot_si128(alphaLanes, sa), _mm_and_si128(alphaLanes, v255));
+  switch (mode) {
+    case BlendMode::Normal:
+      return div255x8(_mm_add_epi16(_mm_mullo_epi16(s, weight), _mm_mullo_epi16(d, inv)));
+    case BlendMode::Additive:
+      // Saturation happens when the caller packs with adds_epu8; return the addend only.
+      return div255x8(_mm_mullo_epi16(s, weight));
+    case BlendMode::Multiply:
+      return _mm_add_epi16(div255x8(_mm_mullo_epi16(s, d)), div255x8(_mm_mullo_epi16(d, inv)));
+  }
+  return d;
+}
+
+size_t blendSse2(BlendMode mode, uint8_t* dst, const uint8_t* src, size_t count, uint8_t brightness, uint8_t alpha) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i modulation = _mm_setr_epi16(brightness, brightness, brightness, alpha, brightness, brightness,
+                                            brightness, alpha);
+  const __m128i alphaLanes = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128i s8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+    const __m128i d8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+    const __m128i lo = blendPair(mode, _mm_unpacklo_epi8(s8, zero), _mm_unpacklo_epi8(d8, zero), modulation,
+                                 alphaLanes);
+    const __m128i hi = blendPair(mode, _mm_unpackhi_epi8(s8, zero), _mm_unpackhi_epi8(d8, zero), modulation,
+                                 alphaLanes);
+    __m128i out = _mm_packus_epi16(lo, hi);
+    if (mode == BlendMode::Additive) {
+      out = _mm_adds_epu8(d8, out);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), out);
+  }
+  return i;
+}
+#elif defined(PROJECTION_BLEND_NEON)
+inline uint16x8_t div255x8(uint16x8_t x) {
+  x = vaddq_u16(x, vdupq_n_u16(128));
+  return vshrq_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+}
+
+inline uint16x8_t broadcastAlpha(uint16x8_t px) {
+  // Byte indices of the two alpha lanes (little endian), repeated across each pixel.
+  static const uint8_t kIndices[16] = {6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15};
+  return vreinterpretq_u16_u8(vqtbl1q_u8(vreinterpretq_u8_u16(px), vld1q_u8(kIndices)));
+}
+
+inline uint16x8_t blendPair(BlendMode mode, uint16x8_t s, uint16x8_t d, uint16x8_t modulation,
+                            uint16x8_t alphaLanes) {
+  const uint16x8_t v255 = vdupq_n_u16(255);
+  s = div255x8(vmulq_u16(s, modulation));
+  const uint16x8_t sa = broadcastAlpha(s);
+  const uint16x8_t inv = vsubq_u16(v255, sa);
+  const uint16x8_t weight = vbslq_u16(alphaLanes, v255, sa);
+  switch (mode) {
+    case BlendMode::Normal:
+      return div255x8(vaddq_u16(vmulq_u16(s, weight), vmulq_u16(d, inv)));
+    case BlendMode::Additive:
+      return div255x8(vmulq_u16(s, weight));
+    case BlendMode::Multiply:
+      return vaddq_u16(div255x8(vmulq_u16(s, d)), div255x8(vmulq_u16(d, inv)));
+  }
+  return d;
+}
+
+size_t blendNeon(BlendMode mode, uint8_t* dst, const uint8_t* src, size_t count, uint8_t brightness, uint8_t alpha) {
+  const uint16_t modulationValues[8] = {brightness, brightness, brightness, alpha,
+                                        brightness, brightness, brightness, alpha};
+  static const uint16_t kAlphaLanes[8] = {0, 0, 0, 0xFFFF, 0, 0, 0, 0xFFFF};
+  const uint16x8_t modulation = vld1q_u16(modulationValues);
+  const uint16x8_t alphaLanes = vld1q_u16(kAlphaLanes);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const uint8x16_t s8 = vld1q_u8(src + i * 4);
+    const uint8x16_t d8 = vld1q_u8(dst + i * 4);
+    const uint16x8_t lo =
+        blendPair(mode, vmovl_u8(vget_low_u8(s8)), vmovl_u8(vget_low_u8(d8)), modulation, alphaLanes);
+    const uint16x8_t hi =
+        blendPair(mode, vmovl_u8(vget_high_u8(s8)), vmovl_u8(vget_high_u8(d8)), modulation, alphaLanes);
+    uint8x16_t out = vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi));
+    if (mode == BlendMode::Additive) {
+      out = vqaddq_u8(d8, out);
+    }
+    vst1q_u8(dst + i * 4, out);
+  }
+  return i;
+}
+#endif
+}  // namespace
+
+void blendSpan(BlendMode mode, uint8_t* dst, const uint8_t* src, size_t count, uint8_t brightness, uint8_t alpha,
+               bool useSimd) {
+  size_t done = 0;
+  if (useSimd) {
+#if defined(PROJECTION_BLEND_SSE2)
+    done = blendSse2(mode, dst, src, count, brightness, alpha);
+#elif defined(PROJECTION_BLEND_NEON)
+    done = blendNeon(mode, dst, src, count, brightness, alpha);
+#endif
+  }
+  blendScalar(mode, dst + done * 4, src + done * 4, count - done, brightness, alpha);
+}
+
+const char* blendSimdBackend() {
+#if defined(PROJECTION_BLEND_SSE2)
+  return "sse2";
+#elif defined(PROJECTION_BLEND_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
+
+}  // namespace projection::renderer
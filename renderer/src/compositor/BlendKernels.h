@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <projection/core/Enums.h>
+
+namespace projection::renderer {
+
+// Blends `count` straight-alpha RGBA8 source pixels into `dst`, matching the fixed-function
+// blend state the windowed renderer uses for each BlendMode:
+//   Normal   (SRC_ALPHA, ONE_MINUS_SRC_ALPHA)  dst = src * a + dst * (1 - a), alpha = a + dstA * (1 - a)
+//   Additive (SRC_ALPHA, ONE)                  dst = dst + src * a,           alpha = dstA + a
+//   Multiply (DST_COLOR, ONE_MINUS_SRC_ALPHA)  dst = src * dst + dst * (1 - a)
+// Source color is first scaled by `brightness` and source alpha by `alpha` (both 0..255).
+// Results are saturated to 0..255 and rounded identically on every code path, so the
+// SIMD and scalar kernels are bit-exact with each other.
+void blendSpan(projection::core::BlendMode mode, uint8_t* dst, const uint8_t* src, size_t count, uint8_t brightness,
+               uint8_t alpha, bool useSimd = true);
+
+// Name of the vector instruction set blendSpan uses when useSimd is true ("sse2", "neon" or "scalar").
+const char* blendSimdBackend();
+
+}  // namespace projection::renderer
@@ -0,0 +1,377 @@
+#include "compositor/EdgeBlend.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PROJECTION_EDGE_BLEND_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PROJECTION_EDGE_BLEND_NEON 1
+#endif
+
+namespace projection::renderer {
+
+namespace {
+// Exact round(x / 255) for x in [0, 255 * 255], as in the blend kernels.
+inline uint32_t div255(uint32_t x) {
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+// dst[i] = round(src[i] * scale), saturated to 0..255; returns how many were written.
+size_t expandRowScalar(const float* src, float scale, uint8_t* dst, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = static_cast<uint8_t>(std::min(255, static_cast<int>(src[i] * scale + 0.5f)));
+  }
+  return count;
+}
+
+void applyScalar(uint8_t* px, const uint8_t* gain, const uint8_t* lift, size_t count) {
+  for (size_t i = 0; i < count; ++i, px += 4) {
+    for (int c = 0; c < 3; ++c) {
+      px[c] = static_cast<uint8_t>(std::min<uint32_t>(255, lift[i] + div255(px[c] * uint32_t{gain[i]})));
+    }
+  }
+}
+
+#if defined(PROJECTION_EDGE_BLEND_SSE2)
+size_t expandRowSse2(const float* src, float scale, uint8_t* dst, size_t count) {
+  const __m128 factor = _mm_set1_ps(scale);
+  const __m128 half = _mm_set1_ps(0.5f);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m128i a = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + i), factor), half));
+    const __m128i b = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), factor), half));
+    const __m128i c = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 8), factor), half));
+    const __m128i d = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 12), factor), half));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+  }
+  return i;
+}
+
+inline __m128i div255x8(__m128i x) {
+  x = _mm_add_epi16(x, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Four plane bytes spread over the four channels of four pixels.
+inline __m128i spreadToPixels(const uint8_t* plane) {
+  uint32_t packed;
+  std::memcpy(&packed, plane, sizeof(packed));
+  __m128i v = _mm_cvtsi32_si128(static_cast<int>(packed));
+  v = _mm_unpacklo_epi8(v, v);
+  return _mm_unpacklo_epi16(v, v);
+}
+
+size_t applySse2(uint8_t* px, const uint8_t* gain, const uint8_t* lift, size_t count) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i alphaBytes = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    // Alpha is multiplied by 255 (exact) and lifted by 0, so it passes through unchanged.
+    const __m128i g = _mm_or_si128(spreadToPixels(gain + i), alphaBytes);
+    const __m128i l = _mm_andnot_si128(alphaBytes, spreadToPixels(lift + i));
+    const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px + i * 4));
+    const __m128i lo = div255x8(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), _mm_unpacklo_epi8(g, zero)));
+    const __m128i hi = div255x8(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), _mm_unpackhi_epi8(g, zero)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(px + i * 4), _mm_adds_epu8(_mm_packus_epi16(lo, hi), l));
+  }
+  return i;
+}
+#elif defined(PROJECTION_EDGE_BLEND_NEON)
+size_t expandRowNeon(const float* src, float scale, uint8_t* dst, size_t count) {
+  const float32x4_t factor = vdupq_n_f32(scale);
+  const float32x4_t half = vdupq_n_f32(0.5f);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    uint16x4_t parts[4];
+    for (int k = 0; k < 4; ++k) {
+      const float32x4_t v = vaddq_f32(vmulq_f32(vld1q_f32(src + i + 4 * k), factor), half);
+      parts[k] = vqmovn_u32(vcvtq_u32_f32(v));
+    }
+    const uint8x8_t lo = vqmovn_u16(vcombine_u16(parts[0], parts[1]));
+    const uint8x8_t hi = vqmovn_u16(vcombine_u16(parts[2], parts[3]));
+    vst1q_u8(dst + i, vcombine_u8(lo, hi));
+  }
+  return i;
+}
+
+inline uint16x8_t div255x8(uint16x8_t x) {
+  x = vaddq_u16(x, vdupq_n_u16(128));
+  return vshrq_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+}
+
+inline uint8x16_t spreadToPixels(const uint8_t* plane) {
+  static const uint8_t kIndices[16] = {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3};
+  uint32_t packed;
+  std::memcpy(&packed, plane, sizeof(packed));
+  return vqtbl1q_u8(vreinterpretq_u8_u32(vdupq_n_u32(packed)), vld1q_u8(kIndices));
+}
+
+size_t applyNeon(uint8_t* px, const uint8_t* gain, const uint8_t* lift, size_t count) {
+  const uint8x16_t alphaBytes = vreinterpretq_u8_u32(vdupq_n_u32(0xFF000000u));
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const uint8x16_t g = vorrq_u8(spreadToPixels(gain + i), alphaBytes);
+    const uint8x16_t l = vbicq_u8(spreadToPixels(lift + i), alphaBytes);
+    const uint8x16_t p = vld1q_u8(px + i * 4);
+    const uint16x8_t lo = div255x8(vmull_u8(vget_low_u8(p), vget_low_u8(g)));
+    const uint16x8_t hi = div255x8(vmull_u8(vget_high_u8(p), vget_high_u8(g)));
+    vst1q_u8(px + i * 4, vqaddq_u8(vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi)), l));
+  }
+  return i;
+}
+#endif
+
+size_t expandRow(const float* src, float scale, uint8_t* dst, size_t count, bool useSimd) {
+  size_t done = 0;
+  if (useSimd) {
+#if defined(PROJECTION_EDGE_BLEND_SSE2)
+    done = expandRowSse2(src, scale, dst, count);
+#elif defined(PROJECTION_EDGE_BLEND_NEON)
+    done = expandRowNeon(src, scale, dst, count);
+#endif
+  }
+  return done + expandRowScalar(src + done, scale, dst + done, count - done);
+}
+
+// Ramp products along one axis of `size` pixels with edges at its start and end.
+void buildAxis(int size, const EdgeBlendEdge& start, const EdgeBlendEdge& end, std::vector<float>& gain,
+               std::vector<uint8_t>& flat) {
+  gain.assign(static_cast<size_t>(size), 1.0f);
+  flat.assign(static_cast<size_t>(size), 1);
+  for (int i = 0; i < size; ++i) {
+    const float center = static_cast<float>(i) + 0.5f;
+    if (start.width > 0 && i < start.width) {
+      gain[i] *= edgeBlendGain(center / static_cast<float>(start.width), start);
+      flat[i] = 0;
+    }
+    if (end.width > 0 && i >= size - end.width) {
+      gain[i] *= edgeBlendGain((static_cast<float>(size) - center) / static_cast<float>(end.width), end);
+      flat[i] = 0;
+    }
+  }
+}
+
+bool parseFloat(const std::string& text, float& out) {
+  if (text.empty()) {
+    return false;
+  }
+  char* end = nullptr;
+  const float value = std::strtof(text.c_str(), &end);
+  if (end != text.c_str() + text.size() || !std::isfinite(value)) {
+    return false;
+  }
+  out = value;
+  return true;
+}
+
+// "width[/gamma[/curve]]"
+bool parseEdge(const std::string& value, EdgeBlendEdge& edge) {
+  EdgeBlendEdge parsed = edge;
+  float fields[3] = {0.0f, parsed.gamma, parsed.curve};
+  size_t begin = 0;
+  for (int field = 0; field < 3; ++field) {
+    const size_t slash = value.find('/', begin);
+    if (!parseFloat(value.substr(begin, slash == std::string::npos ? std::string::npos : slash - begin),
+                    fields[field])) {
+      return false;
+    }
+    if (slash == std::string::npos) {
+      break;
+    }
+    if (field == 2) {
+      return false;
+    }
+    begin = slash + 1;
+  }
+  if (fields[0] < 0.0f || fields[0] != std::floor(fields[0]) || fields[1] <= 0.0f || fields[2] <= 0.0f) {
+    return false;
+  }
+  parsed.width = static_cast<int>(fields[0]);
+  parsed.gamma = fields[1];
+  parsed.curve = fields[2];
+  edge = parsed;
+  return true;
+}
+}  // namespace
+
+bool operator==(const EdgeBlendEdge& a, const EdgeBlendEdge& b) {
+  return a.width == b.width && a.gamma == b.gamma && a.curve == b.curve;
+}
+
+bool operator==(const EdgeBlendSettings& a, const EdgeBlendSettings& b) {
+  return a.left == b.left && a.right == b.right && a.top == b.top && a.bottom == b.bottom &&
+         a.blackLevel == b.blackLevel;
+}
+
+float edgeBlendGain(float t, const EdgeBlendEdge& edge) {
+  t = std::clamp(t, 0.0f, 1.0f);
+  const float curve = edge.curve > 0.0f ? edge.curve : 1.0f;
+  const float blend =
+      t < 0.5f ? 0.5f * std::pow(2.0f * t, curve) : 1.0f - 0.5f * std::pow(2.0f * (1.0f - t), curve);
+  const float gamma = edge.gamma > 0.0f ? edge.gamma : 1.0f;
+  return std::pow(blend, 1.0f / gamma);
+}
+
+EdgeBlendSettings scaleEdgeBlend(const EdgeBlendSettings& settings, float scaleX, float scaleY) {
+  EdgeBlendSettings scaled = settings;
+  const auto scale = [](int width, float factor) { return static_cast<int>(std::lround(width * factor)); };
+  scaled.left.width = scale(settings.left.width, scaleX);
+  scaled.right.width = scale(settings.right.width, scaleX);
+  scaled.top.width = scale(settings.top.width, scaleY);
+  scaled.bottom.width = scale(settings.bottom.width, scaleY);
+  return scaled;
+}
+
+bool parseEdgeBlend(const std::string& spec, EdgeBlendSettings& settings, std::string& error) {
+  EdgeBlendSettings parsed = settings;
+  size_t begin = 0;
+  while (begin <= spec.size()) {
+    const size_t comma = std::min(spec.find(',', begin), spec.size());
+    const std::string item = spec.substr(begin, comma - begin);
+    begin = comma + 1;
+    const size_t equals = item.find('=');
+    if (equals == std::string::npos) {
+      error = "Edge blend entries must look like key=value: " + spec;
+      return false;
+    }
+    const std::string key = item.substr(0, equals);
+    const std::string value = item.substr(equals + 1);
+    const struct {
+      const char* name;
+      EdgeBlendEdge* edge;
+    } edges[] = {{"left", &parsed.left}, {"right", &parsed.right}, {"top", &parsed.top}, {"bottom", &parsed.bottom}};
+    const auto named = std::find_if(std::begin(edges), std::end(edges), [&](const auto& e) { return key == e.name; });
+    bool ok = true;
+    if (named != std::end(edges)) {
+      ok = parseEdge(value, *named->edge);
+    } else if (key == "gamma" || key == "curve") {
+      float number = 0.0f;
+      ok = parseFloat(value, number) && number > 0.0f;
+      if (ok) {
+        for (const auto& e : edges) {
+          (key == "gamma" ? e.edge->gamma : e.edge->curve) = number;
+        }
+      }
+    } else if (key == "black") {
+      ok = parseFloat(value, parsed.blackLevel) && parsed.blackLevel >= 0.0f && parsed.blackLevel < 1.0f;
+    } else {
+      error = "Unknown edge blend key '" + key + "': " + spec;
+      return false;
+    }
+    if (!ok) {
+      error = "Invalid edge blend value for " + key + ": " + spec;
+      return false;
+    }
+  }
+  settings = parsed;
+  return true;
+}
+
+bool EdgeBlendMask::configure(int width, int height, const EdgeBlendSettings& settings, bool useSimd) {
+  width = std::max(0, width);
+  height = std::max(0, height);
+  if (generation_ > 0 && width == width_ && height == height_ && settings == settings_) {
+    return false;
+  }
+  width_ = width;
+  height_ = height;
+  settings_ = settings;
+  regenerate(useSimd);
+  ++generation_;
+  return true;
+}
+
+void EdgeBlendMask::regenerate(bool useSimd) {
+  if (!active()) {
+    gain_.clear();
+    lift_.clear();
+    return;
+  }
+  buildAxis(width_, settings_.left, settings_.right, columnGain_, columnFlat_);
+  buildAxis(height_, settings_.top, settings_.bottom, rowGain_, rowFlat_);
+
+  // The lift applies only outside every overlap; there the gain leaves it headroom so white
+  // stays white.
+  const float black = std::clamp(settings_.blackLevel, 0.0f, 1.0f);
+  const auto liftValue = static_cast<uint8_t>(std::lround(black * 255.0f));
+  columnGainLifted_.resize(columnGain_.size());
+  columnLift_.resize(columnGain_.size());
+  for (size_t x = 0; x < columnGain_.size(); ++x) {
+    columnGainLifted_[x] = columnFlat_[x] ? columnGain_[x] * (1.0f - black) : columnGain_[x];
+    columnLift_[x] = columnFlat_[x] ? liftValue : 0;
+  }
+
+  const auto w = static_cast<size_t>(width_);
+  gain_.resize(w * static_cast<size_t>(height_));
+  lift_.resize(gain_.size());
+  for (int y = 0; y < height_; ++y) {
+    const size_t offset = static_cast<size_t>(y) * w;
+    const bool flatRow = rowFlat_[y] != 0;
+    expandRow(flatRow ? columnGainLifted_.data() : columnGain_.data(), rowGain_[y] * 255.0f, gain_.data() + offset, w,
+              useSimd);
+    if (flatRow) {
+      std::memcpy(lift_.data() + offset, columnLift_.data(), w);
+    } else {
+      std::memset(lift_.data() + offset, 0, w);
+    }
+  }
+}
+
+void EdgeBlendMask::apply(const MutableImageView& image, bool useSimd) const {
+  if (!active() || image.empty() || image.width != width_ || image.height != height_) {
+    return;
+  }
+  const auto w = static_cast<size_t>(width_);
+  for (int y = 0; y < height_; ++y) {
+    uint8_t* px = image.row(y);
+    const uint8_t* gain = gain_.data() + static_cast<size_t>(y) * w;
+    const uint8_t* lift = lift_.data() + static_cast<size_t>(y) * w;
+    size_t done = 0;
+    if (useSimd) {
+#if defined(PROJECTION_EDGE_BLEND_SSE2)
+      done = applySse2(px, gain, lift, w);
+#elif defined(PROJECTION_EDGE_BLEND_NEON)
+      done = applyNeon(px, gain, lift, w);
+#endif
+    }
+    applyScalar(px + done * 4, gain + done, lift + done, w - done);
+  }
+}
+
+void EdgeBlendMask::gainImage(RgbaImage& out) const {
+  out.resize(width_, height_);
+  auto& pixels = out.pixels();
+  for (size_t i = 0; i < gain_.size(); ++i) {
+    pixels[i * 4] = pixels[i * 4 + 1] = pixels[i * 4 + 2] = gain_[i];
+    pixels[i * 4 + 3] = 255;
+  }
+}
+
+void EdgeBlendMask::liftImage(RgbaImage& out) const {
+  out.resize(width_, height_);
+  auto& pixels = out.pixels();
+  for (size_t i = 0; i < lift_.size(); ++i) {
+    pixels[i * 4] = pixels[i * 4 + 1] = pixels[i * 4 + 2] = lift_[i];
+    pixels[i * 4 + 3] = 255;
+  }
+}
+
+const char* edgeBlendSimdBackend() {
+#if defined(PROJECTION_EDGE_BLEND_SSE2)
+  return "sse2";
+#elif defined(PROJECTION_EDGE_BLEND_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
+
+}  // namespace projection::renderer
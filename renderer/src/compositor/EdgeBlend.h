@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "compositor/RgbaImage.h"
+
+namespace projection::renderer {
+
+// Attenuation ramp along one edge of an output that overlaps a neighbouring projector.
+struct EdgeBlendEdge {
+  // Overlap width in output pixels; 0 leaves the edge unblended.
+  int width{0};
+  // Display gamma the ramp is corrected for, so the two projectors' light adds up to one.
+  float gamma{2.2f};
+  // Ramp exponent: 1 is linear, larger values flatten the ramp near both ends of the overlap.
+  float curve{2.0f};
+};
+
+struct EdgeBlendSettings {
+  EdgeBlendEdge left{};
+  EdgeBlendEdge right{};
+  EdgeBlendEdge top{};
+  EdgeBlendEdge bottom{};
+  // Black level of one projector (0..1 of full output). Overlaps show roughly twice this, so
+  // the area outside every overlap is lifted by it to match.
+  float blackLevel{0.0f};
+
+  bool active() const {
+    return left.width > 0 || right.width > 0 || top.width > 0 || bottom.width > 0 || blackLevel > 0.0f;
+  }
+};
+
+bool operator==(const EdgeBlendEdge& a, const EdgeBlendEdge& b);
+bool operator==(const EdgeBlendSettings& a, const EdgeBlendSettings& b);
+inline bool operator!=(const EdgeBlendSettings& a, const EdgeBlendSettings& b) { return !(a == b); }
+
+// Gain at position t across an overlap (0 = outer edge of the output, 1 = where the overlap
+// ends): the curve-shaped blend f(t), with f(t) + f(1 - t) = 1, raised to 1 / gamma.
+float edgeBlendGain(float t, const EdgeBlendEdge& edge);
+
+// The same settings for an output drawn at a different resolution (edge widths are scaled).
+EdgeBlendSettings scaleEdgeBlend(const EdgeBlendSettings& settings, float scaleX, float scaleY);
+
+// Parses comma separated keys, e.g. "left=256,right=256/2.4/1.5,gamma=2.2,black=0.02". Edge
+// keys take width[/gamma[/curve]]; gamma and curve apply to every edge; black sets the black
+// level. Keys not present keep their value in `settings`. Returns false with a message on
+// malformed input.
+bool parseEdgeBlend(const std::string& spec, EdgeBlendSettings& settings, std::string& error);
+
+// Cached per-pixel edge-blend mask for one output: out = lift + pixel * gain per color channel,
+// alpha untouched. The mask is separable in its ramps, which are evaluated once per column and
+// row; the full-size gain and lift planes are expanded from them with SIMD and only rebuilt
+// when the size or settings change. apply() is the final stage on a finished frame.
+class EdgeBlendMask {
+ public:
+  // Returns true when the mask had to be regenerated.
+  bool configure(int width, int height, const EdgeBlendSettings& settings, bool useSimd = true);
+
+  // `image` must match the configured size; a mask with no active settings leaves it as is.
+  void apply(const MutableImageView& image, bool useSimd = true) const;
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+  const EdgeBlendSettings& settings() const { return settings_; }
+  bool active() const { return settings_.active() && width_ > 0 && height_ > 0; }
+  // Number of regenerations so far.
+  uint64_t generation() const { return generation_; }
+
+  // Per-pixel planes (width * height, row major), 0..255.
+  const std::vector<uint8_t>& gain() const { return gain_; }
+  const std::vector<uint8_t>& lift() const { return lift_; }
+  uint8_t gainAt(int x, int y) const { return gain_[static_cast<size_t>(y) * static_cast<size_t>(width_) + x]; }
+  uint8_t liftAt(int x, int y) const { return lift_[static_cast<size_t>(y) * static_cast<size_t>(width_) + x]; }
+
+  // Gray RGBA images of the planes (opaque) for multiply / add passes on the GPU.
+  void gainImage(RgbaImage& out) const;
+  void liftImage(RgbaImage& out) const;
+
+ private:
+  void regenerate(bool useSimd);
+
+  int width_{0};
+  int height_{0};
+  EdgeBlendSettings settings_{};
+  uint64_t generation_{0};
+  // Ramp products per column / row, and whether the column / row is outside every overlap.
+  std::vector<float> columnGain_{};
+  std::vector<float> rowGain_{};
+  std::vector<uint8_t> columnFlat_{};
+  std::vector<uint8_t> rowFlat_{};
+  // Column gains with the black-level headroom taken out where the lift applies.
+  std::vector<float> columnGainLifted_{};
+  std::vector<uint8_t> columnLift_{};
+  std::vector<uint8_t> gain_{};
+  std::vector<uint8_t> lift_{};
+};
+
+// Name of the vector instruction set the mask uses when useSimd is true ("sse2", "neon" or "scalar").
+const char* edgeBlendSimdBackend();
+
+}  // namespace projection::renderer
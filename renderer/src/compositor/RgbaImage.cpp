@@ -0,0 +1,31 @@
+#include "compositor/RgbaImage.h"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace projection::renderer {
+
+void writePpm(const ImageView& image, const std::string& path) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("Cannot open image file for writing: " + path);
+  }
+  out << "P6\n" << image.width << " " << image.height << "\n255\n";
+  std::vector<char> row(static_cast<size_t>(image.width) * 3);
+  for (int y = 0; y < image.height; ++y) {
+    const uint8_t* src = image.row(y);
+    for (int x = 0; x < image.width; ++x) {
+      row[static_cast<size_t>(x) * 3] = static_cast<char>(src[x * 4]);
+      row[static_cast<size_t>(x) * 3 + 1] = static_cast<char>(src[x * 4 + 1]);
+      row[static_cast<size_t>(x) * 3 + 2] = static_cast<char>(src[x * 4 + 2]);
+    }
+    out.write(row.data(), static_cast<std::streamsize>(row.size()));
+  }
+  if (!out) {
+    throw std::runtime_error("Failed to write image file: " + path);
+  }
+}
+
+void writePpm(const RgbaImage& image, const std::string& path) { writePpm(image.view(), path); }
+
+}  // namespace projection::renderer
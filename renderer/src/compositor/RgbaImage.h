@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace projection::renderer {
+
+// Non-owning view of 8-bit RGBA pixels (straight alpha, rows top to bottom).
+struct ImageView {
+  const uint8_t* data{nullptr};
+  int width{0};
+  int height{0};
+  size_t strideBytes{0};
+
+  bool empty() const { return data == nullptr || width <= 0 || height <= 0; }
+  const uint8_t* row(int y) const { return data + static_cast<size_t>(y) * strideBytes; }
+};
+
+// Writable view of 8-bit RGBA pixels: an RgbaImage or a pooled frame buffer.
+struct MutableImageView {
+  uint8_t* data{nullptr};
+  int width{0};
+  int height{0};
+  size_t strideBytes{0};
+
+  bool empty() const { return data == nullptr || width <= 0 || height <= 0; }
+  uint8_t* row(int y) const { return data + static_cast<size_t>(y) * strideBytes; }
+  uint8_t* pixel(int x, int y) const { return row(y) + static_cast<size_t>(x) * 4; }
+  ImageView view() const { return ImageView{data, width, height, strideBytes}; }
+};
+
+// Tightly packed 8-bit RGBA image.
+class RgbaImage {
+ public:
+  RgbaImage() = default;
+  RgbaImage(int width, int height) { resize(width, height); }
+
+  void resize(int width, int height) {
+    width_ = width > 0 ? width : 0;
+    height_ = height > 0 ? height : 0;
+    pixels_.assign(static_cast<size_t>(width_) * static_cast<size_t>(height_) * 4, 0);
+  }
+  void fill(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    for (size_t i = 0; i < pixels_.size(); i += 4) {
+      pixels_[i] = r;
+      pixels_[i + 1] = g;
+      pixels_[i + 2] = b;
+      pixels_[i + 3] = a;
+    }
+  }
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+  size_t strideBytes() const { return static_cast<size_t>(width_) * 4; }
+
+  uint8_t* row(int y) { return pixels_.data() + static_cast<size_t>(y) * strideBytes(); }
+  const uint8_t* row(int y) const { return pixels_.data() + static_cast<size_t>(y) * strideBytes(); }
+  uint8_t* pixel(int x, int y) { return row(y) + static_cast<size_t>(x) * 4; }
+  const uint8_t* pixel(int x, int y) const { return row(y) + static_cast<size_t>(x) * 4; }
+
+  std::vector<uint8_t>& pixels() { return pixels_; }
+  const std::vector<uint8_t>& pixels() const { return pixels_; }
+  ImageView view() const { return ImageView{pixels_.data(), width_, height_, strideBytes()}; }
+  MutableImageView mutableView() { return MutableImageView{pixels_.data(), width_, height_, strideBytes()}; }
+
+ private:
+  int width_{0};
+  int height_{0};
+  std::vector<uint8_t> pixels_{};
+};
+
+// Writes the image as binary PPM (alpha dropped); throws std::runtime_error on I/O failure.
+void writePpm(const ImageView& image, const std::string& path);
+void writePpm(const RgbaImage& image, const std::string& path);
+
+}  // namespace projection::renderer
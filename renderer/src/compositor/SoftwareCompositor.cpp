@@ -0,0 +1,199 @@
+#include "compositor/SoftwareCompositor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "compositor/BlendKernels.h"
+
+namespace projection::renderer {
+
+namespace {
+constexpr uint8_t kWhitePixel[4] = {255, 255, 255, 255};
+constexpr int kMinRowsPerBand = 8;
+
+uint8_t toByte(float unit) { return static_cast<uint8_t>(std::lround(std::clamp(unit, 0.0f, 1.0f) * 255.0f)); }
+
+// First pixel index whose centre (i + 0.5) is >= edge.
+int firstCenterAtOrAfter(float edge) { return static_cast<int>(std::ceil(edge - 0.5f)); }
+}  // namespace
+
+SoftwareCompositor::SoftwareCompositor(WorkerPool* pool, CompositorOptions options)
+    : pool_(pool), options_(options) {}
+
+void SoftwareCompositor::composite(const std::vector<CompositorLayer>& layers, const MutableImageView& target) {
+  if (target.empty()) {
+    return;
+  }
+  const auto rowBytes = static_cast<size_t>(target.width) * 4;
+  for (int x = 0; x < target.width; ++x) {
+    std::memcpy(target.pixel(x, 0), options_.clearColor, 4);
+  }
+  for (int y = 1; y < target.height; ++y) {
+    std::memcpy(target.row(y), target.row(0), rowBytes);
+  }
+
+  prepareTriangles(layers, target.width, target.height);
+  if (triangles_.empty()) {
+    return;
+  }
+
+  const auto rows = static_cast<size_t>(target.height);
+  if (pool_) {
+    pool_->parallelFor(
+        rows,
+        [&](size_t begin, size_t end) { rasterizeRows(target, static_cast<int>(begin), static_cast<int>(end)); },
+        kMinRowsPerBand);
+  } else {
+    rasterizeRows(target, 0, target.height);
+  }
+}
+
+void SoftwareCompositor::prepareTriangles(const std::vector<CompositorLayer>& layers, int width, int height) {
+  order_.resize(layers.size());
+  for (size_t i = 0; i < layers.size(); ++i) {
+    order_[i] = i;
+  }
+  std::stable_sort(order_.begin(), order_.end(),
+                   [&](size_t a, size_t b) { return layers[a].zOrder < layers[b].zOrder; });
+
+  triangles_.clear();
+  for (size_t index : order_) {
+    const auto& layer = layers[index];
+    const auto& p = layer.positions;
+    if (p.size() < 3 || layer.texCoords.size() != p.size() || layer.alpha <= 0.0f) {
+      continue;
+    }
+    const auto& t = layer.texCoords;
+    for (size_t i = 1; i + 1 < p.size(); ++i) {
+      const size_t idx[3] = {0, i, i + 1};
+      Triangle tri{};
+      for (int k = 0; k < 3; ++k) {
+        tri.x[k] = p[idx[k]].x;
+        tri.y[k] = p[idx[k]].y;
+      }
+      const float ex1 = tri.x[1] - tri.x[0];
+      const float ey1 = tri.y[1] - tri.y[0];
+      const float ex2 = tri.x[2] - tri.x[0];
+      const float ey2 = tri.y[2] - tri.y[0];
+      const float det = ex1 * ey2 - ex2 * ey1;
+      if (std::fabs(det) < 1e-6f) {
+        continue;
+      }
+      const float du1 = t[idx[1]].x - t[0].x;
+      const float du2 = t[idx[2]].x - t[0].x;
+      const float dv1 = t[idx[1]].y - t[0].y;
+      const float dv2 = t[idx[2]].y - t[0].y;
+      tri.u0 = t[0].x;
+      tri.dudx = (du1 * ey2 - du2 * ey1) / det;
+      tri.dudy = (du2 * ex1 - du1 * ex2) / det;
+      tri.v0 = t[0].y;
+      tri.dvdx = (dv1 * ey2 - dv2 * ey1) / det;
+      tri.dvdy = (dv2 * ex1 - dv1 * ex2) / det;
+
+      const float minY = std::min({tri.y[0], tri.y[1], tri.y[2]});
+      const float maxY = std::max({tri.y[0], tri.y[1], tri.y[2]});
+      const float minX = std::min({tri.x[0], tri.x[1], tri.x[2]});
+      const float maxX = std::max({tri.x[0], tri.x[1], tri.x[2]});
+      tri.rowBegin = std::max(0, firstCenterAtOrAfter(minY));
+      tri.rowEnd = std::min(height, firstCenterAtOrAfter(maxY));
+      if (tri.rowBegin >= tri.rowEnd || maxX < 0.0f || minX > static_cast<float>(width)) {
+        continue;
+      }
+      tri.layer = &layer;
+      tri.brightness = toByte(layer.brightness);
+      tri.alpha = toByte(layer.alpha);
+      triangles_.push_back(tri);
+    }
+  }
+}
+
+void SoftwareCompositor::rasterizeRows(const MutableImageView& target, int rowBegin, int rowEnd) const {
+  // Sampled source texels for one span; grows to the widest span once per thread.
+  thread_local std::vector<uint8_t> span;
+  const int width = target.width;
+  if (span.size() < static_cast<size_t>(width) * 4) {
+    span.resize(static_cast<size_t>(width) * 4);
+  }
+
+  for (const auto& tri : triangles_) {
+    const int yBegin = std::max(rowBegin, tri.rowBegin);
+    const int yEnd = std::min(rowEnd, tri.rowEnd);
+    const ImageView& texture = tri.layer->texture;
+    const bool solid = texture.empty();
+
+    for (int y = yBegin; y < yEnd; ++y) {
+      const float yc = static_cast<float>(y) + 0.5f;
+      float left = 0.0f;
+      float right = 0.0f;
+      int hits = 0;
+      for (int e = 0; e < 3; ++e) {
+        const float xa = tri.x[e];
+        const float ya = tri.y[e];
+        const float xb = tri.x[(e + 1) % 3];
+        const float yb = tri.y[(e + 1) % 3];
+        // Half-open in y so a vertex row is counted once per crossing.
+        if ((ya <= yc && yc < yb) || (yb <= yc && yc < ya)) {
+          const float x = xa + (yc - ya) * (xb - xa) / (yb - ya);
+          left = hits == 0 ? x : std::min(left, x);
+          right = hits == 0 ? x : std::max(right, x);
+          ++hits;
+        }
+      }
+      if (hits < 2) {
+        continue;
+      }
+      const int xBegin = std::max(0, firstCenterAtOrAfter(left));
+      const int xEnd = std::min(width, firstCenterAtOrAfter(right));
+      if (xBegin >= xEnd) {
+        continue;
+      }
+      const auto count = static_cast<size_t>(xEnd - xBegin);
+
+      const float px = static_cast<float>(xBegin) + 0.5f - tri.x[0];
+      const float py = yc - tri.y[0];
+      float u = tri.u0 + tri.dudx * px + tri.dudy * py;
+      float v = tri.v0 + tri.dvdx * px + tri.dvdy * py;
+      uint8_t* out = span.data();
+      if (solid) {
+        for (size_t i = 0; i < count; ++i) {
+          std::memcpy(out + i * 4, kWhitePixel, 4);
+        }
+      } else {
+        const float texW = static_cast<float>(texture.width);
+        const float texH = static_cast<float>(texture.height);
+        const int maxX = texture.width - 1;
+        const int maxY = texture.height - 1;
+        for (size_t i = 0; i < count; ++i) {
+          const int tx = std::clamp(static_cast<int>(u * texW), 0, maxX);
+          const int ty = std::clamp(static_cast<int>(v * texH), 0, maxY);
+          std::memcpy(out + i * 4, texture.row(ty) + static_cast<size_t>(tx) * 4, 4);
+          u += tri.dudx;
+          v += tri.dvdx;
+        }
+      }
+
+      blendSpan(tri.layer->blendMode, target.pixel(xBegin, y), span.data(), count, tri.brightness, tri.alpha,
+                options_.useSimd);
+    }
+  }
+}
+
+void buildCompositorLayers(const std::vector<SurfaceDraw>& drawList,
+                           const std::function<ImageView(const std::string& feedId)>& frameForFeed,
+                           std::vector<CompositorLayer>& layers) {
+  layers.resize(drawList.size());
+  for (size_t i = 0; i < drawList.size(); ++i) {
+    const auto& draw = drawList[i];
+    auto& layer = layers[i];
+    layer.positions = draw.positions;
+    layer.texCoords = draw.texCoords;
+    layer.texture = frameForFeed(draw.feedId);
+    layer.brightness = draw.brightness;
+    layer.alpha = draw.alpha;
+    layer.blendMode = draw.blendMode;
+    layer.zOrder = draw.zOrder;
+  }
+}
+
+}  // namespace projection::renderer
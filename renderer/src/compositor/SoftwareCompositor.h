@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <projection/core/Enums.h>
+#include <projection/core/Surface.h>
+
+#include "DrawListCompiler.h"
+#include "compositor/RgbaImage.h"
+#include "util/WorkerPool.h"
+
+namespace projection::renderer {
+
+// One textured polygon to composite. Positions are output pixels, texture coordinates are
+// normalized (0..1) and interpolated across the triangle fan (v0, vi, vi+1) exactly like the
+// GPU path draws OF_PRIMITIVE_TRIANGLE_FAN. An empty texture samples as opaque white.
+struct CompositorLayer {
+  std::vector<projection::core::Vec2> positions;
+  std::vector<projection::core::Vec2> texCoords;
+  ImageView texture{};
+  float brightness{1.0f};
+  float alpha{1.0f};
+  projection::core::BlendMode blendMode{projection::core::BlendMode::Normal};
+  int zOrder{0};
+};
+
+struct CompositorOptions {
+  // False forces the scalar blend kernels (used to check the SIMD paths against them).
+  bool useSimd{true};
+  uint8_t clearColor[4]{0, 0, 0, 255};
+};
+
+// CPU reference rasterizer for scenes: nearest-neighbour texture sampling, pixel-centre
+// coverage with a top-left style fill rule (shared fan edges are covered exactly once),
+// layers composited in ascending zOrder (stable for ties). Rows are split into bands across
+// the worker pool; each band walks every layer so per-pixel ordering is preserved.
+class SoftwareCompositor {
+ public:
+  // Without a pool everything runs on the calling thread.
+  explicit SoftwareCompositor(WorkerPool* pool = nullptr, CompositorOptions options = {});
+
+  // Clears `target` to the clear color and composites the layers into it.
+  void composite(const std::vector<CompositorLayer>& layers, const MutableImageView& target);
+  void composite(const std::vector<CompositorLayer>& layers, RgbaImage& target) {
+    composite(layers, target.mutableView());
+  }
+
+  const CompositorOptions& options() const { return options_; }
+
+ private:
+  struct Triangle {
+    float x[3];
+    float y[3];
+    // u(px, py) = u0 + dudx * (px - x[0]) + dudy * (py - y[0]); same for v.
+    float u0, dudx, dudy;
+    float v0, dvdx, dvdy;
+    int rowBegin;
+    int rowEnd;
+    const CompositorLayer* layer;
+    uint8_t brightness;
+    uint8_t alpha;
+  };
+
+  void prepareTriangles(const std::vector<CompositorLayer>& layers, int width, int height);
+  void rasterizeRows(const MutableImageView& target, int rowBegin, int rowEnd) const;
+
+  WorkerPool* pool_;
+  CompositorOptions options_;
+  std::vector<size_t> order_{};
+  std::vector<Triangle> triangles_{};
+};
+
+// Builds compositor layers from a prepared draw list; frameForFeed returns the CPU frame for
+// a feed id (an empty view draws the surface in solid white).
+void buildCompositorLayers(const std::vector<SurfaceDraw>& drawList,
+                           const std::function<ImageView(const std::string& feedId)>& frameForFeed,
+                           std::vector<CompositorLayer>& layers);
+
+}  // namespace projection::renderer
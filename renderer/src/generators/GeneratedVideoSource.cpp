@@ -0,0 +1,73 @@
+#include "generators/GeneratedVideoSource.h"
+
+#include <algorithm>
+
+namespace projection::renderer {
+
+namespace {
+// Rows per work item; at 1080p this yields enough bands to balance across typical core counts.
+constexpr size_t kRowsPerChunk = 32;
+}  // namespace
+
+GeneratedVideoSource::GeneratedVideoSource(const projection::core::GeneratedFeedConfig& config, WorkerPool* pool,
+                                           FramePool* frames, bool useSimd)
+    : config_(config),
+      generator_(makeGenerator(config)),
+      pool_(pool),
+      ownedFrames_(frames ? nullptr : std::make_unique<FramePool>()),
+      frames_(frames ? frames : ownedFrames_.get()),
+      useSimd_(useSimd) {}
+
+bool GeneratedVideoSource::load(const std::string& /*filePath*/) {
+  loaded_ = true;
+  renderIfChanged();
+  return true;
+}
+
+void GeneratedVideoSource::update(double deltaSeconds) {
+  if (!loaded_) {
+    return;
+  }
+  if (playing_) {
+    seconds_ += deltaSeconds * speed_;
+  }
+  renderIfChanged();
+}
+
+void GeneratedVideoSource::seek(double seconds) { seconds_ = std::max(0.0, seconds); }
+
+void GeneratedVideoSource::renderIfChanged() {
+  const uint64_t key = generator_->contentKey(seconds_);
+  if (rendered_ && key == contentKey_) {
+    ++skippedFrames_;
+    return;
+  }
+
+  // Render in place when nobody else holds the current frame; otherwise leave it intact for
+  // its holders and take another buffer from the pool.
+  FrameRef next = frame_.useCount() == 1 ? std::move(frame_) : frames_->acquire(config_.width, config_.height);
+  if (!next) {
+    ++droppedFrames_;
+    return;
+  }
+
+  generator_->prepare(seconds_);
+  const MutableImageView target = next.mutableView();
+  const auto rows = static_cast<size_t>(target.height);
+  auto renderBand = [&](size_t begin, size_t end) {
+    generator_->renderRows(target, static_cast<int>(begin), static_cast<int>(end), useSimd_);
+  };
+  if (pool_ != nullptr) {
+    pool_->parallelFor(rows, renderBand, kRowsPerChunk);
+  } else {
+    renderBand(0, rows);
+  }
+
+  frame_ = std::move(next);
+  rendered_ = true;
+  contentKey_ = key;
+  ++frameVersion_;
+  ++renderedFrames_;
+}
+
+}  // namespace projection::renderer
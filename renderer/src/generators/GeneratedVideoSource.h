@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <projection/core/Feed.h>
+
+#include "compositor/RgbaImage.h"
+#include "generators/Generators.h"
+#include "util/FramePool.h"
+#include "util/WorkerPool.h"
+#include "video/VideoSource.h"
+
+namespace projection::renderer {
+
+// VideoSource for a Generated feed. Frames are rendered on update() into buffers from a
+// FramePool; row bands are split across the worker pool. A frame nobody else holds is
+// overwritten in place; while frame() handles are outstanding the next frame goes into
+// another pooled buffer, so holders keep a stable image. Either way steady-state playback
+// allocates nothing. A frame is only rendered (and
+// frameVersion() only bumped) when the generator's content key changes, so static patterns
+// render once and GPU backends upload only changed frames.
+// Position is the generator time in seconds; duration() is 0 (endless), which keeps the
+// drift corrector away from it since it already runs off the master clock step.
+class GeneratedVideoSource : public VideoSource {
+ public:
+  // Without a worker pool rendering runs on the calling thread; without a frame pool the
+  // source keeps a private one.
+  explicit GeneratedVideoSource(const projection::core::GeneratedFeedConfig& config, WorkerPool* pool = nullptr,
+                                FramePool* frames = nullptr, bool useSimd = true);
+
+  // There is nothing to open; renders the first frame. The path is ignored.
+  bool load(const std::string& filePath) override;
+  void play() override { playing_ = true; }
+  void pause() override { playing_ = false; }
+  void update(double deltaSeconds) override;
+
+  bool isLoaded() const override { return loaded_; }
+  float width() const override { return static_cast<float>(config_.width); }
+  float height() const override { return static_cast<float>(config_.height); }
+
+  double position() const override { return seconds_; }
+  double duration() const override { return 0.0; }
+  void seek(double seconds) override;
+  void setSpeed(double speed) override { speed_ = speed; }
+
+  ImageView cpuFrame() const override { return frame_.view(); }
+  uint64_t frameVersion() const override { return frameVersion_; }
+  // Shared handle on the current frame; stays valid after later updates.
+  FrameRef frame() const { return frame_; }
+
+  const projection::core::GeneratedFeedConfig& config() const { return config_; }
+  // Frames actually rendered vs. updates that reused the previous frame.
+  uint64_t renderedFrames() const { return renderedFrames_; }
+  uint64_t skippedFrames() const { return skippedFrames_; }
+  // Changed frames that could not be rendered because the frame pool budget was exhausted;
+  // the previous frame stays up and rendering is retried on the next update.
+  uint64_t droppedFrames() const { return droppedFrames_; }
+
+ private:
+  void renderIfChanged();
+
+  projection::core::GeneratedFeedConfig config_;
+  std::unique_ptr<Generator> generator_;
+  WorkerPool* pool_;
+  std::unique_ptr<FramePool> ownedFrames_;
+  FramePool* frames_;
+  bool useSimd_;
+  bool loaded_{false};
+  bool playing_{false};
+  double seconds_{0.0};
+  double speed_{1.0};
+  bool rendered_{false};
+  uint64_t contentKey_{0};
+  uint64_t frameVersion_{0};
+  uint64_t renderedFrames_{0};
+  uint64_t skippedFrames_{0};
+  uint64_t droppedFrames_{0};
+  FrameRef frame_{};
+};
+
+}  // namespace projection::renderer
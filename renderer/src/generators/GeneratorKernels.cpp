@@ -0,0 +1,111 @@
+#include "generators/GeneratorKernels.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PROJECTION_GENERATOR_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PROJECTION_GENERATOR_NEON 1
+#endif
+
+namespace projection::renderer {
+
+namespace {
+void lerpScalar(uint8_t* dst, size_t count, const uint8_t a[4], const uint8_t b[4], const uint16_t* weights) {
+  for (size_t i = 0; i < count; ++i, dst += 4) {
+    const uint32_t w = weights[i];
+    for (int c = 0; c < 4; ++c) {
+      dst[c] = static_cast<uint8_t>((a[c] * (256 - w) + b[c] * w) >> 8);
+    }
+  }
+}
+
+#if defined(PROJECTION_GENERATOR_SSE2)
+// Handles whole pairs of pixels; returns how many pixels were written.
+size_t lerpSse2(uint8_t* dst, size_t count, const uint8_t a[4], const uint8_t b[4], const uint16_t* weights) {
+  // a * (256 - w) + b * w <= 255 * 256, so every product and the sum fit in unsigned 16-bit lanes.
+  const __m128i va = _mm_setr_epi16(a[0], a[1], a[2], a[3], a[0], a[1], a[2], a[3]);
+  const __m128i vb = _mm_setr_epi16(b[0], b[1], b[2], b[3], b[0], b[1], b[2], b[3]);
+  const __m128i v256 = _mm_set1_epi16(256);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    // Weights w0..w3 spread to one 16-bit lane per channel: w0 x4, w1 x4 | w2 x4, w3 x4.
+    const __m128i w = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(weights + i));
+    const __m128i w01 = _mm_unpacklo_epi16(w, w);
+    const __m128i lo = _mm_unpacklo_epi32(w01, w01);
+    const __m128i hi = _mm_unpackhi_epi32(w01, w01);
+    const __m128i mixLo = _mm_srli_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(va, _mm_sub_epi16(v256, lo)), _mm_mullo_epi16(vb, lo)), 8);
+    const __m128i mixHi = _mm_srli_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(va, _mm_sub_epi16(v256, hi)), _mm_mullo_epi16(vb, hi)), 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(mixLo, mixHi));
+  }
+  return i;
+}
+#elif defined(PROJECTION_GENERATOR_NEON)
+size_t lerpNeon(uint8_t* dst, size_t count, const uint8_t a[4], const uint8_t b[4], const uint16_t* weights) {
+  const uint16_t aLanes[8] = {a[0], a[1], a[2], a[3], a[0], a[1], a[2], a[3]};
+  const uint16_t bLanes[8] = {b[0], b[1], b[2], b[3], b[0], b[1], b[2], b[3]};
+  const uint16x8_t va = vld1q_u16(aLanes);
+  const uint16x8_t vb = vld1q_u16(bLanes);
+  const uint16x8_t v256 = vdupq_n_u16(256);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const uint16x4_t w = vld1_u16(weights + i);
+    const uint16x8_t lo = vcombine_u16(vdup_lane_u16(w, 0), vdup_lane_u16(w, 1));
+    const uint16x8_t hi = vcombine_u16(vdup_lane_u16(w, 2), vdup_lane_u16(w, 3));
+    const uint16x8_t mixLo = vshrq_n_u16(vmlaq_u16(vmulq_u16(va, vsubq_u16(v256, lo)), vb, lo), 8);
+    const uint16x8_t mixHi = vshrq_n_u16(vmlaq_u16(vmulq_u16(va, vsubq_u16(v256, hi)), vb, hi), 8);
+    vst1q_u8(dst + i * 4, vcombine_u8(vmovn_u16(mixLo), vmovn_u16(mixHi)));
+  }
+  return i;
+}
+#endif
+}  // namespace
+
+void fillSpan(uint8_t* dst, size_t count, const uint8_t rgba[4], bool useSimd) {
+  uint32_t pixel;
+  std::memcpy(&pixel, rgba, 4);
+  size_t i = 0;
+#if defined(PROJECTION_GENERATOR_SSE2)
+  if (useSimd) {
+    const __m128i v = _mm_set1_epi32(static_cast<int>(pixel));
+    for (; i + 4 <= count; i += 4) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), v);
+    }
+  }
+#elif defined(PROJECTION_GENERATOR_NEON)
+  if (useSimd) {
+    const uint32x4_t v = vdupq_n_u32(pixel);
+    for (; i + 4 <= count; i += 4) {
+      vst1q_u32(reinterpret_cast<uint32_t*>(dst + i * 4), v);
+    }
+  }
+#else
+  (void)useSimd;
+#endif
+  for (; i < count; ++i) {
+    std::memcpy(dst + i * 4, &pixel, 4);
+  }
+}
+
+void lerpSpan(uint8_t* dst, size_t count, const uint8_t a[4], const uint8_t b[4], const uint16_t* weights,
+              bool useSimd) {
+  size_t done = 0;
+#if defined(PROJECTION_GENERATOR_SSE2)
+  if (useSimd) {
+    done = lerpSse2(dst, count, a, b, weights);
+  }
+#elif defined(PROJECTION_GENERATOR_NEON)
+  if (useSimd) {
+    done = lerpNeon(dst, count, a, b, weights);
+  }
+#else
+  (void)useSimd;
+#endif
+  lerpScalar(dst + done * 4, count - done, a, b, weights + done);
+}
+
+}  // namespace projection::renderer
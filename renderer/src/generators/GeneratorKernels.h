@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace projection::renderer {
+
+// Row kernels shared by the procedural generators. Like the blend kernels, the SIMD and scalar
+// paths produce identical bytes, so useSimd only changes speed.
+
+// Writes `count` copies of one RGBA8 pixel.
+void fillSpan(uint8_t* dst, size_t count, const uint8_t rgba[4], bool useSimd = true);
+
+// Mixes two RGBA8 colors per pixel: dst[i] = (a * (256 - w) + b * w) >> 8 per channel, with
+// w = weights[i] in 0..256 (256 selects b exactly).
+void lerpSpan(uint8_t* dst, size_t count, const uint8_t a[4], const uint8_t b[4], const uint16_t* weights,
+              bool useSimd = true);
+
+}  // namespace projection::renderer
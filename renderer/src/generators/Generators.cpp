@@ -0,0 +1,495 @@
+#include "generators/Generators.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "generators/GeneratorKernels.h"
+
+namespace projection::renderer {
+
+using projection::core::GeneratedFeedConfig;
+using projection::core::GeneratorColor;
+using projection::core::GeneratorKind;
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+
+void toBytes(const GeneratorColor& color, uint8_t out[4]) {
+  out[0] = color.r;
+  out[1] = color.g;
+  out[2] = color.b;
+  out[3] = color.a;
+}
+
+// Same rounding as lerpSpan, so scalar setup and the row kernels agree.
+uint8_t mix(uint8_t a, uint8_t b, uint32_t weight) {
+  return static_cast<uint8_t>((a * (256 - weight) + b * weight) >> 8);
+}
+
+GeneratorColor mix(const GeneratorColor& a, const GeneratorColor& b, uint32_t weight) {
+  return GeneratorColor{mix(a.r, b.r, weight), mix(a.g, b.g, weight), mix(a.b, b.b, weight),
+                        mix(a.a, b.a, weight)};
+}
+
+// The configured colors, or `fallback` when none are set. A single color is repeated when the
+// generator needs at least as many colors as the fallback provides.
+std::vector<GeneratorColor> colorsOr(const GeneratedFeedConfig& config, const std::vector<GeneratorColor>& fallback) {
+  auto colors = config.colors.empty() ? fallback : config.colors;
+  while (colors.size() < fallback.size()) {
+    colors.push_back(colors.front());
+  }
+  return colors;
+}
+
+// Positive remainder, for wrapping time-based offsets.
+double wrap(double value, double period) {
+  const double r = std::fmod(value, period);
+  return r < 0.0 ? r + period : r;
+}
+
+class ColorFieldGenerator : public Generator {
+ public:
+  explicit ColorFieldGenerator(const GeneratedFeedConfig& config)
+      : colors_(colorsOr(config, {GeneratorColor{}})), speed_(config.speed) {}
+
+  uint64_t contentKey(double seconds) const override {
+    if (!animated()) {
+      return 0;
+    }
+    const auto step = crossfadeStep(seconds);
+    return step.index * 257 + step.weight;
+  }
+
+  void prepare(double seconds) override {
+    const auto step = animated() ? crossfadeStep(seconds) : Step{};
+    toBytes(mix(colors_[step.index], colors_[(step.index + 1) % colors_.size()], step.weight), color_);
+  }
+
+  void renderRows(const MutableImageView& frame, int rowBegin, int rowEnd, bool useSimd) const override {
+    for (int y = rowBegin; y < rowEnd; ++y) {
+      fillSpan(frame.row(y), static_cast<size_t>(frame.width), color_, useSimd);
+    }
+  }
+
+ private:
+  struct Step {
+    uint64_t index{0};
+    uint32_t weight{0};
+  };
+
+  bool animated() const { return colors_.size() > 1 && speed_ != 0.0f; }
+
+  Step crossfadeStep(double seconds) const {
+    const double phase = wrap(seconds * speed_, static_cast<double>(colors_.size()));
+    Step step{static_cast<uint64_t>(phase), 0};
+    step.weight = static_cast<uint32_t>(std::lround((phase - static_cast<double>(step.index)) * 256.0));
+    if (step.weight >= 256) {
+      step.index = (step.index + 1) % colors_.size();
+      step.weight = 0;
+    }
+    return step;
+  }
+
+  std::vector<GeneratorColor> colors_;
+  float speed_;
+  uint8_t color_[4]{};
+};
+
+// Linear gradient through a 1024-entry color table. Every pixel's table index is affine in x
+// and y (16.16 fixed point), so rows are a running sum. Table lookups are gathers, which SSE2
+// lacks, so arbitrary angles stay scalar; horizontal gradients copy their first row and
+// vertical ones fill whole rows with the SIMD kernel. Animated gradients wrap around back to
+// the first stop so the scroll has no seam.
+class GradientGenerator : public Generator {
+ public:
+  explicit GradientGenerator(const GeneratedFeedConfig& config)
+      : speed_(config.speed), periodic_(config.speed != 0.0f) {
+    auto stops = colorsOr(config, {GeneratorColor{0, 0, 0, 255}, GeneratorColor{255, 255, 255, 255}});
+    if (periodic_) {
+      stops.push_back(stops.front());
+    }
+    const size_t segments = stops.size() - 1;
+    for (size_t i = 0; i < kLutSize; ++i) {
+      const double pos = periodic_ ? static_cast<double>(i) / kLutSize : static_cast<double>(i) / (kLutSize - 1);
+      const double p = pos * static_cast<double>(segments);
+      const size_t k = std::min(static_cast<size_t>(p), segments - 1);
+      const auto weight = static_cast<uint32_t>(std::lround((p - static_cast<double>(k)) * 256.0));
+      uint8_t bytes[4];
+      toBytes(mix(stops[k], stops[k + 1], weight), bytes);
+      std::memcpy(&lut_[i], bytes, 4);
+    }
+
+    const double radians = config.angleDegrees * kPi / 180.0;
+    const double dx = std::cos(radians);
+    const double dy = std::sin(radians);
+    const double w = config.width;
+    const double h = config.height;
+    const double corners[4] = {0.0, w * dx, h * dy, w * dx + h * dy};
+    const double minProj = *std::min_element(corners, corners + 4);
+    const double length = std::max(1.0, *std::max_element(corners, corners + 4) - minProj);
+    const double toFixed = kLutSize * 65536.0 / length;
+    duDx_ = std::llround(dx * toFixed);
+    duDy_ = std::llround(dy * toFixed);
+    // Sample pixel centres; snap tiny components to zero so axis-aligned gradients hit the fast paths.
+    if (std::fabs(dx) < 1e-9) {
+      duDx_ = 0;
+    }
+    if (std::fabs(dy) < 1e-9) {
+      duDy_ = 0;
+    }
+    u00_ = std::llround((0.5 * dx + 0.5 * dy - minProj) * toFixed);
+  }
+
+  uint64_t contentKey(double seconds) const override { return periodic_ ? phase(seconds) : 0; }
+
+  void prepare(double seconds) override { offset_ = periodic_ ? static_cast<int64_t>(phase(seconds)) << 10 : 0; }
+
+  void renderRows(const MutableImageView& frame, int rowBegin, int rowEnd, bool useSimd) const override {
+    const auto width = static_cast<size_t>(frame.width);
+    for (int y = rowBegin; y < rowEnd; ++y) {
+      uint8_t* row = frame.row(y);
+      if (duDy_ == 0 && y > rowBegin) {
+        std::memcpy(row, frame.row(rowBegin), width * 4);
+        continue;
+      }
+      int64_t u = u00_ + duDy_ * y + offset_;
+      if (duDx_ == 0) {
+        uint8_t color[4];
+        std::memcpy(color, &lut_[index(u)], 4);
+        fillSpan(row, width, color, useSimd);
+        continue;
+      }
+      for (size_t x = 0; x < width; ++x, u += duDx_) {
+        std::memcpy(row + x * 4, &lut_[index(u)], 4);
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t kLutSize = 1024;
+
+  // Scroll position within one gradient length, 16 fractional bits.
+  uint64_t phase(double seconds) const {
+    return static_cast<uint64_t>(wrap(seconds * speed_, 1.0) * 65536.0) & 0xffff;
+  }
+
+  size_t index(int64_t u) const {
+    const int64_t i = u >> 16;
+    if (periodic_) {
+      return static_cast<size_t>(i & static_cast<int64_t>(kLutSize - 1));
+    }
+    return static_cast<size_t>(std::clamp<int64_t>(i, 0, kLutSize - 1));
+  }
+
+  float speed_;
+  bool periodic_;
+  uint32_t lut_[kLutSize]{};
+  int64_t u00_{0};
+  int64_t duDx_{0};
+  int64_t duDy_{0};
+  int64_t offset_{0};
+};
+
+// Smooth value noise: hashed lattice values every `scale` pixels, blended with a smoothstep
+// fade. Each row first interpolates one value per lattice column, then per pixel along x into
+// a weight row that the SIMD kernel maps onto the low..high colors.
+class NoiseGenerator : public Generator {
+ public:
+  explicit NoiseGenerator(const GeneratedFeedConfig& config)
+      : cell_(config.scale > 0.0f ? std::max(1.0, static_cast<double>(config.scale)) : 64.0),
+        speed_(config.speed),
+        seed_(config.seed) {
+    const auto colors = colorsOr(config, {GeneratorColor{0, 0, 0, 255}, GeneratorColor{255, 255, 255, 255}});
+    toBytes(colors[0], low_);
+    toBytes(colors[1], high_);
+    const double radians = config.angleDegrees * kPi / 180.0;
+    dirX_ = std::cos(radians);
+    dirY_ = std::sin(radians);
+    step16_ = std::max<uint64_t>(1, static_cast<uint64_t>(std::llround(65536.0 / cell_)));
+    for (int i = 0; i <= 256; ++i) {
+      const double f = i / 256.0;
+      fade_[i] = static_cast<uint16_t>(std::lround(256.0 * f * f * (3.0 - 2.0 * f)));
+    }
+  }
+
+  uint64_t contentKey(double seconds) const override {
+    const auto offset = driftOffset(seconds);
+    return (static_cast<uint64_t>(static_cast<uint32_t>(offset.x)) << 32) | static_cast<uint32_t>(offset.y);
+  }
+
+  void prepare(double seconds) override { offset_ = driftOffset(seconds); }
+
+  void renderRows(const MutableImageView& frame, int rowBegin, int rowEnd, bool useSimd) const override {
+    thread_local std::vector<uint8_t> columns;
+    thread_local std::vector<uint16_t> weights;
+    const auto width = static_cast<size_t>(frame.width);
+
+    const double startX = static_cast<double>(offset_.x) / cell_;
+    const double baseCellX = std::floor(startX);
+    const auto startFrac = static_cast<uint64_t>((startX - baseCellX) * 65536.0);
+    const auto cellX = static_cast<int64_t>(baseCellX);
+    columns.resize(static_cast<size_t>((startFrac + (width - 1) * step16_) >> 16) + 2);
+    weights.resize(width);
+    // Raw pointers keep the per-pixel loop free of reloads (uint8_t stores may alias anything).
+    uint8_t* const column = columns.data();
+    uint16_t* const weight = weights.data();
+    const size_t columnCount = columns.size();
+    const uint64_t step = step16_;
+
+    for (int y = rowBegin; y < rowEnd; ++y) {
+      const double py = static_cast<double>(y + offset_.y) / cell_;
+      const double cellYf = std::floor(py);
+      const auto cellY = static_cast<int64_t>(cellYf);
+      const uint32_t fy = fade_[static_cast<int>((py - cellYf) * 256.0)];
+      for (size_t k = 0; k < columnCount; ++k) {
+        const int64_t cx = cellX + static_cast<int64_t>(k);
+        column[k] = mix(hash(cx, cellY), hash(cx, cellY + 1), fy);
+      }
+
+      uint64_t pos = startFrac;
+      for (size_t x = 0; x < width; ++x, pos += step) {
+        const size_t cx = static_cast<size_t>(pos >> 16);
+        const uint32_t fx = fade_[(pos >> 8) & 255];
+        const uint32_t v = (column[cx] * (256 - fx) + column[cx + 1] * fx) >> 8;
+        weight[x] = static_cast<uint16_t>(v + (v >> 7));
+      }
+      lerpSpan(frame.row(y), width, low_, high_, weight, useSimd);
+    }
+  }
+
+ private:
+  struct Offset {
+    int64_t x{0};
+    int64_t y{0};
+  };
+
+  Offset driftOffset(double seconds) const {
+    const double distance = seconds * speed_;
+    return Offset{std::llround(distance * dirX_), std::llround(distance * dirY_)};
+  }
+
+  uint8_t hash(int64_t x, int64_t y) const {
+    uint32_t h = static_cast<uint32_t>(x) * 0x8da6b343u ^ static_cast<uint32_t>(y) * 0xd8163841u ^ seed_ * 0xcb1ab31fu;
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    h ^= h >> 12;
+    h *= 0x297a2d39u;
+    h ^= h >> 15;
+    return static_cast<uint8_t>(h >> 24);
+  }
+
+  double cell_;
+  float speed_;
+  uint32_t seed_;
+  double dirX_{1.0};
+  double dirY_{0.0};
+  uint64_t step16_{1};
+  uint8_t low_[4]{};
+  uint8_t high_[4]{};
+  uint16_t fade_[257]{};
+  Offset offset_{};
+};
+
+// 75% color bars over the top two thirds, a black-to-white ramp, a dark strip, and a 16x9
+// alignment grid with centre lines on top. Never changes, so it renders once.
+class TestPatternGenerator : public Generator {
+ public:
+  uint64_t contentKey(double) const override { return 0; }
+  void prepare(double) override {}
+
+  void renderRows(const MutableImageView& frame, int rowBegin, int rowEnd, bool useSimd) const override {
+    static const uint8_t kBars[7][4] = {{191, 191, 191, 255}, {191, 191, 0, 255}, {0, 191, 191, 255},
+                                        {0, 191, 0, 255},     {191, 0, 191, 255}, {191, 0, 0, 255},
+                                        {0, 0, 191, 255}};
+    static const uint8_t kBlack[4] = {0, 0, 0, 255};
+    static const uint8_t kWhite[4] = {255, 255, 255, 255};
+    static const uint8_t kDark[4] = {16, 16, 16, 255};
+    static const uint8_t kGrid[4] = {160, 160, 160, 255};
+    thread_local std::vector<uint16_t> ramp;
+
+    const int width = frame.width;
+    const int height = frame.height;
+    const int barsEnd = height * 2 / 3;
+    const int rampEnd = height * 5 / 6;
+    const int gridX = std::max(1, width / 16);
+    const int gridY = std::max(1, height / 9);
+    ramp.resize(static_cast<size_t>(width));
+    for (int x = 0; x < width; ++x) {
+      ramp[static_cast<size_t>(x)] = static_cast<uint16_t>(x * 256 / std::max(1, width - 1));
+    }
+
+    for (int y = rowBegin; y < rowEnd; ++y) {
+      uint8_t* row = frame.row(y);
+      if (y % gridY == 0 || y == height - 1) {
+        fillSpan(row, static_cast<size_t>(width), kGrid, useSimd);
+        continue;
+      }
+      if (y == height / 2) {
+        fillSpan(row, static_cast<size_t>(width), kWhite, useSimd);
+        continue;
+      }
+      if (y < barsEnd) {
+        for (int b = 0; b < 7; ++b) {
+          const int x0 = b * width / 7;
+          const int x1 = (b + 1) * width / 7;
+          fillSpan(row + static_cast<size_t>(x0) * 4, static_cast<size_t>(x1 - x0), kBars[b], useSimd);
+        }
+      } else if (y < rampEnd) {
+        lerpSpan(row, static_cast<size_t>(width), kBlack, kWhite, ramp.data(), useSimd);
+      } else {
+        fillSpan(row, static_cast<size_t>(width), kDark, useSimd);
+      }
+      for (int x = 0; x < width; x += gridX) {
+        std::memcpy(row + static_cast<size_t>(x) * 4, kGrid, 4);
+      }
+      std::memcpy(row + static_cast<size_t>(width - 1) * 4, kGrid, 4);
+      std::memcpy(row + static_cast<size_t>(width / 2) * 4, kWhite, 4);
+    }
+  }
+};
+
+// 5x7 bitmap glyphs, one byte per row with bit 4 as the leftmost column.
+struct Glyph {
+  char c;
+  uint8_t rows[7];
+};
+
+constexpr Glyph kFont[] = {
+    {' ', {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, {'A', {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+    {'B', {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}}, {'C', {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}},
+    {'D', {0x1E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1E}}, {'E', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}},
+    {'F', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}}, {'G', {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}},
+    {'H', {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}}, {'I', {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+    {'J', {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}}, {'K', {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}},
+    {'L', {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}}, {'M', {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}},
+    {'N', {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}}, {'O', {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'P', {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}}, {'Q', {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}},
+    {'R', {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}}, {'S', {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}},
+    {'T', {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}}, {'U', {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'V', {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}}, {'W', {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}},
+    {'X', {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}}, {'Y', {0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x04}},
+    {'Z', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}}, {'0', {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}},
+    {'1', {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}}, {'2', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}},
+    {'3', {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}}, {'4', {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}},
+    {'5', {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}}, {'6', {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}},
+    {'7', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}}, {'8', {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}},
+    {'9', {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}}, {'.', {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}},
+    {',', {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}}, {':', {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}},
+    {'!', {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}}, {'?', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}},
+    {'-', {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}}, {'+', {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}},
+    {'/', {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}}, {'\'', {0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00}},
+};
+
+// Lowercase letters render as uppercase; characters without a glyph render as '?'.
+const uint8_t* glyphRows(char c) {
+  const char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  const uint8_t* fallback = nullptr;
+  for (const auto& glyph : kFont) {
+    if (glyph.c == upper) {
+      return glyph.rows;
+    }
+    if (glyph.c == '?') {
+      fallback = glyph.rows;
+    }
+  }
+  return fallback;
+}
+
+// Ticker text in the 5x7 font, vertically centred. Scrolling text enters at the right edge
+// and leaves at the left before repeating; static text is centred.
+class ScrollingTextGenerator : public Generator {
+ public:
+  explicit ScrollingTextGenerator(const GeneratedFeedConfig& config)
+      : width_(config.width),
+        pixel_(config.scale > 0.0f ? std::max(1, static_cast<int>(std::lround(config.scale)))
+                                   : std::max(1, config.height / 24)),
+        speed_(config.speed) {
+    const auto colors = colorsOr(config, {GeneratorColor{255, 255, 255, 255}, GeneratorColor{0, 0, 0, 255}});
+    toBytes(colors[0], text_);
+    toBytes(colors[1], background_);
+    for (char c : config.text) {
+      glyphs_.push_back(glyphRows(c));
+    }
+    advance_ = 6 * pixel_;
+    textWidth_ = static_cast<int64_t>(glyphs_.size()) * advance_;
+    top_ = (config.height - 7 * pixel_) / 2;
+  }
+
+  uint64_t contentKey(double seconds) const override {
+    return speed_ != 0.0f ? static_cast<uint64_t>(textX(seconds)) : 0;
+  }
+
+  void prepare(double seconds) override { textX_ = textX(seconds); }
+
+  void renderRows(const MutableImageView& frame, int rowBegin, int rowEnd, bool useSimd) const override {
+    for (int y = rowBegin; y < rowEnd; ++y) {
+      uint8_t* row = frame.row(y);
+      fillSpan(row, static_cast<size_t>(width_), background_, useSimd);
+      const int fontY = y - top_;
+      if (fontY < 0 || fontY >= 7 * pixel_) {
+        continue;
+      }
+      const int glyphRow = fontY / pixel_;
+      const size_t first = textX_ < 0 ? static_cast<size_t>(-textX_ / advance_) : 0;
+      for (size_t i = first; i < glyphs_.size(); ++i) {
+        const int64_t glyphX = textX_ + static_cast<int64_t>(i) * advance_;
+        if (glyphX >= width_) {
+          break;
+        }
+        const uint8_t bits = glyphs_[i][glyphRow];
+        for (int c = 0; c < 5; ++c) {
+          if ((bits & (0x10 >> c)) == 0) {
+            continue;
+          }
+          const int64_t x0 = std::max<int64_t>(0, glyphX + c * pixel_);
+          const int64_t x1 = std::min<int64_t>(width_, glyphX + (c + 1) * pixel_);
+          if (x1 > x0) {
+            fillSpan(row + x0 * 4, static_cast<size_t>(x1 - x0), text_, useSimd);
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  int64_t textX(double seconds) const {
+    if (speed_ == 0.0f) {
+      return (width_ - textWidth_) / 2;
+    }
+    const double period = static_cast<double>(textWidth_ + width_);
+    return width_ - static_cast<int64_t>(wrap(std::floor(seconds * speed_), period));
+  }
+
+  int width_;
+  int pixel_;
+  float speed_;
+  uint8_t text_[4]{};
+  uint8_t background_[4]{};
+  std::vector<const uint8_t*> glyphs_{};
+  int advance_{6};
+  int64_t textWidth_{0};
+  int top_{0};
+  int64_t textX_{0};
+};
+}  // namespace
+
+std::unique_ptr<Generator> makeGenerator(const GeneratedFeedConfig& config) {
+  switch (config.generator) {
+    case GeneratorKind::ColorField:
+      return std::make_unique<ColorFieldGenerator>(config);
+    case GeneratorKind::Gradient:
+      return std::make_unique<GradientGenerator>(config);
+    case GeneratorKind::Noise:
+      return std::make_unique<NoiseGenerator>(config);
+    case GeneratorKind::TestPattern:
+      return std::make_unique<TestPatternGenerator>();
+    case GeneratorKind::ScrollingText:
+      return std::make_unique<ScrollingTextGenerator>(config);
+  }
+  return std::make_unique<ColorFieldGenerator>(config);
+}
+
+}  // namespace projection::renderer
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <projection/core/Feed.h>
+
+#include "compositor/RgbaImage.h"
+
+namespace projection::renderer {
+
+// Procedural frame source behind a Generated feed (see GeneratedFeedConfig for the options of
+// each built-in generator). A frame is produced in two steps so rows can be rendered in
+// parallel: prepare() runs once on the calling thread, then renderRows() is called for
+// disjoint row bands, possibly concurrently.
+class Generator {
+ public:
+  virtual ~Generator() = default;
+
+  // Identifies the frame shown at `seconds`: equal keys mean identical pixels, so callers can
+  // skip rendering and uploading. Static generators always return 0.
+  virtual uint64_t contentKey(double seconds) const = 0;
+  // Per-frame setup (color lookup tables, offsets) for the frame at `seconds`.
+  virtual void prepare(double seconds) = 0;
+  // Renders rows [rowBegin, rowEnd) of the prepared frame; `frame` has the configured size.
+  virtual void renderRows(const MutableImageView& frame, int rowBegin, int rowEnd, bool useSimd) const = 0;
+};
+
+std::unique_ptr<Generator> makeGenerator(const projection::core::GeneratedFeedConfig& config);
+
+}  // namespace projection::renderer
@@ -0,0 +1,383 @@
+#include "headless/HeadlessRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "net/RendererClient.h"
+#include "video/StubVideoSource.h"
+
+namespace projection::renderer {
+
+using projection::core::FeedId;
+using projection::core::LoadSceneDefinitionMessage;
+using projection::core::RendererMessage;
+using projection::core::RendererMessageType;
+using projection::core::Scene;
+using projection::core::SceneId;
+using projection::core::Surface;
+using projection::core::SurfaceId;
+using projection::core::Vec2;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr double kSyntheticSampleRate = 44100.0;
+constexpr size_t kSyntheticAudioChunk = 256;
+constexpr double kTwoPi = 6.283185307179586;
+
+void printSummary(std::ostream& out, const char* label, const TimingSummary& summary) {
+  out << "  " << std::left << std::setw(10) << label << std::right << std::fixed << std::setprecision(4)
+      << " mean " << summary.mean << "  p50 " << summary.p50 << "  p95 " << summary.p95 << "  p99 " << summary.p99
+      << "  max " << summary.max << " ms\n";
+}
+}  // namespace
+
+LoadSceneDefinitionMessage makeSyntheticScene(int surfaces, int feeds) {
+  if (surfaces < 0 || feeds <= 0) {
+    throw std::runtime_error("Synthetic scene needs a non-negative surface count and at least one feed");
+  }
+
+  LoadSceneDefinitionMessage definition;
+  for (int i = 0; i < feeds; ++i) {
+    const std::string id = "synthetic-feed-" + std::to_string(i);
+    definition.feeds.push_back(projection::core::makeVideoFileFeed(FeedId{id}, id, "synthetic://" + id));
+  }
+
+  // Square-ish grid over the normalized -1..1 output, one quad per cell.
+  const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(surfaces)))));
+  const int rows = std::max(1, (surfaces + columns - 1) / columns);
+  const float cellW = 2.0f / static_cast<float>(columns);
+  const float cellH = 2.0f / static_cast<float>(rows);
+
+  std::vector<Surface> sceneSurfaces;
+  sceneSurfaces.reserve(static_cast<size_t>(surfaces));
+  for (int i = 0; i < surfaces; ++i) {
+    const float x0 = -1.0f + cellW * static_cast<float>(i % columns);
+    const float y0 = -1.0f + cellH * static_cast<float>(i / columns);
+    sceneSurfaces.emplace_back(SurfaceId{"synthetic-surface-" + std::to_string(i)}, "Synthetic",
+                               std::vector<Vec2>{Vec2{x0, y0}, Vec2{x0 + cellW, y0}, Vec2{x0 + cellW, y0 + cellH},
+                                                 Vec2{x0, y0 + cellH}},
+                               definition.feeds[static_cast<size_t>(i % feeds)].getId());
+  }
+  definition.scene = Scene{SceneId{"synthetic-scene"}, "Synthetic", "Generated by the headless renderer",
+                           std::move(sceneSurfaces)};
+  return definition;
+}
+
+LoadSceneDefinitionMessage loadSceneDefinitionFile(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("Cannot open scene file: " + path);
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+
+  nlohmann::json json;
+  try {
+    json = nlohmann::json::parse(buffer.str());
+  } catch (const nlohmann::json::parse_error& ex) {
+    throw std::runtime_error("Invalid JSON in scene file " + path + ": " + ex.what());
+  }
+
+  if (json.contains("type")) {
+    RendererMessage message = json.get<RendererMessage>();
+    if (message.type != RendererMessageType::LoadSceneDefinition || !message.loadSceneDefinition) {
+      throw std::runtime_error("Scene file message is not a LoadSceneDefinition: " + path);
+    }
+    return std::move(*message.loadSceneDefinition);
+  }
+  return json.get<LoadSceneDefinitionMessage>();
+}
+
+namespace {
+VideoSourceFactory makeSkewedStubFactory(double skew) {
+  if (skew == 0.0) {
+    return makeStubVideoSourceFactory();
+  }
+  return [skew, created = 0]() mutable -> std::unique_ptr<VideoSource> {
+    auto source = std::make_unique<StubVideoSource>();
+    source->setRateSkew(created++ % 2 == 0 ? skew : -skew);
+    return source;
+  };
+}
+}  // namespace
+
+HeadlessRunner::HeadlessRunner(HeadlessOptions options)
+    : options_(std::move(options)), runtime_(makeSkewedStubFactory(options_.decoderSkew), options_.verbose) {
+  runtime_.setDriftCorrection(options_.driftCorrection);
+  runtime_.framePool().setBudget(options_.framePoolBudgetBytes);
+  runtime_.setVideoBudget(options_.videoBudgetBytes);
+  QualityGovernorOptions quality;
+  quality.targetFps = options_.targetFps;
+  runtime_.setQualityGovernor(quality);
+  AudioAnalyzerOptions audio;
+  audio.sampleRate = kSyntheticSampleRate;
+  runtime_.setAudioAnalysis(audio);
+  singleOutput_ = fullSceneViewport(options_.outputWidth, options_.outputHeight);
+  singleOutput_.blend = options_.blend;
+  if (options_.compositeWidth > 0 && options_.compositeHeight > 0) {
+    compositorPool_ = std::make_unique<WorkerPool>(options_.compositeThreads);
+    compositor_ = std::make_unique<SoftwareCompositor>(compositorPool_.get());
+  }
+}
+
+HeadlessReport HeadlessRunner::run() {
+  if (!options_.snapshotFile.empty()) {
+    std::string error;
+    if (!runtime_.restoreSceneSnapshot(options_.snapshotFile, error) && options_.verbose) {
+      std::cerr << "[renderer-headless] no scene snapshot restored: " << error << std::endl;
+    }
+    runtime_.enableSceneSnapshots(options_.snapshotFile);
+  }
+  // Local scenes go through the same queue as network commands so the message stage is exercised.
+  if (!options_.sceneFile.empty()) {
+    RendererMessage message{};
+    message.type = RendererMessageType::LoadSceneDefinition;
+    message.commandId = "headless-scene-file";
+    message.loadSceneDefinition = loadSceneDefinitionFile(options_.sceneFile);
+    runtime_.handle(std::move(message));
+  } else if (options_.syntheticSurfaces > 0) {
+    RendererMessage message{};
+    message.type = RendererMessageType::LoadSceneDefinition;
+    message.commandId = "headless-synthetic";
+    message.loadSceneDefinition = makeSyntheticScene(options_.syntheticSurfaces, options_.syntheticFeeds);
+    runtime_.handle(std::move(message));
+  }
+
+  std::unique_ptr<RendererClient> client;
+  if (options_.connect) {
+    client = std::make_unique<RendererClient>(runtime_, options_.host, options_.port, options_.name,
+                                              options_.verbose);
+    client->setLabels(options_.group, options_.tags);
+    client->start();
+  }
+  if (options_.audioThread) {
+    runtime_.startAudioAnalysis();
+  }
+  std::atomic<bool> midiStop{false};
+  std::thread midiThread;
+  if (options_.syntheticMidiHz > 0.0) {
+    midiThread = std::thread([this, &midiStop]() { sendSyntheticMidi(midiStop); });
+  }
+
+  const size_t reserve = options_.frames > 0 ? static_cast<size_t>(options_.frames) : 0;
+  TimingSeries messages(reserve);
+  TimingSeries video(reserve);
+  TimingSeries audio(reserve);
+  TimingSeries prepare(reserve);
+  TimingSeries composite(reserve);
+  TimingSeries frame(reserve);
+  TimingSeries midiLatency(reserve);
+
+  HeadlessReport report;
+  const auto runStart = Clock::now();
+  while (!stopRequested_ && (options_.frames == 0 || report.frames < options_.frames)) {
+    if (client && !client->running()) {
+      if (!client->lastError().empty()) {
+        runtime_.setLastError(client->lastError());
+      }
+      break;
+    }
+
+    const auto frameStart = Clock::now();
+    if (options_.syntheticAudio) {
+      feedSyntheticAudio();
+    }
+    runtime_.update(options_.timestepSeconds);
+    // With outputs configured every output gets its own culled draw list; the preview shows
+    // the first one.
+    size_t surfacesDrawn = 0;
+    size_t batches = 0;
+    size_t culled = 0;
+    const DrawList* previewList = nullptr;
+    const OutputViewport* previewOutput = &singleOutput_;
+    if (options_.outputs.empty()) {
+      previewList = &runtime_.prepareFrame(options_.outputWidth, options_.outputHeight);
+      surfacesDrawn = previewList->surfaces.size();
+      batches = previewList->batches.size();
+    } else {
+      const auto& drawLists = runtime_.prepareOutputs(options_.outputs);
+      for (const auto& list : drawLists) {
+        surfacesDrawn += list.surfaces.size();
+        batches += list.batches.size();
+        culled += list.culledSurfaces;
+      }
+      previewList = &drawLists.front();
+      previewOutput = &options_.outputs.front();
+    }
+    const auto compositeStart = Clock::now();
+    const bool composited = compositor_ && runtime_.qualityLevel().preview;
+    if (composited) {
+      compositeFrame(previewList->surfaces, *previewOutput);
+    }
+    const auto frameEnd = Clock::now();
+    const double frameMs = std::chrono::duration<double, std::milli>(frameEnd - frameStart).count();
+    runtime_.recordFrameTime(frameMs);
+
+    const auto& timings = runtime_.lastTimings();
+    messages.add(timings.messagesMs);
+    video.add(timings.videoMs);
+    audio.add(timings.audioMs);
+    if (runtime_.midiStats().lastFrameEvents > 0) {
+      midiLatency.add(runtime_.midiStats().lastFrameMaxLatencyMs);
+    }
+    prepare.add(timings.prepareMs);
+    if (composited) {
+      composite.add(std::chrono::duration<double, std::milli>(frameEnd - compositeStart).count());
+    }
+    frame.add(frameMs);
+    report.surfacesDrawn = surfacesDrawn;
+    report.batches = batches;
+    report.culledSurfaces = culled;
+    ++report.frames;
+  }
+  report.wallSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+
+  if (client) {
+    client->stop();
+  }
+  runtime_.stopAudioAnalysis();
+  runtime_.flushSceneSnapshots();
+  midiStop = true;
+  if (midiThread.joinable()) {
+    midiThread.join();
+  }
+  if (compositedFrame_ && !options_.previewFile.empty()) {
+    writePpm(compositedFrame_.view(), options_.previewFile);
+  }
+
+  report.simulatedSeconds = runtime_.elapsedSeconds();
+  report.outputs = options_.outputs.size();
+  for (const auto& entry : runtime_.renderState().videoFeeds()) {
+    const auto& drift = entry.second.drift;
+    report.maxDriftMs = std::max(report.maxDriftMs, std::fabs(drift.driftSeconds) * 1000.0);
+    report.resyncs += drift.resyncCount;
+  }
+  report.framePool = runtime_.framePool().stats();
+  report.videoResidency = runtime_.renderState().videoResidency().stats();
+  report.qualityLevel = runtime_.qualityLevel().name;
+  report.qualityChanges = runtime_.qualityGovernor().changeCount();
+  report.audioBlocks = runtime_.audioFeatures().blocks;
+  report.audioOnsets = runtime_.audioFeatures().onsetCount;
+  report.midi = runtime_.midiStats();
+  report.restoredSnapshot = runtime_.restoredFromSnapshot();
+  if (runtime_.sceneSnapshotWriter()) {
+    report.snapshots = runtime_.sceneSnapshotWriter()->stats();
+  }
+  report.coalescing = runtime_.coalescingStats();
+  report.messages = messages.summarize();
+  report.video = video.summarize();
+  report.audio = audio.summarize();
+  report.prepare = prepare.summarize();
+  report.composite = composite.summarize();
+  report.frame = frame.summarize();
+  report.midiLatency = midiLatency.summarize();
+  return report;
+}
+
+void HeadlessRunner::sendSyntheticMidi(const std::atomic<bool>& stop) {
+  // Paced against absolute deadlines like a real controller; a ramp on CC1, channel 1.
+  const auto interval = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / options_.syntheticMidiHz));
+  auto next = Clock::now();
+  uint8_t value = 0;
+  while (!stop.load(std::memory_order_relaxed)) {
+    MidiEvent event;
+    event.status = kMidiControlChange;
+    event.data1 = 1;
+    event.data2 = value;
+    value = static_cast<uint8_t>((value + 1) & 0x7F);
+    runtime_.writeMidi(event);
+    next += interval;
+    std::this_thread::sleep_until(next);
+  }
+}
+
+void HeadlessRunner::feedSyntheticAudio() {
+  // A 220 Hz tone with a slow amplitude swell, written in audio-callback sized chunks.
+  audioChunk_.resize(kSyntheticAudioChunk);
+  size_t remaining = static_cast<size_t>(options_.timestepSeconds * kSyntheticSampleRate);
+  while (remaining > 0) {
+    const size_t count = std::min(remaining, audioChunk_.size());
+    for (size_t i = 0; i < count; ++i) {
+      const double t = audioPhase_ / kSyntheticSampleRate;
+      const double envelope = 0.5 + 0.5 * std::sin(kTwoPi * 0.25 * t);
+      audioChunk_[i] = static_cast<float>(envelope * std::sin(kTwoPi * 220.0 * t));
+      audioPhase_ += 1.0;
+    }
+    runtime_.writeAudio(audioChunk_.data(), count, 1);
+    remaining -= count;
+  }
+}
+
+void HeadlessRunner::compositeFrame(const std::vector<SurfaceDraw>& drawList, const OutputViewport& output) {
+  // The draw list is in output pixels; rescale it to the composite resolution.
+  const auto& feeds = runtime_.renderState().videoFeeds();
+  buildCompositorLayers(
+      drawList,
+      [&](const std::string& feedId) {
+        auto it = feeds.find(feedId);
+        return it == feeds.end() ? ImageView{} : it->second.source->cpuFrame();
+      },
+      compositorLayers_);
+  const float scaleX = static_cast<float>(options_.compositeWidth) / static_cast<float>(output.width);
+  const float scaleY = static_cast<float>(options_.compositeHeight) / static_cast<float>(output.height);
+  for (auto& layer : compositorLayers_) {
+    for (auto& p : layer.positions) {
+      p.x *= scaleX;
+      p.y *= scaleY;
+    }
+  }
+  // The previous preview goes back to the pool first, so every frame after the first is a hit.
+  compositedFrame_.reset();
+  compositedFrame_ = runtime_.framePool().acquire(options_.compositeWidth, options_.compositeHeight);
+  if (compositedFrame_) {
+    compositor_->composite(compositorLayers_, compositedFrame_.mutableView());
+    // Edge blending is the last stage; the mask is only rebuilt when the blend changes.
+    previewBlend_.configure(options_.compositeWidth, options_.compositeHeight,
+                            scaleEdgeBlend(output.blend, scaleX, scaleY));
+    previewBlend_.apply(compositedFrame_.mutableView());
+  }
+}
+
+void printHeadlessReport(const HeadlessReport& report, std::ostream& out) {
+  out << "[renderer-headless] frames=" << report.frames << " surfaces=" << report.surfacesDrawn
+      << " batches=" << report.batches << std::fixed
+      << std::setprecision(3) << " wall=" << report.wallSeconds << "s simulated=" << report.simulatedSeconds
+      << "s fps=" << std::setprecision(1) << report.framesPerSecond() << " drift=" << std::setprecision(3)
+      << report.maxDriftMs << "ms resyncs=" << report.resyncs << " framePool=" << report.framePool.hits << "/"
+      << (report.framePool.hits + report.framePool.misses) << " hits peak=" << std::setprecision(1)
+      << static_cast<double>(report.framePool.peakBytes) / (1024.0 * 1024.0) << "MB players="
+      << report.videoResidency.activePlayers << "+" << report.videoResidency.warmPlayers << " warm evictions="
+      << report.videoResidency.evictions << " outputs=" << std::max<size_t>(1, report.outputs)
+      << " culled=" << report.culledSurfaces << " quality=" << report.qualityLevel << " (" << report.qualityChanges
+      << " changes) audio=" << report.audioBlocks << " blocks/" << report.audioOnsets
+      << " onsets midi=" << report.midi.applied << "/" << report.midi.received << " applied (" << report.midi.dropped
+      << " dropped) snapshot=" << (report.restoredSnapshot ? "restored" : "none") << " ("
+      << report.snapshots.written << " written) commands="
+      << report.coalescing.applied << "/" << report.coalescing.received << " applied\n";
+  printSummary(out, "messages", report.messages);
+  printSummary(out, "video", report.video);
+  printSummary(out, "audio", report.audio);
+  if (report.midiLatency.count > 0) {
+    printSummary(out, "midi", report.midiLatency);
+  }
+  printSummary(out, "prepare", report.prepare);
+  if (report.composite.count > 0) {
+    printSummary(out, "composite", report.composite);
+  }
+  printSummary(out, "frame", report.frame);
+}
+
+}  // namespace projection::renderer
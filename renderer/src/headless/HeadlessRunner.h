@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <projection/core/RendererProtocol.h>
+
+#include "OutputViewport.h"
+#include "RendererRuntime.h"
+#include "SceneSnapshot.h"
+#include "compositor/EdgeBlend.h"
+#include "compositor/RgbaImage.h"
+#include "compositor/SoftwareCompositor.h"
+#include "util/FramePool.h"
+#include "util/TimingStats.h"
+#include "util/WorkerPool.h"
+#include "video/VideoResidency.h"
+
+namespace projection::renderer {
+
+struct HeadlessOptions {
+  std::string host{"127.0.0.1"};
+  int port{5050};
+  std::string name{"renderer-headless"};
+  // Announced in the Hello for group/tag addressing.
+  std::string group{};
+  std::vector<std::string> tags{};
+  // Without a server connection the runner only plays the scene from sceneFile or the synthetic scene.
+  bool connect{true};
+  std::string sceneFile{};
+  int syntheticSurfaces{0};
+  int syntheticFeeds{4};
+  bool syntheticAudio{false};
+  // Analyse audio on its own thread as the windowed renderer does; off by default so the
+  // features (and the audio-reactive scale) stay deterministic, analysed inline each frame.
+  bool audioThread{false};
+  // A thread sending CC1 at this rate (events per second, 0 = none) through the MIDI ring,
+  // to measure event-to-frame latency under a flooding controller.
+  double syntheticMidiHz{0.0};
+  // Restored before the scene file / synthetic scene are applied and rewritten as the scene
+  // changes (flushed at the end of the run); empty disables snapshots.
+  std::string snapshotFile{};
+  // 0 runs until the server connection closes (or forever when offline).
+  uint64_t frames{600};
+  double timestepSeconds{1.0 / 60.0};
+  float outputWidth{1920.0f};
+  float outputHeight{1080.0f};
+  // Outputs prepared each frame instead of the single outputWidth x outputHeight one.
+  std::vector<OutputViewport> outputs{};
+  // Edge blend of the single output (outputs carry their own).
+  EdgeBlendSettings blend{};
+  // Software-composite every frame at this size (0 = skip); the last frame goes to previewFile.
+  int compositeWidth{0};
+  int compositeHeight{0};
+  size_t compositeThreads{0};
+  std::string previewFile{};
+  DriftCorrectionOptions driftCorrection{};
+  // Stub decoders run fast/slow by this fraction (alternating sign per feed) so long runs
+  // exercise drift correction against the master clock.
+  double decoderSkew{0.0};
+  size_t framePoolBudgetBytes{FramePool::kDefaultBudgetBytes};
+  size_t videoBudgetBytes{VideoResidency::kDefaultBudgetBytes};
+  // Frame-time target for the quality governor; 0 keeps full quality (the runner is
+  // unthrottled, so only slow frames count against it).
+  double targetFps{0.0};
+  bool verbose{false};
+};
+
+struct HeadlessReport {
+  uint64_t frames{0};
+  double wallSeconds{0.0};
+  double simulatedSeconds{0.0};
+  size_t surfacesDrawn{0};
+  // Draw calls the windowed renderer would issue for the last frame.
+  size_t batches{0};
+  // Configured outputs (0 = the single full-scene output) and surfaces culled across them.
+  size_t outputs{0};
+  size_t culledSurfaces{0};
+  // Largest feed drift against the master clock at the end of the run, and total resync seeks.
+  double maxDriftMs{0.0};
+  uint64_t resyncs{0};
+  FramePoolStats framePool{};
+  VideoResidencyStats videoResidency{};
+  std::string qualityLevel{};
+  uint64_t qualityChanges{0};
+  // Audio blocks analysed and onsets detected.
+  uint64_t audioBlocks{0};
+  uint64_t audioOnsets{0};
+  MidiStats midi{};
+  bool restoredSnapshot{false};
+  SceneSnapshotWriterStats snapshots{};
+  CoalescingStats coalescing{};
+  TimingSummary messages{};
+  TimingSummary video{};
+  TimingSummary audio{};
+  TimingSummary prepare{};
+  TimingSummary composite{};
+  TimingSummary frame{};
+  // Per frame with MIDI input: latency of the oldest event drained.
+  TimingSummary midiLatency{};
+
+  double framesPerSecond() const { return wallSeconds > 0.0 ? static_cast<double>(frames) / wallSeconds : 0.0; }
+};
+
+// LoadSceneDefinition with `surfaces` quads laid out on a grid, cycling over `feeds` video feeds.
+projection::core::LoadSceneDefinitionMessage makeSyntheticScene(int surfaces, int feeds);
+
+// Reads a scene file: either a full renderer protocol message or a bare {"scene", "feeds"} payload.
+projection::core::LoadSceneDefinitionMessage loadSceneDefinitionFile(const std::string& path);
+
+// Drives RendererRuntime with StubVideoSource and no graphics backend, stepping a fixed
+// timestep as fast as the CPU allows and recording per-stage frame timings.
+class HeadlessRunner {
+ public:
+  explicit HeadlessRunner(HeadlessOptions options);
+
+  HeadlessReport run();
+  // Asks a running loop to stop after the current frame; safe from a signal handler.
+  void requestStop() { stopRequested_ = true; }
+
+  RendererRuntime& runtime() { return runtime_; }
+  ImageView compositedFrame() const { return compositedFrame_.view(); }
+
+ private:
+  void feedSyntheticAudio();
+  void sendSyntheticMidi(const std::atomic<bool>& stop);
+  // Composites a draw list prepared for `output` and applies the output's edge blend.
+  void compositeFrame(const std::vector<SurfaceDraw>& drawList, const OutputViewport& output);
+
+  HeadlessOptions options_;
+  RendererRuntime runtime_;
+  std::atomic<bool> stopRequested_{false};
+  double audioPhase_{0.0};
+  std::vector<float> audioChunk_{};
+
+  std::unique_ptr<WorkerPool> compositorPool_{};
+  std::unique_ptr<SoftwareCompositor> compositor_{};
+  std::vector<CompositorLayer> compositorLayers_{};
+  FrameRef compositedFrame_{};
+  // Stands in for options_.outputs when none are configured.
+  OutputViewport singleOutput_{};
+  EdgeBlendMask previewBlend_{};
+};
+
+void printHeadlessReport(const HeadlessReport& report, std::ostream& out);
+
+}  // namespace projection::renderer
@@ -0,0 +1,201 @@
+#include "headless/HeadlessRunner.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace {
+projection::renderer::HeadlessRunner* activeRunner = nullptr;
+
+void handleSignal(int) {
+  if (activeRunner) {
+    activeRunner->requestStop();
+  }
+}
+
+std::string envOr(const char* name, std::string fallback) {
+  const char* value = std::getenv(name);
+  if (value && *value) {
+    return value;
+  }
+  return fallback;
+}
+
+void printUsage() {
+  std::cerr << "Usage: renderer_headless [--server-host H] [--server-port P] [--name N] [--offline]\n"
+               "                         [--group G] [--tag T]...\n"
+               "                         [--scene-file path.json] [--synthetic-surfaces N] [--synthetic-feeds N]\n"
+               "                         [--synthetic-audio] [--audio-thread] [--synthetic-midi HZ] [--frames N] [--dt seconds]\n"
+               "                         [--snapshot-file path]\n"
+               "                         [--width px] [--height px] [--composite WxH] [--composite-threads N]\n"
+               "                         [--preview-file frame.ppm] [--drift-tolerance-ms ms] [--decoder-skew fraction]\n"
+               "                         [--frame-pool-mb MB] [--video-budget-mb MB] [--target-fps N]\n"
+               "                         [--output WxH+X+Y:left,top,right,bottom[:rotation]]... [--split N[:overlap]]\n"
+               "                         [--blend left=W[/gamma[/curve]],right=...,gamma=G,curve=P,black=B]\n"
+               "                         [--verbose]\n";
+}
+
+// Accepts both "--flag value" and "--flag=value".
+bool matchValue(const std::string& arg, const std::string& flag, int& i, int argc, char* argv[], std::string& out) {
+  if (arg == flag && i + 1 < argc) {
+    out = argv[++i];
+    return true;
+  }
+  if (arg.rfind(flag + "=", 0) == 0) {
+    out = arg.substr(flag.size() + 1);
+    return true;
+  }
+  return false;
+}
+
+projection::renderer::HeadlessOptions parseArgs(int argc, char* argv[]) {
+  projection::renderer::HeadlessOptions options;
+  options.host = envOr("RENDERER_HOST", options.host);
+  options.port = std::stoi(envOr("RENDERER_PORT", std::to_string(options.port)));
+  options.name = envOr("RENDERER_NAME", "renderer-headless-" + std::to_string(static_cast<long long>(::getpid())));
+
+  size_t splitCount = 0;
+  float splitOverlap = 0.0f;
+  std::string splitBlend;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg(argv[i]);
+    std::string value;
+    if (matchValue(arg, "--server-host", i, argc, argv, value)) {
+      options.host = value;
+    } else if (matchValue(arg, "--server-port", i, argc, argv, value) ||
+               matchValue(arg, "--port", i, argc, argv, value)) {
+      options.port = std::stoi(value);
+    } else if (matchValue(arg, "--name", i, argc, argv, value)) {
+      options.name = value;
+    } else if (matchValue(arg, "--group", i, argc, argv, value)) {
+      options.group = value;
+    } else if (matchValue(arg, "--tag", i, argc, argv, value)) {
+      options.tags.push_back(value);
+    } else if (matchValue(arg, "--scene-file", i, argc, argv, value)) {
+      options.sceneFile = value;
+    } else if (matchValue(arg, "--synthetic-surfaces", i, argc, argv, value)) {
+      options.syntheticSurfaces = std::stoi(value);
+    } else if (matchValue(arg, "--synthetic-feeds", i, argc, argv, value)) {
+      options.syntheticFeeds = std::stoi(value);
+    } else if (matchValue(arg, "--frames", i, argc, argv, value)) {
+      options.frames = std::stoull(value);
+    } else if (matchValue(arg, "--dt", i, argc, argv, value)) {
+      options.timestepSeconds = std::stod(value);
+    } else if (matchValue(arg, "--width", i, argc, argv, value)) {
+      options.outputWidth = std::stof(value);
+    } else if (matchValue(arg, "--height", i, argc, argv, value)) {
+      options.outputHeight = std::stof(value);
+    } else if (matchValue(arg, "--composite", i, argc, argv, value)) {
+      const auto separator = value.find('x');
+      if (separator == std::string::npos) {
+        throw std::runtime_error("--composite expects WIDTHxHEIGHT, got " + value);
+      }
+      options.compositeWidth = std::stoi(value.substr(0, separator));
+      options.compositeHeight = std::stoi(value.substr(separator + 1));
+    } else if (matchValue(arg, "--composite-threads", i, argc, argv, value)) {
+      options.compositeThreads = static_cast<size_t>(std::stoul(value));
+    } else if (matchValue(arg, "--drift-tolerance-ms", i, argc, argv, value)) {
+      options.driftCorrection.toleranceSeconds = std::stod(value) / 1000.0;
+    } else if (matchValue(arg, "--decoder-skew", i, argc, argv, value)) {
+      options.decoderSkew = std::stod(value);
+    } else if (matchValue(arg, "--frame-pool-mb", i, argc, argv, value)) {
+      options.framePoolBudgetBytes = static_cast<size_t>(std::stoull(value)) << 20;
+    } else if (matchValue(arg, "--synthetic-midi", i, argc, argv, value)) {
+      options.syntheticMidiHz = std::stod(value);
+    } else if (matchValue(arg, "--snapshot-file", i, argc, argv, value)) {
+      options.snapshotFile = value;
+    } else if (matchValue(arg, "--target-fps", i, argc, argv, value)) {
+      options.targetFps = std::stod(value);
+    } else if (matchValue(arg, "--video-budget-mb", i, argc, argv, value)) {
+      options.videoBudgetBytes = static_cast<size_t>(std::stoull(value)) << 20;
+    } else if (matchValue(arg, "--output", i, argc, argv, value)) {
+      projection::renderer::OutputViewport output;
+      output.name = "output-" + std::to_string(options.outputs.size() + 1);
+      std::string error;
+      if (!projection::renderer::parseOutputViewport(value, output, error)) {
+        throw std::runtime_error(error);
+      }
+      options.outputs.push_back(output);
+    } else if (matchValue(arg, "--split", i, argc, argv, value)) {
+      // N side-by-side outputs of --width x --height sharing `overlap` scene units.
+      const auto separator = value.find(':');
+      splitCount = static_cast<size_t>(std::stoul(value.substr(0, separator)));
+      splitOverlap = separator == std::string::npos ? 0.0f : std::stof(value.substr(separator + 1));
+    } else if (matchValue(arg, "--blend", i, argc, argv, value)) {
+      // Applies to the preceding --output, else to the --split outputs or the single output.
+      if (!options.outputs.empty()) {
+        std::string error;
+        if (!projection::renderer::parseEdgeBlend(value, options.outputs.back().blend, error)) {
+          throw std::runtime_error(error);
+        }
+      } else {
+        splitBlend = value;
+      }
+    } else if (matchValue(arg, "--preview-file", i, argc, argv, value)) {
+      options.previewFile = value;
+    } else if (arg == "--offline") {
+      options.connect = false;
+    } else if (arg == "--synthetic-audio") {
+      options.syntheticAudio = true;
+    } else if (arg == "--audio-thread") {
+      options.audioThread = true;
+    } else if (arg == "--verbose") {
+      options.verbose = true;
+    } else if (arg == "--help" || arg == "-h") {
+      printUsage();
+      std::exit(0);
+    } else {
+      std::cerr << "Unknown argument: " << arg << std::endl;
+      printUsage();
+      std::exit(2);
+    }
+  }
+  // Applied after the loop so --width/--height (and --blend) may come after --split.
+  if (splitCount > 0) {
+    options.outputs = projection::renderer::partitionSceneHorizontally(
+        splitCount, static_cast<int>(options.outputWidth), static_cast<int>(options.outputHeight), splitOverlap);
+  }
+  if (!splitBlend.empty()) {
+    std::string error;
+    if (options.outputs.empty()) {
+      if (!projection::renderer::parseEdgeBlend(splitBlend, options.blend, error)) {
+        throw std::runtime_error(error);
+      }
+    }
+    for (auto& output : options.outputs) {
+      if (!projection::renderer::parseEdgeBlend(splitBlend, output.blend, error)) {
+        throw std::runtime_error(error);
+      }
+    }
+  }
+  return options;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    const auto options = parseArgs(argc, argv);
+    projection::renderer::HeadlessRunner runner(options);
+    activeRunner = &runner;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    const auto report = runner.run();
+    activeRunner = nullptr;
+    printHeadlessReport(report, std::cout);
+
+    const auto status = runner.runtime().status();
+    if (!status.lastError.empty()) {
+      std::cerr << "[renderer-headless] last error: " << status.lastError << std::endl;
+      return 1;
+    }
+    return 0;
+  } catch (const std::exception& ex) {
+    std::cerr << "[renderer-headless] " << ex.what() << std::endl;
+    return 1;
+  }
+}
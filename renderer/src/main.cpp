@@ -2,9 +2,12 @@
 
 #include <ofMain.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <cstdlib>
 #include <string>
+#include <utility>
 #include <vector>
 #include <unistd.h>
 
@@ -14,6 +17,17 @@ struct Args {
   int port;
   std::string name;
   bool verbose;
+  size_t videoBudgetMb;
+  double targetFps;
+  struct Output {
+    std::string spec;
+    std::string blend;
+  };
+  std::vector<Output> outputs;
+  std::string snapshotFile;
+  // Addressing labels sent in the Hello (--group, repeatable --tag).
+  std::string group;
+  std::vector<std::string> tags;
 };
 
 std::string defaultHost() {
@@ -44,8 +58,19 @@ std::string defaultName() {
   return "renderer-" + std::to_string(static_cast<long long>(::getpid()));
 }
 
+// --blend applies to the preceding --output.
+void setOutputBlend(Args& args, const std::string& spec) {
+  if (args.outputs.empty()) {
+    std::cerr << "[renderer] --blend needs a preceding --output" << std::endl;
+    return;
+  }
+  args.outputs.back().blend = spec;
+}
+
 Args parseArgs(int argc, char* argv[]) {
-  Args args{defaultHost(), defaultPort(), defaultName(), false};
+  Args args{defaultHost(), defaultPort(), defaultName(), false,
+            projection::renderer::VideoResidency::kDefaultBudgetBytes >> 20,
+            projection::renderer::QualityGovernorOptions{}.targetFps, {}, {}};
   for (int i = 1; i < argc; ++i) {
     std::string arg(argv[i]);
     if (arg == "--server-host" && i + 1 < argc) {
@@ -64,6 +89,34 @@ Args parseArgs(int argc, char* argv[]) {
       args.port = std::stoi(argv[++i]);
     } else if (arg.rfind("--port=", 0) == 0) {
       args.port = std::stoi(arg.substr(7));
+    } else if (arg == "--target-fps" && i + 1 < argc) {
+      args.targetFps = std::stod(argv[++i]);
+    } else if (arg.rfind("--target-fps=", 0) == 0) {
+      args.targetFps = std::stod(arg.substr(13));
+    } else if (arg == "--video-budget-mb" && i + 1 < argc) {
+      args.videoBudgetMb = static_cast<size_t>(std::stoull(argv[++i]));
+    } else if (arg.rfind("--video-budget-mb=", 0) == 0) {
+      args.videoBudgetMb = static_cast<size_t>(std::stoull(arg.substr(18)));
+    } else if (arg == "--output" && i + 1 < argc) {
+      args.outputs.push_back({argv[++i], ""});
+    } else if (arg.rfind("--output=", 0) == 0) {
+      args.outputs.push_back({arg.substr(9), ""});
+    } else if (arg == "--blend" && i + 1 < argc) {
+      setOutputBlend(args, argv[++i]);
+    } else if (arg.rfind("--blend=", 0) == 0) {
+      setOutputBlend(args, arg.substr(8));
+    } else if (arg == "--snapshot-file" && i + 1 < argc) {
+      args.snapshotFile = argv[++i];
+    } else if (arg.rfind("--snapshot-file=", 0) == 0) {
+      args.snapshotFile = arg.substr(16);
+    } else if (arg == "--group" && i + 1 < argc) {
+      args.group = argv[++i];
+    } else if (arg.rfind("--group=", 0) == 0) {
+      args.group = arg.substr(8);
+    } else if (arg == "--tag" && i + 1 < argc) {
+      args.tags.push_back(argv[++i]);
+    } else if (arg.rfind("--tag=", 0) == 0) {
+      args.tags.push_back(arg.substr(6));
     } else if (arg == "--verbose") {
       args.verbose = true;
     }
@@ -77,6 +130,35 @@ int main(int argc, char* argv[]) {
   if (args.verbose) {
     std::cerr << "[renderer] verbose mode on" << std::endl;
   }
-  ofSetupOpenGL(640, 480, OF_WINDOW);
-  return ofRunApp(new ofApp(args.host, args.port, args.name, args.verbose));
+
+  // Each --output is a viewport of one window spanning all of them (e.g. across displays).
+  std::vector<projection::renderer::OutputViewport> outputs;
+  int windowWidth = 640;
+  int windowHeight = 480;
+  for (const auto& arg : args.outputs) {
+    projection::renderer::OutputViewport output;
+    output.name = "output-" + std::to_string(outputs.size() + 1);
+    std::string error;
+    if (!projection::renderer::parseOutputViewport(arg.spec, output, error) ||
+        (!arg.blend.empty() && !projection::renderer::parseEdgeBlend(arg.blend, output.blend, error))) {
+      std::cerr << "[renderer] " << error << std::endl;
+      return 1;
+    }
+    if (outputs.empty()) {
+      windowWidth = 0;
+      windowHeight = 0;
+    }
+    windowWidth = std::max(windowWidth, output.x + output.width);
+    windowHeight = std::max(windowHeight, output.y + output.height);
+    outputs.push_back(output);
+  }
+
+  ofSetupOpenGL(windowWidth, windowHeight, OF_WINDOW);
+  auto* app = new ofApp(args.host, args.port, args.name, args.verbose);
+  app->setOutputs(std::move(outputs));
+  app->setVideoBudget(args.videoBudgetMb << 20);
+  app->setTargetFps(args.targetFps);
+  app->setSnapshotFile(args.snapshotFile);
+  app->setLabels(args.group, args.tags);
+  return ofRunApp(app);
 }
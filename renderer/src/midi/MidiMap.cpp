@@ -0,0 +1,165 @@
+#include "midi/MidiMap.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace projection::renderer {
+
+namespace {
+// Parses a decimal number in [minValue, maxValue] that makes up all of `text`.
+bool parseNumber(const std::string& text, int minValue, int maxValue, int& value) {
+  if (text.empty() || text.size() > 3 ||
+      !std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isdigit(c) != 0; })) {
+    return false;
+  }
+  value = std::stoi(text);
+  return value >= minValue && value <= maxValue;
+}
+
+bool startsWith(const std::string& text, const char* prefix, std::string& rest) {
+  const std::string p(prefix);
+  if (text.compare(0, p.size(), p) != 0) {
+    return false;
+  }
+  rest = text.substr(p.size());
+  return true;
+}
+
+// "cc7", "note60", "ch2:cc7" -> channel (-1 for all, else 0-15), kind and number.
+bool parseMidiSource(const std::string& key, int& channel, bool& isNote, int& number) {
+  std::string source = key;
+  channel = -1;
+  std::string rest;
+  if (startsWith(key, "ch", rest)) {
+    const auto colon = rest.find(':');
+    int oneBased = 0;
+    if (colon == std::string::npos || !parseNumber(rest.substr(0, colon), 1, 16, oneBased)) {
+      return false;
+    }
+    channel = oneBased - 1;
+    source = rest.substr(colon + 1);
+  }
+  if (startsWith(source, "cc", rest)) {
+    isNote = false;
+  } else if (startsWith(source, "note", rest)) {
+    isNote = true;
+  } else {
+    return false;
+  }
+  return parseNumber(rest, 0, 127, number);
+}
+}  // namespace
+
+const char* midiParameterName(MidiParameter parameter) {
+  switch (parameter) {
+    case MidiParameter::Brightness:
+      return "brightness";
+    case MidiParameter::AudioDepth:
+      return "audioDepth";
+    case MidiParameter::None:
+      break;
+  }
+  return "none";
+}
+
+bool parseMidiParameter(const std::string& name, MidiParameter& parameter) {
+  if (name == "brightness" || name == "master") {
+    parameter = MidiParameter::Brightness;
+    return true;
+  }
+  if (name == "audioDepth" || name == "audio") {
+    parameter = MidiParameter::AudioDepth;
+    return true;
+  }
+  return false;
+}
+
+MidiMap::MidiMap() {
+  controls_.fill(MidiParameter::None);
+  notes_.fill(MidiParameter::None);
+  mapControl(-1, 1, MidiParameter::Brightness);
+}
+
+MidiMap MidiMap::forChannels(const std::vector<int>& channels) {
+  MidiMap map;
+  map.controls_.fill(MidiParameter::None);
+  if (!channels.empty()) {
+    map.channelMask_ = 0;
+    for (const int channel : channels) {
+      if (channel >= 1 && channel <= 16) {
+        map.channelMask_ |= static_cast<uint16_t>(1u << (channel - 1));
+      }
+    }
+  }
+  return map;
+}
+
+void MidiMap::map(std::array<MidiParameter, kChannels * kNumbers>& table, int channel, int number,
+                  MidiParameter parameter) {
+  if (number < 0 || number >= static_cast<int>(kNumbers) || channel >= static_cast<int>(kChannels)) {
+    return;
+  }
+  const size_t first = channel < 0 ? 0 : static_cast<size_t>(channel);
+  const size_t last = channel < 0 ? kChannels : first + 1;
+  for (size_t c = first; c < last; ++c) {
+    table[c * kNumbers + static_cast<size_t>(number)] = parameter;
+  }
+}
+
+void MidiMap::mapControl(int channel, int control, MidiParameter parameter) { map(controls_, channel, control, parameter); }
+
+void MidiMap::mapNote(int channel, int note, MidiParameter parameter) { map(notes_, channel, note, parameter); }
+
+MidiParameter MidiMap::lookup(const MidiEvent& event, float& value) const {
+  const size_t index = static_cast<size_t>(event.channel()) * kNumbers + (event.data1 & 0x7F);
+  const float scaled = static_cast<float>(std::min<uint8_t>(event.data2, 127)) / 127.0f;
+  switch (event.type()) {
+    case kMidiControlChange:
+      value = scaled;
+      return controls_[index];
+    case kMidiNoteOn:
+      value = scaled;
+      return notes_[index];
+    case kMidiNoteOff:
+      value = 0.0f;
+      return notes_[index];
+    default:
+      return MidiParameter::None;
+  }
+}
+
+size_t MidiMap::mappingCount() const {
+  const auto mapped = [](MidiParameter parameter) { return parameter != MidiParameter::None; };
+  return static_cast<size_t>(std::count_if(controls_.begin(), controls_.end(), mapped) +
+                             std::count_if(notes_.begin(), notes_.end(), mapped));
+}
+
+MidiMap compileMidiMap(const projection::core::ProjectSettings& settings, std::vector<std::string>& warnings) {
+  MidiMap map = MidiMap::forChannels(settings.midiChannels);
+  bool mapped = false;
+  for (const auto& [key, target] : settings.controllers) {
+    int channel = -1;
+    bool isNote = false;
+    int number = 0;
+    if (!parseMidiSource(key, channel, isNote, number)) {
+      continue;
+    }
+    MidiParameter parameter = MidiParameter::None;
+    if (!parseMidiParameter(target, parameter)) {
+      warnings.push_back("MIDI controller '" + key + "' targets unknown parameter '" + target + "'");
+      continue;
+    }
+    if (isNote) {
+      map.mapNote(channel, number, parameter);
+    } else {
+      map.mapControl(channel, number, parameter);
+    }
+    mapped = true;
+  }
+  if (!mapped) {
+    map.mapControl(-1, 1, MidiParameter::Brightness);
+  }
+  return map;
+}
+
+}  // namespace projection::renderer
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <projection/core/Project.h>
+
+namespace projection::renderer {
+
+// One channel voice message as received on the MIDI thread, stamped with
+// core::monotonicMicros() so the render thread can measure event-to-frame latency.
+struct MidiEvent {
+  int64_t timestampMicros{0};
+  // Raw status byte: message type in the high nibble, channel (0-15) in the low nibble.
+  uint8_t status{0};
+  uint8_t data1{0};
+  uint8_t data2{0};
+
+  int channel() const { return status & 0x0F; }
+  uint8_t type() const { return status & 0xF0; }
+};
+
+constexpr uint8_t kMidiNoteOff = 0x80;
+constexpr uint8_t kMidiNoteOn = 0x90;
+constexpr uint8_t kMidiControlChange = 0xB0;
+
+// Render parameters MIDI can drive. Values are 0..1.
+enum class MidiParameter : uint8_t {
+  // Multiplies every surface's alpha ("brightness", or "master").
+  Brightness,
+  // Depth of the audio-reactive scale: 0 holds surfaces at their size, 1 applies it fully
+  // ("audioDepth", or "audio").
+  AudioDepth,
+  None = 0xFF
+};
+constexpr size_t kMidiParameterCount = 2;
+
+const char* midiParameterName(MidiParameter parameter);
+// Accepts the names above; false for anything else.
+bool parseMidiParameter(const std::string& name, MidiParameter& parameter);
+
+// Precompiled lookup from (channel, CC or note number) to a parameter, plus the set of
+// channels the project listens on. Lookups are two array reads, so the render thread can
+// apply any number of events per frame at a fixed cost each.
+class MidiMap {
+ public:
+  // CC1 on every channel drives brightness (the mapping the renderer always had).
+  MidiMap();
+
+  // An empty map on the given channels (1-16; empty means all).
+  static MidiMap forChannels(const std::vector<int>& channels);
+
+  // `channel` is 0-15 as in MidiEvent::channel().
+  bool listensTo(int channel) const { return channel >= 0 && channel < 16 && (channelMask_ >> channel) & 1u; }
+  // `channel` -1 maps the number on every channel.
+  void mapControl(int channel, int control, MidiParameter parameter);
+  void mapNote(int channel, int note, MidiParameter parameter);
+
+  // Parameter driven by the event and its 0..1 value: CC value / 127, note-on velocity / 127,
+  // note-off (or note-on with velocity 0) 0. None for other messages and unmapped numbers.
+  MidiParameter lookup(const MidiEvent& event, float& value) const;
+
+  size_t mappingCount() const;
+
+ private:
+  static constexpr size_t kChannels = 16;
+  static constexpr size_t kNumbers = 128;
+  void map(std::array<MidiParameter, kChannels * kNumbers>& table, int channel, int number,
+           MidiParameter parameter);
+
+  uint16_t channelMask_{0xFFFF};
+  std::array<MidiParameter, kChannels * kNumbers> controls_{};
+  std::array<MidiParameter, kChannels * kNumbers> notes_{};
+};
+
+// Builds the map for a project: settings.midiChannels selects the channels, and each
+// settings.controllers entry whose key is a MIDI source ("cc7", "note60", optionally
+// prefixed with a channel as in "ch2:cc7") maps it to the named parameter. Other keys name
+// non-MIDI controllers and are skipped; unknown parameters are skipped with a warning.
+// Without any MIDI mapping the default CC1 -> brightness is kept.
+MidiMap compileMidiMap(const projection::core::ProjectSettings& settings, std::vector<std::string>& warnings);
+
+}  // namespace projection::renderer
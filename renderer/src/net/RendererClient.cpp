@@ -1,18 +1,27 @@
 #include "net/RendererClient.h"
 
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <netdb.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 
 namespace projection::renderer {
 namespace {
 constexpr int kInvalidSocket = -1;
+// Probe quickly until the estimator window has a few samples, then keep tracking drift.
+constexpr size_t kInitialSyncSamples = 8;
+constexpr int64_t kInitialSyncIntervalMicros = 50000;
+constexpr int64_t kSyncIntervalMicros = 1000000;
 }  // namespace
 
 RendererClient::RendererClient(RendererCommandHandler& handler,
@@ -33,6 +42,13 @@ void RendererClient::start() {
     return;
   }
   running_ = true;
+  if (::pipe(wakeFds_) == 0) {
+    for (int fd : wakeFds_) {
+      ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+  }
+  ackOnOutcome_ = handler_.setCommandOutcomeSink(
+      [this](const std::vector<CommandOutcome>& outcomes) { queueOutcomes(outcomes); });
   clientThread_ = std::thread(&RendererClient::run, this);
 }
 
@@ -49,6 +65,16 @@ void RendererClient::stop() {
   if (clientThread_.joinable()) {
     clientThread_.join();
   }
+  if (ackOnOutcome_) {
+    handler_.setCommandOutcomeSink({});
+    ackOnOutcome_ = false;
+  }
+  for (int& fd : wakeFds_) {
+    if (fd != kInvalidSocket) {
+      ::close(fd);
+      fd = kInvalidSocket;
+    }
+  }
 }
 
 std::string RendererClient::lastError() const {
@@ -56,6 +82,12 @@ std::string RendererClient::lastError() const {
   return lastError_;
 }
 
+ClockSyncStatus RendererClient::clockSync() const {
+  std::lock_guard<std::mutex> lock(clockMutex_);
+  return ClockSyncStatus{clockEstimator_.synchronized(), clockEstimator_.offsetMicros(),
+                         clockEstimator_.roundTripMicros(), clockEstimator_.sampleCount()};
+}
+
 void RendererClient::run() {
   try {
   addrinfo hints{};
@@ -100,14 +132,15 @@ void RendererClient::run() {
   projection::core::RendererMessage hello{};
   hello.type = projection::core::RendererMessageType::Hello;
   hello.commandId = generateCommandId();
-  hello.hello = projection::core::HelloMessage{"0.1", "renderer", name_};
+  hello.hello = projection::core::HelloMessage{"0.1", "renderer", name_, group_, tags_};
 
   sendMessage(hello);
 
-  std::string buffer;
-  char chunk[256];
+  projection::core::LineFramer framer(maxMessageBytes_);
+  std::string_view line;
   while (running_) {
-    ssize_t received = ::recv(sock, chunk, sizeof(chunk), 0);
+    char* target = framer.prepare();
+    ssize_t received = ::recv(sock, target, framer.writableBytes(), 0);
     if (received <= 0) {
       std::lock_guard<std::mutex> lock(errorMutex_);
       lastError_ = "Renderer connection closed during handshake";
@@ -119,13 +152,10 @@ void RendererClient::run() {
       running_ = false;
       return;
     }
-    buffer.append(chunk, static_cast<size_t>(received));
-    auto newlinePos = buffer.find('\n');
-    if (newlinePos == std::string::npos) {
+    framer.commit(static_cast<size_t>(received));
+    if (!framer.nextLine(line)) {
       continue;
     }
-    std::string line = buffer.substr(0, newlinePos);
-    buffer.erase(0, newlinePos + 1);
 
     auto response = parseRendererMessageLine(line);
     if (response.type == projection::core::RendererMessageType::Ack) {
@@ -157,7 +187,7 @@ void RendererClient::run() {
     return;
   }
 
-  readLoop(std::move(buffer));
+  readLoop(framer);
   } catch (const std::exception& ex) {
     std::lock_guard<std::mutex> lock(errorMutex_);
     lastError_ = ex.what();
@@ -165,16 +195,30 @@ void RendererClient::run() {
   }
 }
 
-void RendererClient::readLoop(std::string buffer) {
-  char chunk[256];
+void RendererClient::readLoop(projection::core::LineFramer& framer) {
+  {
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    clockEstimator_.reset();
+  }
+  int64_t nextSyncAt = projection::core::monotonicMicros();
+  int64_t receivedAt = nextSyncAt;
 
   while (running_) {
-    auto newlinePos = buffer.find('\n');
-    while (newlinePos != std::string::npos) {
-      std::string line = buffer.substr(0, newlinePos);
-      buffer.erase(0, newlinePos + 1);
-      processLine(line);
-      newlinePos = buffer.find('\n');
+    const int64_t now = projection::core::monotonicMicros();
+    if (now >= nextSyncAt) {
+      try {
+        sendTimeSync();
+      } catch (const std::exception&) {
+        // The next recv reports the closed connection.
+      }
+      const bool initial = clockSync().samples < kInitialSyncSamples;
+      nextSyncAt = now + (initial ? kInitialSyncIntervalMicros : kSyncIntervalMicros);
+    }
+
+    // Lines left over from the handshake read are handled on the first pass.
+    std::string_view line;
+    while (framer.nextLine(line)) {
+      processLine(line, receivedAt);
     }
 
     int socketFd = kInvalidSocket;
@@ -185,25 +229,36 @@ void RendererClient::readLoop(std::string buffer) {
     if (socketFd == kInvalidSocket) {
       break;
     }
-    ssize_t received = ::recv(socketFd, chunk, sizeof(chunk), 0);
+
+    pollfd pfds[2] = {{socketFd, POLLIN, 0}, {wakeFds_[0], POLLIN, 0}};
+    const auto waitMs = static_cast<int>(std::max<int64_t>(0, nextSyncAt - projection::core::monotonicMicros()) / 1000);
+    const int ready = ::poll(pfds, wakeFds_[0] != kInvalidSocket ? 2 : 1, waitMs);
+    if (ready < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ready > 0 && (pfds[1].revents & POLLIN)) {
+      char drain[64];
+      while (::read(wakeFds_[0], drain, sizeof(drain)) > 0) {
+      }
+    }
+    sendOutcomes();
+    if (ready == 0 || (ready > 0 && pfds[0].revents == 0)) {
+      continue;
+    }
+    char* target = framer.prepare();
+    ssize_t received = ready > 0 ? ::recv(socketFd, target, framer.writableBytes(), 0) : -1;
     if (received <= 0) {
       std::lock_guard<std::mutex> lock(errorMutex_);
       lastError_ = "Renderer connection closed";
       running_ = false;
       break;
     }
-    buffer.append(chunk, static_cast<size_t>(received));
-    newlinePos = buffer.find('\n');
-    while (newlinePos != std::string::npos) {
-      std::string line = buffer.substr(0, newlinePos);
-      buffer.erase(0, newlinePos + 1);
-      processLine(line);
-      newlinePos = buffer.find('\n');
-    }
+    receivedAt = projection::core::monotonicMicros();
+    framer.commit(static_cast<size_t>(received));
   }
 }
 
-void RendererClient::processLine(const std::string& line) {
+void RendererClient::processLine(std::string_view line, int64_t receivedAt) {
   try {
     if (verbose_) {
       std::cerr << "[renderer] received: " << line << std::endl;
@@ -213,12 +268,34 @@ void RendererClient::processLine(const std::string& line) {
         message.type == projection::core::RendererMessageType::Error) {
       return;
     }
+    if (message.type == projection::core::RendererMessageType::TimeSync) {
+      if (message.timeSync) {
+        const auto& sync = *message.timeSync;
+        const auto sample = projection::core::computeClockSample(sync.clientSendMicros, sync.serverReceiveMicros,
+                                                                 sync.serverSendMicros, receivedAt);
+        std::lock_guard<std::mutex> lock(clockMutex_);
+        clockEstimator_.addSample(sample);
+      }
+      return;
+    }
+
+    if (message.executeAt) {
+      std::lock_guard<std::mutex> lock(clockMutex_);
+      if (clockEstimator_.synchronized()) {
+        message.executeAt = clockEstimator_.toLocal(*message.executeAt);
+      } else {
+        message.executeAt.reset();
+      }
+    }
 
+    const std::string commandId = message.commandId;
     try {
-      handler_.handle(message);
-      sendAck(message.commandId);
+      handler_.handle(std::move(message));
+      if (!ackOnOutcome_) {
+        sendAck(commandId);
+      }
     } catch (const std::exception& ex) {
-      sendError(message.commandId, ex.what());
+      sendError(commandId, ex.what());
     }
   } catch (const std::exception& ex) {
     sendError("unknown", ex.what());
@@ -245,6 +322,14 @@ void RendererClient::sendMessage(const projection::core::RendererMessage& messag
   }
 }
 
+void RendererClient::sendTimeSync() {
+  projection::core::RendererMessage message{};
+  message.type = projection::core::RendererMessageType::TimeSync;
+  message.commandId = "sync-" + std::to_string(++timeSyncSequence_);
+  message.timeSync = projection::core::TimeSyncMessage{projection::core::monotonicMicros(), 0, 0};
+  sendMessage(message);
+}
+
 void RendererClient::sendAck(const std::string& commandId) {
   projection::core::RendererMessage message{};
   message.type = projection::core::RendererMessageType::Ack;
@@ -261,6 +346,35 @@ void RendererClient::sendError(const std::string& commandId, const std::string&
   sendMessage(message);
 }
 
+void RendererClient::queueOutcomes(const std::vector<CommandOutcome>& outcomes) {
+  {
+    std::lock_guard<std::mutex> lock(outcomesMutex_);
+    outcomes_.insert(outcomes_.end(), outcomes.begin(), outcomes.end());
+  }
+  const char wake = 1;
+  // Failing on a full pipe is fine: a wake-up is already pending.
+  [[maybe_unused]] const ssize_t written = ::write(wakeFds_[1], &wake, 1);
+}
+
+void RendererClient::sendOutcomes() {
+  {
+    std::lock_guard<std::mutex> lock(outcomesMutex_);
+    sendingOutcomes_.swap(outcomes_);
+  }
+  for (const auto& outcome : sendingOutcomes_) {
+    try {
+      if (outcome.error.empty()) {
+        sendAck(outcome.commandId);
+      } else {
+        sendError(outcome.commandId, outcome.error);
+      }
+    } catch (const std::exception&) {
+      // The next recv reports the closed connection.
+    }
+  }
+  sendingOutcomes_.clear();
+}
+
 std::string RendererClient::generateCommandId() const {
   auto now = std::chrono::steady_clock::now().time_since_epoch().count();
   std::ostringstream oss;
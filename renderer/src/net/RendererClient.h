@@ -1,16 +1,37 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
+#include <projection/core/LineFramer.h>
 #include <projection/core/RendererProtocol.h>
+#include <projection/core/TimeSync.h>
 
 #include "net/RendererServer.h"
 
 namespace projection::renderer {
 
+// Estimated relation between the server clock and this renderer's monotonic clock.
+struct ClockSyncStatus {
+  bool synchronized{false};
+  int64_t offsetMicros{0};
+  int64_t roundTripMicros{0};
+  size_t samples{0};
+};
+
+// Connects to the server's renderer port, forwards commands to the handler and acks them:
+// once applied when the handler reports outcomes (see RendererCommandHandler), otherwise on
+// receipt.
+// While connected it probes the server clock with TimeSync messages (NTP-style) and rewrites
+// each command's executeAt from server time to the local monotonic clock before the handler
+// sees it; commands that arrive before the first probe completes drop executeAt and apply
+// on arrival.
 class RendererClient {
  public:
   RendererClient(RendererCommandHandler& handler,
@@ -32,20 +53,38 @@ class RendererClient {
   const std::string& host() const { return host_; }
   int port() const { return port_; }
   const std::string& name() const { return name_; }
+  ClockSyncStatus clockSync() const;
+
+  // Longest accepted command (e.g. a scene definition); a longer one closes the connection.
+  // Set before start().
+  void setMaxMessageBytes(size_t bytes) { maxMessageBytes_ = bytes; }
+  // Group and tags announced in the Hello, so the server can address this renderer with
+  // others of its zone. Set before start().
+  void setLabels(std::string group, std::vector<std::string> tags) {
+    group_ = std::move(group);
+    tags_ = std::move(tags);
+  }
 
  private:
   void run();
-  void readLoop(std::string buffer);
-  void processLine(const std::string& line);
+  void readLoop(projection::core::LineFramer& framer);
+  void processLine(std::string_view line, int64_t receivedAt);
+  void sendTimeSync();
   void sendMessage(const projection::core::RendererMessage& message);
   void sendAck(const std::string& commandId);
   void sendError(const std::string& commandId, const std::string& errorText);
+  // Handler thread: queues outcomes and wakes the client thread, which sends them.
+  void queueOutcomes(const std::vector<CommandOutcome>& outcomes);
+  void sendOutcomes();
   std::string generateCommandId() const;
 
   RendererCommandHandler& handler_;
   std::string host_;
   int port_;
   std::string name_;
+  std::string group_{};
+  std::vector<std::string> tags_{};
+  size_t maxMessageBytes_{projection::core::LineFramer::kDefaultMaxLineBytes};
   std::atomic<bool> running_{false};
   bool verbose_{false};
   int socketFd_{-1};
@@ -53,6 +92,15 @@ class RendererClient {
   mutable std::mutex errorMutex_{};
   std::string lastError_{};
   std::mutex socketMutex_{};
+  mutable std::mutex clockMutex_{};
+  projection::core::ClockOffsetEstimator clockEstimator_{};
+  uint64_t timeSyncSequence_{0};
+  bool ackOnOutcome_{false};
+  std::mutex outcomesMutex_{};
+  std::vector<CommandOutcome> outcomes_{};
+  std::vector<CommandOutcome> sendingOutcomes_{};
+  // Self-pipe that wakes the read loop's poll when outcomes are queued.
+  int wakeFds_[2]{-1, -1};
 };
 
 }  // namespace projection::renderer
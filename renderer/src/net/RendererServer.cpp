@@ -10,14 +10,17 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
+#include <utility>
+
+#include <projection/core/TimeSync.h>
 
 using projection::core::RendererMessage;
 using projection::core::RendererMessageType;
 
 namespace projection::renderer {
 
-RendererMessage parseRendererMessageLine(const std::string& line) {
-  auto json = nlohmann::json::parse(line);
+RendererMessage parseRendererMessageLine(std::string_view line) {
+  auto json = nlohmann::json::parse(line.begin(), line.end());
   return json.get<RendererMessage>();
 }
 
@@ -161,49 +164,61 @@ void RendererServer::run(int port) {
 }
 
 void RendererServer::handleClient(int clientFd) {
-  std::string buffer;
-  constexpr size_t kBufferSize = 1024;
-  char data[kBufferSize];
+  projection::core::LineFramer framer(maxMessageBytes_);
 
-  while (running_) {
-    ssize_t received = recv(clientFd, data, kBufferSize, 0);
-    if (received <= 0) {
-      break;
-    }
-    if (verbose_) {
-      std::cerr << "RendererServer read " << received << " bytes" << std::endl;
-    }
-    buffer.append(data, static_cast<size_t>(received));
-
-    size_t newlinePos;
-    while ((newlinePos = buffer.find('\n')) != std::string::npos) {
-      std::string line = buffer.substr(0, newlinePos);
-      buffer.erase(0, newlinePos + 1);
-      if (!line.empty() && line.back() == '\r') {
-        line.pop_back();
+  try {
+    while (running_) {
+      char* target = framer.prepare();
+      ssize_t received = recv(clientFd, target, framer.writableBytes(), 0);
+      if (received <= 0) {
+        break;
       }
-      if (!line.empty()) {
-        processLine(line);
+      if (verbose_) {
+        std::cerr << "RendererServer read " << received << " bytes" << std::endl;
+      }
+      const int64_t receivedAt = projection::core::monotonicMicros();
+      framer.commit(static_cast<size_t>(received));
+
+      std::string_view line;
+      while (framer.nextLine(line)) {
+        if (!line.empty()) {
+          processLine(line, receivedAt);
+        }
       }
     }
+  } catch (const std::exception& ex) {
+    // Oversized message: the stream cannot be resynchronized, drop the client.
+    sendMessage(makeErrorMessage("", ex.what()));
+    if (verbose_) {
+      std::cerr << "RendererServer closing client: " << ex.what() << std::endl;
+    }
   }
 }
 
-void RendererServer::processLine(const std::string& line) {
+void RendererServer::processLine(std::string_view line, int64_t receivedAt) {
   try {
     if (verbose_) {
       std::cerr << "RendererServer received: " << line << std::endl;
     }
     auto message = parseRendererMessageLine(line);
-    handler_.handle(message);
-    sendMessage(makeAckMessage(message.commandId));
+    // In direct mode this renderer is the clock reference: executeAt is already on its
+    // monotonic clock and controllers sync against it.
+    if (message.type == RendererMessageType::TimeSync && message.timeSync) {
+      message.timeSync->serverReceiveMicros = receivedAt;
+      message.timeSync->serverSendMicros = projection::core::monotonicMicros();
+      sendMessage(message);
+      return;
+    }
+    const std::string commandId = message.commandId;
+    handler_.handle(std::move(message));
+    sendMessage(makeAckMessage(commandId));
     if (verbose_) {
-      std::cerr << "RendererServer sent Ack for " << message.commandId << std::endl;
+      std::cerr << "RendererServer sent Ack for " << commandId << std::endl;
     }
   } catch (const std::exception& ex) {
     std::string commandId;
     try {
-      auto json = nlohmann::json::parse(line);
+      auto json = nlohmann::json::parse(line.begin(), line.end());
       if (json.contains("commandId")) {
         commandId = json["commandId"].get<std::string>();
       }
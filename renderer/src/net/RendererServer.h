@@ -1,24 +1,49 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
+#include <projection/core/LineFramer.h>
 #include <projection/core/RendererProtocol.h>
 
 namespace projection::renderer {
 
-projection::core::RendererMessage parseRendererMessageLine(const std::string& line);
+projection::core::RendererMessage parseRendererMessageLine(std::string_view line);
 std::string renderRendererMessageLine(const projection::core::RendererMessage& message);
 projection::core::RendererMessage makeAckMessage(const std::string& commandId);
 projection::core::RendererMessage makeErrorMessage(const std::string& commandId,
                                                    const std::string& errorText);
 
+// How a handler finished one command; an empty error means it was applied.
+struct CommandOutcome {
+  std::string commandId;
+  std::string error;
+};
+using CommandOutcomeSink = std::function<void(const std::vector<CommandOutcome>&)>;
+
 class RendererCommandHandler {
  public:
   virtual ~RendererCommandHandler() = default;
   virtual void handle(const projection::core::RendererMessage& message) = 0;
+
+  // Called by the network threads with a message they no longer need. Handlers that queue
+  // messages should override this to take ownership instead of copying.
+  virtual void handle(projection::core::RendererMessage&& message) {
+    handle(static_cast<const projection::core::RendererMessage&>(message));
+  }
+
+  // Handlers that apply commands later, on another thread, override this to pass each
+  // command's outcome to `sink` once it is applied or rejected, and return true; the
+  // connection then answers with an Ack or Error from that outcome. By default a command is
+  // acked as soon as handle() returns. An empty sink detaches.
+  virtual bool setCommandOutcomeSink(CommandOutcomeSink /*sink*/) { return false; }
 };
 
 class RendererServer {
@@ -36,10 +61,13 @@ class RendererServer {
   int port() const { return port_; }
   std::string lastError() const;
 
+  // Longest accepted command; a longer one closes the connection. Set before start().
+  void setMaxMessageBytes(size_t bytes) { maxMessageBytes_ = bytes; }
+
  private:
   void run(int port);
   void handleClient(int clientFd);
-  void processLine(const std::string& line);
+  void processLine(std::string_view line, int64_t receivedAt);
   void sendMessage(const projection::core::RendererMessage& message);
   void closeClientSocket();
 
@@ -50,6 +78,7 @@ class RendererServer {
   int serverFd_{-1};
   int clientFd_{-1};
   int port_{0};
+  size_t maxMessageBytes_{projection::core::LineFramer::kDefaultMaxLineBytes};
   std::thread serverThread_{};
   std::mutex socketMutex_{};
   mutable std::mutex errorMutex_{};
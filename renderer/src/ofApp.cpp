@@ -1,18 +1,32 @@
 #include "ofApp.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <csignal>
 #include <cstdlib>
 #include <iostream>
-#include <limits>
 #include <utility>
-#include <vector>
 
-using projection::core::RendererMessageType;
+#include "video/OfVideoSource.h"
+
+namespace {
+ofBlendMode toOfBlendMode(projection::core::BlendMode mode) {
+  switch (mode) {
+    case projection::core::BlendMode::Additive:
+      return OF_BLENDMODE_ADD;
+    case projection::core::BlendMode::Multiply:
+      return OF_BLENDMODE_MULTIPLY;
+    case projection::core::BlendMode::Normal:
+      break;
+  }
+  return OF_BLENDMODE_ALPHA;
+}
+}  // namespace
 
 ofApp::ofApp(std::string host, int port, std::string name, bool verbose)
-    : client_(*this, std::move(host), port, std::move(name), verbose),
+    : runtime_(projection::renderer::makeOfVideoSourceFactory(), verbose),
+      client_(runtime_, std::move(host), port, std::move(name), verbose),
       host_(client_.host()),
       port_(port),
       name_(client_.name()),
@@ -22,6 +36,14 @@ void ofApp::setup() {
   if (verbose_) {
     std::cerr << "[renderer] connecting to server " << host_ << ":" << port_ << " as " << name_ << std::endl;
   }
+  // Show the last scene right away; the server's replay on connect confirms or replaces it.
+  if (!snapshotFile_.empty()) {
+    std::string error;
+    if (!runtime_.restoreSceneSnapshot(snapshotFile_, error)) {
+      std::cerr << "[renderer] no scene snapshot restored: " << error << std::endl;
+    }
+    runtime_.enableSceneSnapshots(snapshotFile_);
+  }
   client_.start();
 
 #if PROJECTION_HAS_OFX_MIDI
@@ -40,6 +62,11 @@ void ofApp::setup() {
   soundSettings.numOutputChannels = outputChannels;
   soundSettings.bufferSize = bufferSize;
   soundSettings.numBuffers = 4;
+  // Analysis runs on its own thread; the frame loop only picks up the newest features.
+  projection::renderer::AudioAnalyzerOptions analysis;
+  analysis.sampleRate = sampleRate;
+  runtime_.setAudioAnalysis(analysis);
+  runtime_.startAudioAnalysis();
   soundStream_.setup(soundSettings);
   if (verbose_) {
     std::cerr << "[renderer] audio/midi initialized" << std::endl;
@@ -47,266 +74,276 @@ void ofApp::setup() {
 }
 
 void ofApp::update() {
+  frameWorkStart_ = std::chrono::steady_clock::now();
   if (!client_.running()) {
     const std::string serverError = client_.lastError();
     if (!serverError.empty()) {
-      std::lock_guard<std::mutex> lock(stateMutex_);
-      lastError_ = serverError;
+      runtime_.setLastError(serverError);
     }
     std::raise(SIGTERM);
     return;
   }
 
-  std::vector<projection::core::RendererMessage> messages;
-  {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    while (!messageQueue_.empty()) {
-      messages.push_back(messageQueue_.front());
-      messageQueue_.pop();
-    }
-  }
+  runtime_.update(ofGetLastFrameTime());
+}
 
-  for (const auto& message : messages) {
-    processMessage(message);
-  }
+void ofApp::draw() {
+  const auto status = runtime_.status();
 
-  renderState_.updateVideoPlayers();
+  ofBackground(0, 0, 0);
+  ofSetColor(255, 255, 255);
 
-  std::vector<float> audioCopy;
-  {
-    std::lock_guard<std::mutex> lock(audioMutex_);
-    audioCopy = audioBuffer_;
+  if (cpuFeedTexturesGeneration_ != runtime_.renderState().sceneGeneration()) {
+    cpuFeedTextures_.clear();
+    cpuFeedTexturesGeneration_ = runtime_.renderState().sceneGeneration();
   }
 
-  if (!audioCopy.empty()) {
-    double energySum = 0.0;
-    for (float sample : audioCopy) {
-      energySum += static_cast<double>(sample) * static_cast<double>(sample);
+  size_t drawCalls = 0;
+  size_t surfaceCount = 0;
+  if (outputs_.empty()) {
+    const auto& drawList =
+        runtime_.prepareFrame(static_cast<float>(ofGetWidth()), static_cast<float>(ofGetHeight()));
+    drawCalls = drawSurfaces(drawList);
+    surfaceCount = drawList.surfaces.size();
+  } else {
+    // One spanning window, one viewport per output; each output only gets the surfaces that
+    // reach it.
+    const auto& drawLists = runtime_.prepareOutputs(outputs_);
+    for (size_t i = 0; i < outputs_.size(); ++i) {
+      const auto& output = outputs_[i];
+      ofPushView();
+      ofViewport(static_cast<float>(output.x), static_cast<float>(output.y), static_cast<float>(output.width),
+                 static_cast<float>(output.height));
+      ofSetupScreenOrtho(static_cast<float>(output.width), static_cast<float>(output.height));
+      drawCalls += drawSurfaces(drawLists[i]);
+      surfaceCount += drawLists[i].surfaces.size();
+      drawEdgeBlend(outputBlends_[i], output);
+      ofPopView();
     }
-    const float averageEnergy = static_cast<float>(energySum / static_cast<double>(audioCopy.size()));
-
-    constexpr float smoothingFactor = 0.9f;
-    smoothedEnergy_ = smoothingFactor * smoothedEnergy_ + (1.0f - smoothingFactor) * averageEnergy;
-    audioScale_ = projection::renderer::mapEnergyToScale(smoothedEnergy_);
-  }
-}
-
-void ofApp::draw() {
-  std::string lastCommand;
-  std::string lastError;
-  std::string sceneId;
-  std::string role;
-  std::string version;
-  int serverPort = port_;
-
-  {
-    std::lock_guard<std::mutex> lock(stateMutex_);
-    lastCommand = lastCommand_;
-    lastError = lastError_;
-    sceneId = sceneId_;
-    role = rendererRole_;
-    version = rendererVersion_;
   }
 
-  ofBackground(0, 0, 0);
+  ofEnableBlendMode(OF_BLENDMODE_ALPHA);
   ofSetColor(255, 255, 255);
 
-  // Draw loaded video feeds onto their skewed surfaces using textured meshes.
-  const auto& scene = renderState_.currentScene();
-  const auto& videoFeeds = renderState_.videoFeeds();
-
-  const float screenW = static_cast<float>(ofGetWidth());
-  const float screenH = static_cast<float>(ofGetHeight());
+  float overlayY = 20.0f;
+  // The quality governor drops the status text when frames run long; errors always show.
+  if (runtime_.qualityLevel().overlay) {
+    overlayY = drawStatusOverlay(status, drawCalls, surfaceCount);
+  }
+  if (!status.lastError.empty()) {
+    ofSetColor(255, 0, 0);
+    ofDrawBitmapString("Last Error: " + status.lastError, 20, overlayY);
+  }
 
-  ofPushMatrix();
-  ofTranslate(screenW / 2.0f, screenH / 2.0f);
-  ofScale(audioScale_, audioScale_);
-  ofTranslate(-screenW / 2.0f, -screenH / 2.0f);
+  // Work from the start of update() to here; the wait for vsync is not part of it.
+  runtime_.recordFrameTime(
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameWorkStart_).count());
+}
 
-  for (const auto& surface : scene.getSurfaces()) {
-    auto feedIt = videoFeeds.find(surface.getFeedId().value);
+size_t ofApp::drawSurfaces(const projection::renderer::DrawList& drawList) {
+  // Draw video and generated feeds onto their skewed surfaces. The draw list is already in zOrder and
+  // batched by feed and blend mode: one texture bind, blend change and draw call per batch.
+  const auto& videoFeeds = runtime_.renderState().videoFeeds();
+  size_t drawCalls = 0;
+  for (const auto& batch : drawList.batches) {
+    auto feedIt = videoFeeds.find(batch.feedId);
     if (feedIt == videoFeeds.end()) {
       continue;
     }
 
-    auto& player = feedIt->second.player;
-    if (!player.isLoaded() || player.getTexture().getTextureData().textureID == 0) {
+    auto& source = *feedIt->second.source;
+    ofTexture* texture = textureForFeed(batch.feedId, source);
+    if (texture == nullptr) {
       continue;
     }
 
-    const auto& vertices = surface.getVertices();
-    if (vertices.size() < 3) {
-      continue;
-    }
-
-    std::vector<glm::vec2> screenVerts;
-    screenVerts.reserve(vertices.size());
-    for (const auto& v : vertices) {
-      // Scene coordinates are normalized -1..1; map to screen pixels.
-      float x = (v.x * 0.5f + 0.5f) * screenW;
-      float y = (v.y * 0.5f + 0.5f) * screenH;
-      screenVerts.emplace_back(x, y);
-    }
-
-    float minX = std::numeric_limits<float>::max();
-    float maxX = std::numeric_limits<float>::lowest();
-    float minY = std::numeric_limits<float>::max();
-    float maxY = std::numeric_limits<float>::lowest();
-    for (const auto& v : screenVerts) {
-      minX = std::min(minX, v.x);
-      maxX = std::max(maxX, v.x);
-      minY = std::min(minY, v.y);
-      maxY = std::max(maxY, v.y);
-    }
-    const float videoW = player.getWidth();
-    const float videoH = player.getHeight();
-    if (videoW <= 0.0f || videoH <= 0.0f || maxX <= minX || maxY <= minY) {
-      continue;
-    }
-
-    ofMesh mesh;
-    mesh.setMode(OF_PRIMITIVE_TRIANGLE_FAN);
-    for (const auto& v : screenVerts) {
-      float u = ofMap(v.x, minX, maxX, 0.0f, videoW, true);
-      float t = ofMap(v.y, minY, maxY, 0.0f, videoH, true);
-      mesh.addVertex(glm::vec3(v.x, v.y, 0.0f));
-      mesh.addTexCoord(glm::vec2(u, t));
+    // Fans are expanded to triangles so surfaces can share one mesh; per-surface brightness
+    // and alpha travel as vertex colors.
+    const float videoW = source.width();
+    const float videoH = source.height();
+    batchMesh_.clear();
+    batchMesh_.setMode(OF_PRIMITIVE_TRIANGLES);
+    for (size_t s = batch.firstSurface; s < batch.firstSurface + batch.surfaceCount; ++s) {
+      const auto& surface = drawList.surfaces[s];
+      const auto base = static_cast<unsigned>(batchMesh_.getNumVertices());
+      const ofFloatColor color(surface.brightness, surface.brightness, surface.brightness, surface.alpha);
+      for (size_t i = 0; i < surface.positions.size(); ++i) {
+        batchMesh_.addVertex(glm::vec3(surface.positions[i].x, surface.positions[i].y, 0.0f));
+        batchMesh_.addTexCoord(glm::vec2(surface.texCoords[i].x * videoW, surface.texCoords[i].y * videoH));
+        batchMesh_.addColor(color);
+      }
+      for (size_t i = 1; i + 1 < surface.positions.size(); ++i) {
+        batchMesh_.addIndex(base);
+        batchMesh_.addIndex(base + static_cast<unsigned>(i));
+        batchMesh_.addIndex(base + static_cast<unsigned>(i + 1));
+      }
     }
 
-    const float alpha = std::clamp(surface.getOpacity() * midiBrightness_, 0.0f, 1.0f);
-    const float brightness = std::clamp(surface.getBrightness(), 0.0f, 1.0f);
-    const int alphaValue = static_cast<int>(std::round(alpha * 255.0f));
-    const int colorValue = static_cast<int>(std::round(brightness * 255.0f));
-    ofSetColor(colorValue, colorValue, colorValue, alphaValue);
+    ofEnableBlendMode(toOfBlendMode(batch.blendMode));
+    texture->bind();
+    batchMesh_.draw();
+    texture->unbind();
+    ++drawCalls;
+  }
+  return drawCalls;
+}
 
-    auto& texture = player.getTexture();
-    if (texture.isAllocated()) {
-      texture.bind();
-      mesh.draw();
-      texture.unbind();
-    }
+void ofApp::drawEdgeBlend(OutputBlend& blend, const projection::renderer::OutputViewport& output) {
+  blend.mask.configure(output.width, output.height, output.blend);
+  if (!blend.mask.active()) {
+    return;
+  }
+  if (blend.uploadedGeneration != blend.mask.generation()) {
+    blend.mask.gainImage(blendUpload_);
+    blend.gain.allocate(output.width, output.height, GL_RGBA);
+    blend.gain.loadData(blendUpload_.pixels().data(), output.width, output.height, GL_RGBA);
+    blend.mask.liftImage(blendUpload_);
+    blend.lift.allocate(output.width, output.height, GL_RGBA);
+    blend.lift.loadData(blendUpload_.pixels().data(), output.width, output.height, GL_RGBA);
+    blend.uploadedGeneration = blend.mask.generation();
   }
 
-  ofPopMatrix();
+  // Opaque masks: multiply leaves dst * gain, add leaves dst + lift, as EdgeBlendMask::apply.
+  const auto width = static_cast<float>(output.width);
+  const auto height = static_cast<float>(output.height);
   ofSetColor(255, 255, 255);
+  ofEnableBlendMode(OF_BLENDMODE_MULTIPLY);
+  blend.gain.draw(0, 0, width, height);
+  if (output.blend.blackLevel > 0.0f) {
+    ofEnableBlendMode(OF_BLENDMODE_ADD);
+    blend.lift.draw(0, 0, width, height);
+  }
+}
 
-  ofDrawBitmapString("Renderer connected to: " + host_ + ":" + std::to_string(serverPort), 20, 20);
-  if (!role.empty()) {
-    ofDrawBitmapString("Role: " + role + " | Version: " + version, 20, 40);
+float ofApp::drawStatusOverlay(const projection::renderer::RendererStatus& status, size_t drawCalls,
+                               size_t surfaceCount) {
+  ofDrawBitmapString("Renderer connected to: " + host_ + ":" + std::to_string(port_), 20, 20);
+  if (!status.role.empty()) {
+    ofDrawBitmapString("Role: " + status.role + " | Version: " + status.version, 20, 40);
   }
-  if (!sceneId.empty()) {
-    ofDrawBitmapString("Loaded Scene: " + sceneId, 20, 60);
+  if (!status.sceneId.empty()) {
+    ofDrawBitmapString("Loaded Scene: " + status.sceneId, 20, 60);
   }
-  if (!lastCommand.empty()) {
-    ofDrawBitmapString("Last Command: " + lastCommand, 20, 80);
+  if (!status.lastCommand.empty()) {
+    ofDrawBitmapString("Last Command: " + status.lastCommand, 20, 80);
   }
-  if (!lastError.empty()) {
-    ofSetColor(255, 0, 0);
-    ofDrawBitmapString("Last Error: " + lastError, 20, 100);
+  const auto& queue = runtime_.messageQueue();
+  ofDrawBitmapString("Message Queue: " + std::to_string(queue.size()) + "/" + std::to_string(queue.capacity()) +
+                         " (peak " + std::to_string(queue.highWaterMark()) + ", rejected " +
+                         std::to_string(queue.rejectedCount()) + ", coalesced " +
+                         std::to_string(runtime_.coalescingStats().coalesced()) + ")",
+                     20, 100);
+  ofDrawBitmapString("Draw Calls: " + std::to_string(drawCalls) + " for " + std::to_string(surfaceCount) +
+                         " surfaces",
+                     20, 120);
+  const auto clockSync = client_.clockSync();
+  ofDrawBitmapString(clockSync.synchronized
+                         ? "Server Clock: offset " + ofToString(clockSync.offsetMicros / 1000.0, 2) + " ms, rtt " +
+                               ofToString(clockSync.roundTripMicros / 1000.0, 2) + " ms, scheduled " +
+                               std::to_string(runtime_.scheduledCount())
+                         : std::string("Server Clock: not synchronized"),
+                     20, 140);
+  const auto framePool = runtime_.framePool().stats();
+  ofDrawBitmapString("Frame Pool: " + ofToString(framePool.bytesInUse / (1024.0 * 1024.0), 1) + " MB in use, " +
+                         ofToString(framePool.bytesIdle / (1024.0 * 1024.0), 1) + " MB idle, hit rate " +
+                         ofToString(framePool.hitRate() * 100.0, 1) + "%",
+                     20, 160);
+  const auto residency = runtime_.renderState().videoResidency().stats();
+  ofDrawBitmapString("Video Players: " + std::to_string(residency.activePlayers) + " active, " +
+                         std::to_string(residency.warmPlayers) + " warm, " +
+                         ofToString(residency.residentBytes() / (1024.0 * 1024.0), 1) + "/" +
+                         ofToString(residency.budgetBytes / (1024.0 * 1024.0), 0) + " MB, evictions " +
+                         std::to_string(residency.evictions),
+                     20, 180);
+  const auto& quality = runtime_.qualityGovernor();
+  ofDrawBitmapString("Quality: " + quality.level().name + " (p" + ofToString(quality.options().percentile, 0) + " " +
+                         ofToString(quality.rollingPercentileMs(), 1) + " ms of " + ofToString(quality.budgetMs(), 1) +
+                         " ms budget, " + std::to_string(quality.changeCount()) + " changes)",
+                     20, 200);
+  const auto& midi = runtime_.midiStats();
+  ofDrawBitmapString("MIDI: " + std::to_string(midi.applied) + "/" + std::to_string(midi.received) + " applied, " +
+                         std::to_string(midi.filtered) + " filtered, " + std::to_string(midi.dropped) +
+                         " dropped, latency " + ofToString(midi.lastFrameMaxLatencyMs, 2) + " ms (mean " +
+                         ofToString(midi.meanLatencyMs(), 2) + ", max " + ofToString(midi.maxLatencyMs, 2) + ")",
+                     20, 220);
+  // Per-feed drift against the master playback clock, after correction.
+  float overlayY = 240.0f;
+  for (const auto& entry : runtime_.renderState().videoFeeds()) {
+    const auto& drift = entry.second.drift;
+    ofDrawBitmapString("Feed " + entry.first + ": drift " + ofToString(drift.driftSeconds * 1000.0, 1) + " ms, rate " +
+                           ofToString(drift.rate, 3) + ", resyncs " + std::to_string(drift.resyncCount),
+                       20, overlayY);
+    overlayY += 20.0f;
   }
+  return overlayY;
 }
 
-void ofApp::audioIn(ofSoundBuffer& input) {
-  const int channels = std::max<int>(1, input.getNumChannels());
-  std::vector<float> mono;
-  mono.reserve(static_cast<size_t>(input.getNumFrames()));
-  for (int i = 0; i < input.getNumFrames(); ++i) {
-    mono.push_back(input[static_cast<size_t>(i * channels)]);
+ofTexture* ofApp::textureForFeed(const std::string& feedId, projection::renderer::VideoSource& source) {
+  if (auto* video = dynamic_cast<projection::renderer::OfVideoSource*>(&source)) {
+    auto& texture = video->player().getTexture();
+    if (!texture.isAllocated() || texture.getTextureData().textureID == 0) {
+      return nullptr;
+    }
+    return &texture;
   }
 
-  std::lock_guard<std::mutex> lock(audioMutex_);
-  audioBuffer_ = std::move(mono);
+  const auto frame = source.cpuFrame();
+  if (frame.empty()) {
+    return nullptr;
+  }
+  auto& entry = cpuFeedTextures_[feedId];
+  if (entry.version != source.frameVersion()) {
+    if (!entry.texture.isAllocated() || entry.texture.getWidth() != frame.width ||
+        entry.texture.getHeight() != frame.height) {
+      entry.texture.allocate(frame.width, frame.height, GL_RGBA);
+    }
+    entry.texture.loadData(frame.data, frame.width, frame.height, GL_RGBA);
+    entry.version = source.frameVersion();
+  }
+  return &entry.texture;
+}
+
+void ofApp::audioIn(ofSoundBuffer& input) {
+  // Runs on the audio thread: no locks, no allocation, just a downmix into the ring.
+  const auto& samples = input.getBuffer();
+  if (samples.empty()) {
+    return;
+  }
+  const size_t channels = std::max<size_t>(1, input.getNumChannels());
+  runtime_.writeAudio(samples.data(), input.getNumFrames(), channels);
 }
 
 #if PROJECTION_HAS_OFX_MIDI
 void ofApp::newMidiMessage(ofxMidiMessage& msg) {
-  if (msg.status == ofxMidiMessage::MIDI_CONTROL_CHANGE && msg.control == 1) {
-    midiBrightness_ = projection::renderer::mapMidiValueToBrightness(msg.value);
+  // Runs on the MIDI thread: stamp and queue; filtering and mapping happen once per frame.
+  projection::renderer::MidiEvent event;
+  switch (msg.status) {
+    case MIDI_CONTROL_CHANGE:
+      event.status = projection::renderer::kMidiControlChange;
+      event.data1 = static_cast<uint8_t>(msg.control);
+      event.data2 = static_cast<uint8_t>(msg.value);
+      break;
+    case MIDI_NOTE_ON:
+    case MIDI_NOTE_OFF:
+      event.status = msg.status == MIDI_NOTE_ON ? projection::renderer::kMidiNoteOn : projection::renderer::kMidiNoteOff;
+      event.data1 = static_cast<uint8_t>(msg.pitch);
+      event.data2 = static_cast<uint8_t>(msg.velocity);
+      break;
+    default:
+      return;
   }
+  // ofxMidi numbers channels 1-16.
+  event.status |= static_cast<uint8_t>(std::clamp(msg.channel - 1, 0, 15));
+  runtime_.writeMidi(event);
 }
 #endif
 
 void ofApp::exit() {
   soundStream_.stop();
+  runtime_.stopAudioAnalysis();
 #if PROJECTION_HAS_OFX_MIDI
   midiIn_.closePort();
 #endif
   client_.stop();
-}
-
-void ofApp::handle(const projection::core::RendererMessage& message) {
-  std::lock_guard<std::mutex> lock(queueMutex_);
-  messageQueue_.push(message);
-}
-
-void ofApp::processMessage(const projection::core::RendererMessage& message) {
-  {
-    std::lock_guard<std::mutex> lock(stateMutex_);
-    lastError_.clear();
-  }
-
-  switch (message.type) {
-    case RendererMessageType::Hello:
-      {
-        std::lock_guard<std::mutex> lock(stateMutex_);
-        updateStatusForHello(*message.hello, message.commandId);
-      }
-      break;
-    case RendererMessageType::LoadScene:
-      {
-        std::lock_guard<std::mutex> lock(stateMutex_);
-        updateStatusForLoadScene(*message.loadScene, message.commandId);
-      }
-      break;
-    case RendererMessageType::LoadSceneDefinition:
-      if (verbose_) {
-        std::cerr << "[renderer] LoadSceneDefinition with scene " << message.loadSceneDefinition->scene.getId().value
-                  << " feeds=" << message.loadSceneDefinition->feeds.size() << std::endl;
-      }
-      renderState_.loadSceneDefinition(message.loadSceneDefinition->scene, message.loadSceneDefinition->feeds);
-      {
-        std::lock_guard<std::mutex> lock(stateMutex_);
-        sceneId_ = message.loadSceneDefinition->scene.getId().value;
-        lastCommand_ = "LoadSceneDefinition (#" + message.commandId + ")";
-      }
-      break;
-    case RendererMessageType::SetFeedForSurface:
-      {
-        std::lock_guard<std::mutex> lock(stateMutex_);
-        updateStatusForSetFeed(*message.setFeedForSurface, message.commandId);
-      }
-      break;
-    case RendererMessageType::PlayCue:
-      {
-        std::lock_guard<std::mutex> lock(stateMutex_);
-        updateStatusForPlayCue(*message.playCue, message.commandId);
-      }
-      break;
-    case RendererMessageType::Ack:
-    case RendererMessageType::Error:
-      // Renderer should not receive these in normal operation, ignore.
-      break;
-  }
-}
-
-void ofApp::updateStatusForHello(const projection::core::HelloMessage& hello, const std::string& commandId) {
-  rendererRole_ = hello.role;
-  rendererVersion_ = hello.version;
-  lastCommand_ = "Hello (#" + commandId + ")";
-}
-
-void ofApp::updateStatusForLoadScene(const projection::core::LoadSceneMessage& loadScene,
-                                     const std::string& commandId) {
-  sceneId_ = loadScene.sceneId.value;
-  lastCommand_ = "LoadScene (#" + commandId + ")";
-}
-
-void ofApp::updateStatusForSetFeed(const projection::core::SetFeedForSurfaceMessage& setFeed,
-                                   const std::string& commandId) {
-  lastCommand_ = "SetFeedForSurface (#" + commandId + ") -> surface " + setFeed.surfaceId.value +
-                 " feed " + setFeed.feedId.value;
-}
-
-void ofApp::updateStatusForPlayCue(const projection::core::PlayCueMessage& playCue, const std::string& commandId) {
-  lastCommand_ = "PlayCue (#" + commandId + ") -> cue " + playCue.cueId.value;
+  runtime_.flushSceneSnapshots();
 }
@@ -1,9 +1,11 @@
 #pragma once
 
-#include <memory>
-#include <mutex>
-#include <queue>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <ofMain.h>
@@ -14,15 +16,16 @@
 #define PROJECTION_HAS_OFX_MIDI 0
 #endif
 
-#include "RenderState.h"
+#include "RendererRuntime.h"
+#include "compositor/EdgeBlend.h"
+#include "compositor/RgbaImage.h"
 #include "net/RendererClient.h"
-#include "util/InteractionUtils.h"
 
-class ofApp : public ofBaseApp,
+class ofApp : public ofBaseApp
 #if PROJECTION_HAS_OFX_MIDI
-              public ofxMidiListener,
+    , public ofxMidiListener
 #endif
-              public projection::renderer::RendererCommandHandler {
+{
  public:
   explicit ofApp(std::string host, int port, std::string name, bool verbose = false);
 
@@ -31,6 +34,24 @@ class ofApp : public ofBaseApp,
   void draw() override;
   void exit() override;
 
+  // Memory budget for open video players (current scene plus warm ones).
+  void setVideoBudget(size_t budgetBytes) { runtime_.setVideoBudget(budgetBytes); }
+  // Frame rate the quality governor holds frames to; 0 keeps full quality.
+  void setTargetFps(double fps) {
+    projection::renderer::QualityGovernorOptions options;
+    options.targetFps = fps;
+    runtime_.setQualityGovernor(options);
+  }
+  // Scene snapshot restored before connecting and rewritten as the scene changes; empty disables it.
+  void setSnapshotFile(std::string path) { snapshotFile_ = std::move(path); }
+  void setLabels(std::string group, std::vector<std::string> tags) { client_.setLabels(std::move(group), std::move(tags)); }
+  // Outputs drawn as viewports of the (spanning) window; empty draws the whole scene once.
+  void setOutputs(std::vector<projection::renderer::OutputViewport> outputs) {
+    outputs_ = std::move(outputs);
+    outputBlends_.clear();
+    outputBlends_.resize(outputs_.size());
+  }
+
 #if PROJECTION_HAS_OFX_MIDI
   void audioIn(ofSoundBuffer& input) override;
   void newMidiMessage(ofxMidiMessage& msg) override;
@@ -38,42 +59,51 @@ class ofApp : public ofBaseApp,
   void audioIn(ofSoundBuffer& input) override;
 #endif
 
-  void handle(const projection::core::RendererMessage& message) override;
-
  private:
-  void updateStatusForHello(const projection::core::HelloMessage& hello, const std::string& commandId);
-  void updateStatusForLoadScene(const projection::core::LoadSceneMessage& loadScene,
-                                const std::string& commandId);
-  void updateStatusForSetFeed(const projection::core::SetFeedForSurfaceMessage& setFeed,
-                              const std::string& commandId);
-  void updateStatusForPlayCue(const projection::core::PlayCueMessage& playCue, const std::string& commandId);
-  void processMessage(const projection::core::RendererMessage& message);
+  // Texture to bind for a feed, or nullptr while it has nothing to show.
+  ofTexture* textureForFeed(const std::string& feedId, projection::renderer::VideoSource& source);
+  // Draws a prepared draw list into the current viewport; returns the number of draw calls.
+  size_t drawSurfaces(const projection::renderer::DrawList& drawList);
+  struct OutputBlend;
+  // Final output stage: multiplies the output by its edge-blend mask and adds the black lift.
+  void drawEdgeBlend(OutputBlend& blend, const projection::renderer::OutputViewport& output);
+  // Status text (connection, queue, clock, pools, quality, per-feed drift); returns the next line's y.
+  float drawStatusOverlay(const projection::renderer::RendererStatus& status, size_t drawCalls, size_t surfaceCount);
 
+  // Owns scene state and per-frame logic; receives commands from client_.
+  projection::renderer::RendererRuntime runtime_;
   projection::renderer::RendererClient client_;
   std::string host_;
   int port_;
   std::string name_;
   bool verbose_{false};
-
-  projection::renderer::RenderState renderState_{};
-
-  std::mutex queueMutex_{};
-  std::queue<projection::core::RendererMessage> messageQueue_{};
-  std::mutex stateMutex_{};
-  std::mutex audioMutex_{};
-  std::string lastCommand_;
-  std::string lastError_;
-  std::string sceneId_;
-  std::string rendererRole_;
-  std::string rendererVersion_;
+  std::string snapshotFile_{};
+  std::chrono::steady_clock::time_point frameWorkStart_{};
+  std::vector<projection::renderer::OutputViewport> outputs_{};
+  // Edge-blend mask per output, uploaded to textures only when the mask is regenerated.
+  struct OutputBlend {
+    projection::renderer::EdgeBlendMask mask;
+    uint64_t uploadedGeneration{0};
+    ofTexture gain;
+    ofTexture lift;
+  };
+  std::vector<OutputBlend> outputBlends_{};
+  projection::renderer::RgbaImage blendUpload_{};
 
 #if PROJECTION_HAS_OFX_MIDI
   ofxMidiIn midiIn_{};
 #endif
-  float midiBrightness_{1.0f};
 
   ofSoundStream soundStream_{};
-  std::vector<float> audioBuffer_{};
-  float audioScale_{1.0f};
-  float smoothedEnergy_{0.0f};
+  // Reused every frame so batch geometry does not reallocate.
+  ofMesh batchMesh_{};
+
+  // Textures for feeds rendered on the CPU (Generated feeds); re-uploaded only when the
+  // source's frameVersion() moves. Dropped when a new scene definition replaces the sources.
+  struct CpuFeedTexture {
+    ofTexture texture;
+    uint64_t version{0};
+  };
+  std::unordered_map<std::string, CpuFeedTexture> cpuFeedTextures_{};
+  uint64_t cpuFeedTexturesGeneration_{0};
 };
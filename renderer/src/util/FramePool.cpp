@@ -0,0 +1,207 @@
+#include "util/FramePool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace projection::renderer {
+
+size_t bytesPerPixel(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::Rgba8:
+      return 4;
+    case PixelFormat::Gray8:
+      return 1;
+  }
+  return 4;
+}
+
+namespace detail {
+struct FramePoolState {
+  using Key = std::tuple<int, int, PixelFormat>;
+
+  std::mutex mutex;
+  bool closed{false};
+  uint64_t tick{0};
+  FramePoolStats stats{};
+  std::map<Key, std::vector<FrameBlock*>> idle;
+
+  size_t allocatedBytes() const { return stats.bytesInUse + stats.bytesIdle; }
+
+  // Removes the least recently released idle buffer; nullptr when there is none.
+  FrameBlock* takeOldestIdle() {
+    auto oldest = idle.end();
+    for (auto it = idle.begin(); it != idle.end(); ++it) {
+      if (!it->second.empty() &&
+          (oldest == idle.end() || it->second.front()->releasedAt < oldest->second.front()->releasedAt)) {
+        oldest = it;
+      }
+    }
+    if (oldest == idle.end()) {
+      return nullptr;
+    }
+    // Each list is in release order, so its front is its oldest entry.
+    FrameBlock* block = oldest->second.front();
+    oldest->second.erase(oldest->second.begin());
+    stats.bytesIdle -= block->bytes;
+    return block;
+  }
+};
+
+namespace {
+void freeBlock(FrameBlock* block) {
+  ::operator delete(block->data, std::align_val_t{FramePool::kAlignment});
+  delete block;
+}
+
+void releaseFrameBlock(FrameBlock* block) {
+  // Keeps the state alive until after its mutex is released, even if the pool is gone.
+  std::shared_ptr<FramePoolState> state = block->pool;
+  bool keep = false;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->stats.bytesInUse -= block->bytes;
+    if (!state->closed && state->allocatedBytes() + block->bytes <= state->stats.budgetBytes) {
+      block->releasedAt = ++state->tick;
+      state->idle[FramePoolState::Key{block->width, block->height, block->format}].push_back(block);
+      state->stats.bytesIdle += block->bytes;
+      keep = true;
+    }
+  }
+  if (!keep) {
+    freeBlock(block);
+  }
+}
+}  // namespace
+}  // namespace detail
+
+FrameRef::FrameRef(const FrameRef& other) : block_(other.block_) {
+  if (block_) {
+    block_->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+FrameRef& FrameRef::operator=(const FrameRef& other) {
+  if (this != &other) {
+    FrameRef copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+FrameRef& FrameRef::operator=(FrameRef&& other) noexcept {
+  if (this != &other) {
+    reset();
+    block_ = other.block_;
+    other.block_ = nullptr;
+  }
+  return *this;
+}
+
+void FrameRef::reset() {
+  if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    detail::releaseFrameBlock(block_);
+  }
+  block_ = nullptr;
+}
+
+ImageView FrameRef::view() const {
+  if (!block_ || block_->format != PixelFormat::Rgba8) {
+    return {};
+  }
+  return ImageView{block_->data, block_->width, block_->height, block_->strideBytes};
+}
+
+MutableImageView FrameRef::mutableView() const {
+  if (!block_ || block_->format != PixelFormat::Rgba8) {
+    return {};
+  }
+  return MutableImageView{block_->data, block_->width, block_->height, block_->strideBytes};
+}
+
+FramePool::FramePool(size_t budgetBytes) : state_(std::make_shared<detail::FramePoolState>()) {
+  state_->stats.budgetBytes = budgetBytes;
+}
+
+FramePool::~FramePool() {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  state_->closed = true;
+  while (detail::FrameBlock* block = state_->takeOldestIdle()) {
+    detail::freeBlock(block);
+  }
+}
+
+FrameRef FramePool::acquire(int width, int height, PixelFormat format) {
+  if (width <= 0 || height <= 0) {
+    return {};
+  }
+  const size_t stride = static_cast<size_t>(width) * bytesPerPixel(format);
+  const size_t bytes = stride * static_cast<size_t>(height);
+
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  auto& stats = state_->stats;
+  auto it = state_->idle.find(detail::FramePoolState::Key{width, height, format});
+  if (it != state_->idle.end() && !it->second.empty()) {
+    // Most recently released first: its pixels are most likely still in cache.
+    detail::FrameBlock* block = it->second.back();
+    it->second.pop_back();
+    stats.bytesIdle -= bytes;
+    stats.bytesInUse += bytes;
+    ++stats.hits;
+    block->refs.store(1, std::memory_order_relaxed);
+    return FrameRef(block);
+  }
+
+  while (state_->allocatedBytes() + bytes > stats.budgetBytes) {
+    detail::FrameBlock* victim = state_->takeOldestIdle();
+    if (!victim) {
+      ++stats.rejected;
+      return {};
+    }
+    ++stats.evictions;
+    detail::freeBlock(victim);
+  }
+
+  auto* block = new detail::FrameBlock;
+  block->pool = state_;
+  block->data = static_cast<uint8_t*>(::operator new(bytes, std::align_val_t{kAlignment}));
+  std::memset(block->data, 0, bytes);
+  block->bytes = bytes;
+  block->width = width;
+  block->height = height;
+  block->format = format;
+  block->strideBytes = stride;
+  block->refs.store(1, std::memory_order_relaxed);
+  stats.bytesInUse += bytes;
+  stats.peakBytes = std::max(stats.peakBytes, state_->allocatedBytes());
+  ++stats.misses;
+  return FrameRef(block);
+}
+
+void FramePool::trim() {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  while (detail::FrameBlock* block = state_->takeOldestIdle()) {
+    ++state_->stats.evictions;
+    detail::freeBlock(block);
+  }
+}
+
+void FramePool::setBudget(size_t budgetBytes) {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  state_->stats.budgetBytes = budgetBytes;
+  while (state_->allocatedBytes() > budgetBytes) {
+    detail::FrameBlock* block = state_->takeOldestIdle();
+    if (!block) {
+      break;
+    }
+    ++state_->stats.evictions;
+    detail::freeBlock(block);
+  }
+}
+
+FramePoolStats FramePool::stats() const {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->stats;
+}
+
+}  // namespace projection::renderer
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "compositor/RgbaImage.h"
+
+namespace projection::renderer {
+
+enum class PixelFormat { Rgba8, Gray8 };
+
+size_t bytesPerPixel(PixelFormat format);
+
+struct FramePoolStats {
+  uint64_t hits{0};
+  uint64_t misses{0};  // each one is a fresh allocation
+  uint64_t rejected{0};  // acquires refused by the budget
+  uint64_t evictions{0};  // idle buffers freed to make room
+  size_t bytesInUse{0};
+  size_t bytesIdle{0};
+  size_t peakBytes{0};  // high-water mark of in-use + idle
+  size_t budgetBytes{0};
+
+  double hitRate() const {
+    const uint64_t total = hits + misses;
+    return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+  }
+};
+
+namespace detail {
+struct FramePoolState;
+
+struct FrameBlock {
+  std::shared_ptr<FramePoolState> pool;
+  uint8_t* data{nullptr};
+  size_t bytes{0};
+  int width{0};
+  int height{0};
+  PixelFormat format{PixelFormat::Rgba8};
+  size_t strideBytes{0};
+  std::atomic<uint32_t> refs{0};
+  uint64_t releasedAt{0};
+};
+}  // namespace detail
+
+// Reference-counted handle on a pooled frame buffer. Copies share the pixels; when the last
+// handle goes away the buffer returns to its pool (from any thread) for the next acquire of
+// the same size and format.
+class FrameRef {
+ public:
+  FrameRef() = default;
+  FrameRef(const FrameRef& other);
+  FrameRef(FrameRef&& other) noexcept : block_(other.block_) { other.block_ = nullptr; }
+  FrameRef& operator=(const FrameRef& other);
+  FrameRef& operator=(FrameRef&& other) noexcept;
+  ~FrameRef() { reset(); }
+
+  void reset();
+  explicit operator bool() const { return block_ != nullptr; }
+  uint32_t useCount() const { return block_ ? block_->refs.load(std::memory_order_relaxed) : 0; }
+
+  int width() const { return block_ ? block_->width : 0; }
+  int height() const { return block_ ? block_->height : 0; }
+  PixelFormat format() const { return block_ ? block_->format : PixelFormat::Rgba8; }
+  size_t strideBytes() const { return block_ ? block_->strideBytes : 0; }
+  uint8_t* data() const { return block_ ? block_->data : nullptr; }
+  uint8_t* row(int y) const { return data() + static_cast<size_t>(y) * strideBytes(); }
+
+  // RGBA8 views; empty for other formats.
+  ImageView view() const;
+  MutableImageView mutableView() const;
+
+ private:
+  friend class FramePool;
+  explicit FrameRef(detail::FrameBlock* block) : block_(block) {}
+
+  detail::FrameBlock* block_{nullptr};
+};
+
+// Renderer-wide recycler for CPU frame buffers (generated content, previews, downscales).
+// Buffers are keyed by size and format, aligned to kAlignment, and tightly packed so they can
+// be uploaded without row padding. All allocated bytes (in use plus idle) stay within the
+// budget: a miss first evicts the oldest idle buffers, and an acquire that still does not fit
+// returns an empty FrameRef. Once every size in use has been seen, steady-state playback
+// allocates nothing. Thread-safe; handles may outlive the pool.
+class FramePool {
+ public:
+  static constexpr size_t kAlignment = 64;
+  static constexpr size_t kDefaultBudgetBytes = size_t{256} << 20;
+
+  explicit FramePool(size_t budgetBytes = kDefaultBudgetBytes);
+  ~FramePool();
+
+  FramePool(const FramePool&) = delete;
+  FramePool& operator=(const FramePool&) = delete;
+
+  // Pixels are left as the previous user wrote them (fresh buffers are zeroed).
+  FrameRef acquire(int width, int height, PixelFormat format = PixelFormat::Rgba8);
+
+  // Frees idle buffers; in-use buffers are unaffected.
+  void trim();
+  // Lowering the budget evicts idle buffers until the pool fits (in-use bytes may still exceed it).
+  void setBudget(size_t budgetBytes);
+  FramePoolStats stats() const;
+
+ private:
+  std::shared_ptr<detail::FramePoolState> state_;
+};
+
+}  // namespace projection::renderer
@@ -23,6 +23,18 @@ float computeAverageEnergy(const std::vector<float>& magnitudes, size_t binCount
   return sum / static_cast<float>(count);
 }
 
+float computeMeanSquareEnergy(const float* samples, size_t count) {
+  if (samples == nullptr || count == 0) {
+    return 0.0f;
+  }
+
+  double energySum = 0.0;
+  for (size_t i = 0; i < count; ++i) {
+    energySum += static_cast<double>(samples[i]) * static_cast<double>(samples[i]);
+  }
+  return static_cast<float>(energySum / static_cast<double>(count));
+}
+
 float mapEnergyToScale(float energy, float minScale, float maxScale, float energyForMax) {
   if (energyForMax <= 0.0f) {
     return minScale;
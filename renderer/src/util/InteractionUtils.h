@@ -9,6 +9,9 @@ float mapMidiValueToBrightness(int value);
 
 float computeAverageEnergy(const std::vector<float>& magnitudes, size_t binCount = 32);
 
+// Mean of the squared samples; 0 for an empty window.
+float computeMeanSquareEnergy(const float* samples, size_t count);
+
 float mapEnergyToScale(float energy, float minScale = 0.8f, float maxScale = 1.2f, float energyForMax = 1.0f);
 
 }  // namespace projection::renderer
@@ -0,0 +1,86 @@
+#include "util/QualityGovernor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace projection::renderer {
+
+std::vector<QualityLevel> defaultQualityLevels() {
+  return {QualityLevel{"high", true, true, 1}, QualityLevel{"medium", true, true, 2},
+          QualityLevel{"low", false, true, 4}, QualityLevel{"minimal", false, false, 8}};
+}
+
+QualityGovernor::QualityGovernor(QualityGovernorOptions options, std::vector<QualityLevel> levels)
+    : levels_(std::move(levels)) {
+  if (levels_.empty()) {
+    throw std::runtime_error("QualityGovernor needs at least one quality level");
+  }
+  setOptions(options);
+}
+
+void QualityGovernor::setOptions(const QualityGovernorOptions& options) {
+  options_ = options;
+  options_.windowFrames = std::max<size_t>(1, options_.windowFrames);
+  window_.assign(options_.windowFrames, 0.0);
+  scratch_.reserve(options_.windowFrames);
+  windowNext_ = 0;
+  windowCount_ = 0;
+  framesAtLevel_ = 0;
+  if (!enabled()) {
+    level_ = 0;
+  }
+}
+
+bool QualityGovernor::addFrame(double frameMs) {
+  ++frames_;
+  if (!enabled()) {
+    return false;
+  }
+  window_[windowNext_] = frameMs;
+  windowNext_ = (windowNext_ + 1) % window_.size();
+  windowCount_ = std::min(windowCount_ + 1, window_.size());
+  ++framesAtLevel_;
+
+  const bool canDegrade = framesAtLevel_ >= options_.degradeHoldFrames && level_ + 1 < levels_.size();
+  const bool canUpgrade = framesAtLevel_ >= options_.upgradeHoldFrames && level_ > 0;
+  if (!canDegrade && !canUpgrade) {
+    return false;
+  }
+  const double percentileMs = rollingPercentileMs();
+  if (canDegrade && percentileMs > budgetMs() * options_.degradeRatio) {
+    changeLevel(level_ + 1, percentileMs);
+    return true;
+  }
+  if (canUpgrade && percentileMs < budgetMs() * options_.upgradeRatio) {
+    changeLevel(level_ - 1, percentileMs);
+    return true;
+  }
+  return false;
+}
+
+double QualityGovernor::rollingPercentileMs() const {
+  if (windowCount_ == 0) {
+    return 0.0;
+  }
+  // Nearest rank, as in TimingSeries; the window is unsorted, so select instead of sorting.
+  scratch_.assign(window_.begin(), window_.begin() + static_cast<std::ptrdiff_t>(windowCount_));
+  const double clamped = std::clamp(options_.percentile, 0.0, 100.0);
+  const auto rank = static_cast<size_t>(std::ceil(clamped / 100.0 * static_cast<double>(windowCount_)));
+  const auto nth = scratch_.begin() + static_cast<std::ptrdiff_t>(rank == 0 ? 0 : rank - 1);
+  std::nth_element(scratch_.begin(), nth, scratch_.end());
+  return *nth;
+}
+
+void QualityGovernor::changeLevel(size_t level, double percentileMs) {
+  lastChange_ = QualityChange{frames_, level_, level, percentileMs};
+  level_ = level;
+  ++changeCount_;
+  // Frame times from the previous level say nothing about this one.
+  windowNext_ = 0;
+  windowCount_ = 0;
+  framesAtLevel_ = 0;
+}
+
+}  // namespace projection::renderer
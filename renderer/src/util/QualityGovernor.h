@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace projection::renderer {
+
+// What the renderer spends per frame at one quality step.
+struct QualityLevel {
+  std::string name;
+  // Status overlay text in the windowed renderer.
+  bool overlay{true};
+  // Software-composited preview frames (headless --composite).
+  bool preview{true};
+  // Audio energy is analysed every N frames; the modulation holds in between.
+  int audioAnalysisInterval{1};
+};
+
+// high (everything every frame), medium (audio every 2nd frame), low (no overlay, audio every
+// 4th frame), minimal (no overlay or preview, audio every 8th frame).
+std::vector<QualityLevel> defaultQualityLevels();
+
+struct QualityGovernorOptions {
+  // <= 0 disables the governor; it then stays at the first level.
+  double targetFps{60.0};
+  // Rolling window of frame times the percentile is taken over.
+  size_t windowFrames{120};
+  double percentile{95.0};
+  // Step down when the percentile exceeds budget * degradeRatio, up when it is below
+  // budget * upgradeRatio; frame times in between keep the current level.
+  double degradeRatio{1.1};
+  double upgradeRatio{0.7};
+  // Frames to stay at a level before stepping down / up again. Stepping up waits longer
+  // so a level that just stopped missing frames is not immediately given the work back.
+  size_t degradeHoldFrames{60};
+  size_t upgradeHoldFrames{300};
+};
+
+struct QualityChange {
+  uint64_t frame{0};
+  size_t fromLevel{0};
+  size_t toLevel{0};
+  // Rolling percentile frame time that triggered the change.
+  double percentileMs{0.0};
+};
+
+// Steps through quality levels (index 0 is the highest) from rolling frame-time percentiles
+// against the target frame budget, with a dead band between the step-down and step-up
+// thresholds and a minimum time at each level. Pure bookkeeping with no clock of its own, so
+// it can be driven by synthetic frame-time traces. Render thread only.
+class QualityGovernor {
+ public:
+  explicit QualityGovernor(QualityGovernorOptions options = {},
+                           std::vector<QualityLevel> levels = defaultQualityLevels());
+
+  // Records one frame's work time; returns true when the level changed.
+  bool addFrame(double frameMs);
+
+  void setOptions(const QualityGovernorOptions& options);
+  const QualityGovernorOptions& options() const { return options_; }
+  bool enabled() const { return options_.targetFps > 0.0; }
+  double budgetMs() const { return enabled() ? 1000.0 / options_.targetFps : 0.0; }
+
+  size_t levelIndex() const { return level_; }
+  const QualityLevel& level() const { return levels_[level_]; }
+  const std::vector<QualityLevel>& levels() const { return levels_; }
+  // Percentile over the frames recorded since the last level change.
+  double rollingPercentileMs() const;
+  uint64_t changeCount() const { return changeCount_; }
+  // Most recent change; frame 0 and equal levels when there was none.
+  const QualityChange& lastChange() const { return lastChange_; }
+
+ private:
+  void changeLevel(size_t level, double percentileMs);
+
+  QualityGovernorOptions options_;
+  std::vector<QualityLevel> levels_;
+  size_t level_{0};
+  // Ring of the last windowFrames frame times; scratch_ is reused for the percentile.
+  std::vector<double> window_{};
+  size_t windowNext_{0};
+  size_t windowCount_{0};
+  mutable std::vector<double> scratch_{};
+  size_t framesAtLevel_{0};
+  uint64_t frames_{0};
+  uint64_t changeCount_{0};
+  QualityChange lastChange_{};
+};
+
+}  // namespace projection::renderer
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace projection::renderer {
+
+// Single-writer sequence lock for a small trivially copyable value.
+//
+// The writer never waits: store() bumps the sequence to odd, copies the value and bumps it
+// back to even. Readers copy the value and keep it only if the sequence was even and
+// unchanged across the copy, so tryLoad() is constant time, lock-free and wait-free (it
+// fails instead of retrying while a store is in progress). The payload lives in relaxed
+// atomic words so a torn read is discarded rather than being a data race.
+template <typename T>
+class Seqlock {
+  static_assert(std::is_trivially_copyable_v<T>, "Seqlock payloads must be trivially copyable");
+
+ public:
+  Seqlock() { store(T{}); }
+  explicit Seqlock(const T& initial) { store(initial); }
+
+  Seqlock(const Seqlock&) = delete;
+  Seqlock& operator=(const Seqlock&) = delete;
+
+  // Writer side; only one thread may store at a time.
+  void store(const T& value) {
+    std::array<uint64_t, kWords> words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+    const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kWords; ++i) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  // Any thread. Returns false (and leaves `out` untouched) when a store overlapped the read.
+  bool tryLoad(T& out) const {
+    const uint64_t before = sequence_.load(std::memory_order_acquire);
+    if (before & 1) {
+      return false;
+    }
+    std::array<uint64_t, kWords> words{};
+    for (size_t i = 0; i < kWords; ++i) {
+      words[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) != before) {
+      return false;
+    }
+    std::memcpy(static_cast<void*>(&out), words.data(), sizeof(T));
+    return true;
+  }
+
+  // Retries until a consistent copy is read; for callers that can afford to spin.
+  T load() const {
+    T value{};
+    while (!tryLoad(value)) {
+    }
+    return value;
+  }
+
+  // Number of completed stores (including the initial one).
+  uint64_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+ private:
+  static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  std::atomic<uint64_t> sequence_{0};
+  std::array<std::atomic<uint64_t>, kWords> words_{};
+};
+
+}  // namespace projection::renderer
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace projection::renderer {
+
+// Bounded lock-free single-producer/single-consumer queue.
+//
+// Exactly one thread may call tryPush and exactly one (other) thread may call tryPop.
+// Elements are moved in and out, so the queue works with move-only types such as
+// std::unique_ptr. Capacity is rounded up to the next power of two.
+template <typename T>
+class SpscQueue {
+ public:
+  explicit SpscQueue(size_t capacity)
+      : capacity_(roundUpToPowerOfTwo(std::max<size_t>(capacity, 2))),
+        mask_(capacity_ - 1),
+        slots_(std::make_unique<T[]>(capacity_)) {}
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  // Producer side. Returns false (and leaves value untouched) when the queue is full.
+  bool tryPush(T&& value) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cachedHead_ >= capacity_) {
+      cachedHead_ = head_.load(std::memory_order_acquire);
+      if (tail - cachedHead_ >= capacity_) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    }
+    slots_[tail & mask_] = std::move(value);
+    tail_.store(tail + 1, std::memory_order_release);
+
+    const size_t occupancy = tail + 1 - cachedHead_;
+    if (occupancy > highWater_.load(std::memory_order_relaxed)) {
+      highWater_.store(occupancy, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  // Consumer side. Returns false when the queue is empty.
+  bool tryPop(T& out) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cachedTail_) {
+      cachedTail_ = tail_.load(std::memory_order_acquire);
+      if (head == cachedTail_) {
+        return false;
+      }
+    }
+    out = std::move(slots_[head & mask_]);
+    slots_[head & mask_] = T{};
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Approximate occupancy; exact when called from either endpoint thread while the other is idle.
+  size_t size() const {
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    const size_t head = head_.load(std::memory_order_acquire);
+    return tail >= head ? tail - head : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+  size_t capacity() const { return capacity_; }
+
+  // Largest occupancy observed by the producer since construction.
+  size_t highWaterMark() const { return highWater_.load(std::memory_order_relaxed); }
+
+  // Number of tryPush calls rejected because the queue was full.
+  uint64_t rejectedCount() const { return rejected_.load(std::memory_order_relaxed); }
+
+ private:
+  static size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  static constexpr size_t kCacheLine = 64;
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<T[]> slots_;
+
+  // Consumer-owned index plus the consumer's cached view of the producer index.
+  alignas(kCacheLine) std::atomic<size_t> head_{0};
+  size_t cachedTail_{0};
+
+  // Producer-owned index plus the producer's cached view of the consumer index.
+  alignas(kCacheLine) std::atomic<size_t> tail_{0};
+  size_t cachedHead_{0};
+
+  alignas(kCacheLine) std::atomic<size_t> highWater_{0};
+  std::atomic<uint64_t> rejected_{0};
+};
+
+}  // namespace projection::renderer
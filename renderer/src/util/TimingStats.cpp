@@ -0,0 +1,41 @@
+#include "util/TimingStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace projection::renderer {
+namespace {
+double nearestRank(const std::vector<double>& sorted, double pct) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const double clamped = std::clamp(pct, 0.0, 100.0);
+  const auto rank = static_cast<size_t>(std::ceil(clamped / 100.0 * static_cast<double>(sorted.size())));
+  return sorted[rank == 0 ? 0 : rank - 1];
+}
+}  // namespace
+
+TimingSummary TimingSeries::summarize() const {
+  TimingSummary summary{};
+  if (samples_.empty()) {
+    return summary;
+  }
+
+  std::vector<double> sorted = samples_;
+  std::sort(sorted.begin(), sorted.end());
+  summary.count = sorted.size();
+  summary.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+  summary.p50 = nearestRank(sorted, 50.0);
+  summary.p95 = nearestRank(sorted, 95.0);
+  summary.p99 = nearestRank(sorted, 99.0);
+  summary.max = sorted.back();
+  return summary;
+}
+
+double percentile(std::vector<double> samples, double pct) {
+  std::sort(samples.begin(), samples.end());
+  return nearestRank(samples, pct);
+}
+
+}  // namespace projection::renderer
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace projection::renderer {
+
+struct TimingSummary {
+  size_t count{0};
+  double mean{0.0};
+  double p50{0.0};
+  double p95{0.0};
+  double p99{0.0};
+  double max{0.0};
+};
+
+// Collects duration samples (any unit) and summarizes them with nearest-rank percentiles.
+class TimingSeries {
+ public:
+  explicit TimingSeries(size_t reserve = 0) { samples_.reserve(reserve); }
+
+  void add(double value) { samples_.push_back(value); }
+  void clear() { samples_.clear(); }
+  size_t size() const { return samples_.size(); }
+
+  TimingSummary summarize() const;
+
+ private:
+  std::vector<double> samples_;
+};
+
+// Nearest-rank percentile (0..100) of an unsorted sample set; 0 when empty.
+double percentile(std::vector<double> samples, double pct);
+
+}  // namespace projection::renderer
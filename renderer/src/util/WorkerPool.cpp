@@ -0,0 +1,92 @@
+#include "util/WorkerPool.h"
+
+#include <algorithm>
+
+namespace projection::renderer {
+
+WorkerPool::WorkerPool(size_t threadCount) {
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  workers_.reserve(threadCount - 1);
+  for (size_t i = 1; i < threadCount; ++i) {
+    workers_.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void WorkerPool::parallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body,
+                             size_t minChunk) {
+  if (count == 0) {
+    return;
+  }
+  // A few chunks per thread keeps bands balanced when some rows are more expensive.
+  const size_t targetChunks = threadCount() * 4;
+  const size_t chunkSize = std::max(std::max<size_t>(1, minChunk), (count + targetChunks - 1) / targetChunks);
+  if (workers_.empty() || chunkSize >= count) {
+    body(0, count);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = &body;
+    count_ = count;
+    chunkSize_ = chunkSize;
+    chunkCount_ = (count + chunkSize - 1) / chunkSize;
+    nextChunk_.store(0, std::memory_order_relaxed);
+    activeWorkers_ = workers_.size();
+    ++generation_;
+  }
+  wake_.notify_all();
+
+  runChunks();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this]() { return activeWorkers_ == 0; });
+  body_ = nullptr;
+}
+
+void WorkerPool::runChunks() {
+  for (;;) {
+    const size_t chunk = nextChunk_.fetch_add(1, std::memory_order_relaxed);
+    if (chunk >= chunkCount_) {
+      return;
+    }
+    const size_t begin = chunk * chunkSize_;
+    (*body_)(begin, std::min(count_, begin + chunkSize_));
+  }
+}
+
+void WorkerPool::workerLoop() {
+  uint64_t seenGeneration = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&]() { return stopping_ || generation_ != seenGeneration; });
+      if (stopping_) {
+        return;
+      }
+      seenGeneration = generation_;
+    }
+
+    runChunks();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--activeWorkers_ == 0) {
+      done_.notify_one();
+    }
+  }
+}
+
+}  // namespace projection::renderer
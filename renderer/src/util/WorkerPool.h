@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace projection::renderer {
+
+// Fixed set of worker threads for data-parallel frame work (row bands, pixel spans).
+// parallelFor blocks until every chunk is done; the calling thread works on chunks too,
+// so a pool of size 1 runs everything inline without any threads.
+class WorkerPool {
+ public:
+  // 0 picks std::thread::hardware_concurrency().
+  explicit WorkerPool(size_t threadCount = 0);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // Total threads taking part in parallelFor, including the caller.
+  size_t threadCount() const { return workers_.size() + 1; }
+
+  // Splits [0, count) into contiguous chunks of at least minChunk items and calls
+  // body(begin, end) for each. Not reentrant: body must not call parallelFor on this pool.
+  void parallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body, size_t minChunk = 1);
+
+ private:
+  void workerLoop();
+  void runChunks();
+
+  std::vector<std::thread> workers_{};
+  std::mutex mutex_{};
+  std::condition_variable wake_{};
+  std::condition_variable done_{};
+  bool stopping_{false};
+  uint64_t generation_{0};
+
+  // Current job; written under mutex_ before a generation bump.
+  const std::function<void(size_t, size_t)>* body_{nullptr};
+  size_t count_{0};
+  size_t chunkSize_{1};
+  size_t chunkCount_{0};
+  std::atomic<size_t> nextChunk_{0};
+  size_t activeWorkers_{0};
+};
+
+}  // namespace projection::renderer
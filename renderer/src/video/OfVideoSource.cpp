@@ -0,0 +1,34 @@
+#include "video/OfVideoSource.h"
+
+#include <memory>
+
+namespace projection::renderer {
+
+bool OfVideoSource::load(const std::string& filePath) {
+  const bool loaded = player_.load(filePath);
+  if (loaded) {
+    player_.setLoopState(OF_LOOP_NORMAL);
+  }
+  return loaded;
+}
+
+void OfVideoSource::play() {
+  player_.play();
+  player_.setPaused(false);
+}
+
+// ofVideoPlayer positions are fractions of the duration.
+double OfVideoSource::position() const { return static_cast<double>(player_.getPosition()) * duration(); }
+
+void OfVideoSource::seek(double seconds) {
+  const double length = duration();
+  if (length > 0.0) {
+    player_.setPosition(static_cast<float>(seconds / length));
+  }
+}
+
+VideoSourceFactory makeOfVideoSourceFactory() {
+  return []() -> std::unique_ptr<VideoSource> { return std::make_unique<OfVideoSource>(); };
+}
+
+}  // namespace projection::renderer
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <ofMain.h>
+
+#include "video/VideoSource.h"
+
+namespace projection::renderer {
+
+// VideoSource backed by ofVideoPlayer; loops the file once loaded.
+class OfVideoSource : public VideoSource {
+ public:
+  bool load(const std::string& filePath) override;
+  void play() override;
+  void pause() override { player_.setPaused(true); }
+  // ofVideoPlayer paces itself off the wall clock; the master clock step is not needed.
+  void update(double /*deltaSeconds*/) override { player_.update(); }
+
+  bool isLoaded() const override { return player_.isLoaded(); }
+  float width() const override { return player_.getWidth(); }
+  float height() const override { return player_.getHeight(); }
+
+  double position() const override;
+  double duration() const override { return player_.getDuration(); }
+  void seek(double seconds) override;
+  void setSpeed(double speed) override { player_.setSpeed(static_cast<float>(speed)); }
+
+  ofVideoPlayer& player() { return player_; }
+
+ private:
+  ofVideoPlayer player_{};
+};
+
+VideoSourceFactory makeOfVideoSourceFactory();
+
+}  // namespace projection::renderer
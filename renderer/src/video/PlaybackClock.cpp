@@ -0,0 +1,50 @@
+#include "video/PlaybackClock.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace projection::renderer {
+
+double loopedDrift(double position, double expected, double duration) {
+  if (duration <= 0.0) {
+    return position - expected;
+  }
+  return std::remainder(position - expected, duration);
+}
+
+void DriftCorrector::correct(VideoSource& source, double masterSeconds, double startSeconds, double deltaSeconds,
+                             FeedDriftMetrics& metrics) const {
+  const double duration = source.duration();
+  if (!source.isLoaded() || duration <= 0.0) {
+    return;
+  }
+
+  const double expected = std::fmod(std::max(0.0, masterSeconds - startSeconds), duration);
+  const double drift = loopedDrift(source.position(), expected, duration);
+  const double absDrift = std::fabs(drift);
+  metrics.driftSeconds = drift;
+  metrics.maxAbsDriftSeconds = std::max(metrics.maxAbsDriftSeconds, absDrift);
+
+  const double limit = options_.maxRateAdjust;
+  double adjust = 0.0;
+  if (absDrift > options_.resyncThresholdSeconds) {
+    source.seek(expected);
+    ++metrics.resyncCount;
+  } else if (absDrift > options_.toleranceSeconds) {
+    // Running ahead plays slower, behind plays faster. Gains give critical damping with a
+    // time constant of convergenceSeconds.
+    const double timeConstant = std::max(options_.convergenceSeconds, 1e-3);
+    const double integralGain = 1.0 / (4.0 * timeConstant * timeConstant);
+    metrics.rateTrim = std::clamp(metrics.rateTrim - drift * integralGain * deltaSeconds, -limit, limit);
+    adjust = -drift / timeConstant;
+    ++metrics.nudgedFrames;
+  }
+
+  const double rate = 1.0 + std::clamp(metrics.rateTrim + adjust, -limit, limit);
+  if (rate != metrics.rate) {
+    source.setSpeed(rate);
+    metrics.rate = rate;
+  }
+}
+
+}  // namespace projection::renderer
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+#include "video/VideoSource.h"
+
+namespace projection::renderer {
+
+// Renderer-wide playback time that every video feed is slaved to. It only moves when the
+// render loop advances it, so headless runs with a fixed timestep stay deterministic.
+class MasterClock {
+ public:
+  void advance(double deltaSeconds) { seconds_ += deltaSeconds; }
+  void reset(double seconds = 0.0) { seconds_ = seconds; }
+  double seconds() const { return seconds_; }
+
+ private:
+  double seconds_{0.0};
+};
+
+struct DriftCorrectionOptions {
+  // Drift inside this band is not actively corrected; the source keeps its learned rate trim.
+  double toleranceSeconds{1.0 / 120.0};
+  // Beyond this the source is seeked straight to the master position.
+  double resyncThresholdSeconds{0.25};
+  // In between, the playback rate is nudged to close the gap over roughly this long,
+  // limited to 1 +/- maxRateAdjust.
+  double convergenceSeconds{1.0};
+  double maxRateAdjust{0.05};
+};
+
+// Per-feed drift against the master clock. Positive drift means the feed is ahead.
+struct FeedDriftMetrics {
+  double driftSeconds{0.0};
+  double maxAbsDriftSeconds{0.0};
+  double rate{1.0};
+  // Learned steady-state rate correction for this decoder (e.g. -0.001 for one 0.1% fast).
+  double rateTrim{0.0};
+  uint64_t nudgedFrames{0};
+  uint64_t resyncCount{0};
+};
+
+// Measures where a source is against where the master clock says it should be and corrects it
+// by nudging its playback rate or, for large errors, seeking. Outside the tolerance band the
+// rate follows a critically damped PI loop, so a decoder with a constant clock error settles
+// on a trimmed rate instead of oscillating around the band edge. Works on the VideoSource
+// interface only, so it can be driven against simulated decoders in tests.
+class DriftCorrector {
+ public:
+  explicit DriftCorrector(DriftCorrectionOptions options = {}) : options_(options) {}
+
+  // startSeconds is the master time at which the source was at position 0; deltaSeconds is
+  // the master step since the previous call. Looping sources are compared modulo their
+  // duration; sources without a known duration are not corrected.
+  void correct(VideoSource& source, double masterSeconds, double startSeconds, double deltaSeconds,
+               FeedDriftMetrics& metrics) const;
+
+  const DriftCorrectionOptions& options() const { return options_; }
+  void setOptions(const DriftCorrectionOptions& options) { options_ = options; }
+
+ private:
+  DriftCorrectionOptions options_;
+};
+
+// Signed difference position - expected wrapped into [-duration/2, duration/2].
+double loopedDrift(double position, double expected, double duration);
+
+}  // namespace projection::renderer
@@ -0,0 +1,63 @@
+#include "video/StubVideoSource.h"
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace projection::renderer {
+
+namespace {
+constexpr int kPatternWidth = 64;
+constexpr int kPatternHeight = 36;
+constexpr int kPatternCell = 8;
+}  // namespace
+
+StubVideoSource::StubVideoSource(float width, float height) : width_(width), height_(height) {}
+
+bool StubVideoSource::load(const std::string& filePath) {
+  filePath_ = filePath;
+  loaded_ = !filePath.empty();
+  if (loaded_ && frame_.width() == 0) {
+    const size_t hash = std::hash<std::string>{}(filePath);
+    const auto r = static_cast<uint8_t>(64 + (hash & 0x7F));
+    const auto g = static_cast<uint8_t>(64 + ((hash >> 8) & 0x7F));
+    const auto b = static_cast<uint8_t>(64 + ((hash >> 16) & 0x7F));
+    frame_.resize(kPatternWidth, kPatternHeight);
+    for (int y = 0; y < kPatternHeight; ++y) {
+      for (int x = 0; x < kPatternWidth; ++x) {
+        const bool light = ((x / kPatternCell) + (y / kPatternCell)) % 2 == 0;
+        uint8_t* px = frame_.pixel(x, y);
+        px[0] = light ? r : static_cast<uint8_t>(r / 2);
+        px[1] = light ? g : static_cast<uint8_t>(g / 2);
+        px[2] = light ? b : static_cast<uint8_t>(b / 2);
+        px[3] = 255;
+      }
+    }
+  }
+  return loaded_;
+}
+
+void StubVideoSource::update(double deltaSeconds) {
+  ++updateCount_;
+  if (!playing_) {
+    return;
+  }
+  position_ += deltaSeconds * speed_ * (1.0 + rateSkew_);
+  if (duration_ > 0.0 && (position_ >= duration_ || position_ < 0.0)) {
+    position_ -= std::floor(position_ / duration_) * duration_;
+  }
+}
+
+void StubVideoSource::seek(double seconds) {
+  position_ = seconds;
+  ++seekCount_;
+}
+
+VideoSourceFactory makeStubVideoSourceFactory(float width, float height) {
+  return [width, height]() -> std::unique_ptr<VideoSource> {
+    return std::make_unique<StubVideoSource>(width, height);
+  };
+}
+
+}  // namespace projection::renderer
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "video/VideoSource.h"
+
+namespace projection::renderer {
+
+// VideoSource that decodes nothing: it reports a fixed frame size and counts updates.
+// Used by the headless renderer and by tests that exercise per-frame logic without a GPU.
+// Its position advances by deltaSeconds * speed * (1 + rateSkew) per update and loops at
+// duration(), so a non-zero skew simulates a decoder whose clock runs fast or slow.
+// Its CPU frame is a small checkerboard tinted per file path, so composited previews show
+// which feed landed on which surface.
+class StubVideoSource : public VideoSource {
+ public:
+  explicit StubVideoSource(float width = 1280.0f, float height = 720.0f);
+
+  bool load(const std::string& filePath) override;
+  void play() override { playing_ = true; }
+  void pause() override { playing_ = false; }
+  void update(double deltaSeconds) override;
+
+  bool isLoaded() const override { return loaded_; }
+  float width() const override { return width_; }
+  float height() const override { return height_; }
+  ImageView cpuFrame() const override { return frame_.view(); }
+  uint64_t frameVersion() const override { return loaded_ ? 1 : 0; }
+
+  double position() const override { return position_; }
+  double duration() const override { return duration_; }
+  void seek(double seconds) override;
+  void setSpeed(double speed) override { speed_ = speed; }
+
+  void setDuration(double seconds) { duration_ = seconds; }
+  void setRateSkew(double skew) { rateSkew_ = skew; }
+  double speed() const { return speed_; }
+  uint64_t seekCount() const { return seekCount_; }
+
+  bool playing() const { return playing_; }
+  uint64_t updateCount() const { return updateCount_; }
+  const std::string& filePath() const { return filePath_; }
+
+ private:
+  float width_;
+  float height_;
+  bool loaded_{false};
+  bool playing_{false};
+  uint64_t updateCount_{0};
+  double position_{0.0};
+  double duration_{60.0};
+  double speed_{1.0};
+  double rateSkew_{0.0};
+  uint64_t seekCount_{0};
+  std::string filePath_{};
+  RgbaImage frame_{};
+};
+
+VideoSourceFactory makeStubVideoSourceFactory(float width = 1280.0f, float height = 720.0f);
+
+}  // namespace projection::renderer
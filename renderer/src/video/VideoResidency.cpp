@@ -0,0 +1,159 @@
+#include "video/VideoResidency.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace projection::renderer {
+
+namespace {
+constexpr size_t kEstimatedFramesPerPlayer = 3;
+constexpr size_t kBytesPerPixel = 4;
+}  // namespace
+
+size_t estimateVideoSourceBytes(const VideoSource& source) {
+  const auto width = static_cast<size_t>(std::max(0.0f, source.width()));
+  const auto height = static_cast<size_t>(std::max(0.0f, source.height()));
+  return width * height * kBytesPerPixel * kEstimatedFramesPerPlayer;
+}
+
+VideoResidency::VideoResidency(VideoSourceFactory factory, size_t budgetBytes)
+    : factory_(std::move(factory)), budgetBytes_(budgetBytes) {}
+
+std::unique_ptr<VideoSource> VideoResidency::acquire(const std::string& filePath) {
+  std::unique_ptr<VideoSource> source;
+  size_t bytes = 0;
+  auto warm = std::find_if(warm_.begin(), warm_.end(),
+                           [&](const ResidentPlayer& player) { return player.filePath == filePath; });
+  if (warm != warm_.end()) {
+    source = std::move(warm->source);
+    bytes = warm->bytes;
+    warmBytes_ -= bytes;
+    warm_.erase(warm);
+    ++counters_.hits;
+    source->seek(0.0);
+    source->play();
+  } else {
+    source = open(filePath);
+    bytes = estimateVideoSourceBytes(*source);
+    ++counters_.misses;
+    if (source->isLoaded()) {
+      source->play();
+    }
+  }
+
+  active_[source.get()] = ActivePlayer{filePath, bytes};
+  activeBytes_ += bytes;
+  evictToBudget();
+  notePeak();
+  return source;
+}
+
+void VideoResidency::release(const std::string& filePath, std::unique_ptr<VideoSource> source) {
+  if (!source) {
+    return;
+  }
+  size_t bytes = estimateVideoSourceBytes(*source);
+  auto active = active_.find(source.get());
+  if (active != active_.end()) {
+    bytes = active->second.bytes;
+    activeBytes_ -= bytes;
+    active_.erase(active);
+  }
+  // A file that failed to open is retried from scratch next time.
+  if (!source->isLoaded()) {
+    return;
+  }
+  source->pause();
+  warm_.push_front(ResidentPlayer{filePath, std::move(source), bytes});
+  warmBytes_ += bytes;
+  evictToBudget();
+  notePeak();
+}
+
+void VideoResidency::prewarm(const std::vector<std::string>& filePaths) {
+  // Collected in priority order and moved to the front together, so the first prediction is
+  // the last one evicted.
+  std::list<ResidentPlayer> predicted;
+  size_t predictedBytes = 0;
+  for (const auto& filePath : filePaths) {
+    if (filePath.empty() || isActive(filePath) ||
+        std::any_of(predicted.begin(), predicted.end(),
+                    [&](const ResidentPlayer& player) { return player.filePath == filePath; })) {
+      continue;
+    }
+    auto warm = std::find_if(warm_.begin(), warm_.end(),
+                             [&](const ResidentPlayer& player) { return player.filePath == filePath; });
+    if (warm != warm_.end()) {
+      warmBytes_ -= warm->bytes;
+      predictedBytes += warm->bytes;
+      predicted.splice(predicted.end(), warm_, warm);
+      continue;
+    }
+
+    auto source = open(filePath);
+    const size_t bytes = estimateVideoSourceBytes(*source);
+    if (!source->isLoaded()) {
+      continue;
+    }
+    if (activeBytes_ + warmBytes_ + predictedBytes + bytes > budgetBytes_) {
+      break;
+    }
+    source->pause();
+    predicted.push_back(ResidentPlayer{filePath, std::move(source), bytes});
+    predictedBytes += bytes;
+    ++counters_.prewarmed;
+  }
+  warm_.splice(warm_.begin(), predicted);
+  warmBytes_ += predictedBytes;
+  notePeak();
+}
+
+void VideoResidency::setBudget(size_t budgetBytes) {
+  budgetBytes_ = budgetBytes;
+  evictToBudget();
+}
+
+void VideoResidency::clearWarm() {
+  warm_.clear();
+  warmBytes_ = 0;
+}
+
+bool VideoResidency::isWarm(const std::string& filePath) const {
+  return std::any_of(warm_.begin(), warm_.end(),
+                     [&](const ResidentPlayer& player) { return player.filePath == filePath; });
+}
+
+VideoResidencyStats VideoResidency::stats() const {
+  VideoResidencyStats stats = counters_;
+  stats.activePlayers = active_.size();
+  stats.warmPlayers = warm_.size();
+  stats.activeBytes = activeBytes_;
+  stats.warmBytes = warmBytes_;
+  stats.budgetBytes = budgetBytes_;
+  return stats;
+}
+
+std::unique_ptr<VideoSource> VideoResidency::open(const std::string& filePath) {
+  auto source = factory_();
+  source->load(filePath);
+  return source;
+}
+
+bool VideoResidency::isActive(const std::string& filePath) const {
+  return std::any_of(active_.begin(), active_.end(),
+                     [&](const auto& entry) { return entry.second.filePath == filePath; });
+}
+
+void VideoResidency::evictToBudget() {
+  while (!warm_.empty() && activeBytes_ + warmBytes_ > budgetBytes_) {
+    warmBytes_ -= warm_.back().bytes;
+    warm_.pop_back();
+    ++counters_.evictions;
+  }
+}
+
+void VideoResidency::notePeak() {
+  counters_.peakBytes = std::max(counters_.peakBytes, activeBytes_ + warmBytes_);
+}
+
+}  // namespace projection::renderer
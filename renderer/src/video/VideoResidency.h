@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "video/VideoSource.h"
+
+namespace projection::renderer {
+
+struct VideoResidencyStats {
+  size_t activePlayers{0};
+  size_t warmPlayers{0};
+  size_t activeBytes{0};
+  size_t warmBytes{0};
+  size_t peakBytes{0};  // high-water mark of active + warm
+  size_t budgetBytes{0};
+  uint64_t hits{0};  // scene feeds served by a warm player
+  uint64_t misses{0};  // players opened on demand
+  uint64_t prewarmed{0};  // players opened ahead of a predicted scene
+  uint64_t evictions{0};  // warm players closed to stay within the budget
+
+  size_t residentBytes() const { return activeBytes + warmBytes; }
+};
+
+// Estimated memory held by an open decoder: a few decoded frames at the source's size
+// (decoder output queue, upload texture and CPU copy).
+size_t estimateVideoSourceBytes(const VideoSource& source);
+
+// Keeps video players open across scene changes within a memory budget. Players the current
+// scene uses are active and never evicted. Players of previous scenes, and players opened
+// ahead of time for predicted scenes, stay warm (paused) in least-recently-used order; when
+// active + warm exceeds the budget the least recently used warm players are closed. A feed
+// whose file is warm starts without reopening the decoder.
+//
+// Render thread only.
+class VideoResidency {
+ public:
+  static constexpr size_t kDefaultBudgetBytes = size_t{512} << 20;
+
+  explicit VideoResidency(VideoSourceFactory factory, size_t budgetBytes = kDefaultBudgetBytes);
+
+  // A playing source for filePath, rewound to 0: a warm player when one is resident,
+  // otherwise a new one from the factory. It counts as active until released.
+  std::unique_ptr<VideoSource> acquire(const std::string& filePath);
+  // Takes back a source the current scene no longer shows, pauses it and keeps it warm as
+  // the most recently used player.
+  void release(const std::string& filePath, std::unique_ptr<VideoSource> source);
+  // Opens paused players for files a coming scene will use, in priority order, while they
+  // fit in the budget; never evicts for a prediction. Files already resident are refreshed
+  // in the LRU order instead.
+  void prewarm(const std::vector<std::string>& filePaths);
+
+  // Lowering the budget evicts warm players until the total fits (active ones may still exceed it).
+  void setBudget(size_t budgetBytes);
+  // Closes every warm player.
+  void clearWarm();
+
+  bool isWarm(const std::string& filePath) const;
+  VideoResidencyStats stats() const;
+
+ private:
+  struct ResidentPlayer {
+    std::string filePath;
+    std::unique_ptr<VideoSource> source;
+    size_t bytes{0};
+  };
+  struct ActivePlayer {
+    std::string filePath;
+    size_t bytes{0};
+  };
+
+  std::unique_ptr<VideoSource> open(const std::string& filePath);
+  bool isActive(const std::string& filePath) const;
+  void evictToBudget();
+  void notePeak();
+
+  VideoSourceFactory factory_;
+  size_t budgetBytes_;
+  // Front is the most recently used.
+  std::list<ResidentPlayer> warm_{};
+  std::unordered_map<const VideoSource*, ActivePlayer> active_{};
+  size_t activeBytes_{0};
+  size_t warmBytes_{0};
+  VideoResidencyStats counters_{};
+};
+
+}  // namespace projection::renderer
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "compositor/RgbaImage.h"
+
+namespace projection::renderer {
+
+// Decoder-agnostic handle on a playing feed. The windowed renderer backs video files with
+// ofVideoPlayer (OfVideoSource); headless runs and tests use StubVideoSource. Generated feeds
+// use GeneratedVideoSource.
+class VideoSource {
+ public:
+  virtual ~VideoSource() = default;
+
+  virtual bool load(const std::string& filePath) = 0;
+  virtual void play() = 0;
+  // Stops decoding while the source is parked; play() resumes it.
+  virtual void pause() {}
+  // Called once per render frame; deltaSeconds is the master clock step. Decoders that pace
+  // themselves off the wall clock may ignore it.
+  virtual void update(double deltaSeconds) = 0;
+
+  virtual bool isLoaded() const = 0;
+  virtual float width() const = 0;
+  virtual float height() const = 0;
+
+  // Playback position and length in seconds; duration() <= 0 while unknown.
+  virtual double position() const = 0;
+  virtual double duration() const = 0;
+  virtual void seek(double seconds) = 0;
+  // 1.0 is normal speed; used by DriftCorrector for small rate nudges.
+  virtual void setSpeed(double speed) = 0;
+
+  // Current frame in CPU memory, for the software compositor. Sources that only decode to
+  // GPU textures return an empty view.
+  virtual ImageView cpuFrame() const { return {}; }
+  // Bumped whenever cpuFrame() content changes, so uploaders can skip unchanged frames.
+  virtual uint64_t frameVersion() const { return 0; }
+};
+
+using VideoSourceFactory = std::function<std::unique_ptr<VideoSource>()>;
+
+}  // namespace projection::renderer
@@ -0,0 +1,182 @@
+#include "audio/AudioAnalyzer.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "RendererRuntime.h"
+#include "audio/SampleRingBuffer.h"
+#include "video/StubVideoSource.h"
+
+using projection::renderer::AudioAnalyzer;
+using projection::renderer::AudioAnalyzerOptions;
+using projection::renderer::AudioFeatures;
+using projection::renderer::SampleRingBuffer;
+
+namespace {
+constexpr double kSampleRate = 48000.0;
+constexpr size_t kBlock = 256;
+
+std::vector<float> sine(double frequency, float amplitude, size_t count, double& phase) {
+  std::vector<float> samples(count);
+  for (auto& sample : samples) {
+    sample = amplitude * static_cast<float>(std::sin(phase));
+    phase += 2.0 * 3.141592653589793 * frequency / kSampleRate;
+  }
+  return samples;
+}
+
+AudioAnalyzerOptions testOptions() {
+  AudioAnalyzerOptions options;
+  options.sampleRate = kSampleRate;
+  options.blockSize = kBlock;
+  return options;
+}
+
+// Feeds `seconds` of a tone block by block and returns the last snapshot.
+AudioFeatures feedTone(AudioAnalyzer& analyzer, double frequency, float amplitude, double seconds) {
+  double phase = 0.0;
+  const auto blocks = static_cast<size_t>(seconds * kSampleRate / kBlock);
+  for (size_t i = 0; i < blocks; ++i) {
+    const auto samples = sine(frequency, amplitude, kBlock, phase);
+    analyzer.analyzeBlock(samples.data(), samples.size());
+  }
+  return analyzer.read();
+}
+}  // namespace
+
+TEST_CASE("AudioAnalyzer measures block energy and peak", "[renderer][audio]") {
+  SampleRingBuffer ring(1024);
+  AudioAnalyzer analyzer(ring, testOptions());
+  REQUIRE(analyzer.read().blocks == 0);
+
+  // A 375 Hz sine fits exactly 2 periods into a 256-sample block: mean square A^2 / 2.
+  const auto features = feedTone(analyzer, 375.0, 0.5f, 0.1);
+  REQUIRE(features.blocks == 18);
+  REQUIRE(features.samples == 18 * kBlock);
+  REQUIRE(std::fabs(features.energy - 0.125f) < 1e-4f);
+  REQUIRE(std::fabs(features.peak - 0.5f) < 1e-3f);
+
+  // Smoothing follows its time constant: after 0.15 s of constant energy, 1 - 1/e of it.
+  SampleRingBuffer ring2(1024);
+  AudioAnalyzer smoothing(ring2, testOptions());
+  const auto blocks = static_cast<int>(std::lround(0.15 * kSampleRate / kBlock));
+  std::vector<float> constant(kBlock, 0.5f);
+  for (int i = 0; i < blocks; ++i) {
+    smoothing.analyzeBlock(constant.data(), constant.size());
+  }
+  const float expected = 0.25f * (1.0f - std::exp(-static_cast<float>(blocks * kBlock / kSampleRate) / 0.15f));
+  REQUIRE(std::fabs(smoothing.read().smoothedEnergy - expected) < 1e-3f);
+}
+
+TEST_CASE("AudioAnalyzer splits energy into crossover bands", "[renderer][audio]") {
+  SampleRingBuffer ring(1024);
+  AudioAnalyzer low(ring, testOptions());
+  // 93.75 Hz puts a whole half period (the period of sin^2) into each block.
+  const auto bass = feedTone(low, 93.75, 0.8f, 0.5);
+  REQUIRE(bass.bandEnergy[0] > 0.5f * bass.energy);
+  for (size_t band = 1; band < AudioFeatures::kBands; ++band) {
+    REQUIRE(bass.bandEnergy[0] > 4.0f * bass.bandEnergy[band]);
+  }
+  REQUIRE(bass.bandEnergy[3] < 0.01f * bass.energy);
+
+  AudioAnalyzer high(ring, testOptions());
+  const auto hiss = feedTone(high, 12000.0, 0.8f, 0.5);
+  // One-pole crossovers leak, but the top band still dominates.
+  for (size_t band = 0; band + 1 < AudioFeatures::kBands; ++band) {
+    REQUIRE(hiss.bandEnergy[3] > hiss.bandEnergy[band]);
+  }
+  REQUIRE(hiss.bandEnergy[0] < 0.01f * hiss.energy);
+
+  AudioAnalyzer mid(ring, testOptions());
+  const auto voice = feedTone(mid, 2000.0, 0.8f, 0.5);
+  REQUIRE(voice.bandEnergy[2] > voice.bandEnergy[0]);
+  REQUIRE(voice.bandEnergy[2] > voice.bandEnergy[3]);
+}
+
+TEST_CASE("AudioAnalyzer flags onsets once per attack", "[renderer][audio]") {
+  SampleRingBuffer ring(1024);
+  AudioAnalyzer analyzer(ring, testOptions());
+  std::vector<float> silence(kBlock, 0.0f);
+  std::vector<float> loud(kBlock, 0.6f);
+
+  for (int i = 0; i < 100; ++i) {
+    analyzer.analyzeBlock(silence.data(), silence.size());
+  }
+  REQUIRE(analyzer.read().onsetCount == 0);
+
+  analyzer.analyzeBlock(loud.data(), loud.size());
+  auto features = analyzer.read();
+  REQUIRE(features.onset);
+  REQUIRE(features.onsetCount == 1);
+  // A DC step lands in the lowest band.
+  REQUIRE((features.bandOnsets & 1u) != 0);
+
+  // Sustained level is not an onset, and neither is anything within the hold time.
+  for (int i = 0; i < 200; ++i) {
+    analyzer.analyzeBlock(loud.data(), loud.size());
+  }
+  features = analyzer.read();
+  REQUIRE(!features.onset);
+  REQUIRE(features.onsetCount == 1);
+
+  for (int i = 0; i < 100; ++i) {
+    analyzer.analyzeBlock(silence.data(), silence.size());
+  }
+  analyzer.analyzeBlock(loud.data(), loud.size());
+  REQUIRE(analyzer.read().onsetCount == 2);
+}
+
+TEST_CASE("AudioAnalyzer consumes the ring in whole blocks", "[renderer][audio]") {
+  SampleRingBuffer ring(4096);
+  AudioAnalyzer analyzer(ring, testOptions());
+  std::vector<float> samples(600, 0.25f);
+  ring.write(samples.data(), samples.size());
+  REQUIRE(analyzer.pump() == 2);
+  REQUIRE(analyzer.read().samples == 512);
+
+  // The 88 leftover samples complete a block with the next 168.
+  ring.write(samples.data(), 168);
+  REQUIRE(analyzer.pump() == 1);
+  REQUIRE(analyzer.pump() == 0);
+  REQUIRE(analyzer.read().blocks == 3);
+}
+
+TEST_CASE("AudioAnalyzer thread publishes features as samples arrive", "[renderer][audio]") {
+  SampleRingBuffer ring(8192);
+  AudioAnalyzer analyzer(ring, testOptions());
+  analyzer.start();
+  REQUIRE(analyzer.running());
+
+  std::vector<float> samples(kBlock * 4, 0.5f);
+  ring.write(samples.data(), samples.size());
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (analyzer.read().blocks < 4 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  analyzer.stop();
+  REQUIRE(!analyzer.running());
+  const auto features = analyzer.read();
+  REQUIRE(features.blocks == 4);
+  REQUIRE(std::fabs(features.energy - 0.25f) < 1e-5f);
+}
+
+TEST_CASE("RendererRuntime reads audio features from the analysis thread", "[renderer][audio][runtime]") {
+  projection::renderer::RendererRuntime runtime(projection::renderer::makeStubVideoSourceFactory());
+  runtime.startAudioAnalysis();
+  std::vector<float> loud(4096, 0.9f);
+  runtime.writeAudio(loud.data(), loud.size(), 1);
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (runtime.audioAnalyzer().read().samples < loud.size() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  runtime.update(1.0 / 60.0);
+  runtime.stopAudioAnalysis();
+  REQUIRE(runtime.audioFeatures().samples == loud.size());
+  REQUIRE(runtime.audioFeatures().onsetCount == 1);
+  REQUIRE(runtime.audioScale() > 0.8f);
+}
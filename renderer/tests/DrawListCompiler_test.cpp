@@ -0,0 +1,120 @@
+#include "DrawListCompiler.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+#include <projection/core/Scene.h>
+#include <projection/core/Surface.h>
+
+#include "RendererRuntime.h"
+#include "video/StubVideoSource.h"
+
+using projection::core::BlendMode;
+using projection::core::FeedId;
+using projection::core::Scene;
+using projection::core::SceneId;
+using projection::core::Surface;
+using projection::core::SurfaceId;
+using projection::core::Vec2;
+using projection::renderer::DrawList;
+using projection::renderer::SurfaceDraw;
+using projection::renderer::buildDrawBatches;
+using projection::renderer::compileDrawOrder;
+
+namespace {
+// Axis-aligned square of side 0.2 with its lower-left corner at (x, y).
+Surface square(const std::string& id, float x, float y, const std::string& feed, int zOrder,
+               BlendMode mode = BlendMode::Normal) {
+  Surface surface{SurfaceId{id}, id, {Vec2{x, y}, Vec2{x + 0.2f, y}, Vec2{x + 0.2f, y + 0.2f}, Vec2{x, y + 0.2f}},
+                  FeedId{feed}, 1.0f, 1.0f, mode};
+  surface.setZOrder(zOrder);
+  return surface;
+}
+
+std::vector<std::string> orderedIds(const Scene& scene) {
+  std::vector<std::string> ids;
+  for (size_t index : compileDrawOrder(scene)) {
+    ids.push_back(scene.getSurfaces()[index].getId().value);
+  }
+  return ids;
+}
+}  // namespace
+
+TEST_CASE("compileDrawOrder sorts by zOrder and keeps ties stable", "[renderer][drawlist]") {
+  Scene scene{SceneId{"z"}, "Z", "", {square("top", 0.0f, 0.0f, "a", 2), square("bottom", 0.0f, 0.0f, "b", -1),
+                                       square("mid1", 0.1f, 0.1f, "a", 0), square("mid2", 0.15f, 0.15f, "b", 0)}};
+  REQUIRE((orderedIds(scene) == std::vector<std::string>{"bottom", "mid1", "mid2", "top"}));
+}
+
+TEST_CASE("compileDrawOrder groups disjoint surfaces by feed and blend mode", "[renderer][drawlist]") {
+  Scene scene{SceneId{"grid"}, "Grid", "",
+              {square("a1", -1.0f, -1.0f, "a", 0), square("b1", -0.5f, -1.0f, "b", 0),
+               square("a2", 0.0f, -1.0f, "a", 0), square("b2", 0.5f, -1.0f, "b", 0),
+               square("a3", -1.0f, 0.0f, "a", 0, BlendMode::Additive), square("a4", 0.0f, 0.0f, "a", 0)}};
+  REQUIRE((orderedIds(scene) == std::vector<std::string>{"a1", "a2", "a4", "b1", "b2", "a3"}));
+}
+
+TEST_CASE("compileDrawOrder never reorders overlapping surfaces", "[renderer][drawlist]") {
+  // b1 overlaps a1 and a2 overlaps b1, so the interleaved feeds must stay in scene order.
+  Scene scene{SceneId{"stack"}, "Stack", "",
+              {square("a1", 0.0f, 0.0f, "a", 0), square("b1", 0.1f, 0.0f, "b", 0), square("a2", 0.2f, 0.0f, "a", 0)}};
+  REQUIRE((orderedIds(scene) == std::vector<std::string>{"a1", "b1", "a2"}));
+
+  // Squares that only share an edge do not overlap and may be grouped.
+  Scene touching{SceneId{"touch"}, "Touch", "",
+                 {square("a1", 0.0f, 0.0f, "a", 0), square("b1", 0.2f, 0.0f, "b", 0),
+                  square("a2", 0.4f, 0.0f, "a", 0)}};
+  REQUIRE((orderedIds(touching) == std::vector<std::string>{"a1", "a2", "b1"}));
+}
+
+TEST_CASE("buildDrawBatches merges runs with the same feed and blend mode", "[renderer][drawlist]") {
+  DrawList list;
+  auto add = [&](const std::string& feed, BlendMode mode) {
+    SurfaceDraw draw;
+    draw.feedId = feed;
+    draw.blendMode = mode;
+    list.surfaces.push_back(draw);
+  };
+  add("a", BlendMode::Normal);
+  add("a", BlendMode::Normal);
+  add("a", BlendMode::Additive);
+  add("b", BlendMode::Additive);
+  add("b", BlendMode::Additive);
+  buildDrawBatches(list);
+
+  REQUIRE(list.batches.size() == 3);
+  REQUIRE(list.batches[0].surfaceCount == 2);
+  REQUIRE(list.batches[1].firstSurface == 2);
+  REQUIRE(list.batches[1].surfaceCount == 1);
+  REQUIRE(list.batches[2].feedId == "b");
+  REQUIRE(list.batches[2].firstSurface == 3);
+  REQUIRE(list.batches[2].surfaceCount == 2);
+
+  buildDrawBatches(list);
+  REQUIRE(list.batches.size() == 3);
+}
+
+TEST_CASE("RendererRuntime batches prepared surfaces in compiled order", "[renderer][drawlist][runtime]") {
+  projection::renderer::RendererRuntime runtime(projection::renderer::makeStubVideoSourceFactory());
+  projection::core::RendererMessage message{};
+  message.type = projection::core::RendererMessageType::LoadSceneDefinition;
+  message.commandId = "cmd";
+  message.loadSceneDefinition = projection::core::LoadSceneDefinitionMessage{
+      Scene{SceneId{"s"}, "S", "",
+            {square("a1", -1.0f, -1.0f, "a", 0), square("b1", -0.5f, -1.0f, "b", 0),
+             square("a2", 0.0f, -1.0f, "a", 0)}},
+      {projection::core::makeVideoFileFeed(FeedId{"a"}, "A", "/media/a.mp4"),
+       projection::core::makeVideoFileFeed(FeedId{"b"}, "B", "/media/b.mp4")}};
+  runtime.handle(message);
+  runtime.update(0.0);
+
+  const auto& list = runtime.prepareFrame(100.0f, 100.0f);
+  REQUIRE(list.surfaces.size() == 3);
+  REQUIRE(list.surfaces[0].surfaceId == "a1");
+  REQUIRE(list.surfaces[1].surfaceId == "a2");
+  REQUIRE(list.surfaces[2].surfaceId == "b1");
+  REQUIRE(list.batches.size() == 2);
+  REQUIRE(list.batches[0].surfaceCount == 2);
+}
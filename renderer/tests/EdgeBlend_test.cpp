@@ -0,0 +1,176 @@
+#include "compositor/EdgeBlend.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include "compositor/RgbaImage.h"
+
+using projection::renderer::EdgeBlendEdge;
+using projection::renderer::EdgeBlendMask;
+using projection::renderer::EdgeBlendSettings;
+using projection::renderer::RgbaImage;
+using projection::renderer::edgeBlendGain;
+using projection::renderer::parseEdgeBlend;
+using projection::renderer::scaleEdgeBlend;
+
+namespace {
+bool near(float a, float b, float tolerance = 1e-4f) { return std::fabs(a - b) < tolerance; }
+
+EdgeBlendEdge linearEdge(int width) { return EdgeBlendEdge{width, 1.0f, 1.0f}; }
+}  // namespace
+
+TEST_CASE("Edge blend ramps are complementary in linear light", "[renderer][edgeblend]") {
+  // Linear curve without gamma is the identity ramp.
+  for (float t : {0.0f, 0.1f, 0.25f, 0.5f, 0.8f, 1.0f}) {
+    REQUIRE(near(edgeBlendGain(t, linearEdge(1)), t));
+  }
+  REQUIRE(near(edgeBlendGain(-1.0f, linearEdge(1)), 0.0f));
+  REQUIRE(near(edgeBlendGain(2.0f, linearEdge(1)), 1.0f));
+
+  // With gamma g and curve p the two projectors' light, gain^g, sums to one across the overlap.
+  for (float gamma : {1.0f, 1.8f, 2.2f, 2.6f}) {
+    for (float curve : {1.0f, 2.0f, 3.5f}) {
+      const EdgeBlendEdge edge{100, gamma, curve};
+      REQUIRE(near(edgeBlendGain(0.5f, edge), std::pow(0.5f, 1.0f / gamma)));
+      for (float t : {0.05f, 0.2f, 0.37f, 0.5f, 0.9f}) {
+        const float light = std::pow(edgeBlendGain(t, edge), gamma) + std::pow(edgeBlendGain(1.0f - t, edge), gamma);
+        REQUIRE(near(light, 1.0f));
+      }
+    }
+  }
+
+  // The curve exponent flattens the ramp near its ends: f(0.25) = 0.5 * 0.5^p.
+  REQUIRE(near(edgeBlendGain(0.25f, EdgeBlendEdge{1, 1.0f, 2.0f}), 0.125f));
+}
+
+TEST_CASE("Edge blend mask matches the analytic ramp per pixel", "[renderer][edgeblend]") {
+  EdgeBlendSettings settings;
+  settings.left = linearEdge(20);
+  settings.bottom = linearEdge(4);
+  EdgeBlendMask mask;
+  REQUIRE(mask.configure(100, 10, settings));
+
+  for (int x = 0; x < 100; ++x) {
+    const int expected = x < 20 ? static_cast<int>(std::lround(255.0 * (x + 0.5) / 20.0)) : 255;
+    REQUIRE(std::abs(mask.gainAt(x, 0) - expected) <= 1);
+    REQUIRE(mask.liftAt(x, 0) == 0);
+  }
+  // Rows in the bottom overlap multiply the column ramp by the row ramp.
+  const double rowGain = (10.0 - 9.5) / 4.0;
+  REQUIRE(std::abs(mask.gainAt(50, 9) - static_cast<int>(std::lround(255.0 * rowGain))) <= 1);
+  REQUIRE(std::abs(mask.gainAt(5, 9) - static_cast<int>(std::lround(255.0 * rowGain * 5.5 / 20.0))) <= 1);
+
+  // Neighbouring outputs with a 20 pixel overlap: the right ramp of one and the left ramp of
+  // the other add up to full brightness at every overlapping pixel.
+  EdgeBlendSettings leftOutput;
+  leftOutput.right = linearEdge(20);
+  EdgeBlendMask leftMask;
+  leftMask.configure(100, 1, leftOutput);
+  for (int k = 0; k < 20; ++k) {
+    REQUIRE(std::abs(leftMask.gainAt(80 + k, 0) + mask.gainAt(k, 0) - 255) <= 1);
+  }
+}
+
+TEST_CASE("Edge blend black level lifts only outside the overlaps", "[renderer][edgeblend]") {
+  EdgeBlendSettings settings;
+  settings.right = linearEdge(10);
+  settings.blackLevel = 0.1f;
+  EdgeBlendMask mask;
+  mask.configure(40, 4, settings);
+  REQUIRE(mask.liftAt(0, 0) == 26);
+  REQUIRE(mask.gainAt(0, 0) == 230);
+  REQUIRE(mask.liftAt(35, 2) == 0);
+
+  RgbaImage image(40, 4);
+  image.fill(0, 0, 0, 200);
+  for (int x = 0; x < 20; ++x) {
+    uint8_t* px = image.pixel(x, 1);
+    px[0] = px[1] = px[2] = 255;
+  }
+  mask.apply(image.mutableView());
+  // Black is raised to the overlap's doubled black level, white stays white, alpha is kept.
+  REQUIRE(image.pixel(25, 0)[0] == 26);
+  REQUIRE(image.pixel(25, 0)[3] == 200);
+  REQUIRE(image.pixel(5, 1)[1] == 255);
+  REQUIRE(image.pixel(35, 0)[2] == 0);
+}
+
+TEST_CASE("Edge blend SIMD and scalar paths are bit-exact", "[renderer][edgeblend]") {
+  EdgeBlendSettings settings;
+  settings.left = EdgeBlendEdge{13, 2.2f, 2.0f};
+  settings.right = EdgeBlendEdge{21, 1.8f, 3.0f};
+  settings.top = EdgeBlendEdge{3, 2.2f, 1.0f};
+  settings.blackLevel = 0.05f;
+  EdgeBlendMask simd;
+  EdgeBlendMask scalar;
+  simd.configure(67, 9, settings, true);
+  scalar.configure(67, 9, settings, false);
+  REQUIRE(simd.gain() == scalar.gain());
+  REQUIRE(simd.lift() == scalar.lift());
+
+  RgbaImage a(67, 9);
+  for (size_t i = 0; i < a.pixels().size(); ++i) {
+    a.pixels()[i] = static_cast<uint8_t>(i * 37 + 11);
+  }
+  RgbaImage b = a;
+  simd.apply(a.mutableView(), true);
+  simd.apply(b.mutableView(), false);
+  REQUIRE(a.pixels() == b.pixels());
+}
+
+TEST_CASE("Edge blend mask regenerates only when parameters change", "[renderer][edgeblend]") {
+  EdgeBlendSettings settings;
+  settings.left = EdgeBlendEdge{16, 2.2f, 2.0f};
+  EdgeBlendMask mask;
+  REQUIRE(mask.configure(64, 8, settings));
+  const auto* planes = mask.gain().data();
+  REQUIRE(!mask.configure(64, 8, settings));
+  REQUIRE(mask.generation() == 1);
+  REQUIRE(mask.gain().data() == planes);
+
+  settings.left.gamma = 2.4f;
+  REQUIRE(mask.configure(64, 8, settings));
+  REQUIRE(mask.configure(32, 8, settings));
+  REQUIRE(mask.generation() == 3);
+
+  // Without any edge or black level the mask is inactive and leaves frames alone.
+  REQUIRE(mask.configure(32, 8, EdgeBlendSettings{}));
+  REQUIRE(!mask.active());
+  RgbaImage image(32, 8);
+  image.fill(10, 20, 30, 40);
+  mask.apply(image.mutableView());
+  REQUIRE(image.pixel(0, 0)[0] == 10);
+}
+
+TEST_CASE("Edge blend specs parse and scale", "[renderer][edgeblend]") {
+  EdgeBlendSettings settings;
+  std::string error;
+  REQUIRE(parseEdgeBlend("gamma=2.4,left=128,right=64/1.8/3,black=0.02", settings, error));
+  REQUIRE(settings.left.width == 128);
+  REQUIRE(near(settings.left.gamma, 2.4f));
+  REQUIRE(near(settings.left.curve, 2.0f));
+  REQUIRE(settings.right.width == 64);
+  REQUIRE(near(settings.right.gamma, 1.8f));
+  REQUIRE(near(settings.right.curve, 3.0f));
+  REQUIRE(near(settings.blackLevel, 0.02f));
+  REQUIRE(settings.top.width == 0);
+
+  REQUIRE(!parseEdgeBlend("left", settings, error));
+  REQUIRE(!error.empty());
+  REQUIRE(!parseEdgeBlend("middle=4", settings, error));
+  REQUIRE(!parseEdgeBlend("left=-4", settings, error));
+  REQUIRE(!parseEdgeBlend("left=4/0", settings, error));
+  REQUIRE(!parseEdgeBlend("left=4/2/2/2", settings, error));
+  REQUIRE(!parseEdgeBlend("black=1.5", settings, error));
+  // Failed parses leave the settings alone.
+  REQUIRE(settings.left.width == 128);
+
+  const auto half = scaleEdgeBlend(settings, 0.5f, 1.0f);
+  REQUIRE(half.left.width == 64);
+  REQUIRE(half.right.width == 32);
+  REQUIRE(near(half.right.gamma, 1.8f));
+}
@@ -0,0 +1,130 @@
+#include "util/FramePool.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <projection/core/Feed.h>
+
+#include "generators/GeneratedVideoSource.h"
+
+using projection::core::GeneratedFeedConfig;
+using projection::core::GeneratorKind;
+using projection::renderer::FramePool;
+using projection::renderer::FrameRef;
+using projection::renderer::GeneratedVideoSource;
+using projection::renderer::PixelFormat;
+
+TEST_CASE("FramePool recycles released buffers by size and format", "[renderer][framepool]") {
+  FramePool pool;
+  FrameRef first = pool.acquire(64, 32);
+  REQUIRE(first);
+  REQUIRE(first.strideBytes() == 256);
+  REQUIRE(reinterpret_cast<uintptr_t>(first.data()) % FramePool::kAlignment == 0);
+  const uint8_t* firstData = first.data();
+  first.reset();
+  REQUIRE(pool.stats().bytesIdle == 64 * 32 * 4);
+
+  FrameRef again = pool.acquire(64, 32);
+  REQUIRE(again.data() == firstData);
+  FrameRef gray = pool.acquire(64, 32, PixelFormat::Gray8);
+  REQUIRE(gray.data() != firstData);
+  REQUIRE(gray.strideBytes() == 64);
+  REQUIRE(gray.view().empty());
+
+  const auto stats = pool.stats();
+  REQUIRE(stats.hits == 1);
+  REQUIRE(stats.misses == 2);
+  REQUIRE(stats.bytesInUse == 64 * 32 * 5);
+  REQUIRE(stats.bytesIdle == 0);
+  REQUIRE(stats.hitRate() > 0.33);
+}
+
+TEST_CASE("FrameRef copies share the buffer until the last one is released", "[renderer][framepool]") {
+  FramePool pool;
+  FrameRef frame = pool.acquire(16, 16);
+  FrameRef copy = frame;
+  REQUIRE(frame.useCount() == 2);
+  REQUIRE(copy.data() == frame.data());
+
+  frame.reset();
+  REQUIRE(copy.useCount() == 1);
+  REQUIRE(pool.stats().bytesInUse == 16 * 16 * 4);
+
+  // Release on another thread, as an upload or encode thread would.
+  std::thread releaser([held = std::move(copy)]() mutable { held.reset(); });
+  releaser.join();
+  REQUIRE(pool.stats().bytesInUse == 0);
+  REQUIRE(pool.stats().bytesIdle == 16 * 16 * 4);
+}
+
+TEST_CASE("FramePool stays within its memory budget", "[renderer][framepool]") {
+  const size_t frameBytes = 100 * 100 * 4;
+  FramePool pool(frameBytes * 2);
+  FrameRef a = pool.acquire(100, 100);
+  FrameRef b = pool.acquire(100, 100);
+  REQUIRE(a);
+  REQUIRE(b);
+  REQUIRE(!pool.acquire(100, 100));
+  REQUIRE(pool.stats().rejected == 1);
+
+  // An idle buffer of another size is evicted to make room.
+  b.reset();
+  FrameRef small = pool.acquire(50, 50);
+  REQUIRE(small);
+  auto stats = pool.stats();
+  REQUIRE(stats.evictions == 1);
+  REQUIRE(stats.bytesInUse + stats.bytesIdle <= frameBytes * 2);
+  REQUIRE(stats.peakBytes == frameBytes * 2);
+
+  // Lowering the budget drops idle buffers; releasing over budget frees instead of pooling.
+  small.reset();
+  pool.setBudget(frameBytes / 2);
+  a.reset();
+  stats = pool.stats();
+  REQUIRE(stats.bytesIdle == 0);
+  REQUIRE(stats.bytesInUse == 0);
+}
+
+TEST_CASE("FrameRefs outlive their pool", "[renderer][framepool]") {
+  FrameRef survivor;
+  {
+    FramePool pool;
+    survivor = pool.acquire(8, 8);
+    std::memset(survivor.data(), 7, 8 * 8 * 4);
+  }
+  REQUIRE(survivor.data()[255] == 7);
+  survivor.reset();
+}
+
+TEST_CASE("Generated playback allocates no frames in steady state", "[renderer][framepool][generators]") {
+  GeneratedFeedConfig config;
+  config.generator = GeneratorKind::Noise;
+  config.width = 320;
+  config.height = 180;
+  config.speed = 120.0f;
+  FramePool pool;
+  GeneratedVideoSource source(config, nullptr, &pool);
+  source.load("");
+  source.play();
+  for (int i = 0; i < 120; ++i) {
+    source.update(1.0 / 60.0);
+  }
+  REQUIRE(source.renderedFrames() == 121);
+  REQUIRE(pool.stats().misses == 1);
+
+  // A held frame is left untouched; the next frame goes to a second buffer, and the two then
+  // alternate without further allocation.
+  for (int i = 0; i < 10; ++i) {
+    FrameRef held = source.frame();
+    std::vector<uint8_t> before(held.data(), held.data() + held.strideBytes() * 180);
+    source.update(1.0 / 60.0);
+    REQUIRE(std::memcmp(before.data(), held.data(), before.size()) == 0);
+    REQUIRE(source.frame().data() != held.data());
+  }
+  REQUIRE(pool.stats().misses == 2);
+  REQUIRE(source.droppedFrames() == 0);
+}
@@ -0,0 +1,208 @@
+#include "generators/GeneratedVideoSource.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <projection/core/Feed.h>
+#include <projection/core/Scene.h>
+#include <projection/core/Surface.h>
+
+#include "RenderState.h"
+#include "generators/GeneratorKernels.h"
+#include "generators/Generators.h"
+#include "util/WorkerPool.h"
+
+using projection::core::FeedId;
+using projection::core::GeneratedFeedConfig;
+using projection::core::GeneratorColor;
+using projection::core::GeneratorKind;
+using projection::core::Scene;
+using projection::core::SceneId;
+using projection::core::Surface;
+using projection::core::SurfaceId;
+using projection::core::Vec2;
+using projection::renderer::GeneratedVideoSource;
+using projection::renderer::RenderState;
+using projection::renderer::RgbaImage;
+using projection::renderer::WorkerPool;
+
+namespace {
+GeneratedFeedConfig makeConfig(GeneratorKind kind, int width = 203, int height = 97) {
+  GeneratedFeedConfig config;
+  config.generator = kind;
+  config.width = width;
+  config.height = height;
+  return config;
+}
+
+RgbaImage render(const GeneratedFeedConfig& config, double seconds, bool useSimd, WorkerPool* pool = nullptr) {
+  auto generator = projection::renderer::makeGenerator(config);
+  RgbaImage frame(config.width, config.height);
+  generator->prepare(seconds);
+  auto band = [&](size_t begin, size_t end) {
+    generator->renderRows(frame.mutableView(), static_cast<int>(begin), static_cast<int>(end), useSimd);
+  };
+  if (pool != nullptr) {
+    pool->parallelFor(static_cast<size_t>(config.height), band, 8);
+  } else {
+    band(0, static_cast<size_t>(config.height));
+  }
+  return frame;
+}
+
+bool pixelIs(const RgbaImage& image, int x, int y, uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255) {
+  const uint8_t* px = image.pixel(x, y);
+  return px[0] == r && px[1] == g && px[2] == b && px[3] == a;
+}
+}  // namespace
+
+TEST_CASE("Generator kernels match the scalar reference on every length", "[renderer][generators]") {
+  const uint8_t a[4] = {250, 3, 128, 255};
+  const uint8_t b[4] = {7, 255, 64, 0};
+  for (size_t count : {1u, 3u, 4u, 5u, 17u, 64u}) {
+    std::vector<uint16_t> weights(count);
+    for (size_t i = 0; i < count; ++i) {
+      weights[i] = static_cast<uint16_t>((i * 37) % 257);
+    }
+    weights[0] = 256;
+    std::vector<uint8_t> simd(count * 4);
+    std::vector<uint8_t> scalar(count * 4);
+    projection::renderer::lerpSpan(simd.data(), count, a, b, weights.data(), true);
+    projection::renderer::lerpSpan(scalar.data(), count, a, b, weights.data(), false);
+    REQUIRE(simd == scalar);
+    REQUIRE(std::memcmp(scalar.data(), b, 4) == 0);
+
+    projection::renderer::fillSpan(simd.data(), count, a, true);
+    projection::renderer::fillSpan(scalar.data(), count, a, false);
+    REQUIRE(simd == scalar);
+    REQUIRE(std::memcmp(simd.data() + (count - 1) * 4, a, 4) == 0);
+  }
+}
+
+TEST_CASE("Generators render identically with SIMD, scalar and worker threads", "[renderer][generators]") {
+  WorkerPool pool(4);
+  GeneratedFeedConfig configs[] = {makeConfig(GeneratorKind::ColorField), makeConfig(GeneratorKind::Gradient),
+                                   makeConfig(GeneratorKind::Noise), makeConfig(GeneratorKind::TestPattern),
+                                   makeConfig(GeneratorKind::ScrollingText)};
+  configs[0].colors = {GeneratorColor{255, 0, 0, 255}, GeneratorColor{0, 0, 255, 255}};
+  configs[0].speed = 0.5f;
+  configs[1].angleDegrees = 30.0f;
+  configs[1].speed = 0.25f;
+  configs[2].scale = 13.0f;
+  configs[2].speed = 40.0f;
+  configs[4].text = "Hello, 42!";
+  configs[4].scale = 3.0f;
+  configs[4].speed = 60.0f;
+
+  for (const auto& config : configs) {
+    const auto reference = render(config, 0.7, false);
+    REQUIRE(render(config, 0.7, true).pixels() == reference.pixels());
+    REQUIRE(render(config, 0.7, true, &pool).pixels() == reference.pixels());
+  }
+}
+
+TEST_CASE("Generators draw the configured colors", "[renderer][generators]") {
+  auto field = makeConfig(GeneratorKind::ColorField);
+  field.colors = {GeneratorColor{10, 20, 30, 255}};
+  const auto fieldFrame = render(field, 3.0, true);
+  REQUIRE(pixelIs(fieldFrame, 0, 0, 10, 20, 30));
+  REQUIRE(pixelIs(fieldFrame, 202, 96, 10, 20, 30));
+
+  // Horizontal black-to-white ramp: dark on the left, bright on the right, rows identical.
+  const auto gradient = render(makeConfig(GeneratorKind::Gradient), 0.0, true);
+  REQUIRE(gradient.pixel(0, 0)[0] < 5);
+  REQUIRE(gradient.pixel(202, 0)[0] > 250);
+  REQUIRE(std::memcmp(gradient.row(0), gradient.row(96), gradient.strideBytes()) == 0);
+
+  // 75% bars: the first is grey, the last blue.
+  const auto bars = render(makeConfig(GeneratorKind::TestPattern, 700, 360), 0.0, true);
+  REQUIRE(pixelIs(bars, 50, 60, 191, 191, 191));
+  REQUIRE(pixelIs(bars, 650, 60, 0, 0, 191));
+
+  auto noiseConfig = makeConfig(GeneratorKind::Noise);
+  noiseConfig.colors = {GeneratorColor{100, 0, 0, 255}, GeneratorColor{200, 0, 0, 255}};
+  const auto noise = render(noiseConfig, 0.0, true);
+  uint8_t lowest = 255;
+  uint8_t highest = 0;
+  for (int y = 0; y < noise.height(); ++y) {
+    for (int x = 0; x < noise.width(); ++x) {
+      lowest = std::min(lowest, noise.pixel(x, y)[0]);
+      highest = std::max(highest, noise.pixel(x, y)[0]);
+    }
+  }
+  REQUIRE(lowest >= 100);
+  REQUIRE(highest <= 200);
+  REQUIRE(highest > lowest);
+
+  // Static text is centred: the 18 px advance of "I" starts at x = 21, its stem is x = 27..29.
+  auto text = makeConfig(GeneratorKind::ScrollingText, 60, 21);
+  text.text = "I";
+  text.scale = 3.0f;
+  const auto textFrame = render(text, 0.0, true);
+  REQUIRE(pixelIs(textFrame, 0, 10, 0, 0, 0));
+  REQUIRE(pixelIs(textFrame, 28, 10, 255, 255, 255));
+  REQUIRE(pixelIs(textFrame, 30, 10, 0, 0, 0));
+}
+
+TEST_CASE("GeneratedVideoSource renders only when content changes", "[renderer][generators]") {
+  GeneratedVideoSource pattern(makeConfig(GeneratorKind::TestPattern));
+  REQUIRE(pattern.frameVersion() == 0);
+  REQUIRE(pattern.load(""));
+  pattern.play();
+  for (int i = 0; i < 10; ++i) {
+    pattern.update(1.0 / 60.0);
+  }
+  REQUIRE(pattern.frameVersion() == 1);
+  REQUIRE(pattern.renderedFrames() == 1);
+  REQUIRE(pattern.skippedFrames() == 10);
+  REQUIRE(pattern.duration() == 0.0);
+  REQUIRE(pattern.position() > 0.16);
+
+  // 30 px/s at 60 fps moves the text every other frame.
+  auto tickerConfig = makeConfig(GeneratorKind::ScrollingText);
+  tickerConfig.text = "NEWS";
+  tickerConfig.speed = 30.0f;
+  GeneratedVideoSource ticker(tickerConfig);
+  ticker.load("");
+  ticker.play();
+  for (int i = 0; i < 60; ++i) {
+    ticker.update(1.0 / 60.0);
+  }
+  REQUIRE(ticker.frameVersion() >= 30);
+  REQUIRE(ticker.frameVersion() <= 32);
+  REQUIRE(ticker.cpuFrame().width == 203);
+}
+
+TEST_CASE("RenderState plays Generated feeds", "[renderer][generators][renderstate]") {
+  RenderState state;
+  auto config = makeConfig(GeneratorKind::Gradient, 64, 32);
+  config.speed = 1.0f;
+  Surface surface{SurfaceId{"s1"}, "S1", {Vec2{-1, -1}, Vec2{1, -1}, Vec2{1, 1}}, FeedId{"gradient"}};
+  state.loadSceneDefinition(Scene{SceneId{"scene"}, "Scene", "", {surface}},
+                            {projection::core::makeGeneratedFeed(FeedId{"gradient"}, "Gradient", config)});
+
+  const auto& feeds = state.videoFeeds();
+  REQUIRE(feeds.size() == 1);
+  const auto& resource = feeds.at("gradient");
+  REQUIRE(resource.filePath.empty());
+  REQUIRE(resource.source->isLoaded());
+  REQUIRE(resource.source->width() == 64.0f);
+  const uint64_t firstVersion = resource.source->frameVersion();
+  REQUIRE(firstVersion == 1);
+
+  state.updateVideoPlayers(0.1);
+  REQUIRE(resource.source->frameVersion() == firstVersion + 1);
+  REQUIRE(resource.drift.resyncCount == 0);
+
+  bool threw = false;
+  try {
+    state.loadSceneDefinition(Scene{}, {projection::core::Feed{FeedId{"bad"}, "Bad",
+                                                               projection::core::FeedType::Generated, "{}"}});
+  } catch (const std::exception&) {
+    threw = true;
+  }
+  REQUIRE(threw);
+}
@@ -0,0 +1,81 @@
+#include "headless/HeadlessRunner.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <string>
+
+#include <nlohmann/json.hpp>
+#include <projection/core/Validation.h>
+
+using projection::core::RendererMessage;
+using projection::core::RendererMessageType;
+using projection::renderer::HeadlessOptions;
+using projection::renderer::HeadlessRunner;
+using projection::renderer::loadSceneDefinitionFile;
+using projection::renderer::makeSyntheticScene;
+
+TEST_CASE("makeSyntheticScene lays out surfaces over the requested feeds", "[renderer][headless]") {
+  const auto definition = makeSyntheticScene(10, 3);
+  REQUIRE(definition.feeds.size() == 3);
+  REQUIRE(definition.scene.getSurfaces().size() == 10);
+  std::string error;
+  REQUIRE(projection::core::validateSceneFeeds(definition.scene, definition.feeds, error));
+  REQUIRE(definition.scene.getSurfaces()[4].getFeedId().value == "synthetic-feed-1");
+}
+
+TEST_CASE("HeadlessRunner steps the frame pipeline offline and reports timings", "[renderer][headless]") {
+  HeadlessOptions options;
+  options.connect = false;
+  options.syntheticSurfaces = 16;
+  options.syntheticAudio = true;
+  options.frames = 120;
+  options.timestepSeconds = 0.01;
+
+  HeadlessRunner runner(options);
+  const auto report = runner.run();
+
+  REQUIRE(report.frames == 120);
+  REQUIRE(report.surfacesDrawn == 16);
+  REQUIRE(report.frame.count == 120);
+  REQUIRE(report.frame.p99 >= report.frame.p50);
+  REQUIRE(report.frame.max >= report.prepare.max);
+  REQUIRE(report.simulatedSeconds > 1.19);
+  REQUIRE(report.simulatedSeconds < 1.21);
+  REQUIRE(runner.runtime().audioScale() > 0.8f);
+  REQUIRE(runner.runtime().status().lastError.empty());
+}
+
+TEST_CASE("loadSceneDefinitionFile accepts bare payloads and full messages", "[renderer][headless]") {
+  const auto definition = makeSyntheticScene(2, 1);
+  const std::string barePath = "headless_scene_bare.json";
+  const std::string messagePath = "headless_scene_message.json";
+
+  {
+    std::ofstream out(barePath);
+    out << nlohmann::json(definition).dump();
+  }
+  {
+    RendererMessage message{};
+    message.type = RendererMessageType::LoadSceneDefinition;
+    message.commandId = "cmd-file";
+    message.loadSceneDefinition = definition;
+    std::ofstream out(messagePath);
+    out << nlohmann::json(message).dump();
+  }
+
+  REQUIRE(loadSceneDefinitionFile(barePath) == definition);
+  REQUIRE(loadSceneDefinitionFile(messagePath) == definition);
+  std::remove(barePath.c_str());
+  std::remove(messagePath.c_str());
+
+  bool threw = false;
+  try {
+    loadSceneDefinitionFile("does-not-exist.json");
+  } catch (const std::exception&) {
+    threw = true;
+  }
+  REQUIRE(threw);
+}
@@ -4,6 +4,7 @@
 #include <cmath>
 
 using projection::renderer::computeAverageEnergy;
+using projection::renderer::computeMeanSquareEnergy;
 using projection::renderer::mapEnergyToScale;
 using projection::renderer::mapMidiValueToBrightness;
 
@@ -24,6 +25,13 @@ TEST_CASE("computeAverageEnergy averages the requested number of bins", "[intera
   REQUIRE(std::abs(computeAverageEnergy({}, 4) - 0.0f) < 1e-5f);
 }
 
+TEST_CASE("computeMeanSquareEnergy averages squared samples", "[interaction]") {
+  const float samples[] = {1.0f, -1.0f, 0.5f, -0.5f};
+  REQUIRE(std::abs(computeMeanSquareEnergy(samples, 4) - 0.625f) < 1e-6f);
+  REQUIRE(computeMeanSquareEnergy(samples, 0) == 0.0f);
+  REQUIRE(computeMeanSquareEnergy(nullptr, 4) == 0.0f);
+}
+
 TEST_CASE("mapEnergyToScale clamps to configured range", "[interaction]") {
   const float minScale = 0.8f;
   const float maxScale = 1.2f;
@@ -0,0 +1,171 @@
+#include "midi/MidiMap.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <projection/core/Project.h>
+#include <projection/core/RendererProtocol.h>
+
+#include "RendererRuntime.h"
+#include "video/StubVideoSource.h"
+
+using projection::core::ProjectSettings;
+using projection::core::RendererMessage;
+using projection::core::RendererMessageType;
+using projection::renderer::MidiEvent;
+using projection::renderer::MidiMap;
+using projection::renderer::MidiParameter;
+using projection::renderer::RendererRuntime;
+using projection::renderer::compileMidiMap;
+using projection::renderer::kMidiControlChange;
+using projection::renderer::kMidiNoteOff;
+using projection::renderer::kMidiNoteOn;
+using projection::renderer::makeStubVideoSourceFactory;
+
+namespace {
+bool near(float a, float b) { return std::fabs(a - b) < 1e-4f; }
+
+// `channel` is 1-16 as in ProjectSettings::midiChannels.
+MidiEvent makeEvent(uint8_t type, int channel, int number, int value, int64_t timestampMicros = 0) {
+  MidiEvent event;
+  event.timestampMicros = timestampMicros;
+  event.status = static_cast<uint8_t>(type | (channel - 1));
+  event.data1 = static_cast<uint8_t>(number);
+  event.data2 = static_cast<uint8_t>(value);
+  return event;
+}
+
+RendererMessage makeCueTable(const ProjectSettings& settings) {
+  RendererMessage message{};
+  message.type = RendererMessageType::LoadCueTable;
+  message.commandId = "cmd-cues";
+  message.cueTable = projection::core::CueTableMessage{};
+  message.cueTable->settings = settings;
+  return message;
+}
+}  // namespace
+
+TEST_CASE("MidiMap defaults to CC1 brightness on every channel", "[renderer][midi]") {
+  const MidiMap map;
+  float value = 0.0f;
+  REQUIRE(map.listensTo(0));
+  REQUIRE(map.listensTo(15));
+  REQUIRE(map.lookup(makeEvent(kMidiControlChange, 1, 1, 127), value) == MidiParameter::Brightness);
+  REQUIRE(near(value, 1.0f));
+  REQUIRE(map.lookup(makeEvent(kMidiControlChange, 9, 1, 64), value) == MidiParameter::Brightness);
+  REQUIRE(near(value, 64.0f / 127.0f));
+  REQUIRE(map.lookup(makeEvent(kMidiControlChange, 1, 7, 64), value) == MidiParameter::None);
+  REQUIRE(map.lookup(makeEvent(kMidiNoteOn, 1, 1, 64), value) == MidiParameter::None);
+  REQUIRE(map.mappingCount() == 16);
+}
+
+TEST_CASE("MidiMap compiles project channels and controller mappings", "[renderer][midi]") {
+  ProjectSettings settings;
+  settings.midiChannels = {2, 10};
+  settings.controllers["cc7"] = "master";
+  settings.controllers["ch10:note36"] = "audio";
+  settings.controllers["fader1"] = "master";
+  settings.controllers["cc8"] = "hue";
+  std::vector<std::string> warnings;
+  const MidiMap map = compileMidiMap(settings, warnings);
+
+  // Non-MIDI controller names are skipped silently, unknown parameters with a warning.
+  REQUIRE(warnings.size() == 1);
+  REQUIRE(warnings[0].find("hue") != std::string::npos);
+  REQUIRE(!map.listensTo(0));
+  REQUIRE(map.listensTo(1));
+  REQUIRE(map.listensTo(9));
+
+  float value = 0.0f;
+  REQUIRE(map.lookup(makeEvent(kMidiControlChange, 2, 7, 127), value) == MidiParameter::Brightness);
+  // The explicit mapping replaces the default CC1.
+  REQUIRE(map.lookup(makeEvent(kMidiControlChange, 2, 1, 127), value) == MidiParameter::None);
+  REQUIRE(map.lookup(makeEvent(kMidiNoteOn, 10, 36, 127), value) == MidiParameter::AudioDepth);
+  REQUIRE(near(value, 1.0f));
+  REQUIRE(map.lookup(makeEvent(kMidiNoteOff, 10, 36, 64), value) == MidiParameter::AudioDepth);
+  REQUIRE(near(value, 0.0f));
+  REQUIRE(map.lookup(makeEvent(kMidiNoteOn, 2, 36, 127), value) == MidiParameter::None);
+  REQUIRE(map.mappingCount() == 17);
+
+  // Malformed sources are not MIDI keys either.
+  ProjectSettings malformed;
+  malformed.controllers["cc128"] = "brightness";
+  malformed.controllers["ch17:cc1"] = "brightness";
+  malformed.controllers["note"] = "brightness";
+  warnings.clear();
+  const MidiMap fallback = compileMidiMap(malformed, warnings);
+  REQUIRE(warnings.empty());
+  REQUIRE(fallback.lookup(makeEvent(kMidiControlChange, 3, 1, 0), value) == MidiParameter::Brightness);
+}
+
+TEST_CASE("RendererRuntime drains timestamped MIDI once per frame", "[renderer][midi][runtime]") {
+  RendererRuntime runtime(makeStubVideoSourceFactory());
+  REQUIRE(near(runtime.midiBrightness(), 1.0f));
+
+  // Events queue until the next frame; the last value of a parameter in a frame wins.
+  REQUIRE(runtime.writeMidi(makeEvent(kMidiControlChange, 1, 1, 0, 1000)));
+  REQUIRE(runtime.writeMidi(makeEvent(kMidiControlChange, 1, 1, 127, 2000)));
+  REQUIRE(runtime.writeMidi(makeEvent(kMidiControlChange, 1, 1, 64, 4000)));
+  REQUIRE(runtime.writeMidi(makeEvent(kMidiControlChange, 1, 9, 64, 4000)));
+  REQUIRE(near(runtime.midiBrightness(), 1.0f));
+  runtime.update(1.0 / 60.0, 6000);
+  REQUIRE(near(runtime.midiBrightness(), 64.0f / 127.0f));
+
+  const auto& stats = runtime.midiStats();
+  REQUIRE(stats.received == 4);
+  REQUIRE(stats.applied == 3);
+  REQUIRE(stats.unmapped == 1);
+  REQUIRE(stats.lastFrameEvents == 4);
+  REQUIRE(std::fabs(stats.lastFrameMaxLatencyMs - 5.0) < 1e-9);
+  REQUIRE(std::fabs(stats.meanLatencyMs() - (5.0 + 4.0 + 2.0 + 2.0) / 4.0) < 1e-9);
+
+  runtime.update(1.0 / 60.0, 22000);
+  REQUIRE(stats.lastFrameEvents == 0);
+  REQUIRE(std::fabs(stats.maxLatencyMs - 5.0) < 1e-9);
+
+  // Unstamped events get the monotonic clock on the MIDI thread.
+  runtime.writeMidi(makeEvent(kMidiControlChange, 1, 1, 127));
+  runtime.update(1.0 / 60.0);
+  REQUIRE(near(runtime.midiBrightness(), 1.0f));
+  REQUIRE(stats.lastFrameMaxLatencyMs < 1000.0);
+}
+
+TEST_CASE("RendererRuntime filters MIDI by the cue table's project channels", "[renderer][midi][runtime]") {
+  RendererRuntime runtime(makeStubVideoSourceFactory());
+  ProjectSettings settings;
+  settings.midiChannels = {3};
+  settings.controllers["cc20"] = "brightness";
+  settings.controllers["cc21"] = "audioDepth";
+  runtime.handle(makeCueTable(settings));
+  runtime.update(1.0 / 60.0, 1000);
+  REQUIRE(runtime.midiMap().listensTo(2));
+
+  runtime.writeMidi(makeEvent(kMidiControlChange, 1, 20, 0, 1000));
+  runtime.writeMidi(makeEvent(kMidiControlChange, 3, 20, 32, 1000));
+  runtime.writeMidi(makeEvent(kMidiControlChange, 3, 21, 0, 1000));
+  runtime.update(1.0 / 60.0, 2000);
+  REQUIRE(runtime.midiStats().filtered == 1);
+  REQUIRE(near(runtime.midiBrightness(), 32.0f / 127.0f));
+  REQUIRE(near(runtime.midiParameter(MidiParameter::AudioDepth), 0.0f));
+}
+
+TEST_CASE("RendererRuntime bounds the MIDI work of a flooded frame", "[renderer][midi][runtime]") {
+  RendererRuntime runtime(makeStubVideoSourceFactory());
+  // A controller at 1 kHz between frames 1.5 s apart overflows the ring: the excess is
+  // dropped on the MIDI thread and the frame drains at most one ring's worth.
+  size_t accepted = 0;
+  for (int i = 0; i < 1500; ++i) {
+    accepted += runtime.writeMidi(makeEvent(kMidiControlChange, 1, 1, i % 128, 1000 + i * 1000)) ? 1 : 0;
+  }
+  REQUIRE(accepted < 1500);
+  runtime.update(1.0 / 60.0, 1501000);
+  const auto& stats = runtime.midiStats();
+  REQUIRE(stats.received == accepted);
+  REQUIRE(stats.dropped == 1500 - accepted);
+  REQUIRE(std::fabs(stats.lastFrameMaxLatencyMs - 1500.0) < 1e-9);
+  REQUIRE(near(runtime.midiBrightness(), static_cast<float>((accepted - 1) % 128) / 127.0f));
+}
@@ -0,0 +1,179 @@
+#include "OutputViewport.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <projection/core/Feed.h>
+#include <projection/core/Scene.h>
+#include <projection/core/Surface.h>
+
+#include "RendererRuntime.h"
+#include "video/StubVideoSource.h"
+
+using projection::core::FeedId;
+using projection::core::LoadSceneDefinitionMessage;
+using projection::core::RendererMessage;
+using projection::core::RendererMessageType;
+using projection::core::Scene;
+using projection::core::SceneId;
+using projection::core::Surface;
+using projection::core::SurfaceId;
+using projection::core::Vec2;
+using projection::renderer::OutputViewport;
+using projection::renderer::RendererRuntime;
+using projection::renderer::ViewportTransform;
+using projection::renderer::fullSceneViewport;
+using projection::renderer::makeStubVideoSourceFactory;
+using projection::renderer::parseOutputViewport;
+using projection::renderer::partitionSceneHorizontally;
+
+namespace {
+bool near(float a, float b) { return std::fabs(a - b) < 1e-3f; }
+}  // namespace
+
+TEST_CASE("Full-scene viewport matches the single-output mapping", "[renderer][outputs]") {
+  const ViewportTransform transform(fullSceneViewport(200.0f, 100.0f));
+  const Vec2 topLeft = transform.toPixels(Vec2{-1.0f, -1.0f});
+  const Vec2 centre = transform.toPixels(Vec2{0.0f, 0.0f});
+  const Vec2 point = transform.toPixels(Vec2{0.5f, -0.5f});
+  REQUIRE(near(topLeft.x, 0.0f));
+  REQUIRE(near(topLeft.y, 0.0f));
+  REQUIRE(near(centre.x, 100.0f));
+  REQUIRE(near(centre.y, 50.0f));
+  REQUIRE(near(point.x, 150.0f));
+  REQUIRE(near(point.y, 25.0f));
+
+  const auto& visible = transform.visibleSceneBounds();
+  REQUIRE(near(visible.left, -1.0f));
+  REQUIRE(near(visible.bottom, 1.0f));
+}
+
+TEST_CASE("Horizontal partition shares the overlap between neighbours", "[renderer][outputs]") {
+  const auto outputs = partitionSceneHorizontally(2, 1920, 1080, 0.2f);
+  REQUIRE(outputs.size() == 2);
+  REQUIRE(outputs[0].name == "output-1");
+  REQUIRE(near(outputs[0].sceneRect.left, -1.0f));
+  REQUIRE(near(outputs[0].sceneRect.right, 0.1f));
+  REQUIRE(near(outputs[1].sceneRect.left, -0.1f));
+  REQUIRE(near(outputs[1].sceneRect.right, 1.0f));
+  REQUIRE(outputs[1].x == 1920);
+  REQUIRE(outputs[1].y == 0);
+  // 0.2 of the 1.1 scene units each output shows is shared: 349 pixels of blend ramp.
+  REQUIRE(outputs[0].blend.left.width == 0);
+  REQUIRE(outputs[0].blend.right.width == 349);
+  REQUIRE(outputs[1].blend.left.width == 349);
+  REQUIRE(outputs[1].blend.right.width == 0);
+
+  // Both outputs stretch 1.1 scene units over 1920 pixels; the shared strip lands on the
+  // right edge of the first and the left edge of the second.
+  const ViewportTransform first(outputs[0]);
+  const ViewportTransform second(outputs[1]);
+  REQUIRE(near(first.toPixels(Vec2{0.1f, 0.0f}).x, 1920.0f));
+  REQUIRE(near(second.toPixels(Vec2{-0.1f, 0.0f}).x, 0.0f));
+  REQUIRE(near(first.toPixels(Vec2{0.0f, 0.0f}).x, 1920.0f / 1.1f));
+  REQUIRE(near(second.toPixels(Vec2{0.0f, 0.0f}).x, 0.1f * 1920.0f / 1.1f));
+
+  REQUIRE(partitionSceneHorizontally(0, 1920, 1080).empty());
+}
+
+TEST_CASE("Rotated output turns the picture clockwise", "[renderer][outputs]") {
+  OutputViewport portrait;
+  portrait.width = 100;
+  portrait.height = 200;
+  portrait.rotationDegrees = 90.0f;
+  const ViewportTransform transform(portrait);
+
+  // The scene's top-left corner ends up top-right, its bottom-left top-left.
+  const Vec2 topLeft = transform.toPixels(Vec2{-1.0f, -1.0f});
+  const Vec2 bottomLeft = transform.toPixels(Vec2{-1.0f, 1.0f});
+  const Vec2 bottomRight = transform.toPixels(Vec2{1.0f, 1.0f});
+  REQUIRE(near(topLeft.x, 100.0f));
+  REQUIRE(near(topLeft.y, 0.0f));
+  REQUIRE(near(bottomLeft.x, 0.0f));
+  REQUIRE(near(bottomLeft.y, 0.0f));
+  REQUIRE(near(bottomRight.x, 0.0f));
+  REQUIRE(near(bottomRight.y, 200.0f));
+
+  const Vec2 roundTrip = transform.toScene(transform.toPixels(Vec2{0.3f, -0.6f}));
+  REQUIRE(near(roundTrip.x, 0.3f));
+  REQUIRE(near(roundTrip.y, -0.6f));
+
+  const auto& visible = transform.visibleSceneBounds();
+  REQUIRE(near(visible.left, -1.0f));
+  REQUIRE(near(visible.top, -1.0f));
+  REQUIRE(near(visible.right, 1.0f));
+  REQUIRE(near(visible.bottom, 1.0f));
+}
+
+TEST_CASE("Output specs parse with optional rotation", "[renderer][outputs]") {
+  OutputViewport viewport;
+  viewport.name = "left";
+  std::string error;
+  REQUIRE(parseOutputViewport("1280x720+0+0:-1,-1,0,1", viewport, error));
+  REQUIRE(viewport.name == "left");
+  REQUIRE(viewport.width == 1280);
+  REQUIRE(viewport.height == 720);
+  REQUIRE(near(viewport.sceneRect.right, 0.0f));
+  REQUIRE(viewport.rotationDegrees == 0.0f);
+
+  REQUIRE(parseOutputViewport("1080x1920+1280+0:0,-1,1,1:90", viewport, error));
+  REQUIRE(viewport.x == 1280);
+  REQUIRE(near(viewport.sceneRect.left, 0.0f));
+  REQUIRE(viewport.rotationDegrees == 90.0f);
+
+  REQUIRE(!parseOutputViewport("1920x1080", viewport, error));
+  REQUIRE(!error.empty());
+  REQUIRE(!parseOutputViewport("1920x1080+0+0:-1,-1,1,1:sideways", viewport, error));
+  REQUIRE(!parseOutputViewport("0x1080+0+0:-1,-1,1,1", viewport, error));
+  REQUIRE(!parseOutputViewport("1920x1080+0+0:1,-1,-1,1", viewport, error));
+  // A failed parse leaves the viewport untouched.
+  REQUIRE(viewport.x == 1280);
+}
+
+TEST_CASE("RendererRuntime prepares culled draw lists per output", "[renderer][outputs][runtime]") {
+  RendererRuntime runtime(makeStubVideoSourceFactory());
+  const Surface leftOnly{SurfaceId{"left"}, "Left", {Vec2{-1, -1}, Vec2{-0.5f, -1}, Vec2{-0.5f, 1}, Vec2{-1, 1}},
+                         FeedId{"video1"}};
+  const Surface spanning{SurfaceId{"span"}, "Span", {Vec2{-0.5f, -0.5f}, Vec2{0.5f, -0.5f}, Vec2{0.5f, 0.5f},
+                                                      Vec2{-0.5f, 0.5f}},
+                         FeedId{"video1"}};
+  RendererMessage message{};
+  message.type = RendererMessageType::LoadSceneDefinition;
+  message.commandId = "cmd-1";
+  message.loadSceneDefinition = LoadSceneDefinitionMessage{
+      Scene{SceneId{"scene-1"}, "Scene", "", {leftOnly, spanning}},
+      {projection::core::makeVideoFileFeed(FeedId{"video1"}, "Video 1", "/media/video1.mp4")}};
+  runtime.handle(message);
+  runtime.update(1.0 / 60.0);
+
+  const auto outputs = partitionSceneHorizontally(2, 100, 100);
+  const auto& lists = runtime.prepareOutputs(outputs);
+  REQUIRE(lists.size() == 2);
+  REQUIRE(lists[0].surfaces.size() == 2);
+  REQUIRE(lists[0].culledSurfaces == 0);
+  REQUIRE(lists[1].surfaces.size() == 1);
+  REQUIRE(lists[1].culledSurfaces == 1);
+  REQUIRE(lists[1].surfaces[0].surfaceId == "span");
+  REQUIRE(!lists[1].batches.empty());
+
+  // The spanning surface continues across the seam with identical texture coordinates.
+  const auto& onFirst = lists[0].surfaces[1];
+  const auto& onSecond = lists[1].surfaces[0];
+  REQUIRE(onFirst.surfaceId == "span");
+  REQUIRE(near(onFirst.positions[0].x, 50.0f));
+  REQUIRE(near(onFirst.positions[1].x, 150.0f));
+  REQUIRE(near(onSecond.positions[0].x, -50.0f));
+  REQUIRE(near(onSecond.positions[1].x, 50.0f));
+  for (size_t i = 0; i < onFirst.texCoords.size(); ++i) {
+    REQUIRE(near(onFirst.texCoords[i].x, onSecond.texCoords[i].x));
+    REQUIRE(near(onFirst.texCoords[i].y, onSecond.texCoords[i].y));
+  }
+
+  // The single-output path still sees everything.
+  const auto& full = runtime.prepareFrame(200.0f, 100.0f);
+  REQUIRE(full.surfaces.size() == 2);
+  REQUIRE(full.culledSurfaces == 0);
+}
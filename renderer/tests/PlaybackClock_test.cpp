@@ -0,0 +1,137 @@
+#include "video/PlaybackClock.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <projection/core/Feed.h>
+#include <projection/core/Scene.h>
+
+#include "RenderState.h"
+#include "video/StubVideoSource.h"
+
+using projection::core::FeedId;
+using projection::core::Scene;
+using projection::core::SceneId;
+using projection::renderer::DriftCorrectionOptions;
+using projection::renderer::DriftCorrector;
+using projection::renderer::FeedDriftMetrics;
+using projection::renderer::MasterClock;
+using projection::renderer::RenderState;
+using projection::renderer::StubVideoSource;
+using projection::renderer::VideoSource;
+using projection::renderer::loopedDrift;
+
+namespace {
+constexpr double kFrame = 1.0 / 60.0;
+
+// Plays `source` for `seconds` of master time, correcting every frame like RenderState does.
+void playCorrected(StubVideoSource& source, MasterClock& clock, const DriftCorrector& corrector,
+                   FeedDriftMetrics& metrics, double seconds) {
+  const int frames = static_cast<int>(std::lround(seconds / kFrame));
+  for (int i = 0; i < frames; ++i) {
+    clock.advance(kFrame);
+    source.update(kFrame);
+    corrector.correct(source, clock.seconds(), 0.0, kFrame, metrics);
+  }
+}
+
+StubVideoSource makeLoadedSource(double duration, double skew) {
+  StubVideoSource source;
+  source.load("/media/clip.mp4");
+  source.play();
+  source.setDuration(duration);
+  source.setRateSkew(skew);
+  return source;
+}
+}  // namespace
+
+TEST_CASE("loopedDrift wraps around the loop point", "[renderer][clock]") {
+  REQUIRE(std::fabs(loopedDrift(0.1, 9.9, 10.0) - 0.2) < 1e-9);
+  REQUIRE(std::fabs(loopedDrift(9.9, 0.1, 10.0) + 0.2) < 1e-9);
+  REQUIRE(std::fabs(loopedDrift(5.0, 4.5, 10.0) - 0.5) < 1e-9);
+  REQUIRE(std::fabs(loopedDrift(5.0, 4.5, 0.0) - 0.5) < 1e-9);
+}
+
+TEST_CASE("Uncorrected skewed decoders drift apart", "[renderer][clock]") {
+  // 0.2% fast over a 10 minute show is more than a second off.
+  auto source = makeLoadedSource(3600.0, 0.002);
+  MasterClock clock;
+  FeedDriftMetrics metrics;
+  DriftCorrectionOptions disabled;
+  disabled.toleranceSeconds = 1e9;
+  disabled.resyncThresholdSeconds = 1e9;
+  playCorrected(source, clock, DriftCorrector(disabled), metrics, 600.0);
+  REQUIRE(metrics.driftSeconds > 1.0);
+  REQUIRE(metrics.resyncCount == 0);
+}
+
+TEST_CASE("DriftCorrector holds skewed decoders within tolerance using rate nudges", "[renderer][clock]") {
+  DriftCorrectionOptions options;
+  options.toleranceSeconds = 0.005;
+  const DriftCorrector corrector(options);
+
+  for (double skew : {0.01, -0.01, 0.002}) {
+    auto source = makeLoadedSource(30.0, skew);
+    MasterClock clock;
+    FeedDriftMetrics metrics;
+    playCorrected(source, clock, corrector, metrics, 600.0);
+
+    // Steady state sits at the edge of the tolerance band; loops and long runs never need a seek.
+    REQUIRE(std::fabs(metrics.driftSeconds) <= options.toleranceSeconds + 0.001);
+    REQUIRE(metrics.maxAbsDriftSeconds < options.resyncThresholdSeconds);
+    REQUIRE(metrics.resyncCount == 0);
+    REQUIRE(source.seekCount() == 0);
+    REQUIRE(metrics.nudgedFrames > 0);
+    // Fast decoders are slowed down, slow ones sped up, within the configured limit.
+    REQUIRE((skew > 0.0 ? metrics.rate < 1.0 : metrics.rate > 1.0));
+    REQUIRE(std::fabs(metrics.rate - 1.0) <= options.maxRateAdjust + 1e-9);
+  }
+}
+
+TEST_CASE("DriftCorrector resyncs large jumps and leaves aligned sources alone", "[renderer][clock]") {
+  const DriftCorrector corrector;
+  auto source = makeLoadedSource(30.0, 0.0);
+  MasterClock clock;
+  FeedDriftMetrics metrics;
+  playCorrected(source, clock, corrector, metrics, 2.0);
+  REQUIRE(metrics.nudgedFrames == 0);
+  REQUIRE(source.speed() == 1.0);
+
+  // A decoder stall (or a seek elsewhere) puts the feed a second behind.
+  source.seek(source.position() - 1.0);
+  playCorrected(source, clock, corrector, metrics, kFrame);
+  REQUIRE(metrics.resyncCount == 1);
+  REQUIRE(std::fabs(loopedDrift(source.position(), std::fmod(clock.seconds(), 30.0), 30.0)) < 1e-9);
+  playCorrected(source, clock, corrector, metrics, 1.0);
+  REQUIRE(std::fabs(metrics.driftSeconds) < 1e-9);
+  REQUIRE(metrics.resyncCount == 1);
+}
+
+TEST_CASE("RenderState slaves every video feed to the master clock", "[renderer][clock][renderstate]") {
+  int created = 0;
+  RenderState state([&created]() -> std::unique_ptr<VideoSource> {
+    auto source = std::make_unique<StubVideoSource>();
+    source->setRateSkew(created++ % 2 == 0 ? 0.01 : -0.01);
+    return source;
+  });
+  state.loadSceneDefinition(Scene{SceneId{"s"}, "S", "", {}},
+                            {projection::core::makeVideoFileFeed(FeedId{"a"}, "A", "/media/a.mp4"),
+                             projection::core::makeVideoFileFeed(FeedId{"b"}, "B", "/media/b.mp4")});
+  for (int i = 0; i < 60 * 120; ++i) {
+    state.updateVideoPlayers(kFrame);
+  }
+
+  REQUIRE(std::fabs(state.masterClock().seconds() - 120.0) < 1e-6);
+  const auto& feeds = state.videoFeeds();
+  const auto& a = *feeds.at("a").source;
+  const auto& b = *feeds.at("b").source;
+  REQUIRE(std::fabs(loopedDrift(a.position(), b.position(), a.duration())) <=
+          2.0 * state.driftCorrection().toleranceSeconds + 0.002);
+  for (const auto& entry : feeds) {
+    REQUIRE(std::fabs(entry.second.drift.driftSeconds) <= state.driftCorrection().toleranceSeconds + 0.001);
+    REQUIRE(entry.second.drift.resyncCount == 0);
+  }
+}
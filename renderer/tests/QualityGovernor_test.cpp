@@ -0,0 +1,114 @@
+#include "util/QualityGovernor.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include "RendererRuntime.h"
+#include "video/StubVideoSource.h"
+
+using projection::renderer::QualityGovernor;
+using projection::renderer::QualityGovernorOptions;
+
+namespace {
+// 60 fps: 16.7 ms budget, step down above 18.3 ms, step up below 11.7 ms.
+QualityGovernorOptions testOptions() {
+  QualityGovernorOptions options;
+  options.targetFps = 60.0;
+  options.windowFrames = 60;
+  options.degradeHoldFrames = 30;
+  options.upgradeHoldFrames = 120;
+  return options;
+}
+
+// Feeds `frames` frame times from a repeating pattern; returns the frames at which the level changed.
+std::vector<size_t> feed(QualityGovernor& governor, const std::vector<double>& pattern, size_t frames) {
+  std::vector<size_t> changes;
+  for (size_t i = 0; i < frames; ++i) {
+    if (governor.addFrame(pattern[i % pattern.size()])) {
+      changes.push_back(i);
+    }
+  }
+  return changes;
+}
+}  // namespace
+
+TEST_CASE("QualityGovernor holds full quality while frames fit the budget", "[renderer][quality]") {
+  QualityGovernor governor(testOptions());
+  // Mostly 8 ms with an occasional 40 ms hitch: below the 95th percentile.
+  std::vector<double> trace(50, 8.0);
+  trace[10] = 40.0;
+  REQUIRE(feed(governor, trace, 2000).empty());
+  REQUIRE(governor.levelIndex() == 0);
+  REQUIRE(governor.level().name == "high");
+}
+
+TEST_CASE("QualityGovernor steps down one level per hold period under sustained load", "[renderer][quality]") {
+  QualityGovernor governor(testOptions());
+  const auto changes = feed(governor, {25.0}, 200);
+  // One step every degradeHoldFrames until the lowest level.
+  REQUIRE((changes == std::vector<size_t>{29, 59, 89}));
+  REQUIRE(governor.levelIndex() == governor.levels().size() - 1);
+  REQUIRE(!governor.level().overlay);
+  REQUIRE(!governor.level().preview);
+  REQUIRE(governor.level().audioAnalysisInterval == 8);
+  REQUIRE(governor.lastChange().fromLevel == 2);
+  REQUIRE(governor.lastChange().toLevel == 3);
+  REQUIRE(governor.lastChange().percentileMs == 25.0);
+  REQUIRE(governor.changeCount() == 3);
+}
+
+TEST_CASE("QualityGovernor does not flap inside the hysteresis band", "[renderer][quality]") {
+  QualityGovernor governor(testOptions());
+  feed(governor, {25.0}, 30);
+  REQUIRE(governor.levelIndex() == 1);
+  // Alternating 12 / 18 ms: p95 sits between the step-up and step-down thresholds.
+  REQUIRE(feed(governor, {12.0, 18.0}, 5000).empty());
+  REQUIRE(governor.levelIndex() == 1);
+}
+
+TEST_CASE("QualityGovernor recovers slowly once frames are fast again", "[renderer][quality]") {
+  QualityGovernor governor(testOptions());
+  feed(governor, {25.0}, 60);
+  REQUIRE(governor.levelIndex() == 2);
+
+  const auto changes = feed(governor, {6.0}, 400);
+  REQUIRE((changes == std::vector<size_t>{119, 239}));
+  REQUIRE(governor.levelIndex() == 0);
+
+  // A slow spell longer than the hold drops quality again.
+  REQUIRE(feed(governor, {6.0, 30.0, 30.0}, 30).size() == 1);
+  REQUIRE(governor.levelIndex() == 1);
+}
+
+TEST_CASE("QualityGovernor is inert without a target frame rate", "[renderer][quality]") {
+  auto options = testOptions();
+  options.targetFps = 0.0;
+  QualityGovernor governor(options);
+  REQUIRE(feed(governor, {100.0}, 1000).empty());
+  REQUIRE(governor.levelIndex() == 0);
+  REQUIRE(governor.budgetMs() == 0.0);
+}
+
+TEST_CASE("RendererRuntime analyses audio at the quality level's rate", "[renderer][quality]") {
+  projection::renderer::RendererRuntime runtime(projection::renderer::makeStubVideoSourceFactory());
+  auto options = testOptions();
+  options.degradeHoldFrames = 1;
+  runtime.setQualityGovernor(options);
+  for (int i = 0; i < 3; ++i) {
+    runtime.recordFrameTime(50.0);
+  }
+  REQUIRE(runtime.qualityLevel().audioAnalysisInterval == 8);
+
+  // A loud signal only moves the modulation on analysed frames (every 8th frame).
+  std::vector<float> loud(512, 0.9f);
+  runtime.update(1.0 / 60.0);  // frame 0: analysed (silent so far)
+  runtime.writeAudio(loud.data(), loud.size(), 1);
+  for (int i = 0; i < 7; ++i) {
+    runtime.update(1.0 / 60.0);
+  }
+  REQUIRE(runtime.audioScale() == 1.0f);
+  runtime.update(1.0 / 60.0);  // frame 8
+  REQUIRE(runtime.audioScale() != 1.0f);
+}
@@ -14,6 +14,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include <projection/core/TimeSync.h>
+
 #include "net/RendererClient.h"
 
 using projection::core::RendererMessage;
@@ -169,18 +171,27 @@ class TestServer {
 
     std::string responseBuffer;
     while (true) {
-      ssize_t received = ::recv(client_, chunk, sizeof(chunk), 0);
-      if (received <= 0) {
-        return;
-      }
-      responseBuffer.append(chunk, static_cast<size_t>(received));
       auto newlinePos = responseBuffer.find('\n');
       if (newlinePos == std::string::npos) {
+        ssize_t received = ::recv(client_, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+          return;
+        }
+        responseBuffer.append(chunk, static_cast<size_t>(received));
         continue;
       }
 
       std::string line = responseBuffer.substr(0, newlinePos);
+      responseBuffer.erase(0, newlinePos + 1);
       auto response = nlohmann::json::parse(line).get<RendererMessage>();
+      if (response.type == RendererMessageType::TimeSync) {
+        // Clock probes interleave with command replies; answer with this process's clock.
+        response.timeSync->serverReceiveMicros = projection::core::monotonicMicros();
+        response.timeSync->serverSendMicros = response.timeSync->serverReceiveMicros;
+        std::string reply = nlohmann::json(response).dump() + "\n";
+        ::send(client_, reply.c_str(), reply.size(), 0);
+        continue;
+      }
       {
         std::lock_guard<std::mutex> lock(mutex_);
         ackMessage_ = response;
@@ -214,6 +225,7 @@ TEST_CASE("RendererClient connects, sends hello, and acknowledges commands", "[r
     return;
   }
   projection::renderer::RendererClient client(handler, "127.0.0.1", server.port(), "studio-a", true);
+  client.setLabels("zone-a", {"left", "upper"});
 
   client.start();
   REQUIRE(handler.waitForMessage());
@@ -222,6 +234,8 @@ TEST_CASE("RendererClient connects, sends hello, and acknowledges commands", "[r
   REQUIRE(hello.type == RendererMessageType::Hello);
   REQUIRE(hello.hello.has_value());
   REQUIRE(hello.hello->name == "studio-a");
+  REQUIRE(hello.hello->group == "zone-a");
+  REQUIRE((hello.hello->tags == std::vector<std::string>{"left", "upper"}));
 
   auto received = handler.lastMessage();
   REQUIRE(received.has_value());
@@ -234,5 +248,14 @@ TEST_CASE("RendererClient connects, sends hello, and acknowledges commands", "[r
   REQUIRE(ack.type == RendererMessageType::Ack);
   REQUIRE(ack.commandId == "cmd-load");
 
+  // The first clock probe goes out right after the handshake; server and client share a clock.
+  for (int i = 0; i < 100 && !client.clockSync().synchronized; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  const auto sync = client.clockSync();
+  REQUIRE(sync.synchronized);
+  REQUIRE(sync.offsetMicros > -5000);
+  REQUIRE(sync.offsetMicros < 5000);
+
   client.stop();
 }
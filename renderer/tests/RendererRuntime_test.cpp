@@ -0,0 +1,391 @@
+#include "RendererRuntime.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <projection/core/Feed.h>
+#include <projection/core/Scene.h>
+#include <projection/core/Surface.h>
+
+#include "video/StubVideoSource.h"
+
+using projection::core::Feed;
+using projection::core::FeedId;
+using projection::core::FeedType;
+using projection::core::LoadSceneDefinitionMessage;
+using projection::core::RendererMessage;
+using projection::core::RendererMessageType;
+using projection::core::Scene;
+using projection::core::SceneId;
+using projection::core::Surface;
+using projection::core::SurfaceId;
+using projection::core::Vec2;
+using projection::renderer::RendererRuntime;
+using projection::renderer::StubVideoSource;
+using projection::renderer::makeStubVideoSourceFactory;
+
+namespace {
+RendererMessage makeLoadSceneDefinition(std::vector<Surface> surfaces, std::vector<Feed> feeds) {
+  RendererMessage message{};
+  message.type = RendererMessageType::LoadSceneDefinition;
+  message.commandId = "cmd-1";
+  message.loadSceneDefinition =
+      LoadSceneDefinitionMessage{Scene{SceneId{"scene-1"}, "Scene", "desc", std::move(surfaces)}, std::move(feeds)};
+  return message;
+}
+
+bool near(float a, float b) { return std::fabs(a - b) < 1e-4f; }
+}  // namespace
+
+TEST_CASE("RendererRuntime applies queued scene definitions on update", "[renderer][runtime]") {
+  RendererRuntime runtime(makeStubVideoSourceFactory());
+  Surface surface{SurfaceId{"s1"}, "S1", {Vec2{-1, -1}, Vec2{1, -1}, Vec2{1, 1}}, FeedId{"video1"}};
+  runtime.handle(makeLoadSceneDefinition(
+      {surface}, {projection::core::makeVideoFileFeed(FeedId{"video1"}, "Video 1", "/media/video1.mp4")}));
+
+  // Nothing is applied until the render thread drains the queue.
+  REQUIRE(runtime.renderState().videoFeeds().empty());
+  REQUIRE(runtime.messageQueue().size() == 1);
+
+  runtime.update(0.5);
+  REQUIRE(runtime.messageQueue().empty());
+  REQUIRE(runtime.status().sceneId == "scene-1");
+  REQUIRE(runtime.frameCount() == 1);
+  REQUIRE(runtime.elapsedSeconds() == 0.5);
+
+  const auto& feeds = runtime.renderState().videoFeeds();
+  REQUIRE(feeds.size() == 1);
+  const auto& source = static_cast<const StubVideoSource&>(*feeds.at("video1").source);
+  REQUIRE(source.isLoaded());
+  REQUIRE(source.playing());
+  REQUIRE(source.updateCount() == 1);
+}
+
+TEST_CASE("RendererRuntime prepareFrame maps surfaces to pixels and modulates alpha", "[renderer][runtime]") {
+  RendererRuntime runtime(makeStubVideoSourceFactory());
+  Surface quad{SurfaceId{"quad"}, "Quad", {Vec2{-1, -1}, Vec2{0, -1}, Vec2{0, 0}, Vec2{-1, 0}}, FeedId{"video1"},
+               0.8f, 0.5f};
+  Surface orphan{SurfaceId{"orphan"}, "No feed", {Vec2{0, 0}, Vec2{1, 0}, Vec2{1, 1}}, FeedId{"camera"}};
+  runtime.handle(makeLoadSceneDefinition(
+      {quad, orphan}, {projection::core::makeVideoFileFeed(FeedId{"video1"}, "Video 1", "/media/video1.mp4"),
+                       Feed{FeedId{"camera"}, "Camera", FeedType::Camera, "{}"}}));
+  runtime.update(1.0 / 60.0);
+  runtime.setMidiBrightness(0.5f);
+
+  const auto& drawList = runtime.prepareFrame(200.0f, 100.0f).surfaces;
+  REQUIRE(drawList.size() == 1);
+  const auto& draw = drawList.front();
+  REQUIRE(draw.surfaceId == "quad");
+  REQUIRE(draw.positions.size() == 4);
+  REQUIRE(near(draw.positions[0].x, 0.0f));
+  REQUIRE(near(draw.positions[0].y, 0.0f));
+  REQUIRE(near(draw.positions[2].x, 100.0f));
+  REQUIRE(near(draw.positions[2].y, 50.0f));
+  REQUIRE(near(draw.texCoords[0].x, 0.0f));
+  REQUIRE(near(draw.texCoords[2].x, 1.0f));
+  REQUIRE(near(draw.texCoords[2].y, 1.0f));
+  REQUIRE(near(draw.alpha, 0.4f));
+  REQUIRE(near(draw.brightness, 0.5f));
+
+  // Re-preparing reuses the same entries.
+  const auto* firstData = drawList.data();
+  REQUIRE(runtime.prepareFrame(200.0f, 100.0f).surfaces.data() == firstData);
+}
+
+TEST_CASE("RendererRuntime reports invalid scenes as errors instead of throwing", "[renderer][runtime][error]") {
+  RendererRuntime runtime(makeStubVideoSourceFactory());
+  runtime.handle(makeLoadSceneDefinition({}, {Feed{FeedId{"broken"}, "Broken", FeedType::VideoFile, "{}"}}));
+  runtime.update(0.0);
+
+  REQUIRE(!runtime.status().lastError.empty());
+  REQUIRE(runtime.status().sceneId.empty());
+}
+
+TEST_CASE("RendererRuntime rejects messages when the queue is full", "[renderer][runtime][error]") {
+  RendererRuntime runtime(makeStubVideoSourceFactory());
+  RendererMessage hello{};
+  hello.type = RendererMessageType::Hello;
+  hello.commandId = "hello";
+  hello.hello = projection::core::HelloMessage{"1.0", "renderer", "test"};
+
+  bool threw = false;
+  try {
+    for (size_t i = 0; i <= runtime.messageQueue().capacity(); ++i) {
+      runtime.handle(hello);
+    }
+  } catch (const std::exception&) {
+    threw = true;
+  }
+  REQUIRE(threw);
+  REQUIRE(runtime.messageQueue().rejectedCount() == 1);
+}
+
+TEST_CASE("RendererRuntime applies scheduled messages on the first frame at or after executeAt",
+          "[renderer][runtime][schedule]") {
+  RendererRuntime runtime(makeStubVideoSourceFactory());
+  auto loadScene = [&](const std::string& commandId, const std::string& sceneId, int64_t executeAt) {
+    RendererMessage message{};
+    message.type = RendererMessageType::LoadScene;
+    message.commandId = commandId;
+    message.executeAt = executeAt;
+    message.loadScene = projection::core::LoadSceneMessage{SceneId{sceneId}};
+    runtime.handle(std::move(message));
+  };
+  // Queued out of order; the later one must not overtake the earlier.
+  loadScene("late", "scene-late", 50000);
+  loadScene("early", "scene-early", 20000);
+
+  runtime.update(1.0 / 60.0, 0);
+  REQUIRE(runtime.scheduledCount() == 2);
+  REQUIRE(runtime.status().sceneId.empty());
+
+  runtime.update(1.0 / 60.0, 16667);
+  REQUIRE(runtime.status().sceneId.empty());
+
+  runtime.update(1.0 / 60.0, 33333);
+  REQUIRE(runtime.status().sceneId == "scene-early");
+  REQUIRE(runtime.scheduledCount() == 1);
+  REQUIRE(near(static_cast<float>(runtime.lastScheduleLatenessMs()), 13.333f));
+  REQUIRE(runtime.lastScheduledFrameMicros() == 33333);
+
+  // Unscheduled and already-due messages apply immediately.
+  loadScene("past", "scene-past", 1000);
+  runtime.update(1.0 / 60.0, 40000);
+  REQUIRE(runtime.status().sceneId == "scene-past");
+
+  runtime.update(1.0 / 60.0, 50000);
+  REQUIRE(runtime.status().sceneId == "scene-late");
+  REQUIRE(runtime.scheduledCount() == 0);
+  REQUIRE(runtime.lastScheduleLatenessMs() == 0.0);
+}
+
+TEST_CASE("RendererRuntime coalesces scene loads and surface updates due in one frame",
+          "[renderer][runtime][coalesce]") {
+  int created = 0;
+  RendererRuntime runtime([&created]() -> std::unique_ptr<projection::renderer::VideoSource> {
+    ++created;
+    return std::make_unique<StubVideoSource>();
+  });
+  auto setFeed = [&](const std::string& commandId, const std::string& surfaceId, const std::string& feedId) {
+    RendererMessage message{};
+    message.type = RendererMessageType::SetFeedForSurface;
+    message.commandId = commandId;
+    message.setFeedForSurface = projection::core::SetFeedForSurfaceMessage{SurfaceId{surfaceId}, FeedId{feedId}};
+    runtime.handle(std::move(message));
+  };
+
+  // A dragged slider: ten full scene loads within one frame interval, the last one wins.
+  setFeed("stale", "s1", "video1");
+  for (int i = 0; i < 10; ++i) {
+    auto message = makeLoadSceneDefinition(
+        {Surface{SurfaceId{"s1"}, "S1", {Vec2{-1, -1}, Vec2{1, -1}, Vec2{1, 1}}, FeedId{"video1"}, 0.1f * i}},
+        {projection::core::makeVideoFileFeed(FeedId{"video1"}, "Video 1", "/media/video1.mp4")});
+    message.commandId = "load-" + std::to_string(i);
+    runtime.handle(std::move(message));
+  }
+  setFeed("a", "s1", "video1");
+  setFeed("b", "s2", "video1");
+  setFeed("c", "s1", "video2");
+
+  runtime.update(1.0 / 60.0);
+  REQUIRE(created == 1);
+  REQUIRE(near(runtime.renderState().currentScene().getSurfaces().front().getOpacity(), 0.9f));
+  // The newest update for s1 is applied last.
+  REQUIRE(runtime.status().lastCommand.find("(#c)") != std::string::npos);
+
+  const auto& stats = runtime.coalescingStats();
+  REQUIRE(stats.received == 14);
+  REQUIRE(stats.applied == 3);
+  REQUIRE(stats.sceneLoadsSuperseded == 9);
+  REQUIRE(stats.surfaceUpdatesMerged == 2);
+  REQUIRE(stats.largestBatch == 14);
+
+  // Messages in different frames are never merged.
+  setFeed("d", "s1", "video1");
+  runtime.update(1.0 / 60.0);
+  setFeed("e", "s1", "video1");
+  runtime.update(1.0 / 60.0);
+  REQUIRE(stats.applied == 5);
+  REQUIRE(stats.coalesced() == 11);
+}
+
+TEST_CASE("RendererRuntime applies surface params in place without reloading feeds",
+          "[renderer][runtime][surfaceParams]") {
+  int created = 0;
+  RendererRuntime runtime([&created]() -> std::unique_ptr<projection::renderer::VideoSource> {
+    ++created;
+    return std::make_unique<StubVideoSource>();
+  });
+  const std::vector<Vec2> left{Vec2{-1, -1}, Vec2{0, -1}, Vec2{0, 1}, Vec2{-1, 1}};
+  const std::vector<Vec2> right{Vec2{0, -1}, Vec2{1, -1}, Vec2{1, 1}, Vec2{0, 1}};
+  runtime.handle(makeLoadSceneDefinition(
+      {Surface{SurfaceId{"a"}, "A", left, FeedId{"video1"}}, Surface{SurfaceId{"b"}, "B", right, FeedId{"video1"}}},
+      {projection::core::makeVideoFileFeed(FeedId{"video1"}, "Video 1", "/media/video1.mp4"),
+       projection::core::makeVideoFileFeed(FeedId{"video2"}, "Video 2", "/media/video2.mp4")}));
+  runtime.update(1.0 / 60.0);
+  REQUIRE(created == 2);
+  REQUIRE(runtime.prepareFrame(200.0f, 100.0f).surfaces.front().surfaceId == "a");
+
+  auto sendParams = [&](const std::string& commandId, std::vector<projection::core::SurfaceParams> updates) {
+    RendererMessage message{};
+    message.type = RendererMessageType::UpdateSurfaceParams;
+    message.commandId = commandId;
+    message.updateSurfaceParams = projection::core::UpdateSurfaceParamsMessage{std::move(updates)};
+    runtime.handle(std::move(message));
+  };
+  projection::core::SurfaceParams fade;
+  fade.surfaceId = SurfaceId{"a"};
+  fade.opacity = 0.2f;
+  projection::core::SurfaceParams fadeMore;
+  fadeMore.surfaceId = SurfaceId{"a"};
+  fadeMore.opacity = 0.6f;
+  projection::core::SurfaceParams raise;
+  raise.surfaceId = SurfaceId{"a"};
+  raise.zOrder = 5;
+  raise.feedId = FeedId{"video2"};
+  sendParams("p1", {fade});
+  sendParams("p2", {raise, fadeMore});
+  runtime.update(1.0 / 60.0);
+
+  REQUIRE(created == 2);
+  REQUIRE(runtime.status().lastError.empty());
+  REQUIRE(runtime.coalescingStats().surfaceUpdatesMerged == 1);
+  const auto& draws = runtime.prepareFrame(200.0f, 100.0f).surfaces;
+  REQUIRE(draws.size() == 2);
+  REQUIRE(draws.back().surfaceId == "a");
+  REQUIRE(draws.back().feedId == "video2");
+  REQUIRE(near(draws.back().alpha, 0.6f));
+
+  // Valid updates in a batch still apply when another one is rejected.
+  projection::core::SurfaceParams unknown;
+  unknown.surfaceId = SurfaceId{"missing"};
+  unknown.brightness = 0.5f;
+  projection::core::SurfaceParams dim;
+  dim.surfaceId = SurfaceId{"b"};
+  dim.brightness = 0.25f;
+  sendParams("p3", {unknown, dim});
+  runtime.update(1.0 / 60.0);
+  REQUIRE(runtime.status().lastError.find("Surface not found: missing") != std::string::npos);
+  REQUIRE(near(runtime.renderState().currentScene().getSurfaces()[1].getBrightness(), 0.25f));
+}
+
+TEST_CASE("RendererRuntime does not merge surface updates across a cue in one frame",
+          "[renderer][runtime][coalesce][cue]") {
+  RendererRuntime runtime([]() -> std::unique_ptr<projection::renderer::VideoSource> {
+    return std::make_unique<StubVideoSource>();
+  });
+  const std::vector<Vec2> quad{Vec2{-1, -1}, Vec2{1, -1}, Vec2{1, 1}, Vec2{-1, 1}};
+  const auto feed = projection::core::makeVideoFileFeed(FeedId{"video1"}, "Video 1", "/media/video1.mp4");
+  runtime.handle(makeLoadSceneDefinition(
+      {Surface{SurfaceId{"s1"}, "S1", quad, FeedId{"video1"}}, Surface{SurfaceId{"s2"}, "S2", quad, FeedId{"video1"}}},
+      {feed}));
+  projection::core::Cue full(projection::core::CueId{"full"}, "Full", SceneId{"scene-1"});
+  full.getSurfaceOpacities()[SurfaceId{"s1"}] = 1.0f;
+  projection::core::Cue finale(projection::core::CueId{"finale"}, "Finale", SceneId{"scene-2"});
+  Scene second{SceneId{"scene-2"}, "Second", "", {Surface{SurfaceId{"big"}, "Big", quad, FeedId{"video1"}}}};
+  RendererMessage table{};
+  table.type = RendererMessageType::LoadCueTable;
+  table.commandId = "cues";
+  table.cueTable = projection::core::CueTableMessage{};
+  table.cueTable->cues = {full, finale};
+  table.cueTable->scenes = {LoadSceneDefinitionMessage{second, {feed}}};
+  runtime.handle(std::move(table));
+  runtime.update(1.0 / 60.0);
+
+  auto sendOpacity = [&](const std::string& commandId, const std::string& surfaceId, float opacity) {
+    projection::core::SurfaceParams params;
+    params.surfaceId = SurfaceId{surfaceId};
+    params.opacity = opacity;
+    RendererMessage message{};
+    message.type = RendererMessageType::UpdateSurfaceParams;
+    message.commandId = commandId;
+    message.updateSurfaceParams = projection::core::UpdateSurfaceParamsMessage{{params}};
+    runtime.handle(std::move(message));
+  };
+  auto sendCue = [&](const std::string& cueId) {
+    RendererMessage message{};
+    message.type = RendererMessageType::PlayCue;
+    message.commandId = "play-" + cueId;
+    message.playCue = projection::core::PlayCueMessage{projection::core::CueId{cueId}};
+    runtime.handle(std::move(message));
+  };
+
+  // The cue's override lands after the earlier fade, not before it.
+  sendOpacity("p1", "s1", 0.2f);
+  sendCue("full");
+  sendOpacity("p2", "s2", 0.5f);
+  runtime.update(1.0 / 60.0);
+  REQUIRE(runtime.status().lastError.empty());
+  REQUIRE(runtime.coalescingStats().surfaceUpdatesMerged == 0);
+  const auto& surfaces = runtime.renderState().currentScene().getSurfaces();
+  REQUIRE(near(surfaces[0].getOpacity(), 1.0f));
+  REQUIRE(near(surfaces[1].getOpacity(), 0.5f));
+
+  // An update for the old scene stays on the old scene when a cue switches scenes.
+  sendOpacity("p3", "s1", 0.3f);
+  sendCue("finale");
+  sendOpacity("p4", "big", 0.4f);
+  runtime.update(1.0 / 60.0);
+  REQUIRE(runtime.status().lastError.empty());
+  REQUIRE(runtime.status().sceneId == "scene-2");
+  REQUIRE(near(runtime.renderState().currentScene().getSurfaces()[0].getOpacity(), 0.4f));
+}
+
+TEST_CASE("RendererRuntime plays cues from the cached cue table", "[renderer][runtime][cue]") {
+  int created = 0;
+  RendererRuntime runtime([&created]() -> std::unique_ptr<projection::renderer::VideoSource> {
+    ++created;
+    return std::make_unique<StubVideoSource>();
+  });
+  const std::vector<Vec2> quad{Vec2{-1, -1}, Vec2{1, -1}, Vec2{1, 1}, Vec2{-1, 1}};
+  const auto feed = projection::core::makeVideoFileFeed(FeedId{"video1"}, "Video 1", "/media/video1.mp4");
+  runtime.handle(makeLoadSceneDefinition({Surface{SurfaceId{"s1"}, "S1", quad, FeedId{"video1"}}}, {feed}));
+
+  projection::core::Cue dim(projection::core::CueId{"dim"}, "Dim", SceneId{"scene-1"});
+  dim.getSurfaceOpacities()[SurfaceId{"s1"}] = 0.25f;
+  projection::core::Cue finale(projection::core::CueId{"finale"}, "Finale", SceneId{"scene-2"});
+  finale.getSurfaceBrightnesses()[SurfaceId{"big"}] = 0.5f;
+  Scene second{SceneId{"scene-2"}, "Second", "", {Surface{SurfaceId{"big"}, "Big", quad, FeedId{"video1"}}}};
+  RendererMessage table{};
+  table.type = RendererMessageType::LoadCueTable;
+  table.commandId = "cues";
+  table.cueTable = projection::core::CueTableMessage{};
+  table.cueTable->cues = {dim, finale};
+  table.cueTable->scenes = {LoadSceneDefinitionMessage{second, {feed}}};
+  runtime.handle(std::move(table));
+  runtime.update(1.0 / 60.0);
+  REQUIRE(runtime.renderState().cachedCueCount() == 2);
+  REQUIRE(created == 1);
+
+  auto playCue = [&](const std::string& cueId) {
+    RendererMessage message{};
+    message.type = RendererMessageType::PlayCue;
+    message.commandId = "play-" + cueId;
+    message.playCue = projection::core::PlayCueMessage{projection::core::CueId{cueId}};
+    runtime.handle(std::move(message));
+    runtime.update(1.0 / 60.0);
+  };
+
+  // Same scene: overrides only, no reload.
+  playCue("dim");
+  REQUIRE(runtime.status().lastError.empty());
+  REQUIRE(created == 1);
+  REQUIRE(near(runtime.renderState().currentScene().getSurfaces()[0].getOpacity(), 0.25f));
+
+  // Other scene: switches from the cached definition, then applies overrides.
+  playCue("finale");
+  REQUIRE(runtime.status().lastError.empty());
+  REQUIRE(runtime.status().sceneId == "scene-2");
+  // Both scenes play the same file, so its player is reused instead of reopened.
+  REQUIRE(created == 1);
+  REQUIRE(near(runtime.renderState().currentScene().getSurfaces()[0].getBrightness(), 0.5f));
+
+  playCue("unknown");
+  REQUIRE(runtime.status().lastError == "PlayCue failed: Cue not cached: unknown");
+  REQUIRE(runtime.status().sceneId == "scene-2");
+}
@@ -0,0 +1,107 @@
+#include "audio/SampleRingBuffer.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+using projection::renderer::SampleRingBuffer;
+
+namespace {
+// Counts heap allocations made by threads that opted in via countAllocations.
+thread_local bool countAllocations = false;
+std::atomic<size_t> countedAllocations{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+  if (countAllocations) {
+    countedAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+TEST_CASE("SampleRingBuffer downmixes interleaved frames to mono", "[renderer][audio]") {
+  SampleRingBuffer ring(8);
+  const float stereo[] = {1.0f, 0.0f, 0.5f, 0.5f, -1.0f, -0.5f};
+  ring.writeInterleaved(stereo, 3, 2);
+
+  float out[3] = {};
+  REQUIRE(ring.readLatest(out, 3) == 3);
+  REQUIRE(std::abs(out[0] - 0.5f) < 1e-6f);
+  REQUIRE(std::abs(out[1] - 0.5f) < 1e-6f);
+  REQUIRE(std::abs(out[2] + 0.75f) < 1e-6f);
+}
+
+TEST_CASE("SampleRingBuffer readLatest returns the newest window after wraparound", "[renderer][audio]") {
+  SampleRingBuffer ring(8);
+  std::vector<float> samples(20);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    samples[i] = static_cast<float>(i);
+  }
+  ring.write(samples.data(), samples.size());
+
+  std::vector<float> out(16, -1.0f);
+  REQUIRE(ring.readLatest(out.data(), out.size()) == 8);
+  for (size_t i = 0; i < 8; ++i) {
+    REQUIRE(out[i] == static_cast<float>(12 + i));
+  }
+  REQUIRE(ring.totalWritten() == 20);
+}
+
+TEST_CASE("SampleRingBuffer read consumes in order and reports overruns", "[renderer][audio]") {
+  SampleRingBuffer ring(8);
+  std::vector<float> samples(12);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    samples[i] = static_cast<float>(i);
+  }
+
+  ring.write(samples.data(), 4);
+  float out[8] = {};
+  REQUIRE(ring.read(out, 8) == 4);
+  REQUIRE(out[3] == 3.0f);
+  REQUIRE(ring.read(out, 8) == 0);
+
+  // Twelve more samples into an eight-slot ring: the reader lost four.
+  ring.write(samples.data(), 12);
+  REQUIRE(ring.read(out, 8) == 8);
+  REQUIRE(out[0] == 4.0f);
+  REQUIRE(out[7] == 11.0f);
+  REQUIRE(ring.overrunSamples() == 4);
+}
+
+TEST_CASE("SampleRingBuffer writer never allocates on the audio thread", "[renderer][audio]") {
+  SampleRingBuffer ring(4096);
+  std::vector<float> block(512 * 2, 0.25f);
+  countedAllocations = 0;
+
+  std::thread audioThread([&ring, &block] {
+    countAllocations = true;
+    for (int callback = 0; callback < 1000; ++callback) {
+      ring.writeInterleaved(block.data(), 512, 2);
+    }
+    countAllocations = false;
+  });
+
+  std::vector<float> window(512);
+  size_t reads = 0;
+  for (int i = 0; i < 200; ++i) {
+    reads += ring.readLatest(window.data(), window.size());
+  }
+  audioThread.join();
+
+  REQUIRE(countedAllocations.load() == 0);
+  REQUIRE(ring.totalWritten() == 512u * 1000u);
+  REQUIRE(ring.readLatest(window.data(), window.size()) == 512);
+  REQUIRE(std::abs(window[0] - 0.25f) < 1e-6f);
+  (void)reads;
+}
@@ -0,0 +1,261 @@
+#include "SceneSnapshot.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <projection/core/Feed.h>
+#include <projection/core/Scene.h>
+#include <projection/core/Surface.h>
+
+#include "RendererRuntime.h"
+#include "video/StubVideoSource.h"
+
+using projection::core::Cue;
+using projection::core::CueId;
+using projection::core::CueTableMessage;
+using projection::core::FeedId;
+using projection::core::LoadSceneDefinitionMessage;
+using projection::core::RendererMessage;
+using projection::core::RendererMessageType;
+using projection::core::Scene;
+using projection::core::SceneId;
+using projection::core::Surface;
+using projection::core::SurfaceId;
+using projection::core::Vec2;
+using projection::renderer::RendererRuntime;
+using projection::renderer::SceneSnapshot;
+using projection::renderer::SceneSnapshotWriter;
+using projection::renderer::decodeSceneSnapshot;
+using projection::renderer::encodeSceneSnapshot;
+using projection::renderer::makeStubVideoSourceFactory;
+using projection::renderer::readSceneSnapshotFile;
+using projection::renderer::writeFileAtomically;
+
+namespace {
+LoadSceneDefinitionMessage makeDefinition(const std::string& sceneId, const std::string& file) {
+  Surface quad{SurfaceId{"quad"}, "Quad", {Vec2{-1, -1}, Vec2{0, -1}, Vec2{0, 0}, Vec2{-1, 0}}, FeedId{"video1"}};
+  return LoadSceneDefinitionMessage{Scene{SceneId{sceneId}, "Scene", "", {quad}},
+                                    {projection::core::makeVideoFileFeed(FeedId{"video1"}, "Video", file)}};
+}
+
+RendererMessage makeLoad(const LoadSceneDefinitionMessage& definition, const std::string& commandId) {
+  RendererMessage message{};
+  message.type = RendererMessageType::LoadSceneDefinition;
+  message.commandId = commandId;
+  message.loadSceneDefinition = definition;
+  return message;
+}
+
+SceneSnapshot makeSnapshot() {
+  SceneSnapshot snapshot;
+  snapshot.scene = makeDefinition("scene-1", "/media/a.mp4");
+  CueTableMessage table;
+  table.cues.push_back(Cue{CueId{"cue-1"}, "Cue", SceneId{"scene-2"}});
+  table.scenes.push_back(makeDefinition("scene-2", "/media/b.mp4"));
+  table.settings = projection::core::ProjectSettings{};
+  table.settings->midiChannels = {4};
+  snapshot.cueTable = std::make_shared<const CueTableMessage>(table);
+  return snapshot;
+}
+
+std::string tempPath(const std::string& name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+}  // namespace
+
+TEST_CASE("Scene snapshots round trip and reject damaged data", "[renderer][snapshot]") {
+  const SceneSnapshot snapshot = makeSnapshot();
+  const auto bytes = encodeSceneSnapshot(snapshot);
+  REQUIRE(std::string(bytes.begin(), bytes.begin() + 8) == "LUMISNAP");
+
+  SceneSnapshot decoded;
+  std::string error;
+  REQUIRE(decodeSceneSnapshot(bytes.data(), bytes.size(), decoded, error));
+  REQUIRE(decoded.scene == snapshot.scene);
+  REQUIRE(decoded.cueTable);
+  REQUIRE(*decoded.cueTable == *snapshot.cueTable);
+
+  // Every kind of damage is refused and leaves the output alone.
+  SceneSnapshot untouched;
+  auto flipped = bytes;
+  flipped.back() ^= 0x40;
+  REQUIRE(!decodeSceneSnapshot(flipped.data(), flipped.size(), untouched, error));
+  REQUIRE(error.find("checksum") != std::string::npos);
+  REQUIRE(!decodeSceneSnapshot(bytes.data(), bytes.size() - 1, untouched, error));
+  REQUIRE(!decodeSceneSnapshot(bytes.data(), 16, untouched, error));
+  auto newer = bytes;
+  newer[8] = 99;
+  REQUIRE(!decodeSceneSnapshot(newer.data(), newer.size(), untouched, error));
+  REQUIRE(error.find("version") != std::string::npos);
+  REQUIRE(untouched.empty());
+
+  // An empty snapshot is valid.
+  const auto empty = encodeSceneSnapshot(SceneSnapshot{});
+  REQUIRE(decodeSceneSnapshot(empty.data(), empty.size(), decoded, error));
+  REQUIRE(decoded.empty());
+}
+
+TEST_CASE("Scene snapshot files are replaced atomically", "[renderer][snapshot]") {
+  const std::string path = tempPath("lumi_snapshot_atomic.bin");
+  std::filesystem::remove(path);
+  std::string error;
+  REQUIRE(writeFileAtomically(path, encodeSceneSnapshot(makeSnapshot()), error));
+  REQUIRE(!std::filesystem::exists(path + ".tmp"));
+
+  SceneSnapshot restored;
+  REQUIRE(readSceneSnapshotFile(path, restored, error));
+  REQUIRE(restored.scene->scene.getId().value == "scene-1");
+
+  REQUIRE(!writeFileAtomically("/nonexistent-dir/snapshot.bin", {1, 2, 3}, error));
+  REQUIRE(!error.empty());
+  REQUIRE(!readSceneSnapshotFile(path + ".missing", restored, error));
+
+  // A torn file (as a crash mid-write of a non-atomic writer would leave) is refused.
+  {
+    std::ofstream torn(path, std::ios::binary | std::ios::trunc);
+    torn << "LUMISNAP";
+  }
+  REQUIRE(!readSceneSnapshotFile(path, restored, error));
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("SceneSnapshotWriter keeps only the newest pending snapshot", "[renderer][snapshot]") {
+  const std::string path = tempPath("lumi_snapshot_writer.bin");
+  std::filesystem::remove(path);
+  {
+    SceneSnapshotWriter writer(path);
+    for (int i = 0; i < 20; ++i) {
+      SceneSnapshot snapshot;
+      snapshot.scene = makeDefinition("scene-" + std::to_string(i), "/media/a.mp4");
+      writer.submit(std::move(snapshot));
+    }
+    writer.flush();
+    const auto stats = writer.stats();
+    REQUIRE(stats.submitted == 20);
+    REQUIRE(stats.written + stats.superseded == 20);
+    REQUIRE(stats.written >= 1);
+    REQUIRE(stats.failed == 0);
+    REQUIRE(stats.lastBytes > 32);
+  }
+  SceneSnapshot restored;
+  std::string error;
+  REQUIRE(readSceneSnapshotFile(path, restored, error));
+  REQUIRE(restored.scene->scene.getId().value == "scene-19");
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("RendererRuntime persists its scene and restores it on the next start", "[renderer][snapshot][runtime]") {
+  const std::string path = tempPath("lumi_snapshot_runtime.bin");
+  std::filesystem::remove(path);
+  const auto definition = makeDefinition("scene-1", "/media/a.mp4");
+  {
+    RendererRuntime runtime(makeStubVideoSourceFactory());
+    runtime.enableSceneSnapshots(path, 1.0);
+    runtime.update(1.0 / 60.0, 1000);
+    REQUIRE(runtime.sceneSnapshotWriter()->stats().submitted == 0);
+
+    runtime.handle(makeLoad(definition, "cmd-1"));
+    runtime.update(1.0 / 60.0, 2000);
+    REQUIRE(runtime.sceneSnapshotWriter()->stats().submitted == 1);
+
+    // Changes within the interval wait for it; flushing writes them out.
+    RendererMessage table{};
+    table.type = RendererMessageType::LoadCueTable;
+    table.commandId = "cmd-2";
+    table.cueTable = CueTableMessage{};
+    runtime.handle(std::move(table));
+    runtime.update(1.0 / 60.0, 3000);
+    REQUIRE(runtime.sceneSnapshotWriter()->stats().submitted == 1);
+    runtime.flushSceneSnapshots();
+    REQUIRE(runtime.sceneSnapshotWriter()->stats().submitted == 2);
+    REQUIRE(runtime.sceneSnapshotWriter()->stats().failed == 0);
+  }
+
+  // Next start: the scene plays before any server message arrives.
+  RendererRuntime restarted(makeStubVideoSourceFactory());
+  std::string error;
+  REQUIRE(restarted.restoreSceneSnapshot(path, error));
+  REQUIRE(restarted.restoredFromSnapshot());
+  REQUIRE(restarted.status().sceneId == "scene-1");
+  restarted.update(1.0 / 60.0);
+  REQUIRE(restarted.prepareFrame(100.0f, 100.0f).surfaces.size() == 1);
+  const auto opened = restarted.renderState().videoResidency().stats().misses;
+
+  // The server confirming the same scene does not reopen anything; a different one loads.
+  restarted.handle(makeLoad(definition, "cmd-3"));
+  restarted.update(1.0 / 60.0);
+  REQUIRE(restarted.status().lastCommand.find("matches snapshot") != std::string::npos);
+  REQUIRE(restarted.renderState().videoResidency().stats().misses == opened);
+  restarted.handle(makeLoad(makeDefinition("scene-2", "/media/b.mp4"), "cmd-4"));
+  restarted.update(1.0 / 60.0);
+  REQUIRE(restarted.status().sceneId == "scene-2");
+
+  RendererRuntime missing(makeStubVideoSourceFactory());
+  REQUIRE(!missing.restoreSceneSnapshot(path + ".missing", error));
+  REQUIRE(!missing.restoredFromSnapshot());
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("RendererRuntime persists live surface changes", "[renderer][snapshot][runtime]") {
+  const std::string path = tempPath("lumi_snapshot_surfaces.bin");
+  std::filesystem::remove(path);
+  {
+    RendererRuntime runtime(makeStubVideoSourceFactory());
+    runtime.enableSceneSnapshots(path, 1.0);
+    runtime.handle(makeLoad(makeDefinition("scene-1", "/media/a.mp4"), "cmd-1"));
+    runtime.update(1.0 / 60.0, 1000);
+    REQUIRE(runtime.sceneSnapshotWriter()->stats().submitted == 1);
+
+    // Opacity changes neither the scene nor its layout, but it is part of what plays.
+    projection::core::SurfaceParams params;
+    params.surfaceId = SurfaceId{"quad"};
+    params.opacity = 0.25f;
+    RendererMessage update{};
+    update.type = RendererMessageType::UpdateSurfaceParams;
+    update.commandId = "cmd-2";
+    update.updateSurfaceParams = projection::core::UpdateSurfaceParamsMessage{{params}};
+    runtime.handle(std::move(update));
+    runtime.update(1.0 / 60.0, 2000);
+    runtime.flushSceneSnapshots();
+    REQUIRE(runtime.sceneSnapshotWriter()->stats().submitted == 2);
+  }
+
+  RendererRuntime restarted(makeStubVideoSourceFactory());
+  std::string error;
+  REQUIRE(restarted.restoreSceneSnapshot(path, error));
+  REQUIRE(restarted.renderState().currentScene().getSurfaces().front().getOpacity() == 0.25f);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("RendererRuntime leaves its state alone when a snapshot's scene is rejected", "[renderer][snapshot][runtime]") {
+  const std::string path = tempPath("lumi_snapshot_bad_scene.bin");
+  SceneSnapshot snapshot = makeSnapshot();
+  // Decodes fine, but the feed config has no file to play.
+  snapshot.scene->feeds = {projection::core::Feed(FeedId{"video1"}, "Video", projection::core::FeedType::VideoFile, "{}")};
+  std::string error;
+  REQUIRE(writeFileAtomically(path, encodeSceneSnapshot(snapshot), error));
+
+  RendererRuntime runtime(makeStubVideoSourceFactory());
+  REQUIRE(!runtime.restoreSceneSnapshot(path, error));
+  REQUIRE(error.find("filePath") != std::string::npos);
+  REQUIRE(!runtime.restoredFromSnapshot());
+  REQUIRE(runtime.renderState().cachedCueCount() == 0);
+  REQUIRE(runtime.renderState().currentScene().getId().value.empty());
+
+  // The server's cue table is loaded, not taken for the one the snapshot held.
+  RendererMessage table{};
+  table.type = RendererMessageType::LoadCueTable;
+  table.commandId = "cmd-cues";
+  table.cueTable = *snapshot.cueTable;
+  runtime.handle(std::move(table));
+  runtime.update(1.0 / 60.0);
+  REQUIRE(runtime.status().lastCommand.find("matches snapshot") == std::string::npos);
+  REQUIRE(runtime.renderState().cachedCueCount() == 1);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,153 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <projection/core/RendererProtocol.h>
+
+#include "RendererRuntime.h"
+#include "net/RendererClient.h"
+#include "renderer/RendererRegistry.h"
+#include "video/StubVideoSource.h"
+
+using projection::core::RendererMessage;
+using projection::core::RendererMessageType;
+using projection::renderer::RendererClient;
+using projection::renderer::RendererRuntime;
+using projection::server::renderer::RendererRegistry;
+
+namespace {
+constexpr auto kFrame = std::chrono::microseconds(16667);
+
+// One renderer process in miniature: runtime, server connection and a 60 Hz render loop.
+struct LocalRenderer {
+  explicit LocalRenderer(const std::string& name, int port)
+      : runtime(projection::renderer::makeStubVideoSourceFactory()), client(runtime, "127.0.0.1", port, name) {
+    client.start();
+    loop = std::thread([this] {
+      auto next = std::chrono::steady_clock::now();
+      while (!stop) {
+        runtime.update(1.0 / 60.0);
+        next += kFrame;
+        std::this_thread::sleep_until(next);
+      }
+    });
+  }
+
+  ~LocalRenderer() {
+    halt();
+    client.stop();
+  }
+
+  // Stops the render loop so runtime state can be read from the test thread.
+  void halt() {
+    stop = true;
+    if (loop.joinable()) {
+      loop.join();
+    }
+  }
+
+  RendererRuntime runtime;
+  RendererClient client;
+  std::atomic<bool> stop{false};
+  std::thread loop;
+};
+
+template <typename Predicate>
+bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(3000)) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (predicate()) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return predicate();
+}
+}  // namespace
+
+TEST_CASE("Scheduled broadcasts apply on the same frame across renderers", "[renderer][timesync][integration]") {
+  RendererRegistry registry;
+  registry.setScheduleLeadTime(std::chrono::milliseconds(150));
+  registry.start(0);
+  REQUIRE(waitFor([&] { return registry.port() != 0; }));
+
+  std::vector<std::unique_ptr<LocalRenderer>> renderers;
+  for (const char* name : {"left", "centre", "right"}) {
+    renderers.push_back(std::make_unique<LocalRenderer>(name, registry.port()));
+  }
+  REQUIRE(waitFor([&] { return registry.rendererCount() == renderers.size(); }));
+  REQUIRE(waitFor([&] {
+    return std::all_of(renderers.begin(), renderers.end(),
+                       [](const auto& r) { return r->client.clockSync().samples >= 3; });
+  }));
+
+  RendererMessage message{};
+  message.type = RendererMessageType::LoadScene;
+  message.commandId = "cmd-aligned";
+  message.loadScene = projection::core::LoadSceneMessage{projection::core::SceneId{"aligned"}};
+  REQUIRE(registry.broadcastMessage(message) == renderers.size());
+
+  // Delivered well before the deadline but held back until it.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  for (const auto& r : renderers) {
+    REQUIRE(r->runtime.status().sceneId.empty());
+  }
+  REQUIRE(waitFor([&] {
+    return std::all_of(renderers.begin(), renderers.end(),
+                       [](const auto& r) { return r->runtime.status().sceneId == "aligned"; });
+  }));
+
+  std::vector<int64_t> appliedAt;
+  for (auto& r : renderers) {
+    r->halt();
+    appliedAt.push_back(r->runtime.lastScheduledFrameMicros());
+    // Each renderer applies on its first frame at or after the deadline. The slack covers
+    // sleep_until overshoot on a loaded machine.
+    REQUIRE(r->runtime.lastScheduleLatenessMs() >= 0.0);
+    REQUIRE(r->runtime.lastScheduleLatenessMs() < 16.7 + 10.0);
+  }
+  const auto [minIt, maxIt] = std::minmax_element(appliedAt.begin(), appliedAt.end());
+  REQUIRE(*maxIt - *minIt < kFrame.count() + 10000);
+
+  renderers.clear();
+  registry.stop();
+}
+
+TEST_CASE("Renderer acks report whether a command was applied", "[renderer][acks][integration]") {
+  RendererRegistry registry;
+  registry.start(0);
+  REQUIRE(waitFor([&] { return registry.port() != 0; }));
+  LocalRenderer renderer("stage", registry.port());
+  REQUIRE(waitFor([&] { return registry.rendererCount() == 1; }));
+
+  // Received fine, but the runtime has no cue table to play it from.
+  RendererMessage cue{};
+  cue.type = RendererMessageType::PlayCue;
+  cue.commandId = "cmd-missing-cue";
+  cue.playCue = projection::core::PlayCueMessage{projection::core::CueId{"missing"}};
+  auto command = registry.sendCommand(cue, std::chrono::milliseconds(3000));
+  REQUIRE(command != nullptr);
+  auto report = command->wait(1, std::chrono::milliseconds(3000));
+  REQUIRE(report.failed == 1);
+  REQUIRE(report.renderers[0].status == projection::server::renderer::AckStatus::Failed);
+  REQUIRE(report.renderers[0].error.find("Cue not cached: missing") != std::string::npos);
+
+  // An applied command is acked once it ran, so its effect is visible by then.
+  RendererMessage scene{};
+  scene.type = RendererMessageType::LoadScene;
+  scene.commandId = "cmd-scene";
+  scene.loadScene = projection::core::LoadSceneMessage{projection::core::SceneId{"scene-1"}};
+  command = registry.sendCommand(scene, std::chrono::milliseconds(3000));
+  REQUIRE(command != nullptr);
+  REQUIRE(command->wait(1, std::chrono::milliseconds(3000)).acked == 1);
+  REQUIRE(renderer.runtime.status().sceneId == "scene-1");
+
+  renderer.halt();
+  registry.stop();
+}
@@ -0,0 +1,71 @@
+#include "util/Seqlock.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+using projection::renderer::Seqlock;
+
+namespace {
+// Larger than one word and odd-sized, so a torn copy would show as mismatched fields.
+struct Snapshot {
+  uint64_t a{0};
+  uint64_t b{0};
+  uint32_t c{0};
+  float d{0.0f};
+  uint8_t e{0};
+};
+}  // namespace
+
+TEST_CASE("Seqlock stores and loads a snapshot", "[renderer][seqlock]") {
+  Seqlock<Snapshot> lock;
+  REQUIRE(lock.version() == 1);
+  Snapshot out;
+  REQUIRE(lock.tryLoad(out));
+  REQUIRE(out.a == 0);
+
+  lock.store(Snapshot{7, 8, 9, 1.5f, 3});
+  REQUIRE(lock.version() == 2);
+  REQUIRE(lock.tryLoad(out));
+  REQUIRE(out.a == 7);
+  REQUIRE(out.c == 9);
+  REQUIRE(out.d == 1.5f);
+  REQUIRE(out.e == 3);
+  REQUIRE(lock.load().b == 8);
+}
+
+TEST_CASE("Seqlock readers never see a torn snapshot", "[renderer][seqlock]") {
+  Seqlock<Snapshot> lock;
+  std::atomic<bool> done{false};
+  constexpr uint64_t kStores = 200000;
+  std::thread writer([&]() {
+    for (uint64_t i = 1; i <= kStores; ++i) {
+      lock.store(Snapshot{i, i * 3, static_cast<uint32_t>(i), static_cast<float>(i & 0xFFFF),
+                          static_cast<uint8_t>(i)});
+    }
+    done = true;
+  });
+
+  uint64_t loads = 0;
+  uint64_t last = 0;
+  bool consistent = true;
+  bool monotonic = true;
+  while (!done.load()) {
+    Snapshot s;
+    if (!lock.tryLoad(s)) {
+      continue;
+    }
+    ++loads;
+    consistent = consistent && s.b == s.a * 3 && s.c == static_cast<uint32_t>(s.a) &&
+                 s.d == static_cast<float>(s.a & 0xFFFF) && s.e == static_cast<uint8_t>(s.a);
+    monotonic = monotonic && s.a >= last;
+    last = s.a;
+  }
+  writer.join();
+  REQUIRE(consistent);
+  REQUIRE(monotonic);
+  REQUIRE(loads > 0);
+  REQUIRE(lock.load().a == kStores);
+}
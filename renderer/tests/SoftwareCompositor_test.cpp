@@ -0,0 +1,169 @@
+#include "compositor/SoftwareCompositor.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "compositor/BlendKernels.h"
+#include "util/WorkerPool.h"
+
+using projection::core::BlendMode;
+using projection::core::Vec2;
+using projection::renderer::CompositorLayer;
+using projection::renderer::CompositorOptions;
+using projection::renderer::RgbaImage;
+using projection::renderer::SoftwareCompositor;
+using projection::renderer::WorkerPool;
+using projection::renderer::blendSpan;
+
+namespace {
+CompositorLayer makeRect(float x0, float y0, float x1, float y1) {
+  CompositorLayer layer;
+  layer.positions = {Vec2{x0, y0}, Vec2{x1, y0}, Vec2{x1, y1}, Vec2{x0, y1}};
+  layer.texCoords = {Vec2{0, 0}, Vec2{1, 0}, Vec2{1, 1}, Vec2{0, 1}};
+  return layer;
+}
+
+bool pixelEquals(const RgbaImage& image, int x, int y, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+  const uint8_t* px = image.pixel(x, y);
+  return px[0] == r && px[1] == g && px[2] == b && px[3] == a;
+}
+}  // namespace
+
+TEST_CASE("SoftwareCompositor covers pixel centres inside the polygon exactly once", "[renderer][compositor]") {
+  RgbaImage target(8, 8);
+  // Additive at half alpha would show any pixel the two fan triangles both cover.
+  auto layer = makeRect(2.0f, 1.0f, 6.0f, 5.0f);
+  layer.alpha = 0.5f;
+  layer.blendMode = BlendMode::Additive;
+
+  SoftwareCompositor compositor;
+  compositor.composite({layer}, target);
+
+  int covered = 0;
+  for (int y = 0; y < 8; ++y) {
+    for (int x = 0; x < 8; ++x) {
+      const bool inside = x >= 2 && x < 6 && y >= 1 && y < 5;
+      if (inside) {
+        REQUIRE(pixelEquals(target, x, y, 128, 128, 128, 255));
+        ++covered;
+      } else {
+        REQUIRE(pixelEquals(target, x, y, 0, 0, 0, 255));
+      }
+    }
+  }
+  REQUIRE(covered == 16);
+}
+
+TEST_CASE("SoftwareCompositor samples textures and honors zOrder", "[renderer][compositor]") {
+  // 2x1 texture: red on the left, green on the right.
+  RgbaImage texture(2, 1);
+  texture.pixels() = {255, 0, 0, 255, 0, 255, 0, 255};
+
+  auto textured = makeRect(0.0f, 0.0f, 8.0f, 4.0f);
+  textured.texture = texture.view();
+  textured.zOrder = 0;
+
+  // Listed first but drawn last: a blue strip on top of the right half.
+  auto top = makeRect(6.0f, 0.0f, 8.0f, 4.0f);
+  top.zOrder = 5;
+  RgbaImage blue(1, 1);
+  blue.pixels() = {0, 0, 255, 255};
+  top.texture = blue.view();
+
+  RgbaImage target(8, 4);
+  SoftwareCompositor compositor;
+  compositor.composite({top, textured}, target);
+
+  REQUIRE(pixelEquals(target, 0, 0, 255, 0, 0, 255));
+  REQUIRE(pixelEquals(target, 3, 3, 255, 0, 0, 255));
+  REQUIRE(pixelEquals(target, 4, 0, 0, 255, 0, 255));
+  REQUIRE(pixelEquals(target, 5, 2, 0, 255, 0, 255));
+  REQUIRE(pixelEquals(target, 6, 1, 0, 0, 255, 255));
+  REQUIRE(pixelEquals(target, 7, 3, 0, 0, 255, 255));
+}
+
+TEST_CASE("blendSpan implements Normal, Additive and Multiply", "[renderer][compositor]") {
+  const uint8_t src[4] = {200, 100, 50, 255};
+
+  uint8_t normal[4] = {0, 0, 0, 255};
+  blendSpan(BlendMode::Normal, normal, src, 1, 255, 128, false);
+  REQUIRE(normal[0] == 100);
+  REQUIRE(normal[1] == 50);
+  REQUIRE(normal[2] == 25);
+  REQUIRE(normal[3] == 255);
+
+  uint8_t additive[4] = {100, 200, 250, 0};
+  blendSpan(BlendMode::Additive, additive, src, 1, 255, 255, false);
+  REQUIRE(additive[0] == 255);
+  REQUIRE(additive[1] == 255);
+  REQUIRE(additive[2] == 255);
+  REQUIRE(additive[3] == 255);
+
+  // Opaque multiply is src * dst; brightness scales the source first.
+  uint8_t multiply[4] = {255, 128, 0, 255};
+  blendSpan(BlendMode::Multiply, multiply, src, 1, 128, 255, false);
+  REQUIRE(multiply[0] == 100);
+  REQUIRE(multiply[1] == 25);
+  REQUIRE(multiply[2] == 0);
+  REQUIRE(multiply[3] == 255);
+}
+
+TEST_CASE("blendSpan SIMD path matches the scalar kernels bit for bit", "[renderer][compositor][simd]") {
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> byte(0, 255);
+  for (BlendMode mode : {BlendMode::Normal, BlendMode::Additive, BlendMode::Multiply}) {
+    // Odd length exercises the scalar tail after the vector loop.
+    const size_t count = 67;
+    std::vector<uint8_t> src(count * 4);
+    std::vector<uint8_t> dst(count * 4);
+    for (auto& v : src) v = static_cast<uint8_t>(byte(rng));
+    for (auto& v : dst) v = static_cast<uint8_t>(byte(rng));
+    for (int modulation : {0, 77, 255}) {
+      auto simd = dst;
+      auto scalar = dst;
+      const auto brightness = static_cast<uint8_t>(255 - modulation / 2);
+      const auto alpha = static_cast<uint8_t>(modulation);
+      blendSpan(mode, simd.data(), src.data(), count, brightness, alpha, true);
+      blendSpan(mode, scalar.data(), src.data(), count, brightness, alpha, false);
+      REQUIRE(simd == scalar);
+    }
+  }
+}
+
+TEST_CASE("SoftwareCompositor output does not depend on threading", "[renderer][compositor]") {
+  RgbaImage texture(16, 16);
+  for (size_t i = 0; i < texture.pixels().size(); ++i) {
+    texture.pixels()[i] = static_cast<uint8_t>(i * 13);
+  }
+  std::vector<CompositorLayer> layers;
+  const BlendMode modes[3] = {BlendMode::Normal, BlendMode::Additive, BlendMode::Multiply};
+  for (int i = 0; i < 6; ++i) {
+    CompositorLayer layer;
+    const float o = static_cast<float>(i) * 9.0f;
+    // Skewed quads so spans differ from row to row.
+    layer.positions = {Vec2{3.0f + o, 2.0f}, Vec2{90.0f - o, 10.0f + o}, Vec2{70.0f, 60.0f - o}, Vec2{5.0f, 50.0f}};
+    layer.texCoords = {Vec2{0, 0}, Vec2{1, 0}, Vec2{1, 1}, Vec2{0, 1}};
+    layer.texture = texture.view();
+    layer.alpha = 0.3f + 0.1f * static_cast<float>(i);
+    layer.brightness = 0.9f;
+    layer.blendMode = modes[i % 3];
+    layer.zOrder = 3 - i;
+    layers.push_back(layer);
+  }
+
+  RgbaImage single(97, 64);
+  RgbaImage threaded(97, 64);
+  RgbaImage scalar(97, 64);
+  WorkerPool pool(4);
+  CompositorOptions scalarOptions;
+  scalarOptions.useSimd = false;
+  SoftwareCompositor(nullptr).composite(layers, single);
+  SoftwareCompositor(&pool).composite(layers, threaded);
+  SoftwareCompositor(nullptr, scalarOptions).composite(layers, scalar);
+
+  REQUIRE(single.pixels() == threaded.pixels());
+  REQUIRE(single.pixels() == scalar.pixels());
+}
@@ -0,0 +1,81 @@
+#include "util/SpscQueue.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using projection::renderer::SpscQueue;
+
+TEST_CASE("SpscQueue preserves FIFO order and rounds capacity up", "[renderer][spsc]") {
+  SpscQueue<int> queue(3);
+  REQUIRE(queue.capacity() == 4);
+  REQUIRE(queue.empty());
+
+  for (int i = 0; i < 4; ++i) {
+    int value = i;
+    REQUIRE(queue.tryPush(std::move(value)));
+  }
+  REQUIRE(queue.size() == 4);
+
+  int out = -1;
+  for (int i = 0; i < 4; ++i) {
+    REQUIRE(queue.tryPop(out));
+    REQUIRE(out == i);
+  }
+  REQUIRE(!queue.tryPop(out));
+}
+
+TEST_CASE("SpscQueue rejects pushes when full and tracks high water", "[renderer][spsc]") {
+  SpscQueue<std::unique_ptr<int>> queue(2);
+  REQUIRE(queue.tryPush(std::make_unique<int>(1)));
+  REQUIRE(queue.tryPush(std::make_unique<int>(2)));
+
+  auto rejected = std::make_unique<int>(3);
+  REQUIRE(!queue.tryPush(std::move(rejected)));
+  REQUIRE(rejected != nullptr);
+  REQUIRE(*rejected == 3);
+  REQUIRE(queue.rejectedCount() == 1);
+  REQUIRE(queue.highWaterMark() == 2);
+
+  std::unique_ptr<int> out;
+  REQUIRE(queue.tryPop(out));
+  REQUIRE(*out == 1);
+  REQUIRE(queue.size() == 1);
+  REQUIRE(queue.highWaterMark() == 2);
+}
+
+TEST_CASE("SpscQueue hands every element across threads in order", "[renderer][spsc]") {
+  constexpr int kCount = 200000;
+  SpscQueue<int> queue(64);
+
+  std::thread producer([&queue] {
+    for (int i = 0; i < kCount; ++i) {
+      int value = i;
+      while (!queue.tryPush(std::move(value))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::vector<int> received;
+  received.reserve(kCount);
+  int value = 0;
+  while (static_cast<int>(received.size()) < kCount) {
+    if (queue.tryPop(value)) {
+      received.push_back(value);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  bool ordered = true;
+  for (int i = 0; i < kCount; ++i) {
+    ordered = ordered && received[static_cast<size_t>(i)] == i;
+  }
+  REQUIRE(ordered);
+  REQUIRE(queue.empty());
+  REQUIRE(queue.highWaterMark() <= queue.capacity());
+}
@@ -0,0 +1,169 @@
+#include "video/VideoResidency.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <projection/core/Cue.h>
+#include <projection/core/Feed.h>
+#include <projection/core/RendererProtocol.h>
+#include <projection/core/Scene.h>
+#include <projection/core/Surface.h>
+
+#include "RenderState.h"
+#include "video/StubVideoSource.h"
+
+using projection::core::Cue;
+using projection::core::CueId;
+using projection::core::Feed;
+using projection::core::FeedId;
+using projection::core::Scene;
+using projection::core::SceneId;
+using projection::core::Surface;
+using projection::core::SurfaceId;
+using projection::core::Vec2;
+using projection::renderer::RenderState;
+using projection::renderer::StubVideoSource;
+using projection::renderer::VideoResidency;
+using projection::renderer::VideoSource;
+using projection::renderer::VideoSourceFactory;
+
+namespace {
+// 16x16 stub frames: every player is estimated at the same small size.
+const size_t kPlayerBytes = 16 * 16 * 4 * 3;
+
+VideoSourceFactory countingFactory(int& created) {
+  return [&created]() -> std::unique_ptr<VideoSource> {
+    ++created;
+    return std::make_unique<StubVideoSource>(16.0f, 16.0f);
+  };
+}
+
+projection::core::LoadSceneDefinitionMessage makeVideoScene(const std::string& sceneId,
+                                                            const std::vector<std::string>& files) {
+  projection::core::LoadSceneDefinitionMessage definition;
+  std::vector<Surface> surfaces;
+  for (size_t i = 0; i < files.size(); ++i) {
+    const FeedId feedId{sceneId + "-feed" + std::to_string(i)};
+    definition.feeds.push_back(projection::core::makeVideoFileFeed(feedId, "Feed", files[i]));
+    surfaces.push_back(Surface{SurfaceId{sceneId + "-surface" + std::to_string(i)}, "Surface",
+                               {Vec2{0, 0}, Vec2{10, 0}, Vec2{10, 10}, Vec2{0, 10}}, feedId});
+  }
+  definition.scene = Scene{SceneId{sceneId}, sceneId, "", surfaces};
+  return definition;
+}
+}  // namespace
+
+TEST_CASE("VideoResidency reuses a released player for the same file", "[renderer][residency]") {
+  int created = 0;
+  VideoResidency residency(countingFactory(created), 10 * kPlayerBytes);
+
+  auto source = residency.acquire("/media/a.mp4");
+  REQUIRE(created == 1);
+  REQUIRE(source->isLoaded());
+  REQUIRE(static_cast<StubVideoSource&>(*source).playing());
+  REQUIRE(residency.stats().activeBytes == kPlayerBytes);
+
+  VideoSource* const raw = source.get();
+  source->update(5.0);
+  residency.release("/media/a.mp4", std::move(source));
+  REQUIRE(residency.isWarm("/media/a.mp4"));
+  REQUIRE(!static_cast<StubVideoSource*>(raw)->playing());
+
+  auto again = residency.acquire("/media/a.mp4");
+  REQUIRE(again.get() == raw);
+  REQUIRE(created == 1);
+  REQUIRE(again->position() == 0.0);
+  REQUIRE(static_cast<StubVideoSource&>(*again).playing());
+
+  const auto stats = residency.stats();
+  REQUIRE(stats.hits == 1);
+  REQUIRE(stats.misses == 1);
+  REQUIRE(stats.activePlayers == 1);
+  REQUIRE(stats.warmPlayers == 0);
+}
+
+TEST_CASE("VideoResidency evicts the least recently used warm players", "[renderer][residency]") {
+  int created = 0;
+  VideoResidency residency(countingFactory(created), 3 * kPlayerBytes);
+
+  for (const std::string file : {"/media/a.mp4", "/media/b.mp4", "/media/c.mp4"}) {
+    residency.release(file, residency.acquire(file));
+  }
+  REQUIRE(residency.stats().warmPlayers == 3);
+
+  // Touch a so b is now the oldest.
+  residency.release("/media/a.mp4", residency.acquire("/media/a.mp4"));
+  auto d = residency.acquire("/media/d.mp4");
+  REQUIRE(!residency.isWarm("/media/b.mp4"));
+  REQUIRE(residency.isWarm("/media/a.mp4"));
+  REQUIRE(residency.isWarm("/media/c.mp4"));
+
+  // Active players are never evicted, even over budget.
+  auto e = residency.acquire("/media/e.mp4");
+  auto f = residency.acquire("/media/f.mp4");
+  auto g = residency.acquire("/media/g.mp4");
+  auto stats = residency.stats();
+  REQUIRE(stats.activePlayers == 4);
+  REQUIRE(stats.warmPlayers == 0);
+  REQUIRE(stats.evictions == 3);
+  REQUIRE(stats.residentBytes() == 4 * kPlayerBytes);
+  REQUIRE(stats.peakBytes == 4 * kPlayerBytes);
+
+  residency.setBudget(10 * kPlayerBytes);
+  residency.release("/media/e.mp4", std::move(e));
+  residency.setBudget(4 * kPlayerBytes);
+  REQUIRE(residency.isWarm("/media/e.mp4"));
+  residency.setBudget(3 * kPlayerBytes);
+  REQUIRE(!residency.isWarm("/media/e.mp4"));
+}
+
+TEST_CASE("VideoResidency prewarms predicted files within the budget", "[renderer][residency]") {
+  int created = 0;
+  VideoResidency residency(countingFactory(created), 3 * kPlayerBytes);
+  auto active = residency.acquire("/media/a.mp4");
+
+  residency.prewarm({"/media/a.mp4", "/media/b.mp4", "/media/b.mp4", "/media/c.mp4", "/media/d.mp4"});
+  auto stats = residency.stats();
+  REQUIRE(stats.prewarmed == 2);
+  REQUIRE(stats.evictions == 0);
+  REQUIRE(residency.isWarm("/media/b.mp4"));
+  REQUIRE(residency.isWarm("/media/c.mp4"));
+  REQUIRE(!residency.isWarm("/media/d.mp4"));
+
+  const int opened = created;
+  auto b = residency.acquire("/media/b.mp4");
+  REQUIRE(created == opened);
+  REQUIRE(residency.stats().hits == 1);
+}
+
+TEST_CASE("RenderState keeps players warm across scene switches and cue tables", "[renderer][residency]") {
+  int created = 0;
+  RenderState state(countingFactory(created));
+  state.setVideoBudget(8 * kPlayerBytes);
+
+  const auto first = makeVideoScene("scene-a", {"/media/a.mp4", "/media/b.mp4"});
+  const auto second = makeVideoScene("scene-b", {"/media/b.mp4", "/media/c.mp4"});
+  const auto third = makeVideoScene("scene-c", {"/media/d.mp4"});
+  state.loadSceneDefinition(first.scene, first.feeds);
+  state.loadSceneDefinition(second.scene, second.feeds);
+  REQUIRE(created == 3);
+  state.loadSceneDefinition(first.scene, first.feeds);
+  REQUIRE(created == 3);
+  REQUIRE(state.videoFeeds().size() == 2);
+  REQUIRE(state.videoResidency().stats().activePlayers == 2);
+  REQUIRE(state.videoResidency().stats().warmPlayers == 1);
+
+  projection::core::CueTableMessage table;
+  table.cues.push_back(Cue{CueId{"cue-c"}, "Cue C", SceneId{"scene-c"}});
+  table.scenes.push_back(third);
+  state.loadCueTable(table);
+  REQUIRE(state.videoResidency().isWarm("/media/d.mp4"));
+  REQUIRE(created == 4);
+
+  REQUIRE(state.playCue(CueId{"cue-c"}));
+  REQUIRE(created == 4);
+  REQUIRE(state.videoResidency().stats().activePlayers == 1);
+}
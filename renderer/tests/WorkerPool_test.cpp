@@ -0,0 +1,38 @@
+#include "util/WorkerPool.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <vector>
+
+using projection::renderer::WorkerPool;
+
+TEST_CASE("WorkerPool parallelFor visits every index exactly once", "[renderer][workerpool]") {
+  WorkerPool pool(4);
+  REQUIRE(pool.threadCount() == 4);
+
+  // Run several jobs back to back to exercise generation handoff between them.
+  for (size_t count : {1u, 7u, 1000u, 4096u}) {
+    std::vector<std::atomic<int>> visits(count);
+    pool.parallelFor(count, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        visits[i].fetch_add(1);
+      }
+    });
+    for (const auto& v : visits) {
+      REQUIRE(v.load() == 1);
+    }
+  }
+}
+
+TEST_CASE("WorkerPool of one thread runs inline", "[renderer][workerpool]") {
+  WorkerPool pool(1);
+  int calls = 0;
+  size_t covered = 0;
+  pool.parallelFor(100, [&](size_t begin, size_t end) {
+    ++calls;
+    covered += end - begin;
+  });
+  REQUIRE(calls == 1);
+  REQUIRE(covered == 100);
+}
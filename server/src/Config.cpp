@@ -28,6 +28,62 @@ int parsePort(const std::string& value) {
     }
 }
 
+int parseScheduleLead(const std::string& value) {
+    try {
+        int leadMs = std::stoi(value);
+        if (leadMs < 0 || leadMs > 10000) {
+            throw std::invalid_argument("schedule lead out of range");
+        }
+        return leadMs;
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Invalid schedule lead value: " + value);
+    }
+}
+
+int parseMaxMessageMb(const std::string& value) {
+    try {
+        int megabytes = std::stoi(value);
+        if (megabytes <= 0 || megabytes > 4096) {
+            throw std::invalid_argument("max message size out of range");
+        }
+        return megabytes;
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Invalid max message size: " + value);
+    }
+}
+
+int parseAckTimeout(const std::string& value) {
+    try {
+        int timeoutMs = std::stoi(value);
+        if (timeoutMs <= 0 || timeoutMs > 60000) {
+            throw std::invalid_argument("ack timeout out of range");
+        }
+        return timeoutMs;
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Invalid ack timeout value: " + value);
+    }
+}
+
+int parseRendererQueueMb(const std::string& value) {
+    try {
+        int megabytes = std::stoi(value);
+        if (megabytes <= 0 || megabytes > 4096) {
+            throw std::invalid_argument("renderer queue size out of range");
+        }
+        return megabytes;
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Invalid renderer queue size: " + value);
+    }
+}
+
+renderer::OverflowPolicy parseQueueOverflow(const std::string& value) {
+    const auto policy = renderer::parseOverflowPolicy(value);
+    if (!policy) {
+        throw std::invalid_argument("Invalid queue overflow policy: " + value);
+    }
+    return *policy;
+}
+
 std::string parseOptionValue(int& index, int argc, char* argv[], const std::string& option) {
     if (index + 1 >= argc) {
         throw std::invalid_argument("Missing value for " + option);
@@ -58,6 +114,26 @@ ServerConfig parseServerConfig(int argc, char* argv[]) {
             config.rendererPort = parsePort(parseOptionValue(i, argc, argv, "--renderer-port"));
         } else if (startsWith(arg, "--renderer-port=")) {
             config.rendererPort = parsePort(arg.substr(16));
+        } else if (arg == "--schedule-lead-ms") {
+            config.scheduleLeadMs = parseScheduleLead(parseOptionValue(i, argc, argv, "--schedule-lead-ms"));
+        } else if (startsWith(arg, "--schedule-lead-ms=")) {
+            config.scheduleLeadMs = parseScheduleLead(arg.substr(19));
+        } else if (arg == "--max-message-mb") {
+            config.maxMessageMb = parseMaxMessageMb(parseOptionValue(i, argc, argv, "--max-message-mb"));
+        } else if (startsWith(arg, "--max-message-mb=")) {
+            config.maxMessageMb = parseMaxMessageMb(arg.substr(17));
+        } else if (arg == "--ack-timeout-ms") {
+            config.ackTimeoutMs = parseAckTimeout(parseOptionValue(i, argc, argv, "--ack-timeout-ms"));
+        } else if (startsWith(arg, "--ack-timeout-ms=")) {
+            config.ackTimeoutMs = parseAckTimeout(arg.substr(17));
+        } else if (arg == "--renderer-queue-mb") {
+            config.rendererQueueMb = parseRendererQueueMb(parseOptionValue(i, argc, argv, "--renderer-queue-mb"));
+        } else if (startsWith(arg, "--renderer-queue-mb=")) {
+            config.rendererQueueMb = parseRendererQueueMb(arg.substr(20));
+        } else if (arg == "--queue-overflow") {
+            config.queueOverflow = parseQueueOverflow(parseOptionValue(i, argc, argv, "--queue-overflow"));
+        } else if (startsWith(arg, "--queue-overflow=")) {
+            config.queueOverflow = parseQueueOverflow(arg.substr(17));
         } else if (arg == "--verbose") {
             config.verbose = true;
         } else {
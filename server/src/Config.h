@@ -11,12 +11,29 @@ namespace projection::server {
 //   --port=<port>
 //   --renderer-port <port> : Renderer TCP listen port.
 //   --renderer-port=<port>
+//   --schedule-lead-ms <ms> : Delay between broadcasting a scene or cue command and its
+//   --schedule-lead-ms=<ms>   executeAt time, so all renderers switch on the same frame (0
+//                             disables). Surface and feed updates are never delayed: they stay
+//                             interactive but may land a frame apart across renderers.
+//   --max-message-mb <mb>  : Longest control message accepted from a renderer; a longer one
+//   --max-message-mb=<mb>    drops the connection.
+//   --ack-timeout-ms <ms>  : How long a renderer has to ack a command before it counts as
+//   --ack-timeout-ms=<ms>    timed out (HTTP requests waiting for acks wait this long).
+//   --renderer-queue-mb <mb> : Output queued per renderer before the overflow policy applies.
+//   --renderer-queue-mb=<mb>
+//   --queue-overflow <policy> : drop-superseded (drop queued commands a newer one replaces,
+//   --queue-overflow=<policy>   disconnecting when that is not enough) or disconnect.
 //   --verbose             : Enable verbose logging to stdout/stderr.
 //
 // Defaults:
 //   databasePath = "./data/db/projection.db"
 //   httpPort = 8080
 //   rendererPort = 5050
+//   scheduleLeadMs = 100
+//   maxMessageMb = 64
+//   ackTimeoutMs = 2000
+//   rendererQueueMb = 16
+//   queueOverflow = drop-superseded
 //   verbose = false
 ServerConfig parseServerConfig(int argc, char* argv[]);
 
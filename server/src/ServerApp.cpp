@@ -1,5 +1,6 @@
 #include "ServerApp.h"
 
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <stdexcept>
@@ -43,6 +44,11 @@ int ServerApp::run() {
         projectRepository_ = std::make_unique<repo::ProjectRepository>(*connection_);
 
         rendererRegistry_ = std::make_shared<renderer::RendererRegistry>(config_.verbose);
+        rendererRegistry_->setScheduleLeadTime(std::chrono::milliseconds(config_.scheduleLeadMs));
+        rendererRegistry_->setMaxMessageBytes(static_cast<size_t>(config_.maxMessageMb) * 1024 * 1024);
+        rendererRegistry_->setAckTimeout(std::chrono::milliseconds(config_.ackTimeoutMs));
+        rendererRegistry_->setOutboundQueueLimit(static_cast<size_t>(config_.rendererQueueMb) * 1024 * 1024,
+                                                 config_.queueOverflow);
         log("Listening for renderers on port " + std::to_string(config_.rendererPort));
         rendererRegistry_->start(config_.rendererPort);
 
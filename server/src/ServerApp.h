@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 
+#include "renderer/OutboundQueue.h"
 #include "repo/CueRepository.h"
 
 namespace projection::server::db {
@@ -31,6 +32,15 @@ struct ServerConfig {
     int httpPort;
     int rendererPort;
     bool verbose{false};
+    // Broadcast renderer commands carry executeAt = now + this lead (0 applies on arrival).
+    int scheduleLeadMs{100};
+    // Longest line accepted from a renderer connection.
+    int maxMessageMb{64};
+    // Renderers that have not acked a command within this time count as timed out.
+    int ackTimeoutMs{2000};
+    // Per-renderer outbound queue bound and what happens to a renderer that passes it.
+    int rendererQueueMb{16};
+    renderer::OverflowPolicy queueOverflow{renderer::OverflowPolicy::DropSuperseded};
 };
 
 class ServerApp {
@@ -2,7 +2,9 @@
 
 #include <httplib.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <stdexcept>
 #include <sstream>
 #include <filesystem>
@@ -411,6 +413,131 @@ void HttpServer::registerRoutes() {
     server_->Post("/renderer/ping", handleRendererPing);
     server_->Get("/renderer/ping", handleRendererPing);
 
+    auto rendererJson = [](const std::string& name, const renderer::RendererLabels& labels) {
+        return json{{"name", name}, {"group", labels.group}, {"tags", labels.tags}};
+    };
+
+    // Connected renderers with the group and tags commands can target.
+    server_->Get("/renderer/renderers", [this, rendererJson](const ::httplib::Request&, ::httplib::Response& res) {
+        if (!rendererRegistry_) {
+            respondWithError(res, 500, "Renderer registry not configured");
+            return;
+        }
+        auto renderers = rendererRegistry_->renderers();
+        std::sort(renderers.begin(), renderers.end(),
+                  [](const renderer::RendererInfo& a, const renderer::RendererInfo& b) { return a.name < b.name; });
+        json payload = json::array();
+        for (const auto& info : renderers) {
+            payload.push_back(rendererJson(info.name, info.labels));
+        }
+        res.status = 200;
+        res.set_content(payload.dump(), "application/json");
+    });
+
+    // Assigns a renderer's group and tags ({"group": "...", "tags": [...]}, both optional),
+    // replacing what its Hello announced. Kept for renderers that are not connected yet.
+    server_->Post(R"(/renderer/renderers/(.+))", [this, rendererJson](const ::httplib::Request& req,
+                                                                     ::httplib::Response& res) {
+        if (!rendererRegistry_) {
+            respondWithError(res, 500, "Renderer registry not configured");
+            return;
+        }
+        renderer::RendererLabels labels;
+        try {
+            if (req.matches.size() < 2) {
+                respondWithError(res, 400, "Missing renderer name");
+                return;
+            }
+            const auto body = json::parse(req.body);
+            if (!body.is_object()) {
+                respondWithError(res, 400, "Request body must be an object");
+                return;
+            }
+            if (body.contains("group")) {
+                if (!body["group"].is_string()) {
+                    respondWithError(res, 400, "Field 'group' must be a string");
+                    return;
+                }
+                labels.group = body["group"].get<std::string>();
+            }
+            if (body.contains("tags")) {
+                const auto& tags = body["tags"];
+                if (!tags.is_array() ||
+                    !std::all_of(tags.begin(), tags.end(), [](const json& tag) { return tag.is_string(); })) {
+                    respondWithError(res, 400, "Field 'tags' must be an array of strings");
+                    return;
+                }
+                labels.tags = tags.get<std::vector<std::string>>();
+            }
+        } catch (const std::exception& ex) {
+            respondWithError(res, 400, ex.what());
+            return;
+        }
+        const std::string name = req.matches[1].str();
+        json payload = rendererJson(name, labels);
+        payload["connected"] = rendererRegistry_->assignLabels(name, std::move(labels));
+        res.status = 200;
+        res.set_content(payload.dump(), "application/json");
+    });
+
+    // Delivery counters and ack round-trip latency across all commands sent to renderers.
+    server_->Get("/renderer/acks", [this](const ::httplib::Request&, ::httplib::Response& res) {
+        if (!rendererRegistry_) {
+            respondWithError(res, 500, "Renderer registry not configured");
+            return;
+        }
+        const auto stats = rendererRegistry_->ackStats();
+        res.status = 200;
+        res.set_content(json({{"commands", stats.commands},
+                              {"pendingCommands", stats.pendingCommands},
+                              {"acked", stats.acked},
+                              {"failed", stats.failed},
+                              {"timedOut", stats.timedOut},
+                              {"disconnected", stats.disconnected},
+                              {"latencyMs",
+                               {{"mean", stats.meanMs}, {"p50", stats.p50Ms}, {"p95", stats.p95Ms}, {"max", stats.maxMs}}}})
+                            .dump(),
+                        "application/json");
+    });
+
+    // Outbound queue depth per renderer, how often the overflow policy had to act, and what
+    // encoding broadcasts cost.
+    server_->Get("/renderer/queues", [this](const ::httplib::Request&, ::httplib::Response& res) {
+        if (!rendererRegistry_) {
+            respondWithError(res, 500, "Renderer registry not configured");
+            return;
+        }
+        const auto report = rendererRegistry_->queueStats();
+        json renderers = json::array();
+        for (const auto& [name, stats] : report.renderers) {
+            renderers.push_back({{"renderer", name},
+                                 {"queuedMessages", stats.queuedMessages},
+                                 {"queuedBytes", stats.queuedBytes},
+                                 {"peakBytes", stats.peakBytes},
+                                 {"sentMessages", stats.sentMessages},
+                                 {"droppedMessages", stats.droppedMessages},
+                                 {"writes", stats.writes}});
+        }
+        const auto broadcasts = rendererRegistry_->broadcastStats();
+        const double meanEncodeMicros =
+            broadcasts.broadcasts > 0
+                ? static_cast<double>(broadcasts.totalEncodeMicros) / static_cast<double>(broadcasts.broadcasts)
+                : 0.0;
+        res.status = 200;
+        res.set_content(json({{"limitBytes", report.limitBytes},
+                              {"overflowPolicy", renderer::overflowPolicyName(report.policy)},
+                              {"overflowDisconnects", report.overflowDisconnects},
+                              {"renderers", renderers},
+                              {"broadcasts",
+                               {{"count", broadcasts.broadcasts},
+                                {"encodedBytes", broadcasts.encodedBytes},
+                                {"queuedBytes", broadcasts.queuedBytes},
+                                {"meanEncodeMicros", meanEncodeMicros},
+                                {"maxEncodeMicros", broadcasts.maxEncodeMicros}}}})
+                            .dump(),
+                        "application/json");
+    });
+
     server_->Post("/renderer/loadScene", [this](const ::httplib::Request& req, ::httplib::Response& res) {
         if (!rendererRegistry_) {
             respondWithError(res, 500, "Renderer registry not configured");
@@ -424,6 +551,13 @@ void HttpServer::registerRoutes() {
                 return;
             }
 
+            SendOptions sendOptions;
+            std::string optionsError;
+            if (!parseSendOptions(body, sendOptions, optionsError)) {
+                respondWithError(res, 400, optionsError);
+                return;
+            }
+
             core::SceneId sceneId{body["sceneId"].get<std::string>()};
             auto scene = sceneRepository_.findSceneById(sceneId);
             if (!scene.has_value()) {
@@ -446,14 +580,85 @@ void HttpServer::registerRoutes() {
             message.type = core::RendererMessageType::LoadSceneDefinition;
             message.commandId = generateCommandId();
             message.loadSceneDefinition = core::LoadSceneDefinitionMessage{*scene, feeds};
+            sendToRenderers(message, sendOptions, json::object(), res);
+        } catch (const json::exception& ex) {
+            respondWithError(res, 400, ex.what());
+        } catch (const std::exception& ex) {
+            respondWithError(res, 500, ex.what());
+        }
+    });
 
-            size_t sentCount = rendererRegistry_->broadcastMessage(message);
-            if (sentCount == 0) {
-                respondWithError(res, 503, "No renderers connected");
+    // Renderers cache cues (and the scenes they target) ahead of the show so that firing a
+    // cue sends only its id. Without "projectId" every cue is sent.
+    server_->Post("/renderer/loadCues", [this](const ::httplib::Request& req, ::httplib::Response& res) {
+        if (!rendererRegistry_) {
+            respondWithError(res, 500, "Renderer registry not configured");
+            return;
+        }
+
+        try {
+            auto body = req.body.empty() ? json::object() : json::parse(req.body);
+            SendOptions sendOptions;
+            std::string optionsError;
+            if (!parseSendOptions(body, sendOptions, optionsError)) {
+                respondWithError(res, 400, optionsError);
                 return;
             }
-            res.status = 200;
-            res.set_content(json({{"status", "sent"}}).dump(), "application/json");
+            std::vector<core::Cue> cues;
+            std::optional<core::ProjectSettings> settings;
+            if (body.contains("projectId")) {
+                if (!body["projectId"].is_string()) {
+                    respondWithError(res, 400, "Invalid projectId");
+                    return;
+                }
+                core::ProjectId projectId{body["projectId"].get<std::string>()};
+                auto project = projectRepository_.findProjectById(projectId);
+                if (!project.has_value()) {
+                    respondWithError(res, 400, "Project does not exist");
+                    return;
+                }
+                settings = project->getSettings();
+                for (const auto& cueId : project->getCueOrder()) {
+                    auto cue = cueRepository_.findCueById(cueId);
+                    if (!cue.has_value()) {
+                        respondWithError(res, 400, "Cue not found: " + cueId.value);
+                        return;
+                    }
+                    cues.push_back(*cue);
+                }
+            } else {
+                cues = cueRepository_.listCues();
+            }
+
+            core::CueTableMessage table;
+            std::unordered_set<std::string> sceneIds;
+            for (const auto& cue : cues) {
+                if (!sceneIds.insert(cue.getSceneId().value).second) {
+                    continue;
+                }
+                auto scene = sceneRepository_.findSceneById(cue.getSceneId());
+                if (!scene.has_value()) {
+                    respondWithError(res, 400, "Scene not found for cue " + cue.getId().value);
+                    return;
+                }
+                std::vector<core::Feed> feeds;
+                std::string error;
+                if (!collectFeedsForScene(*scene, feeds, error)) {
+                    respondWithError(res, 400, error);
+                    return;
+                }
+                table.scenes.push_back(core::LoadSceneDefinitionMessage{std::move(*scene), std::move(feeds)});
+            }
+            table.cues = std::move(cues);
+            table.settings = std::move(settings);
+
+            const size_t cueCount = table.cues.size();
+            const size_t sceneCount = table.scenes.size();
+            core::RendererMessage message{};
+            message.type = core::RendererMessageType::LoadCueTable;
+            message.commandId = generateCommandId();
+            message.cueTable = std::move(table);
+            sendToRenderers(message, sendOptions, json{{"cues", cueCount}, {"scenes", sceneCount}}, res);
         } catch (const json::exception& ex) {
             respondWithError(res, 400, ex.what());
         } catch (const std::exception& ex) {
@@ -461,6 +666,119 @@ void HttpServer::registerRoutes() {
         }
     });
 
+    server_->Post("/renderer/playCue", [this](const ::httplib::Request& req, ::httplib::Response& res) {
+        if (!rendererRegistry_) {
+            respondWithError(res, 500, "Renderer registry not configured");
+            return;
+        }
+
+        try {
+            auto body = json::parse(req.body);
+            if (!body.contains("cueId") || !body["cueId"].is_string()) {
+                respondWithError(res, 400, "Missing or invalid cueId");
+                return;
+            }
+            SendOptions sendOptions;
+            std::string optionsError;
+            if (!parseSendOptions(body, sendOptions, optionsError)) {
+                respondWithError(res, 400, optionsError);
+                return;
+            }
+            core::CueId cueId{body["cueId"].get<std::string>()};
+            if (!cueRepository_.findCueById(cueId).has_value()) {
+                respondWithError(res, 400, "Cue does not exist");
+                return;
+            }
+
+            // Renderers play the cue from the table sent by /renderer/loadCues.
+            core::RendererMessage message{};
+            message.type = core::RendererMessageType::PlayCue;
+            message.commandId = generateCommandId();
+            message.playCue = core::PlayCueMessage{cueId};
+            sendToRenderers(message, sendOptions, json::object(), res);
+        } catch (const json::exception& ex) {
+            respondWithError(res, 400, ex.what());
+        } catch (const std::exception& ex) {
+            respondWithError(res, 500, ex.what());
+        }
+    });
+
+    // Live per-surface changes (calibration, faders): only the changed fields go on the wire
+    // and renderers apply them without reloading feeds. With "sceneId" the changes are also
+    // stored in that scene so the next /renderer/loadScene keeps them.
+    auto optionalSceneId = [](const json& body) -> std::optional<core::SceneId> {
+        if (!body.contains("sceneId")) {
+            return std::nullopt;
+        }
+        if (!body["sceneId"].is_string()) {
+            throw std::runtime_error("Field 'sceneId' must be a string");
+        }
+        return core::SceneId{body["sceneId"].get<std::string>()};
+    };
+
+    server_->Post("/renderer/surfaceParams", [this, optionalSceneId](const ::httplib::Request& req,
+                                                                    ::httplib::Response& res) {
+        if (!rendererRegistry_) {
+            respondWithError(res, 500, "Renderer registry not configured");
+            return;
+        }
+        core::UpdateSurfaceParamsMessage params;
+        std::optional<core::SceneId> sceneId;
+        SendOptions sendOptions;
+        try {
+            auto body = json::parse(req.body);
+            std::string optionsError;
+            if (!parseSendOptions(body, sendOptions, optionsError)) {
+                respondWithError(res, 400, optionsError);
+                return;
+            }
+            params = body.get<core::UpdateSurfaceParamsMessage>();
+            sceneId = optionalSceneId(body);
+        } catch (const std::exception& ex) {
+            respondWithError(res, 400, ex.what());
+            return;
+        }
+        sendSurfaceParams(std::move(params), sceneId, sendOptions, res);
+    });
+
+    server_->Post(R"(/renderer/surfaces/(.+))", [this, optionalSceneId](const ::httplib::Request& req,
+                                                                       ::httplib::Response& res) {
+        if (!rendererRegistry_) {
+            respondWithError(res, 500, "Renderer registry not configured");
+            return;
+        }
+        core::UpdateSurfaceParamsMessage params;
+        std::optional<core::SceneId> sceneId;
+        SendOptions sendOptions;
+        try {
+            if (req.matches.size() < 2) {
+                respondWithError(res, 400, "Missing surface id");
+                return;
+            }
+            auto body = json::parse(req.body);
+            if (!body.is_object()) {
+                respondWithError(res, 400, "Request body must be an object");
+                return;
+            }
+            std::string optionsError;
+            if (!parseSendOptions(body, sendOptions, optionsError)) {
+                respondWithError(res, 400, optionsError);
+                return;
+            }
+            sceneId = optionalSceneId(body);
+            body.erase("sceneId");
+            body.erase("waitForAcks");
+            body.erase("ackTimeoutMs");
+            body.erase("target");
+            body["surfaceId"] = req.matches[1].str();
+            params.updates.push_back(body.get<core::SurfaceParams>());
+        } catch (const std::exception& ex) {
+            respondWithError(res, 400, ex.what());
+            return;
+        }
+        sendSurfaceParams(std::move(params), sceneId, sendOptions, res);
+    });
+
     server_->Post("/demo/two-video-test", [this](const ::httplib::Request&, ::httplib::Response& res) {
         if (!rendererRegistry_) {
             respondWithError(res, 500, "Renderer registry not configured");
@@ -559,6 +877,84 @@ void HttpServer::respondWithError(::httplib::Response& res, int status, const st
     res.set_content(json({{"error", message}}).dump(), "application/json");
 }
 
+bool HttpServer::parseSendOptions(const json& body, SendOptions& options, std::string& error) {
+    if (body.contains("target")) {
+        const auto& selector = body["target"];
+        const auto target =
+            selector.is_string() ? renderer::parseRendererTarget(selector.get<std::string>()) : std::nullopt;
+        if (!target) {
+            error = "Field 'target' must be \"all\", \"renderer:<name>\", \"group:<group>\" or \"tag:<tag>\"";
+            return false;
+        }
+        options.target = *target;
+    }
+    if (body.contains("waitForAcks")) {
+        const auto& wait = body["waitForAcks"];
+        if (wait.is_string() && wait.get<std::string>() == "all") {
+            options.waitForAcks = std::numeric_limits<size_t>::max();
+        } else if (wait.is_number_unsigned() && wait.get<size_t>() > 0) {
+            options.waitForAcks = wait.get<size_t>();
+        } else {
+            error = "Field 'waitForAcks' must be a positive count or \"all\"";
+            return false;
+        }
+    }
+    if (body.contains("ackTimeoutMs")) {
+        const auto& timeout = body["ackTimeoutMs"];
+        if (!timeout.is_number_unsigned() || timeout.get<int64_t>() <= 0 || timeout.get<int64_t>() > 60000) {
+            error = "Field 'ackTimeoutMs' must be between 1 and 60000";
+            return false;
+        }
+        options.timeout = std::chrono::milliseconds(timeout.get<int64_t>());
+    }
+    return true;
+}
+
+void HttpServer::sendToRenderers(const core::RendererMessage& message, const SendOptions& sendOptions, json response,
+                                 ::httplib::Response& res) {
+    const auto command = rendererRegistry_->sendCommand(sendOptions.target, message, sendOptions.timeout);
+    if (!command) {
+        respondWithError(res, 503,
+                         sendOptions.target.kind == renderer::RendererTarget::Kind::All
+                             ? "No renderers connected"
+                             : "No connected renderer matches target " + sendOptions.target.toString());
+        return;
+    }
+    response["commandId"] = message.commandId;
+    response["target"] = sendOptions.target.toString();
+    response["renderers"] = command->targetCount();
+    if (!sendOptions.waitForAcks) {
+        response["status"] = "sent";
+        res.status = 200;
+        res.set_content(response.dump(), "application/json");
+        return;
+    }
+
+    // The registry resolves every renderer by the command's deadline; the margin only covers
+    // the loop noticing it.
+    const size_t required = std::min(*sendOptions.waitForAcks, command->targetCount());
+    const auto timeout = sendOptions.timeout.value_or(rendererRegistry_->ackTimeout()) + std::chrono::milliseconds(100);
+    const auto report = command->wait(required, timeout);
+    json results = json::array();
+    for (const auto& ack : report.renderers) {
+        json result{{"renderer", ack.renderer}, {"status", renderer::ackStatusName(ack.status)}};
+        if (ack.status != renderer::AckStatus::Pending) {
+            result["latencyMs"] = static_cast<double>(ack.latencyMicros) / 1000.0;
+        }
+        if (!ack.error.empty()) {
+            result["error"] = ack.error;
+        }
+        results.push_back(std::move(result));
+    }
+    const bool satisfied = report.acked >= required;
+    response["status"] = satisfied ? "acked" : "incomplete";
+    response["acked"] = report.acked;
+    response["required"] = required;
+    response["results"] = std::move(results);
+    res.status = satisfied ? 200 : (report.timedOut > 0 || report.pending > 0 ? 504 : 502);
+    res.set_content(response.dump(), "application/json");
+}
+
 std::string HttpServer::generateCommandId() const {
     auto now = std::chrono::steady_clock::now().time_since_epoch().count();
     std::ostringstream oss;
@@ -566,6 +962,49 @@ std::string HttpServer::generateCommandId() const {
     return oss.str();
 }
 
+void HttpServer::sendSurfaceParams(core::UpdateSurfaceParamsMessage params,
+                                   const std::optional<core::SceneId>& persistSceneId, const SendOptions& sendOptions,
+                                   ::httplib::Response& res) {
+    try {
+        for (const auto& update : params.updates) {
+            if (update.feedId && !update.feedId->value.empty() &&
+                !feedRepository_.findFeedById(*update.feedId).has_value()) {
+                respondWithError(res, 400, "Feed not found: " + update.feedId->value);
+                return;
+            }
+        }
+
+        if (persistSceneId) {
+            auto scene = sceneRepository_.findSceneById(*persistSceneId);
+            if (!scene.has_value()) {
+                respondWithError(res, 400, "Scene does not exist");
+                return;
+            }
+            std::string error;
+            for (const auto& update : params.updates) {
+                if (!core::applySurfaceParams(*scene, update, error)) {
+                    respondWithError(res, 400, error);
+                    return;
+                }
+            }
+            if (!core::validateSceneFeeds(*scene, feedRepository_.listFeeds(), error)) {
+                respondWithError(res, 400, error);
+                return;
+            }
+            sceneRepository_.updateScene(*scene);
+        }
+
+        const size_t updateCount = params.updates.size();
+        core::RendererMessage message{};
+        message.type = core::RendererMessageType::UpdateSurfaceParams;
+        message.commandId = generateCommandId();
+        message.updateSurfaceParams = std::move(params);
+        sendToRenderers(message, sendOptions, json{{"updates", updateCount}}, res);
+    } catch (const std::exception& ex) {
+        respondWithError(res, 500, ex.what());
+    }
+}
+
 bool HttpServer::collectFeedsForScene(const core::Scene& scene, std::vector<core::Feed>& feeds, std::string& error) {
     std::vector<std::string> feedOrder;
     std::unordered_set<std::string> seenFeedIds;
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <httplib.h>
+#include <chrono>
 #include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
 
 #include "repo/FeedRepository.h"
 #include "repo/SceneRepository.h"
@@ -27,9 +30,30 @@ public:
     bool isRunning() const;
 
 private:
+    // Optional body fields of the /renderer command endpoints: "target" picks the renderers
+    // ("all", "renderer:<name>", "group:<group>" or "tag:<tag>"; all by default),
+    // "waitForAcks" (a count or "all") holds the response until that many renderers acked, and
+    // "ackTimeoutMs" overrides the registry's ack timeout for the command.
+    struct SendOptions {
+        renderer::RendererTarget target{};
+        std::optional<size_t> waitForAcks;
+        std::optional<std::chrono::milliseconds> timeout;
+    };
+    static bool parseSendOptions(const nlohmann::json& body, SendOptions& options, std::string& error);
+
     void registerRoutes();
     void respondWithError(::httplib::Response& res, int status, const std::string& message);
     bool collectFeedsForScene(const core::Scene& scene, std::vector<core::Feed>& feeds, std::string& error);
+    // Validates live surface changes, optionally stores them in the scene and sends them as
+    // one UpdateSurfaceParams message.
+    void sendSurfaceParams(core::UpdateSurfaceParamsMessage params, const std::optional<core::SceneId>& persistSceneId,
+                           const SendOptions& sendOptions, ::httplib::Response& res);
+    // Sends `message` to the target renderers and responds with `response` plus the command id
+    // and renderer count: status "sent" right away, or after waiting for acks "acked" (200) or
+    // "incomplete" (504 when renderers timed out, 502 when they failed) with every renderer's
+    // result.
+    void sendToRenderers(const core::RendererMessage& message, const SendOptions& sendOptions, nlohmann::json response,
+                         ::httplib::Response& res);
 
     std::string generateCommandId() const;
 
@@ -0,0 +1,242 @@
+#include "renderer/CommandTracker.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace projection::server::renderer {
+
+const char* ackStatusName(AckStatus status) {
+    switch (status) {
+        case AckStatus::Pending:
+            return "pending";
+        case AckStatus::Acked:
+            return "acked";
+        case AckStatus::Failed:
+            return "failed";
+        case AckStatus::TimedOut:
+            return "timedOut";
+        case AckStatus::Disconnected:
+            return "disconnected";
+    }
+    return "unknown";
+}
+
+PendingCommand::PendingCommand(std::string commandId, const std::vector<std::string>& renderers,
+                               int64_t sentAtMicros, int64_t deadlineMicros)
+    : commandId_(std::move(commandId)), sentAtMicros_(sentAtMicros), deadlineMicros_(deadlineMicros) {
+    targets_.reserve(renderers.size());
+    for (const auto& renderer : renderers) {
+        Target target;
+        target.ack.renderer = renderer;
+        target.future = target.promise.get_future().share();
+        targets_.push_back(std::move(target));
+    }
+}
+
+std::shared_future<RendererAck> PendingCommand::future(const std::string& renderer) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& target : targets_) {
+        if (target.ack.renderer == renderer) {
+            return target.future;
+        }
+    }
+    throw std::out_of_range("Renderer '" + renderer + "' was not sent command " + commandId_);
+}
+
+CommandReport PendingCommand::wait(size_t ackCount, std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait_for(lock, timeout, [&]() { return acked_ >= ackCount || resolved_ == targets_.size(); });
+    return reportLocked();
+}
+
+CommandReport PendingCommand::report() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reportLocked();
+}
+
+bool PendingCommand::done() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return resolved_ == targets_.size();
+}
+
+bool PendingCommand::resolve(const std::string& renderer, AckStatus status, std::string error, int64_t nowMicros) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(targets_.begin(), targets_.end(),
+                               [&](const Target& target) { return target.ack.renderer == renderer; });
+        if (it == targets_.end() || it->ack.status != AckStatus::Pending) {
+            return false;
+        }
+        settle(*it, status, std::move(error), nowMicros);
+    }
+    changed_.notify_all();
+    return true;
+}
+
+size_t PendingCommand::resolveRemaining(AckStatus status, int64_t nowMicros) {
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& target : targets_) {
+            if (target.ack.status == AckStatus::Pending) {
+                settle(target, status, {}, nowMicros);
+                ++count;
+            }
+        }
+    }
+    if (count > 0) {
+        changed_.notify_all();
+    }
+    return count;
+}
+
+void PendingCommand::settle(Target& target, AckStatus status, std::string error, int64_t nowMicros) {
+    target.ack.status = status;
+    target.ack.error = std::move(error);
+    target.ack.latencyMicros = std::max<int64_t>(0, nowMicros - sentAtMicros_);
+    target.promise.set_value(target.ack);
+    ++resolved_;
+    if (status == AckStatus::Acked) {
+        ++acked_;
+    }
+}
+
+CommandReport PendingCommand::reportLocked() const {
+    CommandReport report;
+    report.commandId = commandId_;
+    report.targeted = targets_.size();
+    report.renderers.reserve(targets_.size());
+    for (const auto& target : targets_) {
+        switch (target.ack.status) {
+            case AckStatus::Pending:
+                ++report.pending;
+                break;
+            case AckStatus::Acked:
+                ++report.acked;
+                break;
+            case AckStatus::Failed:
+                ++report.failed;
+                break;
+            case AckStatus::TimedOut:
+                ++report.timedOut;
+                break;
+            case AckStatus::Disconnected:
+                ++report.disconnected;
+                break;
+        }
+        report.renderers.push_back(target.ack);
+    }
+    return report;
+}
+
+std::shared_ptr<PendingCommand> CommandTracker::track(const std::string& commandId,
+                                                      const std::vector<std::string>& renderers,
+                                                      std::chrono::microseconds timeout, int64_t nowMicros) {
+    if (commandId.empty() || renderers.empty()) {
+        return nullptr;
+    }
+    auto command = std::make_shared<PendingCommand>(commandId, renderers, nowMicros, nowMicros + timeout.count());
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++totals_.commands;
+    // A reused id takes over; whoever waits on the old command still gets its deadline.
+    pending_[commandId] = command;
+    return command;
+}
+
+void CommandTracker::resolve(const std::string& commandId, const std::string& renderer, AckStatus status,
+                             std::string error, int64_t nowMicros) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = pending_.find(commandId);
+    if (it == pending_.end()) {
+        return;
+    }
+    const auto& command = it->second;
+    if (command->resolve(renderer, status, std::move(error), nowMicros)) {
+        record(status, nowMicros - command->sentAtMicros());
+        retireIfDone(commandId);
+    }
+}
+
+void CommandTracker::rendererGone(const std::string& renderer, int64_t nowMicros) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        const auto& command = it->second;
+        if (command->resolve(renderer, AckStatus::Disconnected, {}, nowMicros)) {
+            record(AckStatus::Disconnected, 0);
+        }
+        it = command->done() ? pending_.erase(it) : std::next(it);
+    }
+}
+
+int64_t CommandTracker::expire(int64_t nowMicros) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t next = -1;
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        const auto& command = it->second;
+        if (command->deadlineMicros() <= nowMicros) {
+            record(AckStatus::TimedOut, 0, command->resolveRemaining(AckStatus::TimedOut, nowMicros));
+            it = pending_.erase(it);
+            continue;
+        }
+        const int64_t remaining = command->deadlineMicros() - nowMicros;
+        next = next < 0 ? remaining : std::min(next, remaining);
+        ++it;
+    }
+    return next;
+}
+
+AckLatencyStats CommandTracker::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AckLatencyStats stats = totals_;
+    stats.pendingCommands = pending_.size();
+    stats.meanMs = stats.acked > 0 ? totalLatencyMs_ / static_cast<double>(stats.acked) : 0.0;
+    if (!recentLatencyMs_.empty()) {
+        auto sorted = recentLatencyMs_;
+        std::sort(sorted.begin(), sorted.end());
+        const auto at = [&](double fraction) {
+            return sorted[std::min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()))];
+        };
+        stats.p50Ms = at(0.50);
+        stats.p95Ms = at(0.95);
+    }
+    return stats;
+}
+
+void CommandTracker::record(AckStatus status, int64_t latencyMicros, size_t count) {
+    switch (status) {
+        case AckStatus::Acked: {
+            const double latencyMs = static_cast<double>(latencyMicros) / 1000.0;
+            ++totals_.acked;
+            totalLatencyMs_ += latencyMs;
+            totals_.maxMs = std::max(totals_.maxMs, latencyMs);
+            if (recentLatencyMs_.size() < kLatencyWindow) {
+                recentLatencyMs_.push_back(latencyMs);
+            } else {
+                recentLatencyMs_[nextLatency_] = latencyMs;
+                nextLatency_ = (nextLatency_ + 1) % kLatencyWindow;
+            }
+            break;
+        }
+        case AckStatus::Failed:
+            totals_.failed += count;
+            break;
+        case AckStatus::TimedOut:
+            totals_.timedOut += count;
+            break;
+        case AckStatus::Disconnected:
+            totals_.disconnected += count;
+            break;
+        case AckStatus::Pending:
+            break;
+    }
+}
+
+void CommandTracker::retireIfDone(const std::string& commandId) {
+    const auto it = pending_.find(commandId);
+    if (it != pending_.end() && it->second->done()) {
+        pending_.erase(it);
+    }
+}
+
+}  // namespace projection::server::renderer
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace projection::server::renderer {
+
+enum class AckStatus { Pending, Acked, Failed, TimedOut, Disconnected };
+
+const char* ackStatusName(AckStatus status);
+
+// How one renderer answered a command.
+struct RendererAck {
+    std::string renderer;
+    AckStatus status{AckStatus::Pending};
+    // The renderer's error text when it answered with an Error.
+    std::string error{};
+    // From queuing the command to its resolution.
+    int64_t latencyMicros{0};
+};
+
+struct CommandReport {
+    std::string commandId;
+    size_t targeted{0};
+    size_t acked{0};
+    size_t failed{0};
+    size_t timedOut{0};
+    size_t disconnected{0};
+    size_t pending{0};
+    // In the order the renderers were targeted.
+    std::vector<RendererAck> renderers{};
+};
+
+// One broadcast command and the renderers it went to. Each renderer resolves exactly once:
+// its ack or error, the command's deadline, or its disconnect, whichever comes first.
+class PendingCommand {
+public:
+    PendingCommand(std::string commandId, const std::vector<std::string>& renderers, int64_t sentAtMicros,
+                   int64_t deadlineMicros);
+
+    PendingCommand(const PendingCommand&) = delete;
+    PendingCommand& operator=(const PendingCommand&) = delete;
+
+    const std::string& commandId() const { return commandId_; }
+    int64_t sentAtMicros() const { return sentAtMicros_; }
+    int64_t deadlineMicros() const { return deadlineMicros_; }
+    size_t targetCount() const { return targets_.size(); }
+
+    // Ready once `renderer` resolved. Throws std::out_of_range for a renderer not targeted.
+    std::shared_future<RendererAck> future(const std::string& renderer) const;
+    // Blocks until `ackCount` renderers acked, every renderer resolved, or `timeout` passed.
+    CommandReport wait(size_t ackCount, std::chrono::milliseconds timeout) const;
+    CommandReport report() const;
+    bool done() const;
+
+    // The first resolution of a renderer wins; false when it was already resolved or not targeted.
+    bool resolve(const std::string& renderer, AckStatus status, std::string error, int64_t nowMicros);
+    // Resolves every still-pending renderer with `status`; returns how many.
+    size_t resolveRemaining(AckStatus status, int64_t nowMicros);
+
+private:
+    struct Target {
+        RendererAck ack;
+        std::promise<RendererAck> promise;
+        std::shared_future<RendererAck> future;
+    };
+
+    // Caller holds mutex_.
+    void settle(Target& target, AckStatus status, std::string error, int64_t nowMicros);
+    CommandReport reportLocked() const;
+
+    const std::string commandId_;
+    const int64_t sentAtMicros_;
+    const int64_t deadlineMicros_;
+    mutable std::mutex mutex_{};
+    mutable std::condition_variable changed_{};
+    // A handful of renderers per command; searched linearly.
+    std::vector<Target> targets_{};
+    size_t resolved_{0};
+    size_t acked_{0};
+};
+
+struct AckLatencyStats {
+    uint64_t commands{0};
+    uint64_t acked{0};
+    uint64_t failed{0};
+    uint64_t timedOut{0};
+    uint64_t disconnected{0};
+    size_t pendingCommands{0};
+    // Over acks since start (mean, max) and the last kLatencyWindow acks (percentiles).
+    double meanMs{0.0};
+    double maxMs{0.0};
+    double p50Ms{0.0};
+    double p95Ms{0.0};
+};
+
+// Pending-command table keyed by commandId. The registry's loop feeds it acks, errors,
+// disconnects and the clock; HTTP handlers hold the PendingCommand they broadcast and wait
+// on it. Finished commands leave the table, and their latencies feed AckLatencyStats.
+class CommandTracker {
+public:
+    static constexpr size_t kLatencyWindow = 1024;
+
+    // Returns nullptr for an empty commandId or no renderers (nothing to wait for).
+    std::shared_ptr<PendingCommand> track(const std::string& commandId, const std::vector<std::string>& renderers,
+                                          std::chrono::microseconds timeout, int64_t nowMicros);
+    void resolve(const std::string& commandId, const std::string& renderer, AckStatus status, std::string error,
+                 int64_t nowMicros);
+    // A renderer that went away will not answer what it still owes.
+    void rendererGone(const std::string& renderer, int64_t nowMicros);
+    // Times out commands past their deadline. Returns microseconds until the next deadline, or
+    // -1 when nothing is pending.
+    int64_t expire(int64_t nowMicros);
+
+    AckLatencyStats stats() const;
+
+private:
+    // Caller holds mutex_.
+    void record(AckStatus status, int64_t latencyMicros, size_t count = 1);
+    void retireIfDone(const std::string& commandId);
+
+    mutable std::mutex mutex_{};
+    std::unordered_map<std::string, std::shared_ptr<PendingCommand>> pending_{};
+    AckLatencyStats totals_{};
+    double totalLatencyMs_{0.0};
+    std::vector<double> recentLatencyMs_{};
+    size_t nextLatency_{0};
+};
+
+}  // namespace projection::server::renderer
@@ -0,0 +1,176 @@
+#include "renderer/OutboundQueue.h"
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <map>
+#include <utility>
+
+namespace projection::server::renderer {
+
+const char* overflowPolicyName(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::DropSuperseded:
+            return "drop-superseded";
+        case OverflowPolicy::Disconnect:
+            return "disconnect";
+    }
+    return "unknown";
+}
+
+std::optional<OverflowPolicy> parseOverflowPolicy(std::string_view name) {
+    if (name == "drop-superseded") {
+        return OverflowPolicy::DropSuperseded;
+    }
+    if (name == "disconnect") {
+        return OverflowPolicy::Disconnect;
+    }
+    return std::nullopt;
+}
+
+std::string supersedeKey(const projection::core::RendererMessage& message) {
+    using projection::core::RendererMessageType;
+    switch (message.type) {
+        case RendererMessageType::LoadSceneDefinition:
+            return "scene";
+        case RendererMessageType::LoadCueTable:
+            return "cues";
+        case RendererMessageType::SetFeedForSurface:
+            return message.setFeedForSurface ? "feed:" + message.setFeedForSurface->surfaceId.value : std::string();
+        case RendererMessageType::UpdateSurfaceParams: {
+            if (!message.updateSurfaceParams || message.updateSurfaceParams->updates.empty()) {
+                return {};
+            }
+            // Surface id -> the fields the message sets on it, in a stable order.
+            std::map<std::string, unsigned> fields;
+            for (const auto& params : message.updateSurfaceParams->updates) {
+                fields[params.surfaceId.value] |= (params.opacity ? 1u : 0u) | (params.brightness ? 2u : 0u) |
+                                                  (params.blendMode ? 4u : 0u) | (params.zOrder ? 8u : 0u) |
+                                                  (params.vertices ? 16u : 0u) | (params.feedId ? 32u : 0u);
+            }
+            std::string key = "surfaces";
+            for (const auto& [surfaceId, mask] : fields) {
+                key += ':' + surfaceId + '/' + std::to_string(mask);
+            }
+            return key;
+        }
+        default:
+            return {};
+    }
+}
+
+OutboundQueue::PushResult OutboundQueue::push(OutboundLine line, std::vector<std::string>& dropped) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_ || stats_.overflowed) {
+        return PushResult::Closed;
+    }
+    const size_t size = line.bytes->size();
+    if (!lines_.empty() && queuedBytes_ + size > limitBytes_) {
+        if (policy_ == OverflowPolicy::DropSuperseded && !line.supersedeKey.empty()) {
+            dropSuperseded(line.supersedeKey, dropped);
+        }
+        if (!lines_.empty() && queuedBytes_ + size > limitBytes_) {
+            stats_.overflowed = true;
+            return PushResult::Overflow;
+        }
+    }
+    queuedBytes_ += size;
+    stats_.peakBytes = std::max(stats_.peakBytes, queuedBytes_);
+    lines_.push_back(std::move(line));
+    return PushResult::Queued;
+}
+
+void OutboundQueue::pushControl(SharedLine bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) {
+        return;
+    }
+    queuedBytes_ += bytes->size();
+    stats_.peakBytes = std::max(stats_.peakBytes, queuedBytes_);
+    lines_.push_back(OutboundLine{std::move(bytes)});
+}
+
+void OutboundQueue::dropSuperseded(const std::string& key, std::vector<std::string>& dropped) {
+    auto it = lines_.begin();
+    if (frontOffset_ > 0) {
+        ++it;
+    }
+    while (it != lines_.end()) {
+        if (it->supersedeKey != key) {
+            ++it;
+            continue;
+        }
+        if (!it->commandId.empty()) {
+            dropped.push_back(it->commandId);
+        }
+        queuedBytes_ -= it->bytes->size();
+        ++stats_.droppedMessages;
+        it = lines_.erase(it);
+    }
+}
+
+bool OutboundQueue::write(int socketFd, bool& drained) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    iovec parts[kMaxWriteLines];
+    while (!lines_.empty()) {
+        size_t count = 0;
+        for (auto it = lines_.begin(); it != lines_.end() && count < kMaxWriteLines; ++it, ++count) {
+            const size_t skip = count == 0 ? frontOffset_ : 0;
+            parts[count].iov_base = const_cast<char*>(it->bytes->data() + skip);
+            parts[count].iov_len = it->bytes->size() - skip;
+        }
+        msghdr message{};
+        message.msg_iov = parts;
+        message.msg_iovlen = count;
+        const ssize_t sent = ::sendmsg(socketFd, &message, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            drained = false;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        ++stats_.writes;
+        // Retire every line the write completed; the last one may be partly sent.
+        size_t remaining = static_cast<size_t>(sent);
+        while (remaining > 0) {
+            const size_t left = lines_.front().bytes->size() - frontOffset_;
+            if (remaining < left) {
+                frontOffset_ += remaining;
+                break;
+            }
+            remaining -= left;
+            queuedBytes_ -= lines_.front().bytes->size();
+            lines_.pop_front();
+            frontOffset_ = 0;
+            ++stats_.sentMessages;
+        }
+    }
+    drained = true;
+    return true;
+}
+
+void OutboundQueue::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    lines_.clear();
+    queuedBytes_ = 0;
+    frontOffset_ = 0;
+}
+
+bool OutboundQueue::overflowed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_.overflowed;
+}
+
+OutboundQueueStats OutboundQueue::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    OutboundQueueStats stats = stats_;
+    stats.queuedMessages = lines_.size();
+    stats.queuedBytes = queuedBytes_;
+    return stats;
+}
+
+}  // namespace projection::server::renderer
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "projection/core/RendererProtocol.h"
+
+namespace projection::server::renderer {
+
+// What a session does when a renderer falls so far behind that its queue would pass the limit.
+enum class OverflowPolicy {
+    // Drop queued lines the new one supersedes (same supersede key); disconnect when that
+    // does not free enough room.
+    DropSuperseded,
+    // Disconnect at once. The renderer catches up through the state replayed on reconnect.
+    Disconnect
+};
+
+const char* overflowPolicyName(OverflowPolicy policy);
+std::optional<OverflowPolicy> parseOverflowPolicy(std::string_view name);
+
+// Lines with the same non-empty key replace each other: once a later one is queued, an earlier
+// one not yet on the wire changes nothing the renderer ends up with. Scene definitions replace
+// scene definitions, cue tables replace cue tables, a surface's feed replaces its feed, and a
+// surface-params update replaces one touching exactly the same surfaces and fields. Empty for
+// everything else: cues stack overrides on the current scene and neither they nor a bare
+// LoadScene carry the definition a dropped LoadSceneDefinition would have.
+std::string supersedeKey(const projection::core::RendererMessage& message);
+
+// An encoded, newline-terminated line. Immutable once built, so one broadcast is encoded once and
+// every session's queue holds the same buffer.
+using SharedLine = std::shared_ptr<const std::string>;
+
+struct OutboundLine {
+    SharedLine bytes;
+    std::string supersedeKey{};
+    // Resolved as failed in the command tracker when the line is dropped.
+    std::string commandId{};
+};
+
+struct OutboundQueueStats {
+    size_t queuedMessages{0};
+    size_t queuedBytes{0};
+    size_t peakBytes{0};
+    uint64_t sentMessages{0};
+    uint64_t droppedMessages{0};
+    // Socket writes; each gathers up to kMaxWriteLines queued lines.
+    uint64_t writes{0};
+    bool overflowed{false};
+};
+
+// One session's outbound lines, bounded in bytes. Any thread pushes; the registry's loop writes.
+// A single line longer than the limit is still accepted into an empty queue, so a large scene
+// definition always goes out.
+class OutboundQueue {
+public:
+    enum class PushResult { Queued, Closed, Overflow };
+
+    static constexpr size_t kMaxWriteLines = 64;
+
+    OutboundQueue(size_t limitBytes, OverflowPolicy policy) : limitBytes_(limitBytes), policy_(policy) {}
+
+    OutboundQueue(const OutboundQueue&) = delete;
+    OutboundQueue& operator=(const OutboundQueue&) = delete;
+
+    // Command ids of lines dropped to make room are appended to `dropped`. After an Overflow the
+    // queue refuses further lines (Closed) and the owner is expected to disconnect.
+    PushResult push(OutboundLine line, std::vector<std::string>& dropped);
+    // Queued regardless of the limit (but not once closed): handshake replies, time-sync answers
+    // and the state replayed on connect, none of which a renderer may miss.
+    void pushControl(SharedLine bytes);
+
+    // Sends from the front with scatter-gather writes until the socket would block. False on a
+    // socket error; `drained` tells whether the queue is empty afterwards.
+    bool write(int socketFd, bool& drained);
+
+    // Drops whatever is queued; later pushes return Closed.
+    void close();
+    bool overflowed() const;
+    OutboundQueueStats stats() const;
+
+private:
+    // Caller holds mutex_. Removes queued lines with `key`, except a partly sent front line.
+    void dropSuperseded(const std::string& key, std::vector<std::string>& dropped);
+
+    const size_t limitBytes_;
+    const OverflowPolicy policy_;
+    mutable std::mutex mutex_{};
+    std::deque<OutboundLine> lines_{};
+    size_t queuedBytes_{0};
+    // Bytes of the front line already sent.
+    size_t frontOffset_{0};
+    bool closed_{false};
+    OutboundQueueStats stats_{};
+};
+
+}  // namespace projection::server::renderer
@@ -2,25 +2,42 @@
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
-#include <functional>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <iostream>
+#include <string_view>
 #include <vector>
 #include <nlohmann/json.hpp>
 
+#include "projection/core/LineFramer.h"
+#include "projection/core/TimeSync.h"
+
 namespace projection::server::renderer {
 namespace {
 constexpr int kInvalidSocket = -1;
+constexpr int kMaxEvents = 64;
 
-projection::core::RendererMessage parseRendererMessageLine(const std::string& line) {
-    auto json = nlohmann::json::parse(line);
+projection::core::RendererMessage parseRendererMessageLine(std::string_view line) {
+    auto json = nlohmann::json::parse(line.begin(), line.end());
     return json.get<projection::core::RendererMessage>();
 }
 
-std::string renderRendererMessageLine(const projection::core::RendererMessage& message) {
-    return nlohmann::json(message).dump();
+// Newline-terminated, ready to queue.
+SharedLine encodeLine(const nlohmann::json& json) {
+    auto line = std::make_shared<std::string>(json.dump());
+    line->push_back('\n');
+    return line;
+}
+
+SharedLine renderRendererMessageLine(const projection::core::RendererMessage& message) {
+    return encodeLine(nlohmann::json(message));
 }
 
 projection::core::RendererMessage makeAckMessage(const std::string& commandId) {
@@ -31,6 +48,15 @@ projection::core::RendererMessage makeAckMessage(const std::string& commandId) {
     return message;
 }
 
+// Scene and cue switches wait out the schedule lead so every renderer changes on the same
+// frame. Live surface and feed updates apply on arrival: the lead would only add latency to
+// every fader move.
+bool isScheduledOnBroadcast(projection::core::RendererMessageType type) {
+    using projection::core::RendererMessageType;
+    return type == RendererMessageType::LoadSceneDefinition || type == RendererMessageType::LoadScene ||
+           type == RendererMessageType::PlayCue || type == RendererMessageType::LoadCueTable;
+}
+
 projection::core::RendererMessage makeErrorMessage(const std::string& commandId, const std::string& errorText) {
     projection::core::RendererMessage message{};
     message.type = projection::core::RendererMessageType::Error;
@@ -39,142 +65,134 @@ projection::core::RendererMessage makeErrorMessage(const std::string& commandId,
     return message;
 }
 
+void closeFd(int& fd) {
+    if (fd != kInvalidSocket) {
+        ::close(fd);
+        fd = kInvalidSocket;
+    }
+}
+
 }  // namespace
 
-class RendererSession : public std::enable_shared_from_this<RendererSession> {
+// One renderer connection. The socket, framer and epoll state belong to the registry's loop
+// thread; only the outbound queue is shared, so any thread may queue a line.
+class RendererSession {
 public:
-    RendererSession(std::string name,
-                    int socketFd,
-                    bool verbose,
-                    std::function<void(const std::string&)> onDisconnect)
-        : name_(std::move(name)),
-          socketFd_(socketFd),
-          verbose_(verbose),
-          onDisconnect_(std::move(onDisconnect)) {}
+    RendererSession(int socketFd, size_t maxMessageBytes, size_t queueLimitBytes, OverflowPolicy overflowPolicy)
+        : socketFd_(socketFd), framer_(maxMessageBytes), outbound_(queueLimitBytes, overflowPolicy) {}
 
-    ~RendererSession() { stop(); }
+    ~RendererSession() { close(); }
 
     RendererSession(const RendererSession&) = delete;
     RendererSession& operator=(const RendererSession&) = delete;
 
+    int socketFd() const { return socketFd_; }
+    bool open() const { return socketFd_ != kInvalidSocket; }
+    // Empty until the Hello handshake succeeds.
     const std::string& name() const { return name_; }
-
-    void start() {
-        if (running_) {
-            return;
-        }
-        running_ = true;
-        auto self = shared_from_this();
-        readerThread_ = std::thread([self] { self->readLoop(); });
-    }
-
-    void stop() {
-        running_ = false;
+    void setName(std::string name) { name_ = std::move(name); }
+    bool registered() const { return !name_.empty(); }
+    // Guarded by the registry's sessionsMutex_: HTTP threads reassign them while others send.
+    const RendererLabels& labels() const { return labels_; }
+    void setLabels(RendererLabels labels) { labels_ = std::move(labels); }
+    projection::core::LineFramer& framer() { return framer_; }
+
+    // Set when a handshake is refused: the error line goes out, then the connection closes.
+    bool closeWhenFlushed() const { return closeWhenFlushed_; }
+    void setCloseWhenFlushed() { closeWhenFlushed_ = true; }
+    bool writeArmed() const { return writeArmed_; }
+    void setWriteArmed(bool armed) { writeArmed_ = armed; }
+
+    OutboundQueue& outbound() { return outbound_; }
+    // Loop-thread replies and replayed state; broadcasts go through outbound().push.
+    void enqueue(SharedLine line) { outbound_.pushControl(std::move(line)); }
+
+    void close() {
+        outbound_.close();
         if (socketFd_ != kInvalidSocket) {
             ::shutdown(socketFd_, SHUT_RDWR);
-            ::close(socketFd_);
-            socketFd_ = kInvalidSocket;
-        }
-        if (readerThread_.joinable()) {
-            if (readerThread_.get_id() == std::this_thread::get_id()) {
-                readerThread_.detach();
-            } else {
-                readerThread_.join();
-            }
+            closeFd(socketFd_);
         }
     }
 
-    bool sendMessage(const projection::core::RendererMessage& message) {
-        std::lock_guard<std::mutex> lock(sendMutex_);
-        if (socketFd_ == kInvalidSocket) {
-            return false;
-        }
-        std::string payload = renderRendererMessageLine(message);
-        payload.push_back('\n');
-
-        const char* data = payload.c_str();
-        size_t totalSent = 0;
-        while (totalSent < payload.size()) {
-            ssize_t sent = ::send(socketFd_, data + totalSent, payload.size() - totalSent, 0);
-            if (sent <= 0) {
-                return false;
-            }
-            totalSent += static_cast<size_t>(sent);
-        }
-        return true;
-    }
-
 private:
-    void readLoop() {
-        std::string buffer;
-        char chunk[256];
-
-        while (running_) {
-            ssize_t received = ::recv(socketFd_, chunk, sizeof(chunk), 0);
-            if (received <= 0) {
-                break;
-            }
-            buffer.append(chunk, static_cast<size_t>(received));
-            auto newlinePos = buffer.find('\n');
-            while (newlinePos != std::string::npos) {
-                std::string line = buffer.substr(0, newlinePos);
-                buffer.erase(0, newlinePos + 1);
-                if (verbose_) {
-                    std::cerr << "[renderer-registry] received from " << name_ << ": " << line << std::endl;
-                }
-                newlinePos = buffer.find('\n');
-            }
-        }
-
-        if (onDisconnect_) {
-            onDisconnect_(name_);
-        }
-    }
-
-    std::string name_;
     int socketFd_{kInvalidSocket};
-    std::atomic<bool> running_{false};
-    bool verbose_{false};
-    std::function<void(const std::string&)> onDisconnect_{};
-    std::thread readerThread_{};
-    std::mutex sendMutex_{};
+    std::string name_{};
+    RendererLabels labels_{};
+    projection::core::LineFramer framer_;
+    bool closeWhenFlushed_{false};
+    bool writeArmed_{false};
+    OutboundQueue outbound_;
 };
 
 RendererRegistry::RendererRegistry(bool verbose) : verbose_(verbose) {}
 
-RendererRegistry::~RendererRegistry() { stop(); }
+RendererRegistry::~RendererRegistry() {
+    stop();
+    closeFd(wakeFd_);
+}
 
 void RendererRegistry::start(int port) {
     if (running_) {
         return;
     }
-    running_ = true;
-    serverThread_ = std::thread(&RendererRegistry::run, this, port);
-}
-
-void RendererRegistry::stop() {
-    running_ = false;
-    if (serverFd_ != kInvalidSocket) {
-        ::shutdown(serverFd_, SHUT_RDWR);
-        ::close(serverFd_);
+    serverFd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (serverFd_ < 0) {
         serverFd_ = kInvalidSocket;
+        return;
     }
 
-    std::vector<std::shared_ptr<RendererSession>> sessions;
-    {
-        std::lock_guard<std::mutex> lock(sessionsMutex_);
-        for (auto& [_, session] : sessions_) {
-            sessions.push_back(session);
-        }
-        sessions_.clear();
+    int opt = 1;
+    ::setsockopt(serverFd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+
+    if (::bind(serverFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(serverFd_, SOMAXCONN) != 0) {
+        closeFd(serverFd_);
+        return;
     }
-    for (auto& session : sessions) {
-        session->stop();
+
+    socklen_t len = sizeof(addr);
+    if (::getsockname(serverFd_, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+        port_ = ntohs(addr.sin_port);
     }
 
-    if (serverThread_.joinable()) {
-        serverThread_.join();
+    if (wakeFd_ == kInvalidSocket) {
+        wakeFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+    epollFd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    epoll_event listenEvent{};
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.fd = serverFd_;
+    epoll_event wakeEvent{};
+    wakeEvent.events = EPOLLIN;
+    wakeEvent.data.fd = wakeFd_;
+    if (wakeFd_ < 0 || epollFd_ < 0 || ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, serverFd_, &listenEvent) != 0 ||
+        ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &wakeEvent) != 0) {
+        closeFd(epollFd_);
+        closeFd(serverFd_);
+        return;
     }
+
+    if (verbose_) {
+        std::cerr << "[renderer-registry] listening on 0.0.0.0:" << port_ << std::endl;
+    }
+    running_ = true;
+    loopThread_ = std::thread(&RendererRegistry::run, this);
+}
+
+void RendererRegistry::stop() {
+    running_ = false;
+    if (loopThread_.joinable()) {
+        wake();
+        loopThread_.join();
+    }
+    closeFd(epollFd_);
+    closeFd(serverFd_);
 }
 
 std::vector<std::string> RendererRegistry::rendererNames() const {
@@ -192,164 +210,478 @@ size_t RendererRegistry::rendererCount() const {
     return sessions_.size();
 }
 
+BroadcastStats RendererRegistry::broadcastStats() const {
+    std::lock_guard<std::mutex> stateLock(stateMutex_);
+    return broadcastTotals_;
+}
+
+OutboundQueueReport RendererRegistry::queueStats() const {
+    OutboundQueueReport report;
+    report.limitBytes = queueLimitBytes_;
+    report.policy = overflowPolicy_;
+    report.overflowDisconnects = overflowDisconnects_;
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    report.renderers.reserve(sessions_.size());
+    for (const auto& [name, session] : sessions_) {
+        report.renderers.emplace_back(name, session->outbound().stats());
+    }
+    return report;
+}
+
+std::vector<RendererInfo> RendererRegistry::renderers() const {
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    std::vector<RendererInfo> renderers;
+    renderers.reserve(sessions_.size());
+    for (const auto& [name, session] : sessions_) {
+        renderers.push_back(RendererInfo{name, session->labels()});
+    }
+    return renderers;
+}
+
+bool RendererRegistry::assignLabels(const std::string& name, RendererLabels labels) {
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    assignedLabels_[name] = labels;
+    const auto it = sessions_.find(name);
+    if (it == sessions_.end()) {
+        return false;
+    }
+    it->second->setLabels(std::move(labels));
+    return true;
+}
+
+size_t RendererRegistry::sendMessage(const RendererTarget& target, const projection::core::RendererMessage& message) {
+    size_t sentCount = 0;
+    queueFor(target, message, ackTimeout(), sentCount);
+    return sentCount;
+}
+
 size_t RendererRegistry::broadcastMessage(const projection::core::RendererMessage& message) {
+    return sendMessage(RendererTarget::all(), message);
+}
+
+std::shared_ptr<PendingCommand> RendererRegistry::sendCommand(const RendererTarget& target,
+                                                              const projection::core::RendererMessage& message,
+                                                              std::optional<std::chrono::milliseconds> ackTimeout) {
+    size_t sentCount = 0;
+    return queueFor(target, message, ackTimeout.value_or(this->ackTimeout()), sentCount);
+}
+
+std::shared_ptr<PendingCommand> RendererRegistry::sendCommand(const projection::core::RendererMessage& message,
+                                                              std::optional<std::chrono::milliseconds> ackTimeout) {
+    return sendCommand(RendererTarget::all(), message, ackTimeout);
+}
+
+std::shared_ptr<PendingCommand> RendererRegistry::queueFor(const RendererTarget& target,
+                                                           const projection::core::RendererMessage& message,
+                                                           std::chrono::milliseconds ackTimeout, size_t& sentCount) {
+    // Encoded once into a buffer every session's queue shares. The schedule stamp goes into the
+    // JSON rather than into a copy of the message, which may carry a whole scene.
+    const int64_t encodeStart = projection::core::monotonicMicros();
+    nlohmann::json json = message;
+    const int64_t leadMicros = scheduleLeadMicros_.load();
+    if (leadMicros > 0 && !message.executeAt && isScheduledOnBroadcast(message.type)) {
+        json["executeAt"] = encodeStart + leadMicros;
+    }
+    const SharedLine line = encodeLine(json);
+    const int64_t encodeMicros = projection::core::monotonicMicros() - encodeStart;
+
+    std::lock_guard<std::mutex> stateLock(stateMutex_);
     std::vector<std::shared_ptr<RendererSession>> sessions;
     {
         std::lock_guard<std::mutex> lock(sessionsMutex_);
-        for (const auto& [_, session] : sessions_) {
-            sessions.push_back(session);
+        for (const auto& [name, session] : sessions_) {
+            if (target.matches(name, session->labels())) {
+                sessions.push_back(session);
+            }
         }
     }
 
-    size_t sentCount = 0;
+    std::vector<std::string> names;
+    names.reserve(sessions.size());
     for (const auto& session : sessions) {
-        if (session->sendMessage(message)) {
-            ++sentCount;
-        } else {
-            std::lock_guard<std::mutex> lock(sessionsMutex_);
-            sessions_.erase(session->name());
-        }
+        names.push_back(session->name());
     }
-    return sentCount;
-}
+    // Tracked before the line is queued, so even an immediate ack finds its entry.
+    const int64_t now = projection::core::monotonicMicros();
+    auto command = commands_.track(message.commandId, names, ackTimeout, now);
 
-void RendererRegistry::run(int port) {
-    serverFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
-    if (serverFd_ < 0) {
-        running_ = false;
-        return;
+    const std::string key = supersedeKey(message);
+    sentCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        std::vector<std::string> dropped;
+        for (const auto& session : sessions) {
+            dropped.clear();
+            const auto result = session->outbound().push(OutboundLine{line, key, message.commandId}, dropped);
+            for (const auto& droppedId : dropped) {
+                commands_.resolve(droppedId, session->name(), AckStatus::Failed, "Superseded before it was sent", now);
+            }
+            if (result == OutboundQueue::PushResult::Queued) {
+                pendingFlush_.push_back(session);
+                ++sentCount;
+                continue;
+            }
+            commands_.resolve(message.commandId, session->name(), AckStatus::Disconnected, {}, now);
+            if (result == OutboundQueue::PushResult::Overflow) {
+                // The loop disconnects it on its next pass.
+                pendingFlush_.push_back(session);
+            }
+        }
     }
-
-    int opt = 1;
-    ::setsockopt(serverFd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-
-    sockaddr_in addr{};
-    addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = htonl(INADDR_ANY);
-    addr.sin_port = htons(static_cast<uint16_t>(port));
-
-    if (::bind(serverFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
-        ::close(serverFd_);
-        serverFd_ = kInvalidSocket;
-        running_ = false;
-        return;
+    if (sentCount > 0) {
+        rememberState(target, message);
     }
-
-    if (::listen(serverFd_, 8) != 0) {
-        ::close(serverFd_);
-        serverFd_ = kInvalidSocket;
-        running_ = false;
-        return;
+    ++broadcastTotals_.broadcasts;
+    broadcastTotals_.encodedBytes += line->size();
+    broadcastTotals_.queuedBytes += line->size() * sentCount;
+    broadcastTotals_.totalEncodeMicros += encodeMicros;
+    broadcastTotals_.maxEncodeMicros = std::max(broadcastTotals_.maxEncodeMicros, encodeMicros);
+    if (!sessions.empty()) {
+        // Also recomputes the loop's wait for the new deadline.
+        wake();
     }
+    return command;
+}
 
-    socklen_t len = sizeof(addr);
-    if (::getsockname(serverFd_, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
-        port_ = ntohs(addr.sin_port);
+void RendererRegistry::rememberState(const RendererTarget& target, const projection::core::RendererMessage& message) {
+    using projection::core::RendererMessageType;
+    std::vector<ReplayState>* states = nullptr;
+    switch (message.type) {
+        case RendererMessageType::LoadCueTable:
+            states = &cueTables_;
+            break;
+        case RendererMessageType::LoadSceneDefinition:
+            states = &sceneDefinitions_;
+            break;
+        case RendererMessageType::PlayCue:
+            states = &cues_;
+            break;
+        default:
+            // LoadScene only names a scene; replaying it would leave a renderer without the
+            // definition dark.
+            return;
     }
+    if (target.kind == RendererTarget::Kind::All) {
+        states->clear();
+    } else {
+        states->erase(std::remove_if(states->begin(), states->end(),
+                                     [&](const ReplayState& state) { return state.target == target; }),
+                      states->end());
+    }
+    ReplayState state{target, message, ++replaySequence_};
+    // Replayed on connect, long after the original schedule.
+    state.message.executeAt.reset();
+    states->push_back(std::move(state));
+}
 
-    if (verbose_) {
-        std::cerr << "[renderer-registry] listening on 0.0.0.0:" << port_ << std::endl;
+void RendererRegistry::wake() {
+    const uint64_t one = 1;
+    if (wakeFd_ != kInvalidSocket && ::write(wakeFd_, &one, sizeof(one)) < 0 && verbose_) {
+        std::cerr << "[renderer-registry] wake failed: " << std::strerror(errno) << std::endl;
     }
+}
 
+void RendererRegistry::run() {
+    epoll_event events[kMaxEvents];
     while (running_) {
-        sockaddr_in clientAddr{};
-        socklen_t clientLen = sizeof(clientAddr);
-        int clientFd = ::accept(serverFd_, reinterpret_cast<sockaddr*>(&clientAddr), &clientLen);
-        if (clientFd < 0) {
-            if (running_) {
+        // Sleep until the next ack deadline at the latest (rounded up to whole milliseconds).
+        const int64_t untilDeadline = commands_.expire(projection::core::monotonicMicros());
+        const int waitMillis = untilDeadline < 0 ? -1 : static_cast<int>((untilDeadline + 999) / 1000);
+        const int count = ::epoll_wait(epollFd_, events, kMaxEvents, waitMillis);
+        if (count < 0) {
+            if (errno == EINTR) {
                 continue;
             }
+            if (verbose_) {
+                std::cerr << "[renderer-registry] epoll_wait failed: " << std::strerror(errno) << std::endl;
+            }
             break;
         }
-        std::thread(&RendererRegistry::handleClient, this, clientFd).detach();
+        for (int i = 0; i < count; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == serverFd_) {
+                acceptConnections();
+                continue;
+            }
+            if (fd == wakeFd_) {
+                uint64_t value = 0;
+                while (::read(wakeFd_, &value, sizeof(value)) < 0 && errno == EINTR) {
+                }
+                continue;
+            }
+            const auto it = connections_.find(fd);
+            if (it == connections_.end()) {
+                continue;
+            }
+            const auto session = it->second;
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                readFrom(session);
+            }
+            if ((events[i].events & EPOLLOUT) && session->open()) {
+                flush(session);
+            }
+        }
+
+        std::vector<std::shared_ptr<RendererSession>> pending;
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            pending.swap(pendingFlush_);
+        }
+        for (const auto& session : pending) {
+            flush(session);
+        }
     }
+    closeAll();
 }
 
-void RendererRegistry::handleClient(int clientFd) {
-    std::string buffer;
-    char chunk[256];
+void RendererRegistry::acceptConnections() {
     while (true) {
-        ssize_t received = ::recv(clientFd, chunk, sizeof(chunk), 0);
-        if (received <= 0) {
-            ::close(clientFd);
+        const int clientFd = ::accept4(serverFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (clientFd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // EAGAIN once the backlog is empty; anything else (e.g. out of descriptors) is
+            // retried on the next readiness event.
             return;
         }
-        buffer.append(chunk, static_cast<size_t>(received));
-        auto newlinePos = buffer.find('\n');
-        if (newlinePos == std::string::npos) {
+        // Commands are small and latency-bound.
+        int noDelay = 1;
+        ::setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = clientFd;
+        if (::epoll_ctl(epollFd_, EPOLL_CTL_ADD, clientFd, &event) != 0) {
+            ::close(clientFd);
             continue;
         }
+        connections_[clientFd] = std::make_shared<RendererSession>(clientFd, maxMessageBytes_, queueLimitBytes_,
+                                                                   overflowPolicy_);
+    }
+}
 
-        std::string line = buffer.substr(0, newlinePos);
-        try {
-            auto message = parseRendererMessageLine(line);
-            if (message.type != projection::core::RendererMessageType::Hello || !message.hello) {
-                auto error = makeErrorMessage(message.commandId, "Expected hello message");
-                sendMessage(clientFd, error);
-                ::close(clientFd);
-                return;
+void RendererRegistry::readFrom(const std::shared_ptr<RendererSession>& session) {
+    // One read per readiness event; the level-triggered loop comes back for the rest, so a
+    // chatty renderer cannot starve the others.
+    auto& framer = session->framer();
+    try {
+        char* target = framer.prepare();
+        const ssize_t received = ::recv(session->socketFd(), target, framer.writableBytes(), 0);
+        if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            closeSession(session);
+            return;
+        }
+        if (received < 0) {
+            return;
+        }
+        const int64_t receivedAt = projection::core::monotonicMicros();
+        framer.commit(static_cast<size_t>(received));
+        std::string_view line;
+        while (!session->closeWhenFlushed() && framer.nextLine(line)) {
+            if (verbose_ && session->registered()) {
+                std::cerr << "[renderer-registry] received from " << session->name() << ": " << line << std::endl;
             }
+            handleLine(session, line, receivedAt);
+        }
+    } catch (const std::exception& ex) {
+        if (verbose_) {
+            std::cerr << "[renderer-registry] dropping " << (session->registered() ? session->name() : "connection")
+                      << ": " << ex.what() << std::endl;
+        }
+        closeSession(session);
+        return;
+    }
+    // Handshake replies and time-sync answers go out before the loop waits again.
+    flush(session);
+}
 
-            const auto& hello = *message.hello;
-            if (hello.name.empty()) {
-                auto error = makeErrorMessage(message.commandId, "Renderer name must be provided");
-                sendMessage(clientFd, error);
-                ::close(clientFd);
-                return;
-            }
+void RendererRegistry::handleLine(const std::shared_ptr<RendererSession>& session,
+                                  std::string_view line,
+                                  int64_t receivedAt) {
+    projection::core::RendererMessage message;
+    try {
+        message = parseRendererMessageLine(line);
+    } catch (const std::exception& ex) {
+        if (!session->registered()) {
+            session->enqueue(renderRendererMessageLine(makeErrorMessage("handshake", ex.what())));
+            session->setCloseWhenFlushed();
+        } else if (verbose_) {
+            std::cerr << "[renderer-registry] ignoring malformed line from " << session->name() << ": "
+                      << ex.what() << std::endl;
+        }
+        return;
+    }
 
-            auto session = std::make_shared<RendererSession>(
-                hello.name, clientFd, verbose_, [this](const std::string& name) {
-                    std::lock_guard<std::mutex> lock(sessionsMutex_);
-                    sessions_.erase(name);
-                });
-            {
-                std::lock_guard<std::mutex> lock(sessionsMutex_);
-                if (sessions_.find(hello.name) != sessions_.end()) {
-                    auto error = makeErrorMessage(message.commandId, "Renderer name already in use");
-                    sendMessage(clientFd, error);
-                    ::close(clientFd);
-                    return;
-                }
-                sessions_.emplace(hello.name, session);
-            }
+    if (!session->registered()) {
+        const char* refusal = nullptr;
+        if (message.type != projection::core::RendererMessageType::Hello || !message.hello) {
+            refusal = "Expected hello message";
+        } else if (message.hello->name.empty()) {
+            refusal = "Renderer name must be provided";
+        }
+        if (refusal) {
+            session->enqueue(renderRendererMessageLine(makeErrorMessage(message.commandId, refusal)));
+            session->setCloseWhenFlushed();
+            return;
+        }
+        registerSession(session, message);
+        return;
+    }
 
-            auto ack = makeAckMessage(message.commandId);
-            if (!sendMessage(clientFd, ack)) {
-                std::lock_guard<std::mutex> lock(sessionsMutex_);
-                sessions_.erase(hello.name);
-                ::close(clientFd);
-                return;
+    switch (message.type) {
+        case projection::core::RendererMessageType::Ack:
+            commands_.resolve(message.ack ? message.ack->commandId : message.commandId, session->name(),
+                              AckStatus::Acked, {}, receivedAt);
+            return;
+        case projection::core::RendererMessageType::Error:
+            commands_.resolve(message.error ? message.error->commandId : message.commandId, session->name(),
+                              AckStatus::Failed, message.error ? message.error->message : std::string(), receivedAt);
+            return;
+        case projection::core::RendererMessageType::TimeSync:
+            if (message.timeSync) {
+                break;
             }
+            return;
+        default:
+            return;
+    }
+    // Answered on the loop as soon as the probe is read, so queuing stays out of the measured
+    // server time.
+    auto reply = message;
+    reply.timeSync->serverReceiveMicros = receivedAt;
+    reply.timeSync->serverSendMicros = projection::core::monotonicMicros();
+    session->enqueue(renderRendererMessageLine(reply));
+}
 
-            if (verbose_) {
-                std::cerr << "[renderer-registry] registered renderer '" << hello.name << "'" << std::endl;
+void RendererRegistry::registerSession(const std::shared_ptr<RendererSession>& session,
+                                       const projection::core::RendererMessage& hello) {
+    const std::string& name = hello.hello->name;
+    // Held until the replay is queued, so no broadcast reaches the new renderer before the
+    // state it supersedes.
+    std::lock_guard<std::mutex> stateLock(stateMutex_);
+    RendererLabels labels;
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
+        if (sessions_.find(name) != sessions_.end()) {
+            session->enqueue(
+                renderRendererMessageLine(makeErrorMessage(hello.commandId, "Renderer name already in use")));
+            session->setCloseWhenFlushed();
+            return;
+        }
+        const auto assigned = assignedLabels_.find(name);
+        labels = assigned != assignedLabels_.end() ? assigned->second
+                                                   : RendererLabels{hello.hello->group, hello.hello->tags};
+        session->setName(name);
+        session->setLabels(labels);
+        sessions_.emplace(name, session);
+    }
+
+    session->enqueue(renderRendererMessageLine(makeAckMessage(hello.commandId)));
+    if (verbose_) {
+        std::cerr << "[renderer-registry] registered renderer '" << name << "'" << std::endl;
+    }
+    if (replayStateOnConnect_) {
+        uint64_t definitionSequence = 0;
+        for (auto* states : {&cueTables_, &sceneDefinitions_, &cues_}) {
+            // The newest state addressed to this renderer.
+            const auto state = std::find_if(states->rbegin(), states->rend(), [&](const ReplayState& candidate) {
+                return candidate.target.matches(name, labels);
+            });
+            if (state == states->rend()) {
+                continue;
+            }
+            if (states == &sceneDefinitions_) {
+                definitionSequence = state->sequence;
+            } else if (states == &cues_ && state->sequence < definitionSequence) {
+                // The definition sent since replaced whatever that cue set up.
+                continue;
             }
+            // Encoded by the first replay and shared by the ones after it.
+            if (!state->line) {
+                state->line = renderRendererMessageLine(state->message);
+            }
+            session->enqueue(state->line);
+        }
+    }
+}
 
-            session->start();
-            return;
-        } catch (const std::exception& ex) {
-            auto error = makeErrorMessage("handshake", ex.what());
-            sendMessage(clientFd, error);
-            ::close(clientFd);
-            return;
+void RendererRegistry::flush(const std::shared_ptr<RendererSession>& session) {
+    if (!session->open()) {
+        return;
+    }
+    if (session->outbound().overflowed()) {
+        if (verbose_) {
+            std::cerr << "[renderer-registry] dropping " << session->name() << ": outbound queue overflowed"
+                      << std::endl;
+        }
+        ++overflowDisconnects_;
+        closeSession(session);
+        return;
+    }
+    bool drained = false;
+    if (!session->outbound().write(session->socketFd(), drained)) {
+        if (verbose_) {
+            std::cerr << "[renderer-registry] dropping " << session->name() << ": " << std::strerror(errno)
+                      << std::endl;
+        }
+        closeSession(session);
+        return;
+    }
+    if (drained && session->closeWhenFlushed()) {
+        closeSession(session);
+        return;
+    }
+    // Only wait for writability while output is backed up.
+    if (drained == session->writeArmed()) {
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | (drained ? 0u : static_cast<uint32_t>(EPOLLOUT));
+        event.data.fd = session->socketFd();
+        ::epoll_ctl(epollFd_, EPOLL_CTL_MOD, session->socketFd(), &event);
+        session->setWriteArmed(!drained);
+    }
+}
+
+void RendererRegistry::closeSession(const std::shared_ptr<RendererSession>& session) {
+    if (!session->open()) {
+        return;
+    }
+    if (session->registered()) {
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
+        const auto it = sessions_.find(session->name());
+        if (it != sessions_.end() && it->second == session) {
+            sessions_.erase(it);
+        }
+        if (verbose_) {
+            std::cerr << "[renderer-registry] renderer '" << session->name() << "' disconnected" << std::endl;
         }
+        commands_.rendererGone(session->name(), projection::core::monotonicMicros());
     }
+    ::epoll_ctl(epollFd_, EPOLL_CTL_DEL, session->socketFd(), nullptr);
+    connections_.erase(session->socketFd());
+    session->close();
 }
 
-bool RendererRegistry::sendMessage(int clientFd, const projection::core::RendererMessage& message) {
-    std::string payload = renderRendererMessageLine(message);
-    payload.push_back('\n');
-    const char* data = payload.c_str();
-    size_t totalSent = 0;
-    while (totalSent < payload.size()) {
-        ssize_t sent = ::send(clientFd, data + totalSent, payload.size() - totalSent, 0);
-        if (sent <= 0) {
-            return false;
+void RendererRegistry::closeAll() {
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
+        for (const auto& [name, _] : sessions_) {
+            names.push_back(name);
         }
-        totalSent += static_cast<size_t>(sent);
+        sessions_.clear();
     }
-    return true;
+    for (const auto& name : names) {
+        commands_.rendererGone(name, projection::core::monotonicMicros());
+    }
+    for (auto& [_, session] : connections_) {
+        bool drained = false;
+        session->outbound().write(session->socketFd(), drained);
+        session->close();
+    }
+    connections_.clear();
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    pendingFlush_.clear();
 }
 
 }  // namespace projection::server::renderer
@@ -1,49 +1,196 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "projection/core/LineFramer.h"
 #include "projection/core/RendererProtocol.h"
+#include "renderer/CommandTracker.h"
+#include "renderer/OutboundQueue.h"
+#include "renderer/RendererTarget.h"
 
 namespace projection::server::renderer {
 
 class RendererSession;
 
+// Totals over every broadcast: each is encoded once, then shared by the queues it went to.
+struct BroadcastStats {
+    uint64_t broadcasts{0};
+    uint64_t encodedBytes{0};
+    // What the shared buffers stand in for: encoded bytes times the renderers queued for.
+    uint64_t queuedBytes{0};
+    int64_t totalEncodeMicros{0};
+    int64_t maxEncodeMicros{0};
+};
+
+struct RendererInfo {
+    std::string name;
+    RendererLabels labels;
+};
+
+struct OutboundQueueReport {
+    size_t limitBytes{0};
+    OverflowPolicy policy{OverflowPolicy::DropSuperseded};
+    uint64_t overflowDisconnects{0};
+    // Connected renderers by name.
+    std::vector<std::pair<std::string, OutboundQueueStats>> renderers{};
+};
+
+// Accepts renderer connections and fans commands out to them from a single event-loop thread
+// (epoll). The loop owns every socket: it accepts, runs the Hello handshake, reads renderer
+// lines (answering time-sync probes) and writes each session's outbound queue as the socket
+// takes it. Other threads only queue lines and wake the loop, so a slow renderer never blocks
+// an HTTP handler or the other renderers. Each queue is bounded; a renderer that falls too far
+// behind has superseded lines dropped or is disconnected.
 class RendererRegistry {
 public:
+    static constexpr size_t kDefaultQueueLimitBytes = 16 * 1024 * 1024;
+
     explicit RendererRegistry(bool verbose = false);
     ~RendererRegistry();
 
     RendererRegistry(const RendererRegistry&) = delete;
     RendererRegistry& operator=(const RendererRegistry&) = delete;
 
+    // Binds and listens before returning (port() is then the bound port); the loop runs on its
+    // own thread until stop(). On failure running() stays false.
     void start(int port);
+    // Writes what the sockets accept of the queued output without waiting, then closes every
+    // connection and joins the loop.
     void stop();
 
     bool running() const { return running_; }
     int port() const { return port_; }
     std::vector<std::string> rendererNames() const;
     size_t rendererCount() const;
+    // Connected renderers with their group and tags.
+    std::vector<RendererInfo> renderers() const;
 
+    // Sets a renderer's group and tags, overriding what its Hello announced, now and on every
+    // later connection under that name. Returns whether the renderer is connected; labels for
+    // one that is not are kept for when it connects.
+    bool assignLabels(const std::string& name, RendererLabels labels);
+
+    // Queues `message` for the renderers `target` matches; the loop writes to all of them in
+    // parallel. Messages without an executeAt are stamped with now + the schedule lead time
+    // (when it is positive) so every renderer applies them on the same frame regardless of send
+    // order. Returns the number of renderers the message was queued for.
+    size_t sendMessage(const RendererTarget& target, const projection::core::RendererMessage& message);
+    // sendMessage to every renderer.
     size_t broadcastMessage(const projection::core::RendererMessage& message);
+    // Like sendMessage, returning the command's pending entry to wait on for acks (nullptr when
+    // no connected renderer matches). Renderers that do not answer within `ackTimeout` (the
+    // registry's ack timeout when unset) resolve as timed out.
+    std::shared_ptr<PendingCommand> sendCommand(const RendererTarget& target,
+                                                const projection::core::RendererMessage& message,
+                                                std::optional<std::chrono::milliseconds> ackTimeout = std::nullopt);
+    // sendCommand to every renderer.
+    std::shared_ptr<PendingCommand> sendCommand(const projection::core::RendererMessage& message,
+                                                std::optional<std::chrono::milliseconds> ackTimeout = std::nullopt);
+
+    void setAckTimeout(std::chrono::milliseconds timeout) { ackTimeoutMillis_ = timeout.count(); }
+    std::chrono::milliseconds ackTimeout() const { return std::chrono::milliseconds(ackTimeoutMillis_); }
+    AckLatencyStats ackStats() const { return commands_.stats(); }
+
+    // Scene and cue commands (LoadSceneDefinition, LoadScene, PlayCue, LoadCueTable) without an
+    // executeAt are stamped with now + lead, so renderers apply them on the same frame; other
+    // commands apply on arrival. Lead time must cover send fan-out plus network latency to the
+    // slowest renderer.
+    void setScheduleLeadTime(std::chrono::microseconds leadTime) { scheduleLeadMicros_ = leadTime.count(); }
+    std::chrono::microseconds scheduleLeadTime() const { return std::chrono::microseconds(scheduleLeadMicros_); }
+
+    // Renderers that (re)connect are sent, unscheduled, the newest cue table, the newest
+    // LoadSceneDefinition and the newest PlayCue sent after that definition, each the newest
+    // whose target matches their name, group or one of their tags. Only messages that reached at
+    // least one renderer count. This lets them catch up without an operator resending. A renderer
+    // that restored the same state from its snapshot applies them without reloading. On by default.
+    void setReplayStateOnConnect(bool replay) { replayStateOnConnect_ = replay; }
+
+    // Longest line accepted from a renderer; a longer one drops the connection. Set before start().
+    void setMaxMessageBytes(size_t bytes) { maxMessageBytes_ = bytes; }
+
+    // Bounds each renderer's outbound queue and picks what happens to a renderer that falls
+    // further behind (see OverflowPolicy). Applies to connections accepted afterwards.
+    void setOutboundQueueLimit(size_t bytes, OverflowPolicy policy) {
+        queueLimitBytes_ = bytes;
+        overflowPolicy_ = policy;
+    }
+    // Queue depth per renderer plus overflow counters.
+    OutboundQueueReport queueStats() const;
+    BroadcastStats broadcastStats() const;
 
 private:
-    void run(int port);
-    void handleClient(int clientFd);
-    bool sendMessage(int clientFd, const projection::core::RendererMessage& message);
+    std::shared_ptr<PendingCommand> queueFor(const RendererTarget& target,
+                                             const projection::core::RendererMessage& message,
+                                             std::chrono::milliseconds ackTimeout, size_t& sentCount);
+    void run();
+    void wake();
+    void acceptConnections();
+    void readFrom(const std::shared_ptr<RendererSession>& session);
+    void handleLine(const std::shared_ptr<RendererSession>& session, std::string_view line, int64_t receivedAt);
+    void registerSession(const std::shared_ptr<RendererSession>& session,
+                         const projection::core::RendererMessage& hello);
+    // Writes the session's queue; arms or disarms EPOLLOUT as needed and closes on errors.
+    void flush(const std::shared_ptr<RendererSession>& session);
+    void closeSession(const std::shared_ptr<RendererSession>& session);
+    void closeAll();
+    // Caller holds stateMutex_.
+    void rememberState(const RendererTarget& target, const projection::core::RendererMessage& message);
 
     std::atomic<bool> running_{false};
     bool verbose_{false};
     int serverFd_{-1};
+    int epollFd_{-1};
+    // eventfd the loop polls so other threads can hand it queued output or a stop request.
+    int wakeFd_{-1};
     int port_{0};
-    std::thread serverThread_{};
+    std::atomic<int64_t> scheduleLeadMicros_{0};
+    std::atomic<int64_t> ackTimeoutMillis_{2000};
+    CommandTracker commands_{};
+    size_t maxMessageBytes_{projection::core::LineFramer::kDefaultMaxLineBytes};
+    size_t queueLimitBytes_{kDefaultQueueLimitBytes};
+    OverflowPolicy overflowPolicy_{OverflowPolicy::DropSuperseded};
+    std::atomic<uint64_t> overflowDisconnects_{0};
+    std::thread loopThread_{};
+    // Every open connection by socket, handshaking or registered. Loop thread only.
+    std::unordered_map<int, std::shared_ptr<RendererSession>> connections_{};
+    // Registered renderers by name, and their sessions' labels.
     mutable std::mutex sessionsMutex_{};
     std::unordered_map<std::string, std::shared_ptr<RendererSession>> sessions_{};
+    // Labels assigned over HTTP, by renderer name, connected or not.
+    std::unordered_map<std::string, RendererLabels> assignedLabels_{};
+    // Sessions with output queued by other threads, flushed by the loop when woken.
+    std::mutex pendingMutex_{};
+    std::vector<std::shared_ptr<RendererSession>> pendingFlush_{};
+    std::atomic<bool> replayStateOnConnect_{true};
+    // A state message as last sent to one target, unscheduled; encoded by the first replay that
+    // needs it. `sequence` orders entries across the lists.
+    struct ReplayState {
+        RendererTarget target;
+        projection::core::RendererMessage message;
+        uint64_t sequence{0};
+        SharedLine line{};
+    };
+
+    // Serializes sends with registering (and replaying state to) a new renderer.
+    mutable std::mutex stateMutex_{};
+    // Oldest first, one entry per distinct target; sending to every renderer clears the rest.
+    // A scene definition is the base a reconnecting renderer needs; the newest cue played after
+    // it is replayed on top. A bare LoadScene carries nothing to replay.
+    std::vector<ReplayState> cueTables_{};
+    std::vector<ReplayState> sceneDefinitions_{};
+    std::vector<ReplayState> cues_{};
+    uint64_t replaySequence_{0};
+    BroadcastStats broadcastTotals_{};
 };
 
 }  // namespace projection::server::renderer
@@ -0,0 +1,61 @@
+#include "renderer/RendererTarget.h"
+
+#include <algorithm>
+
+namespace projection::server::renderer {
+
+bool RendererLabels::hasTag(const std::string& tag) const {
+    return std::find(tags.begin(), tags.end(), tag) != tags.end();
+}
+
+bool RendererTarget::matches(const std::string& name, const RendererLabels& labels) const {
+    switch (kind) {
+        case Kind::All:
+            return true;
+        case Kind::Name:
+            return name == value;
+        case Kind::Group:
+            return labels.group == value;
+        case Kind::Tag:
+            return labels.hasTag(value);
+    }
+    return false;
+}
+
+std::string RendererTarget::toString() const {
+    switch (kind) {
+        case Kind::All:
+            return "all";
+        case Kind::Name:
+            return "renderer:" + value;
+        case Kind::Group:
+            return "group:" + value;
+        case Kind::Tag:
+            return "tag:" + value;
+    }
+    return "all";
+}
+
+std::optional<RendererTarget> parseRendererTarget(std::string_view selector) {
+    if (selector == "all") {
+        return RendererTarget::all();
+    }
+    const auto colon = selector.find(':');
+    if (colon == std::string_view::npos || colon + 1 == selector.size()) {
+        return std::nullopt;
+    }
+    const std::string_view kind = selector.substr(0, colon);
+    std::string value(selector.substr(colon + 1));
+    if (kind == "renderer") {
+        return RendererTarget::renderer(std::move(value));
+    }
+    if (kind == "group") {
+        return RendererTarget::group(std::move(value));
+    }
+    if (kind == "tag") {
+        return RendererTarget::tag(std::move(value));
+    }
+    return std::nullopt;
+}
+
+}  // namespace projection::server::renderer
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace projection::server::renderer {
+
+// Addressing labels of one renderer: announced in its Hello, or assigned over HTTP (which wins).
+struct RendererLabels {
+    std::string group{};
+    std::vector<std::string> tags{};
+
+    bool hasTag(const std::string& tag) const;
+    bool operator==(const RendererLabels& other) const { return group == other.group && tags == other.tags; }
+};
+
+// Which renderers a command goes to: every one, one by name, the members of a group, or the
+// holders of a tag.
+struct RendererTarget {
+    enum class Kind { All, Name, Group, Tag };
+
+    Kind kind{Kind::All};
+    std::string value{};
+
+    static RendererTarget all() { return {}; }
+    static RendererTarget renderer(std::string name) { return {Kind::Name, std::move(name)}; }
+    static RendererTarget group(std::string group) { return {Kind::Group, std::move(group)}; }
+    static RendererTarget tag(std::string tag) { return {Kind::Tag, std::move(tag)}; }
+
+    bool matches(const std::string& name, const RendererLabels& labels) const;
+    // The selector form parseRendererTarget reads back.
+    std::string toString() const;
+
+    bool operator==(const RendererTarget& other) const { return kind == other.kind && value == other.value; }
+};
+
+// "all", "renderer:<name>", "group:<group>" or "tag:<tag>"; nullopt for anything else,
+// including an empty name, group or tag.
+std::optional<RendererTarget> parseRendererTarget(std::string_view selector);
+
+}  // namespace projection::server::renderer
@@ -0,0 +1,117 @@
+#include "renderer/CommandTracker.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace projection::server::renderer {
+
+TEST_CASE("CommandTracker resolves each renderer once and reports latency", "[renderer][acks]") {
+    CommandTracker tracker;
+    REQUIRE(tracker.track("", {"a"}, std::chrono::seconds(1), 0) == nullptr);
+    REQUIRE(tracker.track("cmd-none", {}, std::chrono::seconds(1), 0) == nullptr);
+
+    auto command = tracker.track("cmd-1", {"a", "b", "c"}, std::chrono::seconds(1), 1000);
+    REQUIRE(command != nullptr);
+    REQUIRE(command->targetCount() == 3);
+    auto futureA = command->future("a");
+    REQUIRE(futureA.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+    tracker.resolve("cmd-1", "a", AckStatus::Acked, {}, 3000);
+    tracker.resolve("cmd-1", "a", AckStatus::Failed, "late duplicate", 4000);
+    tracker.resolve("cmd-1", "b", AckStatus::Failed, "Unknown scene", 5000);
+    tracker.resolve("cmd-other", "c", AckStatus::Acked, {}, 5000);
+    tracker.resolve("cmd-1", "z", AckStatus::Acked, {}, 5000);
+
+    REQUIRE(futureA.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    REQUIRE(futureA.get().status == AckStatus::Acked);
+    REQUIRE(futureA.get().latencyMicros == 2000);
+    REQUIRE(command->future("b").get().error == "Unknown scene");
+    bool threw = false;
+    try {
+        (void)command->future("z");
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+
+    auto report = command->report();
+    REQUIRE(report.acked == 1);
+    REQUIRE(report.failed == 1);
+    REQUIRE(report.pending == 1);
+    REQUIRE(report.renderers[2].renderer == "c");
+    REQUIRE(!command->done());
+
+    tracker.resolve("cmd-1", "c", AckStatus::Acked, {}, 7000);
+    REQUIRE(command->done());
+    const auto stats = tracker.stats();
+    REQUIRE(stats.commands == 1);
+    REQUIRE(stats.acked == 2);
+    REQUIRE(stats.failed == 1);
+    REQUIRE(stats.pendingCommands == 0);
+    REQUIRE(stats.meanMs == 4.0);
+    REQUIRE(stats.maxMs == 6.0);
+    REQUIRE(stats.p50Ms == 6.0);
+}
+
+TEST_CASE("CommandTracker times out and disconnects what stays unanswered", "[renderer][acks]") {
+    CommandTracker tracker;
+    REQUIRE(tracker.expire(0) == -1);
+    auto early = tracker.track("cmd-early", {"a", "b"}, std::chrono::milliseconds(10), 0);
+    auto late = tracker.track("cmd-late", {"a", "b"}, std::chrono::milliseconds(50), 0);
+    REQUIRE(tracker.expire(4000) == 6000);
+
+    tracker.rendererGone("b", 5000);
+    REQUIRE(early->future("b").get().status == AckStatus::Disconnected);
+    REQUIRE(late->future("b").get().status == AckStatus::Disconnected);
+
+    REQUIRE(tracker.expire(10000) == 40000);
+    REQUIRE(early->done());
+    const auto timedOut = early->future("a").get();
+    REQUIRE(timedOut.status == AckStatus::TimedOut);
+    REQUIRE(timedOut.latencyMicros == 10000);
+
+    // An ack after the deadline no longer counts.
+    tracker.resolve("cmd-early", "a", AckStatus::Acked, {}, 11000);
+    REQUIRE(early->report().timedOut == 1);
+    tracker.resolve("cmd-late", "a", AckStatus::Acked, {}, 12000);
+    REQUIRE(tracker.expire(60000) == -1);
+
+    const auto stats = tracker.stats();
+    REQUIRE(stats.acked == 1);
+    REQUIRE(stats.timedOut == 1);
+    REQUIRE(stats.disconnected == 2);
+}
+
+TEST_CASE("PendingCommand waits for N of M acks", "[renderer][acks]") {
+    CommandTracker tracker;
+    auto command = tracker.track("cmd-wait", {"a", "b", "c"}, std::chrono::seconds(5), 0);
+
+    std::thread acks([&tracker] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        tracker.resolve("cmd-wait", "a", AckStatus::Acked, {}, 1000);
+        tracker.resolve("cmd-wait", "b", AckStatus::Acked, {}, 2000);
+    });
+    auto report = command->wait(2, std::chrono::seconds(2));
+    acks.join();
+    REQUIRE(report.acked == 2);
+    REQUIRE(report.pending == 1);
+
+    // Not enough acks before the wait's own timeout: returns what is known so far.
+    const auto start = std::chrono::steady_clock::now();
+    report = command->wait(3, std::chrono::milliseconds(30));
+    REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(30));
+    REQUIRE(report.acked == 2);
+
+    // Every renderer resolved ends the wait even when fewer acked.
+    tracker.resolve("cmd-wait", "c", AckStatus::Failed, "boom", 3000);
+    report = command->wait(3, std::chrono::seconds(2));
+    REQUIRE(report.failed == 1);
+    REQUIRE(report.pending == 0);
+}
+
+}  // namespace projection::server::renderer
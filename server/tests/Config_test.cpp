@@ -29,6 +29,10 @@ TEST_CASE("parseServerConfig uses defaults", "[server][config]") {
     REQUIRE(config.databasePath == "./data/db/projection.db");
     REQUIRE(config.httpPort == 8080);
     REQUIRE(config.rendererPort == 5050);
+    REQUIRE(config.scheduleLeadMs == 100);
+    REQUIRE(config.ackTimeoutMs == 2000);
+    REQUIRE(config.rendererQueueMb == 16);
+    REQUIRE(config.queueOverflow == renderer::OverflowPolicy::DropSuperseded);
 }
 
 TEST_CASE("parseServerConfig accepts overrides", "[server][config]") {
@@ -44,13 +48,19 @@ TEST_CASE("parseServerConfig accepts overrides", "[server][config]") {
 
 TEST_CASE("parseServerConfig accepts inline values", "[server][config]") {
     std::vector<const char*> args{"lumi_server", "--db=/opt/app.db", "--port=9090",
-                                   "--renderer-port=6060"};
+                                   "--renderer-port=6060", "--schedule-lead-ms=0", "--max-message-mb=8",
+                                   "--ack-timeout-ms=250", "--renderer-queue-mb=2", "--queue-overflow=disconnect"};
 
     auto config = parseArgs(args);
 
     REQUIRE(config.databasePath == "/opt/app.db");
     REQUIRE(config.httpPort == 9090);
     REQUIRE(config.rendererPort == 6060);
+    REQUIRE(config.scheduleLeadMs == 0);
+    REQUIRE(config.maxMessageMb == 8);
+    REQUIRE(config.ackTimeoutMs == 250);
+    REQUIRE(config.rendererQueueMb == 2);
+    REQUIRE(config.queueOverflow == renderer::OverflowPolicy::Disconnect);
 }
 
 TEST_CASE("parseServerConfig rejects missing values", "[server][config]") {
@@ -65,6 +75,14 @@ TEST_CASE("parseServerConfig rejects invalid ports", "[server][config]") {
     REQUIRE(throwsInvalid(args));
 }
 
+TEST_CASE("parseServerConfig rejects invalid schedule leads", "[server][config]") {
+    REQUIRE(throwsInvalid({"lumi_server", "--schedule-lead-ms", "-5"}));
+    REQUIRE(throwsInvalid({"lumi_server", "--schedule-lead-ms=soon"}));
+    REQUIRE(throwsInvalid({"lumi_server", "--ack-timeout-ms", "0"}));
+    REQUIRE(throwsInvalid({"lumi_server", "--renderer-queue-mb", "0"}));
+    REQUIRE(throwsInvalid({"lumi_server", "--queue-overflow=block"}));
+}
+
 TEST_CASE("parseServerConfig rejects unknown options", "[server][config]") {
     std::vector<const char*> args{"lumi_server", "--unknown"};
 
@@ -59,7 +59,8 @@ std::unique_ptr<httplib::Client> makeClient(int port) {
 
 class FakeRendererClient {
 public:
-    FakeRendererClient(std::string name, int port) : name_(std::move(name)), port_(port) {
+    // A renderer with `acks` false receives commands but never answers them.
+    FakeRendererClient(std::string name, int port, bool acks = true) : name_(std::move(name)), port_(port), acks_(acks) {
         thread_ = std::thread([this] { run(); });
     }
 
@@ -153,6 +154,9 @@ private:
                 std::lock_guard<std::mutex> lock(mutex_);
                 messages_.push_back(message);
             }
+            if (!acks_) {
+                continue;
+            }
 
             core::RendererMessage ack{};
             ack.type = core::RendererMessageType::Ack;
@@ -166,6 +170,7 @@ private:
 
     std::string name_;
     int port_;
+    bool acks_{true};
     int socketFd_{-1};
     std::thread thread_;
     std::atomic<bool> stop_{false};
@@ -316,4 +321,293 @@ TEST_CASE("LoadScene endpoint validates and forwards to renderer", "[http][rende
     std::filesystem::remove(dbPath);
 }
 
+TEST_CASE("Surface params endpoints forward partial updates and persist on request", "[http][renderer]") {
+    const auto rendererPort = reservePort();
+    auto registry = std::make_shared<renderer::RendererRegistry>();
+    registry->start(rendererPort);
+    REQUIRE(waitForRegistry(*registry));
+    FakeRendererClient fakeRenderer("renderer-main", rendererPort);
+    REQUIRE(fakeRenderer.waitUntilReady());
+
+    const auto httpPort = reservePort();
+    const auto dbPath = tempDbPath("renderer_surface_params.db");
+    RendererHttpContext ctx(dbPath, registry);
+
+    core::Feed feed(core::FeedId{}, "Feed", core::FeedType::VideoFile, R"({"filePath":"a.mp4"})");
+    feed = ctx.feedRepo.createFeed(feed);
+    std::vector<core::Vec2> quad{{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    core::Scene scene(core::SceneId{}, "Calibration", "",
+                      {core::Surface(core::SurfaceId{"params-surface"}, "One", quad, feed.getId())});
+    scene = ctx.sceneRepo.createScene(scene);
+
+    ServerRunner runner(ctx.httpServer, httpPort);
+    auto httpClient = makeClient(httpPort);
+    REQUIRE(waitForServer(*httpClient, ctx.httpServer));
+
+    nlohmann::json batch{{"updates", {{{"surfaceId", "params-surface"}, {"opacity", 0.5}},
+                                      {{"surfaceId", "other-surface"}, {"zOrder", 2}}}}};
+    auto res = httpClient->Post("/renderer/surfaceParams", batch.dump(), "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 200);
+
+    nlohmann::json single{{"sceneId", scene.getId().value}, {"brightness", 0.25}, {"blendMode", "Additive"}};
+    res = httpClient->Post("/renderer/surfaces/params-surface", single.dump(), "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 200);
+    REQUIRE(fakeRenderer.waitForMessages(2));
+
+    auto messages = fakeRenderer.messages();
+    REQUIRE(messages[0].type == core::RendererMessageType::UpdateSurfaceParams);
+    REQUIRE(messages[0].updateSurfaceParams->updates.size() == 2);
+    REQUIRE(*messages[0].updateSurfaceParams->updates[0].opacity == 0.5f);
+    REQUIRE(!messages[0].updateSurfaceParams->updates[0].zOrder.has_value());
+    const auto& update = messages[1].updateSurfaceParams->updates.at(0);
+    REQUIRE(update.surfaceId.value == "params-surface");
+    REQUIRE(*update.brightness == 0.25f);
+    REQUIRE(*update.blendMode == core::BlendMode::Additive);
+
+    // Only the request with a sceneId was stored.
+    auto stored = ctx.sceneRepo.findSceneById(scene.getId());
+    REQUIRE(stored.has_value());
+    REQUIRE(stored->getSurfaces()[0].getBrightness() == 0.25f);
+    REQUIRE(stored->getSurfaces()[0].getOpacity() == 1.0f);
+
+    res = httpClient->Post("/renderer/surfaces/params-surface", R"({"feedId":"no-such-feed"})", "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 400);
+    res = httpClient->Post("/renderer/surfaceParams", R"({"updates":[]})", "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 400);
+
+    std::filesystem::remove(dbPath);
+}
+
+TEST_CASE("Cue endpoints preload the cue table and fire cues by id", "[http][renderer]") {
+    const auto rendererPort = reservePort();
+    auto registry = std::make_shared<renderer::RendererRegistry>();
+    registry->start(rendererPort);
+    REQUIRE(waitForRegistry(*registry));
+    FakeRendererClient fakeRenderer("renderer-main", rendererPort);
+    REQUIRE(fakeRenderer.waitUntilReady());
+
+    const auto httpPort = reservePort();
+    const auto dbPath = tempDbPath("renderer_play_cue.db");
+    RendererHttpContext ctx(dbPath, registry);
+
+    core::Feed feed(core::FeedId{}, "Feed", core::FeedType::VideoFile, R"({"filePath":"a.mp4"})");
+    feed = ctx.feedRepo.createFeed(feed);
+    std::vector<core::Vec2> quad{{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    core::Scene scene(core::SceneId{}, "Show", "",
+                      {core::Surface(core::SurfaceId{"cue-surface"}, "One", quad, feed.getId())});
+    scene = ctx.sceneRepo.createScene(scene);
+    core::Cue cue(core::CueId{"cue-dim"}, "Dim", scene.getId());
+    cue.getSurfaceOpacities()[core::SurfaceId{"cue-surface"}] = 0.4f;
+    cue = ctx.cueRepo.createCue(cue);
+    core::Cue second(core::CueId{"cue-bright"}, "Bright", scene.getId());
+    second = ctx.cueRepo.createCue(second);
+
+    ServerRunner runner(ctx.httpServer, httpPort);
+    auto httpClient = makeClient(httpPort);
+    REQUIRE(waitForServer(*httpClient, ctx.httpServer));
+
+    auto res = httpClient->Post("/renderer/loadCues", "{}", "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 200);
+    REQUIRE(nlohmann::json::parse(res->body)["scenes"] == 1);
+
+    nlohmann::json play{{"cueId", cue.getId().value}};
+    res = httpClient->Post("/renderer/playCue", play.dump(), "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 200);
+    REQUIRE(fakeRenderer.waitForMessages(2));
+
+    auto messages = fakeRenderer.messages();
+    REQUIRE(messages[0].type == core::RendererMessageType::LoadCueTable);
+    REQUIRE(messages[0].cueTable->cues.size() == 2);
+    REQUIRE(messages[0].cueTable->scenes.size() == 1);
+    REQUIRE(messages[0].cueTable->scenes[0].scene.getId() == scene.getId());
+    REQUIRE(messages[0].cueTable->scenes[0].feeds.size() == 1);
+    // Without a projectId there are no project settings to send.
+    REQUIRE(!messages[0].cueTable->settings.has_value());
+    // Firing a cue sends only its id.
+    REQUIRE(messages[1].type == core::RendererMessageType::PlayCue);
+    REQUIRE(messages[1].playCue->cueId == cue.getId());
+    REQUIRE(nlohmann::json(messages[1]).dump().find("cue-surface") == std::string::npos);
+
+    res = httpClient->Post("/renderer/playCue", R"({"cueId":"no-such-cue"})", "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 400);
+
+    std::filesystem::remove(dbPath);
+}
+
+TEST_CASE("Renderer command endpoints can wait for acks", "[http][renderer][acks]") {
+    const auto rendererPort = reservePort();
+    auto registry = std::make_shared<renderer::RendererRegistry>();
+    registry->setAckTimeout(std::chrono::milliseconds(300));
+    registry->start(rendererPort);
+    REQUIRE(waitForRegistry(*registry));
+    FakeRendererClient acking("renderer-acking", rendererPort);
+    FakeRendererClient silent("renderer-silent", rendererPort, false);
+    REQUIRE(acking.waitUntilReady());
+    REQUIRE(silent.waitUntilReady());
+
+    const auto httpPort = reservePort();
+    const auto dbPath = tempDbPath("renderer_acks.db");
+    RendererHttpContext ctx(dbPath, registry);
+    core::Feed feed(core::FeedId{}, "Feed", core::FeedType::VideoFile, R"({"filePath":"a.mp4"})");
+    feed = ctx.feedRepo.createFeed(feed);
+    std::vector<core::Vec2> quad{{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    core::Scene scene(core::SceneId{}, "Show", "", {core::Surface(core::SurfaceId{"s"}, "One", quad, feed.getId())});
+    scene = ctx.sceneRepo.createScene(scene);
+    auto cue = ctx.cueRepo.createCue(core::Cue(core::CueId{"cue-acks"}, "Acks", scene.getId()));
+
+    ServerRunner runner(ctx.httpServer, httpPort);
+    auto httpClient = makeClient(httpPort);
+    REQUIRE(waitForServer(*httpClient, ctx.httpServer));
+
+    // Without waitForAcks the response does not wait.
+    nlohmann::json play{{"cueId", cue.getId().value}};
+    auto res = httpClient->Post("/renderer/playCue", play.dump(), "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 200);
+    auto payload = nlohmann::json::parse(res->body);
+    REQUIRE(payload["status"] == "sent");
+    REQUIRE(payload["renderers"] == 2);
+    REQUIRE(payload["commandId"].is_string());
+
+    // One of two is enough: answered as soon as the acking renderer acks.
+    play["waitForAcks"] = 1;
+    res = httpClient->Post("/renderer/playCue", play.dump(), "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 200);
+    payload = nlohmann::json::parse(res->body);
+    REQUIRE(payload["status"] == "acked");
+    REQUIRE(payload["acked"] == 1);
+    REQUIRE(payload["results"].size() == 2);
+    for (const auto& result : payload["results"]) {
+        if (result["renderer"] == "renderer-acking") {
+            REQUIRE(result["status"] == "acked");
+            REQUIRE(result["latencyMs"].get<double>() >= 0.0);
+        } else {
+            REQUIRE(result["status"] == "pending");
+        }
+    }
+
+    // All of them cannot be had: the silent renderer times out after the request's timeout.
+    play["waitForAcks"] = "all";
+    play["ackTimeoutMs"] = 100;
+    const auto start = std::chrono::steady_clock::now();
+    res = httpClient->Post("/renderer/playCue", play.dump(), "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(300));
+    REQUIRE(res->status == 504);
+    payload = nlohmann::json::parse(res->body);
+    REQUIRE(payload["status"] == "incomplete");
+    REQUIRE(payload["required"] == 2);
+    for (const auto& result : payload["results"]) {
+        REQUIRE(result["status"] == (result["renderer"] == "renderer-acking" ? "acked" : "timedOut"));
+    }
+
+    play["waitForAcks"] = "some";
+    res = httpClient->Post("/renderer/playCue", play.dump(), "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 400);
+
+    // The earlier commands' silent entries expire on the registry's own timeout.
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    res = httpClient->Get("/renderer/acks");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 200);
+    payload = nlohmann::json::parse(res->body);
+    REQUIRE(payload["commands"] == 3);
+    REQUIRE(payload["acked"] == 3);
+    REQUIRE(payload["timedOut"] == 3);
+    REQUIRE(payload["pendingCommands"] == 0);
+    REQUIRE(payload["latencyMs"]["max"].get<double>() >= payload["latencyMs"]["p50"].get<double>());
+
+    res = httpClient->Get("/renderer/queues");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 200);
+    payload = nlohmann::json::parse(res->body);
+    REQUIRE(payload["overflowPolicy"] == "drop-superseded");
+    REQUIRE(payload["overflowDisconnects"] == 0);
+    REQUIRE(payload["renderers"].size() == 2);
+    REQUIRE(payload["renderers"][0]["queuedMessages"] == 0);
+    REQUIRE(payload["broadcasts"]["count"] == 3);
+    REQUIRE(payload["broadcasts"]["queuedBytes"] == payload["broadcasts"]["encodedBytes"].get<uint64_t>() * 2);
+
+    std::filesystem::remove(dbPath);
+}
+
+TEST_CASE("Renderer command endpoints send to a target selector", "[http][renderer][target]") {
+    const auto rendererPort = reservePort();
+    auto registry = std::make_shared<renderer::RendererRegistry>();
+    registry->start(rendererPort);
+    REQUIRE(waitForRegistry(*registry));
+    FakeRendererClient stageLeft("stage-left", rendererPort);
+    FakeRendererClient foyer("foyer", rendererPort);
+    REQUIRE(stageLeft.waitUntilReady());
+    REQUIRE(foyer.waitUntilReady());
+
+    const auto httpPort = reservePort();
+    const auto dbPath = tempDbPath("renderer_target.db");
+    RendererHttpContext ctx(dbPath, registry);
+    core::Feed feed(core::FeedId{}, "Feed", core::FeedType::VideoFile, R"({"filePath":"a.mp4"})");
+    feed = ctx.feedRepo.createFeed(feed);
+    std::vector<core::Vec2> quad{{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    core::Scene scene(core::SceneId{}, "Show", "", {core::Surface(core::SurfaceId{"s"}, "One", quad, feed.getId())});
+    scene = ctx.sceneRepo.createScene(scene);
+    auto cue = ctx.cueRepo.createCue(core::Cue(core::CueId{"cue-target"}, "Target", scene.getId()));
+
+    ServerRunner runner(ctx.httpServer, httpPort);
+    auto httpClient = makeClient(httpPort);
+    REQUIRE(waitForServer(*httpClient, ctx.httpServer));
+
+    auto res = httpClient->Post("/renderer/renderers/foyer", R"({"group":"lobby","tags":["screens"]})",
+                                "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 200);
+    auto payload = nlohmann::json::parse(res->body);
+    REQUIRE(payload["connected"] == true);
+    REQUIRE(payload["group"] == "lobby");
+    res = httpClient->Post("/renderer/renderers/foyer", R"({"tags":"screens"})", "application/json");
+    REQUIRE(res->status == 400);
+
+    res = httpClient->Get("/renderer/renderers");
+    REQUIRE(res != nullptr);
+    payload = nlohmann::json::parse(res->body);
+    REQUIRE(payload.size() == 2);
+    REQUIRE(payload[0]["name"] == "foyer");
+    REQUIRE(payload[0]["tags"][0] == "screens");
+    REQUIRE(payload[1]["group"] == "");
+
+    nlohmann::json play{{"cueId", cue.getId().value}, {"target", "group:lobby"}, {"waitForAcks", "all"}};
+    res = httpClient->Post("/renderer/playCue", play.dump(), "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 200);
+    payload = nlohmann::json::parse(res->body);
+    REQUIRE(payload["target"] == "group:lobby");
+    REQUIRE(payload["renderers"] == 1);
+    REQUIRE(payload["results"][0]["renderer"] == "foyer");
+
+    nlohmann::json surface{{"opacity", 0.5}, {"target", "renderer:stage-left"}};
+    res = httpClient->Post("/renderer/surfaces/s", surface.dump(), "application/json");
+    REQUIRE(res != nullptr);
+    REQUIRE(res->status == 200);
+    REQUIRE(nlohmann::json::parse(res->body)["renderers"] == 1);
+    REQUIRE(stageLeft.waitForMessages(1));
+    REQUIRE(stageLeft.messages().front().type == core::RendererMessageType::UpdateSurfaceParams);
+    REQUIRE(foyer.messages().size() == 1);
+
+    play["target"] = "tag:nowhere";
+    res = httpClient->Post("/renderer/playCue", play.dump(), "application/json");
+    REQUIRE(res->status == 503);
+    play["target"] = "zone:lobby";
+    res = httpClient->Post("/renderer/playCue", play.dump(), "application/json");
+    REQUIRE(res->status == 400);
+
+    std::filesystem::remove(dbPath);
+}
+
 }  // namespace projection::server
@@ -0,0 +1,151 @@
+#include "renderer/OutboundQueue.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace projection::server::renderer {
+
+namespace {
+SharedLine line(const std::string& text) { return std::make_shared<const std::string>(text); }
+
+projection::core::RendererMessage surfaceUpdate(const std::string& surfaceId, bool withBrightness) {
+    projection::core::SurfaceParams params;
+    params.surfaceId = projection::core::SurfaceId{surfaceId};
+    params.opacity = 0.5f;
+    if (withBrightness) {
+        params.brightness = 1.0f;
+    }
+    projection::core::RendererMessage message{};
+    message.type = projection::core::RendererMessageType::UpdateSurfaceParams;
+    message.updateSurfaceParams = projection::core::UpdateSurfaceParamsMessage{{params}};
+    return message;
+}
+}  // namespace
+
+TEST_CASE("supersedeKey groups messages that replace each other", "[renderer][queue]") {
+    projection::core::RendererMessage definition{};
+    definition.type = projection::core::RendererMessageType::LoadSceneDefinition;
+    projection::core::RendererMessage loadScene{};
+    loadScene.type = projection::core::RendererMessageType::LoadScene;
+    projection::core::RendererMessage playCue{};
+    playCue.type = projection::core::RendererMessageType::PlayCue;
+    REQUIRE(supersedeKey(definition) == "scene");
+    // Cues stack overrides, and neither a cue nor a bare scene id replaces a definition.
+    REQUIRE(supersedeKey(playCue).empty());
+    REQUIRE(supersedeKey(loadScene).empty());
+    REQUIRE(supersedeKey(playCue) != supersedeKey(definition));
+    REQUIRE(supersedeKey(loadScene) != supersedeKey(definition));
+
+    REQUIRE(supersedeKey(surfaceUpdate("s1", false)) == supersedeKey(surfaceUpdate("s1", false)));
+    // Fewer fields or another surface: the earlier update still matters.
+    REQUIRE(supersedeKey(surfaceUpdate("s1", false)) != supersedeKey(surfaceUpdate("s1", true)));
+    REQUIRE(supersedeKey(surfaceUpdate("s1", false)) != supersedeKey(surfaceUpdate("s2", false)));
+
+    projection::core::RendererMessage ack{};
+    ack.type = projection::core::RendererMessageType::Ack;
+    REQUIRE(supersedeKey(ack).empty());
+
+    REQUIRE(parseOverflowPolicy("disconnect") == OverflowPolicy::Disconnect);
+    REQUIRE(!parseOverflowPolicy("block").has_value());
+}
+
+TEST_CASE("OutboundQueue drops superseded lines before it overflows", "[renderer][queue]") {
+    OutboundQueue queue(20, OverflowPolicy::DropSuperseded);
+    std::vector<std::string> dropped;
+
+    REQUIRE(queue.push({line("0123456789AB"), "scene", "cmd-scene"}, dropped) == OutboundQueue::PushResult::Queued);
+    REQUIRE(queue.push({line("fade1"), "fade", "cmd-1"}, dropped) == OutboundQueue::PushResult::Queued);
+    REQUIRE(queue.push({line("fade2"), "fade", "cmd-2"}, dropped) == OutboundQueue::PushResult::Queued);
+    REQUIRE(dropped == std::vector<std::string>{"cmd-1"});
+    auto stats = queue.stats();
+    REQUIRE(stats.queuedMessages == 2);
+    REQUIRE(stats.queuedBytes == 17);
+    REQUIRE(stats.droppedMessages == 1);
+
+    // Nothing queued is superseded by an unkeyed line: the renderer is too far behind.
+    dropped.clear();
+    REQUIRE(queue.push({line("other"), "", "cmd-3"}, dropped) == OutboundQueue::PushResult::Overflow);
+    REQUIRE(dropped.empty());
+    REQUIRE(queue.overflowed());
+    REQUIRE(queue.push({line("x"), "", ""}, dropped) == OutboundQueue::PushResult::Closed);
+}
+
+TEST_CASE("OutboundQueue with the disconnect policy never drops", "[renderer][queue]") {
+    OutboundQueue queue(8, OverflowPolicy::Disconnect);
+    std::vector<std::string> dropped;
+    // A line past the limit still fits into an empty queue.
+    REQUIRE(queue.push({line("0123456789"), "scene", "cmd-scene"}, dropped) == OutboundQueue::PushResult::Queued);
+    REQUIRE(queue.push({line("scene2"), "scene", "cmd-scene-2"}, dropped) == OutboundQueue::PushResult::Overflow);
+    REQUIRE(dropped.empty());
+    REQUIRE(queue.stats().queuedMessages == 1);
+    REQUIRE(queue.stats().droppedMessages == 0);
+}
+
+TEST_CASE("OutboundQueue writes queued lines and tracks depth", "[renderer][queue]") {
+    int fds[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+
+    OutboundQueue queue(1024, OverflowPolicy::DropSuperseded);
+    std::vector<std::string> dropped;
+    REQUIRE(queue.push({line("first\n"), "", "cmd-1"}, dropped) == OutboundQueue::PushResult::Queued);
+    queue.pushControl(line("second\n"));
+    REQUIRE(queue.stats().peakBytes == 13);
+
+    bool drained = false;
+    REQUIRE(queue.write(fds[0], drained));
+    REQUIRE(drained);
+    char buffer[32] = {};
+    REQUIRE(::read(fds[1], buffer, sizeof(buffer)) == 13);
+    REQUIRE(std::string(buffer) == "first\nsecond\n");
+
+    const auto stats = queue.stats();
+    REQUIRE(stats.queuedMessages == 0);
+    REQUIRE(stats.queuedBytes == 0);
+    REQUIRE(stats.sentMessages == 2);
+    // Both lines went out in one gathered write.
+    REQUIRE(stats.writes == 1);
+
+    queue.close();
+    REQUIRE(queue.push({line("late\n"), "", ""}, dropped) == OutboundQueue::PushResult::Closed);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_CASE("OutboundQueue resumes lines a full socket cut short", "[renderer][queue]") {
+    int fds[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+    int sendBuffer = 4096;
+    ::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+
+    OutboundQueue queue(1 << 20, OverflowPolicy::DropSuperseded);
+    std::vector<std::string> dropped;
+    std::string expected;
+    for (int i = 0; i < 200; ++i) {
+        const std::string text = std::to_string(i) + ":" + std::string(997, 'x') + "\n";
+        expected += text;
+        REQUIRE(queue.push({line(text), "", ""}, dropped) == OutboundQueue::PushResult::Queued);
+    }
+
+    std::string received;
+    char buffer[8192];
+    bool drained = false;
+    while (!drained) {
+        REQUIRE(queue.write(fds[0], drained));
+        ssize_t count = 0;
+        while ((count = ::read(fds[1], buffer, sizeof(buffer))) > 0) {
+            received.append(buffer, static_cast<size_t>(count));
+        }
+    }
+    REQUIRE(received == expected);
+    REQUIRE(queue.stats().sentMessages == 200);
+    REQUIRE(queue.stats().writes > 1);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+}  // namespace projection::server::renderer
@@ -4,6 +4,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <chrono>
 #include <condition_variable>
+#include <fstream>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <netinet/in.h>
 #include <nlohmann/json.hpp>
@@ -11,6 +14,8 @@
 #include <thread>
 #include <unistd.h>
 
+#include "projection/core/TimeSync.h"
+
 using projection::core::RendererMessage;
 using projection::core::RendererMessageType;
 
@@ -18,7 +23,8 @@ namespace projection::server::renderer {
 namespace {
 class FakeRendererClient {
 public:
-    FakeRendererClient(std::string name, int port) : name_(std::move(name)), port_(port) {
+    FakeRendererClient(std::string name, int port, RendererLabels labels = {})
+        : name_(std::move(name)), port_(port), labels_(std::move(labels)) {
         thread_ = std::thread([this] { run(); });
     }
 
@@ -52,11 +58,30 @@ public:
         return false;
     }
 
+    bool waitForCommand(const std::string& commandId, std::chrono::milliseconds timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (std::chrono::steady_clock::now() < deadline) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!messages_.empty() && messages_.back().commandId == commandId) {
+                    return true;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        return false;
+    }
+
     std::vector<RendererMessage> messages() const {
         std::lock_guard<std::mutex> lock(mutex_);
         return messages_;
     }
 
+    void send(const RendererMessage& message) {
+        std::string payload = nlohmann::json(message).dump() + "\n";
+        ::send(socketFd_, payload.c_str(), payload.size(), 0);
+    }
+
 private:
     void run() {
         socketFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
@@ -76,7 +101,7 @@ private:
         RendererMessage hello{};
         hello.type = RendererMessageType::Hello;
         hello.commandId = "cmd-hello";
-        hello.hello = projection::core::HelloMessage{"0.1", "renderer", name_};
+        hello.hello = projection::core::HelloMessage{"0.1", "renderer", name_, labels_.group, labels_.tags};
         std::string payload = nlohmann::json(hello).dump() + "\n";
         ::send(socketFd_, payload.c_str(), payload.size(), 0);
 
@@ -88,42 +113,44 @@ private:
                 break;
             }
             buffer.append(chunk, static_cast<size_t>(received));
-            auto newlinePos = buffer.find('\n');
-            if (newlinePos == std::string::npos) {
-                continue;
+            size_t newlinePos = 0;
+            while ((newlinePos = buffer.find('\n')) != std::string::npos) {
+                std::string line = buffer.substr(0, newlinePos);
+                buffer.erase(0, newlinePos + 1);
+                handleLine(line);
             }
+        }
+    }
 
-            std::string line = buffer.substr(0, newlinePos);
-            buffer.erase(0, newlinePos + 1);
-
-            auto json = nlohmann::json::parse(line);
-            RendererMessage message = json.get<RendererMessage>();
-
-            if (!ready_) {
-                {
-                    std::lock_guard<std::mutex> lock(mutex_);
-                    ready_ = true;
-                }
-                readyCv_.notify_all();
-                continue;
-            }
+    void handleLine(const std::string& line) {
+        auto json = nlohmann::json::parse(line);
+        RendererMessage message = json.get<RendererMessage>();
 
+        if (!ready_) {
             {
                 std::lock_guard<std::mutex> lock(mutex_);
-                messages_.push_back(message);
+                ready_ = true;
             }
+            readyCv_.notify_all();
+            return;
+        }
 
-            RendererMessage ack{};
-            ack.type = RendererMessageType::Ack;
-            ack.commandId = message.commandId;
-            ack.ack = projection::core::AckMessage{message.commandId};
-            std::string response = nlohmann::json(ack).dump() + "\n";
-            ::send(socketFd_, response.c_str(), response.size(), 0);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            messages_.push_back(message);
         }
+
+        RendererMessage ack{};
+        ack.type = RendererMessageType::Ack;
+        ack.commandId = message.commandId;
+        ack.ack = projection::core::AckMessage{message.commandId};
+        std::string response = nlohmann::json(ack).dump() + "\n";
+        ::send(socketFd_, response.c_str(), response.size(), 0);
     }
 
     std::string name_;
     int port_;
+    RendererLabels labels_;
     int socketFd_{-1};
     std::thread thread_;
     std::atomic<bool> stop_{false};
@@ -170,6 +197,60 @@ RendererMessage handshakeOnce(const std::string& name, int port) {
     }
 }
 
+RendererMessage makeSceneDefinition(const std::string& commandId, const std::string& sceneId) {
+    RendererMessage message{};
+    message.type = RendererMessageType::LoadSceneDefinition;
+    message.commandId = commandId;
+    message.loadSceneDefinition = projection::core::LoadSceneDefinitionMessage{
+        projection::core::Scene{projection::core::SceneId{sceneId}, "Scene", "", {}}, {}};
+    return message;
+}
+
+std::string sceneIdOf(const RendererMessage& message) {
+    return message.loadSceneDefinition ? message.loadSceneDefinition->scene.getId().value : std::string();
+}
+
+// Sends Hello and nothing else: never reads, never acks. `receiveBuffer` keeps the kernel from
+// absorbing much of what the registry sends.
+int connectWithoutReading(const std::string& name, int port, int receiveBuffer = 4096) {
+    const int socketFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(socketFd >= 0);
+    ::setsockopt(socketFd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    REQUIRE(::connect(socketFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    RendererMessage hello{};
+    hello.type = RendererMessageType::Hello;
+    hello.commandId = "cmd-hello";
+    hello.hello = projection::core::HelloMessage{"0.1", "renderer", name};
+    const std::string line = nlohmann::json(hello).dump() + "\n";
+    ::send(socketFd, line.c_str(), line.size(), 0);
+    return socketFd;
+}
+
+bool waitForRendererCount(RendererRegistry& registry, size_t count) {
+    for (int i = 0; i < 100; ++i) {
+        if (registry.rendererCount() == count) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+size_t processThreadCount() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("Threads:", 0) == 0) {
+            return static_cast<size_t>(std::stoul(line.substr(8)));
+        }
+    }
+    return 0;
+}
+
 int waitForPort(RendererRegistry& registry) {
     for (int i = 0; i < 100; ++i) {
         int port = registry.port();
@@ -203,7 +284,423 @@ TEST_CASE("RendererRegistry accepts renderer and broadcasts messages", "[rendere
     REQUIRE(messages.front().type == RendererMessageType::LoadScene);
     REQUIRE(messages.front().loadScene.has_value());
     REQUIRE(messages.front().loadScene->sceneId.value == "scene-1");
+    REQUIRE(!messages.front().executeAt.has_value());
+
+    registry.stop();
+}
+
+TEST_CASE("RendererRegistry answers time sync probes and schedules broadcasts", "[renderer][registry][timesync]") {
+    RendererRegistry registry;
+    registry.setScheduleLeadTime(std::chrono::milliseconds(50));
+    registry.start(0);
+    const int port = waitForPort(registry);
+    REQUIRE(port != 0);
+
+    FakeRendererClient renderer("alpha", port);
+    REQUIRE(renderer.waitUntilReady());
+
+    RendererMessage probe{};
+    probe.type = RendererMessageType::TimeSync;
+    probe.commandId = "sync-1";
+    probe.timeSync = projection::core::TimeSyncMessage{42, 0, 0};
+    const int64_t probeSentAt = projection::core::monotonicMicros();
+    renderer.send(probe);
+    REQUIRE(renderer.waitForMessages(1));
+
+    // Test and registry share a process, so both timestamps are on this clock.
+    const auto reply = renderer.messages().front();
+    REQUIRE(reply.type == RendererMessageType::TimeSync);
+    REQUIRE(reply.commandId == "sync-1");
+    REQUIRE(reply.timeSync->clientSendMicros == 42);
+    REQUIRE(reply.timeSync->serverReceiveMicros >= probeSentAt);
+    REQUIRE(reply.timeSync->serverSendMicros >= reply.timeSync->serverReceiveMicros);
+    REQUIRE(reply.timeSync->serverSendMicros <= projection::core::monotonicMicros());
+
+    RendererMessage message{};
+    message.type = RendererMessageType::LoadScene;
+    message.commandId = "cmd-load";
+    message.loadScene = projection::core::LoadSceneMessage{projection::core::SceneId{"scene-1"}};
+    const int64_t before = projection::core::monotonicMicros();
+    REQUIRE(registry.broadcastMessage(message) == 1);
+    const int64_t after = projection::core::monotonicMicros();
+    REQUIRE(renderer.waitForMessages(2));
+
+    const auto scheduled = renderer.messages().back();
+    REQUIRE(scheduled.executeAt.has_value());
+    REQUIRE(*scheduled.executeAt >= before + 50000);
+    REQUIRE(*scheduled.executeAt <= after + 50000);
+
+    // An explicit executeAt is left alone.
+    message.commandId = "cmd-explicit";
+    message.executeAt = 123;
+    REQUIRE(registry.broadcastMessage(message) == 1);
+    REQUIRE(renderer.waitForMessages(3));
+    REQUIRE(renderer.messages().back().executeAt == std::optional<int64_t>(123));
+
+    // Live surface updates are not held for the lead.
+    projection::core::SurfaceParams params;
+    params.surfaceId = projection::core::SurfaceId{"s1"};
+    params.opacity = 0.5f;
+    RendererMessage update{};
+    update.type = RendererMessageType::UpdateSurfaceParams;
+    update.commandId = "cmd-fader";
+    update.updateSurfaceParams = projection::core::UpdateSurfaceParamsMessage{{params}};
+    REQUIRE(registry.broadcastMessage(update) == 1);
+    REQUIRE(renderer.waitForMessages(4));
+    REQUIRE(!renderer.messages().back().executeAt.has_value());
+
+    registry.stop();
+}
+
+TEST_CASE("RendererRegistry replays the last scene and cue table to new renderers", "[renderer][registry]") {
+    RendererRegistry registry;
+    registry.setScheduleLeadTime(std::chrono::milliseconds(50));
+    registry.start(0);
+    const int port = waitForPort(registry);
+    REQUIRE(port != 0);
 
+    // Nothing is remembered from broadcasts that reached no renderer.
+    REQUIRE(registry.broadcastMessage(makeSceneDefinition("cmd-unsent", "scene-0")) == 0);
+
+    FakeRendererClient first("first", port);
+    REQUIRE(first.waitUntilReady());
+    RendererMessage table{};
+    table.type = RendererMessageType::LoadCueTable;
+    table.commandId = "cmd-cues";
+    table.cueTable = projection::core::CueTableMessage{};
+    REQUIRE(registry.broadcastMessage(table) == 1);
+    REQUIRE(registry.broadcastMessage(makeSceneDefinition("cmd-scene-1", "scene-1")) == 1);
+    REQUIRE(registry.broadcastMessage(makeSceneDefinition("cmd-scene-2", "scene-2")) == 1);
+    REQUIRE(first.waitForMessages(3));
+
+    // A renderer connecting later gets the cue table, then only the newest scene, unscheduled.
+    FakeRendererClient second("second", port);
+    REQUIRE(second.waitUntilReady());
+    REQUIRE(second.waitForMessages(2));
+    const auto replayed = second.messages();
+    REQUIRE(replayed.size() == 2);
+    REQUIRE(replayed[0].type == RendererMessageType::LoadCueTable);
+    REQUIRE(replayed[1].commandId == "cmd-scene-2");
+    REQUIRE(!replayed[1].executeAt.has_value());
+
+    registry.setReplayStateOnConnect(false);
+    FakeRendererClient third("third", port);
+    REQUIRE(third.waitUntilReady());
+    REQUIRE(!third.waitForMessages(1, std::chrono::milliseconds(100)));
+
+    registry.stop();
+}
+
+TEST_CASE("RendererRegistry replays the scene definition and the cue played on it", "[renderer][registry]") {
+    RendererRegistry registry;
+    registry.start(0);
+    const int port = waitForPort(registry);
+    REQUIRE(port != 0);
+
+    RendererMessage loadScene{};
+    loadScene.type = RendererMessageType::LoadScene;
+    loadScene.commandId = "cmd-load";
+    loadScene.loadScene = projection::core::LoadSceneMessage{projection::core::SceneId{"scene-1"}};
+    RendererMessage playCue{};
+    playCue.type = RendererMessageType::PlayCue;
+    playCue.commandId = "cmd-cue";
+    playCue.playCue = projection::core::PlayCueMessage{projection::core::CueId{"cue-dim"}};
+    {
+        FakeRendererClient first("first", port);
+        REQUIRE(first.waitUntilReady());
+        REQUIRE(registry.broadcastMessage(makeSceneDefinition("cmd-definition", "scene-1")) == 1);
+        REQUIRE(registry.broadcastMessage(loadScene) == 1);
+        REQUIRE(registry.broadcastMessage(playCue) == 1);
+        REQUIRE(first.waitForMessages(3));
+    }
+
+    // Neither the bare LoadScene nor the cue displaces the definition a renderer needs to draw.
+    FakeRendererClient second("second", port);
+    REQUIRE(second.waitUntilReady());
+    REQUIRE(second.waitForMessages(2));
+    REQUIRE(!second.waitForMessages(3, std::chrono::milliseconds(100)));
+    auto replayed = second.messages();
+    REQUIRE(replayed[0].commandId == "cmd-definition");
+    REQUIRE(sceneIdOf(replayed[0]) == "scene-1");
+    REQUIRE(replayed[1].commandId == "cmd-cue");
+
+    // A newer definition replaces the scene the cue was played on, so the cue is not replayed.
+    REQUIRE(registry.broadcastMessage(makeSceneDefinition("cmd-definition-2", "scene-2")) == 1);
+    FakeRendererClient third("third", port);
+    REQUIRE(third.waitUntilReady());
+    REQUIRE(third.waitForMessages(1));
+    REQUIRE(!third.waitForMessages(2, std::chrono::milliseconds(100)));
+    REQUIRE(sceneIdOf(third.messages().front()) == "scene-2");
+
+    registry.stop();
+}
+
+TEST_CASE("RendererRegistry serves many renderers from one event loop", "[renderer][registry]") {
+    RendererRegistry registry;
+    registry.start(0);
+    const int port = registry.port();
+    REQUIRE(port != 0);
+    const size_t threadsBefore = processThreadCount();
+
+    constexpr size_t kRenderers = 40;
+    std::vector<std::unique_ptr<FakeRendererClient>> renderers;
+    for (size_t i = 0; i < kRenderers; ++i) {
+        renderers.push_back(std::make_unique<FakeRendererClient>("renderer-" + std::to_string(i), port));
+    }
+    for (auto& renderer : renderers) {
+        REQUIRE(renderer->waitUntilReady());
+    }
+    REQUIRE(registry.rendererCount() == kRenderers);
+    // One thread per fake client; the registry adds none per connection.
+    REQUIRE(processThreadCount() <= threadsBefore + kRenderers);
+
+    RendererMessage message{};
+    message.type = RendererMessageType::LoadScene;
+    message.commandId = "cmd-load";
+    message.loadScene = projection::core::LoadSceneMessage{projection::core::SceneId{"scene-1"}};
+    REQUIRE(registry.broadcastMessage(message) == kRenderers);
+    for (auto& renderer : renderers) {
+        REQUIRE(renderer->waitForMessages(1));
+    }
+    // Encoded once; all 40 queues shared the one buffer.
+    const auto broadcasts = registry.broadcastStats();
+    REQUIRE(broadcasts.broadcasts == 1);
+    REQUIRE(broadcasts.encodedBytes > 0);
+    REQUIRE(broadcasts.queuedBytes == broadcasts.encodedBytes * kRenderers);
+    REQUIRE(broadcasts.maxEncodeMicros >= 0);
+
+    // Disconnects are noticed by the loop.
+    renderers.resize(kRenderers / 2);
+    REQUIRE(waitForRendererCount(registry, kRenderers / 2));
+    registry.stop();
+}
+
+TEST_CASE("RendererRegistry keeps broadcasting past a renderer that stops reading", "[renderer][registry]") {
+    RendererRegistry registry;
+    registry.start(0);
+    const int port = registry.port();
+    REQUIRE(port != 0);
+
+    // Handshakes, then never reads: its socket buffers fill and the rest waits in its queue.
+    const int stalledFd = connectWithoutReading("stalled", port);
+
+    FakeRendererClient healthy("healthy", port);
+    REQUIRE(healthy.waitUntilReady());
+    REQUIRE(waitForRendererCount(registry, 2));
+
+    // ~8 MB in total, well past what the stalled connection's buffers hold.
+    constexpr size_t kMessages = 2048;
+    RendererMessage message{};
+    message.type = RendererMessageType::LoadScene;
+    message.loadScene = projection::core::LoadSceneMessage{projection::core::SceneId{std::string(4096, 's')}};
+    for (size_t i = 0; i < kMessages; ++i) {
+        message.commandId = "cmd-" + std::to_string(i);
+        REQUIRE(registry.broadcastMessage(message) == 2);
+    }
+    REQUIRE(healthy.waitForMessages(kMessages, std::chrono::milliseconds(10000)));
+    REQUIRE(healthy.messages().back().commandId == "cmd-" + std::to_string(kMessages - 1));
+    REQUIRE(registry.rendererCount() == 2);
+
+    // Shutdown does not wait for the stalled renderer to drain.
+    registry.stop();
+    REQUIRE(registry.rendererCount() == 0);
+    ::close(stalledFd);
+}
+
+TEST_CASE("RendererRegistry bounds the queue of a renderer that stops reading", "[renderer][registry][queue]") {
+    RendererRegistry registry;
+    constexpr size_t kLimit = 64 * 1024;
+    registry.setOutboundQueueLimit(kLimit, OverflowPolicy::DropSuperseded);
+    registry.start(0);
+    const int port = registry.port();
+    REQUIRE(port != 0);
+
+    const int stalledFd = connectWithoutReading("stalled", port);
+    FakeRendererClient healthy("healthy", port);
+    REQUIRE(healthy.waitUntilReady());
+    REQUIRE(waitForRendererCount(registry, 2));
+
+    // Scene definitions replace each other, so the stalled queue stays bounded and connected.
+    constexpr size_t kScenes = 2048;
+    RendererMessage scene{};
+    scene.type = RendererMessageType::LoadSceneDefinition;
+    scene.loadSceneDefinition = projection::core::LoadSceneDefinitionMessage{
+        projection::core::Scene{projection::core::SceneId{std::string(4096, 's')}, "Scene", "", {}}, {}};
+    for (size_t i = 0; i < kScenes; ++i) {
+        scene.commandId = "scene-" + std::to_string(i);
+        REQUIRE(registry.broadcastMessage(scene) == 2);
+    }
+    REQUIRE(healthy.waitForCommand("scene-" + std::to_string(kScenes - 1), std::chrono::milliseconds(10000)));
+    REQUIRE(registry.rendererCount() == 2);
+    auto report = registry.queueStats();
+    REQUIRE(report.limitBytes == kLimit);
+    REQUIRE(report.overflowDisconnects == 0);
+    for (const auto& [name, stats] : report.renderers) {
+        if (name == "stalled") {
+            REQUIRE(stats.droppedMessages > 0);
+            REQUIRE(stats.queuedBytes <= kLimit);
+            REQUIRE(stats.peakBytes <= kLimit);
+        }
+    }
+
+    // Commands for distinct surfaces supersede nothing: the stalled renderer overflows and is
+    // disconnected, while the healthy one keeps up.
+    RendererMessage feed{};
+    feed.type = RendererMessageType::SetFeedForSurface;
+    bool disconnected = false;
+    for (size_t i = 0; i < 4096 && !disconnected; ++i) {
+        feed.commandId = "feed-" + std::to_string(i);
+        feed.setFeedForSurface = projection::core::SetFeedForSurfaceMessage{
+            projection::core::SurfaceId{"surface-" + std::to_string(i)}, projection::core::FeedId{std::string(4096, 'f')}};
+        registry.broadcastMessage(feed);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        disconnected = registry.rendererCount() == 1;
+    }
+    // The event loop closes the overflowed session; under load that can trail the last send.
+    disconnected = disconnected || waitForRendererCount(registry, 1);
+    REQUIRE(disconnected);
+    REQUIRE(registry.rendererNames() == std::vector<std::string>{"healthy"});
+    report = registry.queueStats();
+    REQUIRE(report.overflowDisconnects == 1);
+    REQUIRE(report.renderers.size() == 1);
+    REQUIRE(report.renderers[0].second.sentMessages > kScenes / 2);
+
+    registry.stop();
+    ::close(stalledFd);
+}
+
+TEST_CASE("RendererRegistry sends to a renderer, a group or a tag", "[renderer][registry][target]") {
+    RendererRegistry registry;
+    registry.start(0);
+    const int port = registry.port();
+    REQUIRE(port != 0);
+
+    FakeRendererClient leftA("left-a", port, RendererLabels{"zone-a", {"left"}});
+    FakeRendererClient rightA("right-a", port, RendererLabels{"zone-a", {"right"}});
+    FakeRendererClient leftB("left-b", port, RendererLabels{"zone-b", {"left"}});
+    REQUIRE(leftA.waitUntilReady());
+    REQUIRE(rightA.waitUntilReady());
+    REQUIRE(leftB.waitUntilReady());
+    REQUIRE(waitForRendererCount(registry, 3));
+
+    RendererMessage message{};
+    message.type = RendererMessageType::PlayCue;
+    message.playCue = projection::core::PlayCueMessage{projection::core::CueId{"cue-1"}};
+    message.commandId = "cmd-zone-a";
+    REQUIRE(registry.sendMessage(RendererTarget::group("zone-a"), message) == 2);
+    message.commandId = "cmd-left";
+    auto command = registry.sendCommand(RendererTarget::tag("left"), message);
+    REQUIRE(command != nullptr);
+    REQUIRE(command->targetCount() == 2);
+    REQUIRE(command->wait(2, std::chrono::seconds(2)).acked == 2);
+    message.commandId = "cmd-right-a";
+    REQUIRE(registry.sendMessage(RendererTarget::renderer("right-a"), message) == 1);
+    REQUIRE(registry.sendCommand(RendererTarget::group("zone-c"), message) == nullptr);
+
+    REQUIRE(leftA.waitForMessages(2));
+    REQUIRE(rightA.waitForMessages(2));
+    REQUIRE(leftB.waitForMessages(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE(leftA.messages().size() == 2);
+    REQUIRE(rightA.messages().back().commandId == "cmd-right-a");
+    REQUIRE(leftB.messages().size() == 1);
+    REQUIRE(leftB.messages().front().commandId == "cmd-left");
+
+    // An assignment overrides the Hello and moves the renderer between zones.
+    REQUIRE(registry.assignLabels("left-b", RendererLabels{"zone-a", {}}));
+    REQUIRE(!registry.assignLabels("spare", RendererLabels{"zone-b", {}}));
+    message.commandId = "cmd-zone-a-2";
+    REQUIRE(registry.sendMessage(RendererTarget::group("zone-a"), message) == 3);
+    REQUIRE(leftB.waitForMessages(2));
+    for (const auto& info : registry.renderers()) {
+        if (info.name == "left-b") {
+            REQUIRE(info.labels.group == "zone-a");
+            REQUIRE(info.labels.tags.empty());
+        }
+    }
+    registry.stop();
+}
+
+TEST_CASE("RendererRegistry replays the state addressed to each reconnecting renderer", "[renderer][registry][target]") {
+    RendererRegistry registry;
+    registry.start(0);
+    const int port = registry.port();
+    REQUIRE(port != 0);
+
+    {
+        FakeRendererClient a("zone-a-1", port, RendererLabels{"zone-a", {}});
+        FakeRendererClient b("zone-b-1", port, RendererLabels{"zone-b", {}});
+        REQUIRE(a.waitUntilReady());
+        REQUIRE(b.waitUntilReady());
+        REQUIRE(waitForRendererCount(registry, 2));
+
+        REQUIRE(registry.broadcastMessage(makeSceneDefinition("cmd-all", "scene-shared")) == 2);
+        REQUIRE(registry.sendMessage(RendererTarget::group("zone-a"), makeSceneDefinition("cmd-a", "scene-a")) == 1);
+        REQUIRE(a.waitForMessages(2));
+        REQUIRE(b.waitForMessages(1));
+    }
+    REQUIRE(waitForRendererCount(registry, 0));
+
+    FakeRendererClient a("zone-a-2", port, RendererLabels{"zone-a", {}});
+    FakeRendererClient b("zone-b-2", port, RendererLabels{"zone-b", {}});
+    REQUIRE(a.waitForMessages(1));
+    REQUIRE(b.waitForMessages(1));
+    REQUIRE(sceneIdOf(a.messages().front()) == "scene-a");
+    REQUIRE(sceneIdOf(b.messages().front()) == "scene-shared");
+
+    // A later broadcast supersedes every zone's state.
+    REQUIRE(registry.broadcastMessage(makeSceneDefinition("cmd-all-2", "scene-finale")) == 2);
+    FakeRendererClient late("zone-a-3", port, RendererLabels{"zone-a", {}});
+    REQUIRE(late.waitForMessages(1));
+    REQUIRE(sceneIdOf(late.messages().front()) == "scene-finale");
+    registry.stop();
+}
+
+TEST_CASE("RendererRegistry correlates renderer acks with the commands it sent", "[renderer][registry][acks]") {
+    RendererRegistry registry;
+    registry.setAckTimeout(std::chrono::milliseconds(100));
+    registry.start(0);
+    const int port = registry.port();
+    REQUIRE(port != 0);
+
+    FakeRendererClient acking("acking", port);
+    REQUIRE(acking.waitUntilReady());
+    const int silentFd = connectWithoutReading("silent", port, 1 << 16);
+    REQUIRE(waitForRendererCount(registry, 2));
+
+    RendererMessage message{};
+    message.type = RendererMessageType::LoadScene;
+    message.commandId = "cmd-tracked";
+    message.loadScene = projection::core::LoadSceneMessage{projection::core::SceneId{"scene-1"}};
+    auto command = registry.sendCommand(message);
+    REQUIRE(command != nullptr);
+    REQUIRE(command->targetCount() == 2);
+
+    const auto acked = command->future("acking").get();
+    REQUIRE(acked.status == AckStatus::Acked);
+    REQUIRE(acked.latencyMicros > 0);
+    // The loop wakes for the deadline even with no socket activity.
+    auto silent = command->future("silent");
+    REQUIRE(silent.wait_for(std::chrono::seconds(2)) == std::future_status::ready);
+    REQUIRE(silent.get().status == AckStatus::TimedOut);
+    REQUIRE(command->done());
+
+    // A renderer that drops owes nothing more; the wait ends without the timeout.
+    message.commandId = "cmd-dropped";
+    command = registry.sendCommand(message, std::chrono::milliseconds(10000));
+    REQUIRE(command->wait(1, std::chrono::seconds(2)).acked == 1);
+    ::close(silentFd);
+    const auto report = command->wait(2, std::chrono::seconds(2));
+    REQUIRE(report.acked == 1);
+    REQUIRE(report.disconnected == 1);
+
+    const auto stats = registry.ackStats();
+    REQUIRE(stats.commands == 2);
+    REQUIRE(stats.acked == 2);
+    REQUIRE(stats.timedOut == 1);
+    REQUIRE(stats.disconnected == 1);
+    REQUIRE(stats.pendingCommands == 0);
+    REQUIRE(stats.maxMs > 0.0);
     registry.stop();
 }
 
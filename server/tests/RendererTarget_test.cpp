@@ -0,0 +1,36 @@
+#include "renderer/RendererTarget.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+namespace projection::server::renderer {
+
+TEST_CASE("parseRendererTarget reads every selector form", "[renderer][target]") {
+    REQUIRE(parseRendererTarget("all") == RendererTarget::all());
+    REQUIRE(parseRendererTarget("renderer:left-1") == RendererTarget::renderer("left-1"));
+    REQUIRE(parseRendererTarget("group:zone-a") == RendererTarget::group("zone-a"));
+    // Only the first colon separates: tag values may contain more.
+    REQUIRE(parseRendererTarget("tag:floor:2") == RendererTarget::tag("floor:2"));
+    REQUIRE(parseRendererTarget("group:zone-a")->toString() == "group:zone-a");
+
+    REQUIRE(!parseRendererTarget("").has_value());
+    REQUIRE(!parseRendererTarget("group:").has_value());
+    REQUIRE(!parseRendererTarget("zone:a").has_value());
+    REQUIRE(!parseRendererTarget("left-1").has_value());
+}
+
+TEST_CASE("RendererTarget matches by name, group or tag", "[renderer][target]") {
+    const RendererLabels labels{"zone-a", {"left", "upper"}};
+    REQUIRE(RendererTarget::all().matches("left-1", labels));
+    REQUIRE(RendererTarget::all().matches("bare", RendererLabels{}));
+    REQUIRE(RendererTarget::renderer("left-1").matches("left-1", labels));
+    REQUIRE(!RendererTarget::renderer("left-2").matches("left-1", labels));
+    REQUIRE(RendererTarget::group("zone-a").matches("left-1", labels));
+    REQUIRE(!RendererTarget::group("zone-b").matches("left-1", labels));
+    REQUIRE(RendererTarget::tag("upper").matches("left-1", labels));
+    REQUIRE(!RendererTarget::tag("lower").matches("left-1", labels));
+    // A renderer without a group is not in the group "".
+    REQUIRE(!RendererTarget::group("zone-a").matches("bare", RendererLabels{}));
+}
+
+}  // namespace projection::server::renderer